@@ -83,7 +83,8 @@ public:
         sizeOfFastAlloc32(16384),
         sizeOfFastAlloc64(16384),
         useDisplay(True),
-        clearLog(True)
+        clearLog(True),
+        asyncLog(False)
     {
     }
 
@@ -105,6 +106,12 @@ public:
      * @details Clear the default choosen log file at startup.
     */
     Bool clearLog;
+
+    /**
+     * @details Write the default log file from a background thread, using an
+     * AsyncLogger, and flush it on a crash. Not for Android, which uses logcat.
+    */
+    Bool asyncLog;
 };
 
 /**
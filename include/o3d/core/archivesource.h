@@ -0,0 +1,62 @@
+/**
+ * @file archivesource.h
+ * @brief Shared positional access to an archive stream.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_ARCHIVESOURCE_H
+#define _O3D_ARCHIVESOURCE_H
+
+#include "instream.h"
+#include "smartcounter.h"
+#include "mutex.h"
+
+namespace o3d {
+
+/**
+ * @brief Positional and thread-safe reads into the stream of an archive.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * A MmapInStream is read directly from its mapping, and a FileInStream with positional
+ * reads on its descriptor, so concurrent reads do not wait for each other. Any other
+ * stream is sought and read under a mutex.
+ * It is shared by an archive (Zip, ChunkPack) and its entries streams, and deletes
+ * the archive stream when no longer used.
+ */
+class O3D_API ArchiveSource : public SmartCounter<ArchiveSource>, NonCopyable<>
+{
+public:
+
+    //! Construct and take the ownership of the archive stream.
+    ArchiveSource(InStream *is);
+
+    virtual ~ArchiveSource();
+
+    //! Read size bytes at the position pos of the archive.
+    //! @return The number of read bytes.
+    UInt32 readAt(UInt64 pos, void *buf, UInt32 size);
+
+    //! Get the data of a memory mapped archive, or null.
+    inline const UInt8* getData() const { return m_data; }
+
+    //! Get the size of a memory mapped archive.
+    inline UInt64 getSize() const { return m_size; }
+
+private:
+
+    InStream *m_is;
+
+    const UInt8 *m_data;    //!< Mapped data if any.
+    UInt64 m_size;          //!< Mapped data size.
+
+    int m_fd;               //!< Descriptor for the positional reads, or -1.
+
+    FastMutex m_mutex;      //!< Protect m_is for the others streams.
+};
+
+} // namespace o3d
+
+#endif // _O3D_ARCHIVESOURCE_H
@@ -114,6 +114,13 @@ public:
      * @param path
      */
     virtual void searchFirstFile(const String &path) = 0;
+
+    /**
+     * @brief Is the list of files complete once mounted, so it can be indexed by the
+     *        FileManager. Otherwise the asset is searched at each lookup.
+     * @return True by default.
+     */
+    virtual Bool isIndexable() const { return True; }
 };
 
 typedef std::list<Asset*> T_AssetList;
@@ -0,0 +1,190 @@
+/**
+ * @file assetcache.h
+ * @brief Persistent content addressed cache of the converted resources.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_ASSETCACHE_H
+#define _O3D_ASSETCACHE_H
+
+#include "string.h"
+#include "smartarray.h"
+#include "templatearray.h"
+#include "mutex.h"
+#include "smartcounter.h"
+#include "xxhash3.h"
+
+#include <unordered_map>
+
+namespace o3d {
+
+/**
+ * @brief On disk cache of the results of the resources conversions, addressed by a
+ * hash of the source data and of the conversion parameters.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Each entry is a file of the cache directory, named by its key. The total size of
+ * the entries is bounded by a budget, the least recently used entries being evicted
+ * first. The last uses are saved into an index file by flush and at destruction, the
+ * entries found without index are the first evicted. The methods are thread safe,
+ * and an entry is written into a temporary file next renamed, so a process never
+ * read a partial entry.
+ * It is shared using SmartPtr, a user keeps it alive while the FileManager replaces it.
+ */
+class O3D_API AssetCache : public SmartCounter<AssetCache>
+{
+public:
+
+    static const UInt32 MAGIC = 0x4344334f;     //!< 'O3DC'
+    static const UInt32 VERSION = 1;
+
+    //! Default budget in bytes.
+    static const UInt64 DEFAULT_BUDGET = 256 * 1024 * 1024;
+
+    /**
+     * @brief Key of an entry, hashing the kind and version of a conversion, its source
+     * data and its parameters, using a 128 bits XXH3.
+     * The conversion version must be incremented when its algorithm or its result
+     * layout change, invalidating the previous entries.
+     */
+    class O3D_API Key
+    {
+    public:
+
+        Key(const String &kind, UInt32 version);
+
+        //! Hash some source data.
+        Key& addData(const void *data, UInt32 size);
+
+        //! Hash a string parameter.
+        Key& addString(const String &str);
+
+        //! Hash a plain parameter value.
+        template<class T>
+        inline Key& addValue(const T &value) { return addData(&value, sizeof(T)); }
+
+        //! Finalize if necessary and get the hexadecimal key.
+        const String& getHex();
+
+    private:
+
+        XXH3Hash m_hash;
+        String m_hex;
+
+        Key(const Key &dup);
+        Key& operator=(const Key &dup);
+    };
+
+    struct Stats
+    {
+        UInt64 hits;          //!< Number of fetched entries.
+        UInt64 misses;        //!< Number of fetches of a missing or invalid entry.
+        UInt64 stores;        //!< Number of stored entries.
+        UInt64 evictions;     //!< Number of evicted entries.
+        UInt64 bytesRead;     //!< Size of the fetched entries.
+        UInt64 bytesWritten;  //!< Size of the stored entries.
+        UInt32 numEntries;    //!< Current number of entries.
+        UInt64 size;          //!< Current size of the entries.
+        UInt64 budget;        //!< Maximal size of the entries.
+
+        //! Ratio of the hits over the fetches, or 0 if none.
+        inline Double getHitRatio() const
+        {
+            return (hits + misses) > 0 ? (Double)hits / (Double)(hits + misses) : 0.0;
+        }
+    };
+
+    /**
+     * @brief Open or create a cache directory. The entries are evicted until the budget.
+     * @param path Absolute or working directory relative path of the cache directory.
+     * @param budget Maximal size in bytes of the entries.
+     */
+    AssetCache(const String &path, UInt64 budget = DEFAULT_BUDGET);
+
+    //! Save the index.
+    ~AssetCache();
+
+    //! Get the absolute path of the cache directory.
+    inline const String& getPath() const { return m_path; }
+
+    //! Define the maximal size in bytes of the entries, evicting if necessary.
+    void setBudget(UInt64 budget);
+
+    //! Get the maximal size in bytes of the entries.
+    UInt64 getBudget() const;
+
+    //! Fetch the content of an entry, counting a hit or a miss.
+    //! @return True if the entry exists and is valid.
+    Bool fetch(const String &key, SmartArrayUInt8 &data);
+
+    //! Store or replace an entry, evicting the least recently used entries if the
+    //! budget is exceeded.
+    //! @return True if the entry is written.
+    Bool store(const String &key, const UInt8 *data, UInt32 size);
+
+    //! Store or replace an entry.
+    inline Bool store(const String &key, const ArrayUInt8 &data)
+    {
+        return store(key, data.getData(), (UInt32)data.getSize());
+    }
+
+    //! Check for an entry, without counting it or updating its last use.
+    Bool contains(const String &key) const;
+
+    //! Remove an entry.
+    void remove(const String &key);
+
+    //! Remove every entry.
+    void clear();
+
+    //! Save the index of the last uses.
+    void flush();
+
+    //! Get the statistics, including the current size.
+    Stats getStats() const;
+
+    //! Reset the hits, misses, stores, evictions and transfered bytes counters.
+    void resetStats();
+
+private:
+
+    struct Entry
+    {
+        UInt64 size;      //!< Size of the entry file.
+        UInt64 lastUse;   //!< Last use tick.
+    };
+
+    typedef std::unordered_map<String, Entry, std::hash<String> > T_EntryMap;
+
+    mutable FastMutex m_mutex;
+
+    String m_path;
+    UInt64 m_budget;
+    UInt64 m_size;
+    UInt64 m_clock;       //!< Increased at each use.
+
+    T_EntryMap m_entries;
+    Stats m_stats;
+
+    //! Name of the file of an entry, relative to the cache directory.
+    static String entryFileName(const String &key);
+
+    //! List the entry files and restore their last uses from the index.
+    void load();
+
+    //! Remove an entry file. The mutex must be locked.
+    void removeEntry(T_EntryMap::iterator it);
+
+    //! Evict the least recently used entries until the budget. The mutex must be locked.
+    void evict();
+
+    AssetCache(const AssetCache &dup);
+    AssetCache& operator=(const AssetCache &dup);
+};
+
+} // namespace o3d
+
+#endif // _O3D_ASSETCACHE_H
@@ -0,0 +1,250 @@
+/**
+ * @file asynclogger.h
+ * @brief File logger writing from a background thread.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_ASYNCLOGGER_H
+#define _O3D_ASYNCLOGGER_H
+
+#include "logger.h"
+#include "thread.h"
+
+#include <atomic>
+#include <vector>
+
+namespace o3d {
+
+/**
+ * @brief File logger whose writes are done by a background thread.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The callers copy the message and a timestamp into a bounded lock-free ring buffer
+ * of records, without lock nor allocation for messages of less than
+ * INLINE_LENGTH characters. The date, the time and the UTF-8 encoding are done by the
+ * background thread, which writes the pending records by batches, with a single
+ * write and flush per batch.
+ * When the ring buffer is full the overflow policy applies to the records of level
+ * lower than ERROR. The ERROR and CRITICAL records always wait for a free record.
+ * The background thread is an o3d::Thread, so it must be stopped with stopAll()
+ * before ThreadManager::waitEndThreads(), what Application::quit() does. Once stopped
+ * the logger writes synchronously from the calling thread, like FileLogger.
+ * The output is the same as FileLogger for the same date format.
+ */
+class O3D_API AsyncLogger : public Logger
+{
+public:
+
+    //! Behavior of log() when the ring buffer is full.
+    enum OverflowPolicy
+    {
+        OVERFLOW_DROP = 0,    //!< Drop the new records and count them.
+        OVERFLOW_BLOCK,       //!< Wait for the background thread to free some records.
+        OVERFLOW_SAMPLE       //!< Past 3/4 of the capacity, keep only one record of N.
+    };
+
+    //! Number of characters stored inline in a record, longer messages are allocated.
+    static const UInt32 INLINE_LENGTH = 120;
+
+    //! Size of the buffer of the records written from a fatal signal handler.
+    static const UInt32 SIGNAL_BUFFER_SIZE = 16384;
+
+    //! Constructor. Start the background thread.
+    //! @param logname Log file name, relative to the working directory or absolute.
+    //! @param capacity Number of records of the ring buffer, rounded to a power of two.
+    //! @param policy Behavior when the ring buffer is full.
+    AsyncLogger(
+            const String &logname,
+            UInt32 capacity = 2048,
+            OverflowPolicy policy = OVERFLOW_DROP);
+
+    //! Write the pending records and stop the background thread.
+    virtual ~AsyncLogger();
+
+    //! set the log file name. Pending records are written into the previous file.
+    void setLogFileName(const String &name);
+    //! get the log file name
+    const String& getLogFileName() const;
+
+    //! push a message to write in the log file.
+    //! @param str The message to write
+    virtual void log(LogLevel level, const String &str) override;
+
+    //! set the date format, default is no date, empty string mean none.
+    virtual void setDateFormat(const String &format) override;
+    //! get the date format, can be empty.
+    virtual const String& getDateFormat() const override;
+
+    //! clean log file. Pending records are written before.
+    virtual void clearLog() override;
+
+    //! set the minimal log level.
+    virtual void setLogLevel(LogLevel minLevel) override;
+
+    //! get the minimal log level.
+    virtual LogLevel getLogLevel() const override;
+
+    //! Set the overflow policy.
+    //! @param sampleRate For OVERFLOW_SAMPLE, one record of sampleRate is kept.
+    void setOverflowPolicy(OverflowPolicy policy, UInt32 sampleRate = 8);
+
+    //! Get the overflow policy.
+    inline OverflowPolicy getOverflowPolicy() const { return (OverflowPolicy)m_policy.load(); }
+
+    //! Get the sample rate used by OVERFLOW_SAMPLE.
+    inline UInt32 getSampleRate() const { return m_sampleRate.load(); }
+
+    //! Get the number of records of the ring buffer.
+    inline UInt32 getCapacity() const { return m_mask + 1; }
+
+    //! Get the number of records dropped since the creation.
+    inline UInt64 getNumDropped() const { return m_numDropped.load(); }
+
+    //! Set the maximal delay before writing the pending records (default 50ms).
+    void setFlushDelay(UInt32 ms);
+
+    //! Get the maximal delay before writing the pending records.
+    inline UInt32 getFlushDelay() const { return m_flushDelay.load(); }
+
+    //! Write the pending records from the calling thread and flush the file.
+    void flush();
+
+    //! Write the pending records and stop the background thread. The next records are
+    //! written synchronously from the calling thread.
+    void stop();
+
+    //! Is the background thread running.
+    inline Bool isRunning() const { return m_running.load(); }
+
+    //! Flush every living async logger.
+    static void flushAll();
+
+    //! Stop the background thread of every living async logger.
+    static void stopAll();
+
+    //! Install the handlers flushing every living async logger on a crash: the
+    //! terminate handler and the fatal signals or the unhandled exception filter. They
+    //! call the previous handler after the flush. Best effort, because the crashing
+    //! thread can own some lock needed by the flush. A fatal signal only writes the
+    //! pending records without their date (see flushOnSignal). Only once, next calls
+    //! do nothing.
+    static void installCrashHandler();
+
+    //! Flush every living async logger from a crash handler, waiting for the locks only
+    //! a short delay.
+    static void flushOnCrash();
+
+#ifndef O3D_WINDOWS
+    //! Write the pending records of every living async logger from a fatal signal
+    //! handler. Async-signal-safe: no lock and no allocation, the records are encoded
+    //! without their date into a buffer allocated with the logger, and written with
+    //! write(). The loggers whose records are being written by a thread are skipped.
+    static void flushOnSignal();
+#endif
+
+private:
+
+    struct Record
+    {
+        std::atomic<UInt32> sequence;  //!< Ring buffer sequence (Vyukov's bounded queue).
+        Int64 time;                    //!< System::getTime() when pushed.
+        WChar *heap;                   //!< Allocated message, or null if inline.
+        WChar text[INLINE_LENGTH];     //!< Null terminated inline message.
+    };
+
+    class Writer : public Runnable
+    {
+    public:
+
+        Writer(AsyncLogger *logger);
+        virtual Int32 run(void *) override;
+
+        AsyncLogger *m_logger;
+    };
+
+    Record *m_records;
+    UInt32 m_mask;
+
+    std::atomic<UInt32> m_enqueuePos;
+    std::atomic<UInt32> m_dequeuePos;     //!< Modified with m_writeMutex locked.
+
+    std::atomic<Int32> m_policy;
+    std::atomic<UInt32> m_sampleRate;
+    std::atomic<UInt32> m_sampleCount;
+    std::atomic<UInt64> m_numDropped;
+    UInt64 m_numReported;                 //!< Number of dropped records already reported.
+
+    std::atomic<Int32> m_logLevel;
+    std::atomic<UInt32> m_flushDelay;
+    std::atomic<Bool> m_running;
+    std::atomic<Bool> m_sleeping;         //!< The writer is waiting for records.
+    std::atomic<Int32> m_numBlocked;      //!< Callers waiting for a free record.
+    std::atomic<Bool> m_consuming;        //!< The records are popped, by drain or a signal.
+
+    FastMutex m_writeMutex;               //!< Consumer side, file and formats.
+    FastMutex m_sleepMutex;
+    WaitCondition m_wakeUp;               //!< Wake up the writer.
+    WaitCondition m_freed;                //!< Wake up the blocked callers.
+
+    Writer m_writer;
+    Thread m_thread;
+
+    String m_absolutefname; //!< the filename in absolute path
+    String m_logFilename;   //!< log file name
+    String m_dateFormat;    //!< date format
+
+    OutStream *m_os;        //!< file output stream
+
+    std::vector<Char> m_batch;  //!< UTF-8 content of the current batch
+    Int64 m_epochBase;      //!< Epoch time in microseconds at System::getTime() == 0.
+    Int64 m_lastSecond;     //!< Second of the cached date.
+    CString m_lastDate;     //!< Cached UTF-8 date string.
+    Bool m_dateUs;          //!< The date format contains the microseconds.
+    Int64 m_timeFrequency;  //!< System::getTimeFrequency().
+
+    Char *m_signalBuffer;           //!< Records encoded from a fatal signal handler.
+    std::atomic<Int32> m_signalFd;  //!< Append only descriptor of the file, or -1.
+
+    //! Try to push a record, false if the ring buffer is full.
+    Bool tryPush(Int64 time, const String &str);
+
+    //! Write synchronously a single record, after the pending ones.
+    void writeRecord(Int64 time, const String &str);
+
+    //! Pop and write all the pending records, the write mutex must be locked.
+    //! @return The number of written records.
+    UInt32 drain();
+
+    //! Format a record into the batch.
+    void format(Int64 time, const WChar *text);
+
+    //! Write the batch into the file and flush, the write mutex must be locked.
+    void writeBatch();
+
+    //! Replace the output stream, writing the pending records into the previous one.
+    void setStream(OutStream *os);
+
+    //! Wake up the writer if it waits for records.
+    void wakeUpWriter();
+
+#ifndef O3D_WINDOWS
+    //! Open the append only descriptor used from a fatal signal handler.
+    void openSignalFd();
+
+    //! Pop and write all the pending records from a fatal signal handler.
+    void writeOnSignal();
+#endif
+
+    //! Background thread loop.
+    void process();
+
+    AsyncLogger(const AsyncLogger &dup);
+    AsyncLogger& operator=(const AsyncLogger &dup);
+};
+
+} // namespace o3d
+
+#endif // _O3D_ASYNCLOGGER_H
@@ -390,6 +390,9 @@ public:
     //! Invert the byte-order.
     static inline void swapBytes8(void* value);
 
+    //! Invert the byte-order of an array of count elements of 2, 4 or 8 bytes.
+    static inline void swapBytesArray(void* values, UInt32 size, UInt32 count);
+
 	//-----------------------------------------------------------------------------------
 	// Global message output
 	//-----------------------------------------------------------------------------------
@@ -575,6 +578,31 @@ inline void System::swapBytes8(void* value)
     ((UInt8*)value)[7] = t0;
 }
 
+inline void System::swapBytesArray(void* values, UInt32 size, UInt32 count)
+{
+    // shifts and masks only, so the loops can be vectorized
+    if (size == 2) {
+        UInt16 *v = (UInt16*)values;
+        for (UInt32 i = 0; i < count; ++i) {
+            v[i] = (UInt16)((v[i] >> 8) | (v[i] << 8));
+        }
+    } else if (size == 4) {
+        UInt32 *v = (UInt32*)values;
+        for (UInt32 i = 0; i < count; ++i) {
+            const UInt32 t = v[i];
+            v[i] = (t >> 24) | ((t >> 8) & 0xff00) | ((t << 8) & 0xff0000) | (t << 24);
+        }
+    } else if (size == 8) {
+        UInt64 *v = (UInt64*)values;
+        for (UInt32 i = 0; i < count; ++i) {
+            UInt64 t = v[i];
+            t = ((t >> 8) & 0x00ff00ff00ff00ffULL) | ((t & 0x00ff00ff00ff00ffULL) << 8);
+            t = ((t >> 16) & 0x0000ffff0000ffffULL) | ((t & 0x0000ffff0000ffffULL) << 16);
+            v[i] = (t >> 32) | (t << 32);
+        }
+    }
+}
+
 } // namespace o3d
 
 #endif // _O3D_BASE_H
@@ -0,0 +1,121 @@
+/**
+ * @file batchmath.h
+ * @brief Transformations and reductions of arrays of 3 components vectors.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_BATCHMATH_H
+#define _O3D_BATCHMATH_H
+
+#include "matrix4.h"
+#include "vector3.h"
+
+namespace o3d {
+
+/**
+ * @brief Array of 3 components vectors, either interleaved (AoS) or in three separate
+ * arrays (SoA). The vector i is (x[i*stride], y[i*stride], z[i*stride]).
+ */
+struct BatchVectors
+{
+    Float *x;
+    Float *y;
+    Float *z;
+    UInt32 stride;  //!< Number of floats from a vector to the next one.
+
+    BatchVectors(Float *_x, Float *_y, Float *_z, UInt32 _stride) :
+        x(_x), y(_y), z(_z), stride(_stride) {}
+
+    //! Interleaved vectors, 3 consecutive floats every stride floats.
+    static BatchVectors aos(Float *data, UInt32 stride = 3)
+    {
+        return BatchVectors(data, data + 1, data + 2, stride);
+    }
+
+    //! Contiguous arrays of components.
+    static BatchVectors soa(Float *x, Float *y, Float *z)
+    {
+        return BatchVectors(x, y, z, 1);
+    }
+};
+
+/**
+ * @brief Read only array of 3 components vectors, interleaved (AoS) or in three
+ * separate arrays (SoA). The vector i is (x[i*stride], y[i*stride], z[i*stride]).
+ */
+struct ConstBatchVectors
+{
+    const Float *x;
+    const Float *y;
+    const Float *z;
+    UInt32 stride;  //!< Number of floats from a vector to the next one.
+
+    ConstBatchVectors(const Float *_x, const Float *_y, const Float *_z, UInt32 _stride) :
+        x(_x), y(_y), z(_z), stride(_stride) {}
+
+    ConstBatchVectors(const BatchVectors &v) :
+        x(v.x), y(v.y), z(v.z), stride(v.stride) {}
+
+    //! Interleaved vectors, 3 consecutive floats every stride floats.
+    static ConstBatchVectors aos(const Float *data, UInt32 stride = 3)
+    {
+        return ConstBatchVectors(data, data + 1, data + 2, stride);
+    }
+
+    //! Contiguous arrays of components.
+    static ConstBatchVectors soa(const Float *x, const Float *y, const Float *z)
+    {
+        return ConstBatchVectors(x, y, z, 1);
+    }
+};
+
+/**
+ * @brief Operations on arrays of vectors, processing 4, 8 or 16 vectors at once with
+ * SSE2, AVX2 or AVX-512 when available, selected at runtime through CpuDispatch.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The packed AoS (stride of 3) and SoA (stride of 1) layouts are loaded directly,
+ * any other stride is gathered. The destination can be the source, but must not
+ * partially overlap it. The results are the same as Matrix4::operator*(Vector3) and
+ * Matrix4::rotate() up to the rounding of the fused multiply-add.
+ */
+class O3D_API BatchMath
+{
+public:
+
+    //! Transform points, dst[i] = m * src[i], with w = 1 and without projection.
+    static void transformPoints(
+            const Matrix4 &m,
+            const ConstBatchVectors &src,
+            const BatchVectors &dst,
+            UInt32 n);
+
+    //! Transform directions by the 3x3 part of the matrix, dst[i] = m.rotate(src[i]).
+    static void transformNormals(
+            const Matrix4 &m,
+            const ConstBatchVectors &src,
+            const BatchVectors &dst,
+            UInt32 n);
+
+    //! Normalize vectors like Vector3::normalize(), a null vector becomes (1,0,0).
+    static void normalize(
+            const ConstBatchVectors &src,
+            const BatchVectors &dst,
+            UInt32 n);
+
+    //! Compute the minimal and maximal components, and optionally the sum of the
+    //! vectors. Nothing is written for an empty array.
+    static void bounds(
+            const ConstBatchVectors &src,
+            UInt32 n,
+            Vector3 &min,
+            Vector3 &max,
+            Vector3 *sum = nullptr);
+};
+
+} // namespace o3d
+
+#endif // _O3D_BATCHMATH_H
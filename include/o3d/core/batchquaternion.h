@@ -0,0 +1,75 @@
+/**
+ * @file batchquaternion.h
+ * @brief Interpolation and conversion of arrays of quaternions and dual quaternions.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_BATCHQUATERNION_H
+#define _O3D_BATCHQUATERNION_H
+
+#include "base.h"
+
+namespace o3d {
+
+/**
+ * @brief Operations on arrays of quaternions and dual quaternions, processing 4, 8 or
+ * 16 of them at once with SSE2, AVX2 or AVX-512 when available, selected at runtime
+ * through CpuDispatch.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The quaternions are packed (x,y,z,w) by 4 floats like QuaternionArray::getData(), the
+ * dual quaternions (x,y,z,w) followed by the dual part (ex,ey,ez,ew) by 8 floats like
+ * DualQuaternionArray::getData(), and the matrices are column major arrays of 16 floats
+ * like Matrix4Array::getData(). The destination can be one of the sources.
+ * Unlike Quaternion::lerp() and slerp(), the interpolations take the shortest path, the
+ * 'to' quaternion being negated when the dot product with 'from' is negative.
+ */
+class O3D_API BatchQuaternion
+{
+public:
+
+    //! Interpolation of the quaternions.
+    enum Interpolation
+    {
+        NLERP = 0,          //!< Normalized linear interpolation, the angular speed is not constant.
+        NLERP_CORRECTED,    //!< Normalized linear interpolation with an adjusted t, close to SLERP.
+        SLERP               //!< Spherical linear interpolation, exact but not vectorized.
+    };
+
+    //! Interpolate and normalize each pair, dst[i] = from[i] to to[i] at t[i].
+    static void interpolate(
+            const Float *from,
+            const Float *to,
+            const Float *t,
+            Float *dst,
+            UInt32 n,
+            Interpolation mode = NLERP_CORRECTED);
+
+    //! Normalize quaternions like Quaternion::normalize(), a null one becomes the identity.
+    static void normalize(const Float *src, Float *dst, UInt32 n);
+
+    //! Convert unit quaternions to rotation matrices like Quaternion::toMatrix4().
+    static void toMatrix4(const Float *src, Float *matrices, UInt32 n);
+
+    //! Linearly blend each pair of dual quaternions at t[i] and normalize the result.
+    static void interpolateDual(
+            const Float *from,
+            const Float *to,
+            const Float *t,
+            Float *dst,
+            UInt32 n);
+
+    //! Normalize dual quaternions, giving a unit real part and a dual part orthogonal
+    //! to it. A null real part becomes the identity.
+    static void normalizeDual(const Float *src, Float *dst, UInt32 n);
+
+    //! Convert unit dual quaternions to rotation and translation matrices.
+    static void dualToMatrix4(const Float *src, Float *matrices, UInt32 n);
+};
+
+} // namespace o3d
+
+#endif // _O3D_BATCHQUATERNION_H
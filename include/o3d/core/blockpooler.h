@@ -12,6 +12,8 @@
 
 #include "objective3dconfig.h"
 
+#include <atomic>
+
 #define O3D_B_MALLOC(_S)     ::malloc((_S))
 #define O3D_B_FREE(_P)       ::free((_P))
 
@@ -250,6 +252,309 @@ private:
 	Chunk *m_stacks;     //!< begin of a doubly linked list of chunks
 };
 
+/**
+ * @brief Slot of the calling thread for the per thread data of the concurrent poolers.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * A slot is acquired at the first call from a thread, and released when the thread
+ * exits, so a later thread can reuse it.
+ */
+class O3D_API BlockPoolerThreadSlot
+{
+public:
+
+    //! Maximal number of threads having a slot at the same time.
+    static const UInt32 MAX_SLOTS = 64;
+
+    //! Returned when no slot is available, or when the thread is exiting.
+    static const UInt32 NO_SLOT = 0xffffffff;
+
+    //! Get the slot of the calling thread or NO_SLOT.
+    static UInt32 get();
+};
+
+/**
+ * @brief A thread-safe allocator for fixed size block allocation.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Blocks can be allocated and freed from any thread, including freeing a block on
+ * another thread than the one that allocated it.
+ *
+ * Each thread owns a magazine (a small stack of free blocks) that serves most of the
+ * allocations and frees without any synchronization. Empty magazines are refilled
+ * from, and full magazines are half flushed to, a global lock-free free list. The
+ * head of this list is tagged with a version counter to avoid the ABA problem.
+ *
+ * Blocks are carved into slabs aligned to their size, so a block address gives its
+ * slab without a search. Slabs are only released at the destruction of the pooler.
+ * Threads without a slot (more than BlockPoolerThreadSlot::MAX_SLOTS) directly use
+ * the global list.
+ */
+template <size_t EltSize, size_t Align>
+class O3D_API_TEMPLATE ConcurrentBlockPooler : NonCopyable<>
+{
+public:
+
+    static_assert((Align & (Align - 1)) == 0, "Alignment must be a power of two");
+
+    //! Size of a block, at least the size of a free list link, multiple of Align.
+    static const size_t BLOCK_SIZE = ((EltSize < sizeof(UInt32) ? sizeof(UInt32) : EltSize) + Align - 1) & ~(Align - 1);
+
+    //! Number of blocks of a thread magazine.
+    static const UInt32 MAGAZINE_SIZE = 32;
+
+    //! Maximal number of slabs.
+    static const UInt32 MAX_SLABS = 4096;
+
+    //! Default constructor
+    //! @param numBlock Minimal number of blocks of a slab.
+    ConcurrentBlockPooler(UInt32 numBlock = 1024) :
+        m_slabSize(4096),
+        m_blocksPerSlab(0),
+        m_numSlabs(0),
+        m_head(NIL),
+        m_magazines(nullptr)
+    {
+        // a slab contains a header block plus the others, and it is a power of two
+        while (m_slabSize < (numBlock + 1) * BLOCK_SIZE) {
+            m_slabSize <<= 1;
+        }
+
+        m_blocksPerSlab = (UInt32)(m_slabSize / BLOCK_SIZE) - 1;
+
+        m_slabs = (UInt8**)O3D_B_MALLOC(MAX_SLABS * sizeof(UInt8*));
+
+        m_magazines = (Magazine*)O3D_B_ALIGNED_MALLOC(BlockPoolerThreadSlot::MAX_SLOTS * sizeof(Magazine), 64);
+        for (UInt32 i = 0; i < BlockPoolerThreadSlot::MAX_SLOTS; ++i) {
+            m_magazines[i].count = 0;
+        }
+    }
+
+    //! Destructor. All the blocks are released, even if they are not freed.
+    ~ConcurrentBlockPooler()
+    {
+        const UInt32 numSlabs = m_numSlabs.load();
+        for (UInt32 i = 0; i < numSlabs; ++i) {
+            O3D_B_ALIGNED_FREE(m_slabs[i]);
+        }
+
+        O3D_B_FREE(m_slabs);
+        O3D_B_ALIGNED_FREE(m_magazines);
+    }
+
+    //! Allocate a block.
+    //! @return The block or null if the maximal number of slabs is reached.
+    inline void* allocate()
+    {
+        const UInt32 slot = BlockPoolerThreadSlot::get();
+
+        if (slot == BlockPoolerThreadSlot::NO_SLOT) {
+            UInt32 index = pop();
+            while (index == NIL) {
+                if (!grow()) {
+                    return nullptr;
+                }
+                index = pop();
+            }
+
+            return block(index);
+        }
+
+        Magazine &magazine = m_magazines[slot];
+
+        if (magazine.count == 0) {
+            refill(magazine);
+
+            if (magazine.count == 0) {
+                return nullptr;
+            }
+        }
+
+        return magazine.blocks[--magazine.count];
+    }
+
+    //! Free a block previously allocated by this pooler, from any thread.
+    inline void free(void *ptr)
+    {
+        if (!ptr) {
+            return;
+        }
+
+        const UInt32 slot = BlockPoolerThreadSlot::get();
+
+        if (slot == BlockPoolerThreadSlot::NO_SLOT) {
+            const UInt32 idx = index(ptr);
+            pushChain(idx, idx);
+            return;
+        }
+
+        Magazine &magazine = m_magazines[slot];
+
+        if (magazine.count == MAGAZINE_SIZE) {
+            flush(magazine, MAGAZINE_SIZE / 2);
+        }
+
+        magazine.blocks[magazine.count++] = ptr;
+    }
+
+    //! Get the number of allocated slabs.
+    inline UInt32 getNumSlabs() const { return m_numSlabs.load(); }
+
+    //! Get the total number of blocks of the allocated slabs.
+    inline UInt32 getCapacity() const { return m_numSlabs.load() * m_blocksPerSlab; }
+
+    //! Get the size in bytes of a slab.
+    inline size_t getSlabSize() const { return m_slabSize; }
+
+private:
+
+    static const UInt32 NIL = 0xffffffff;
+
+    //! Per thread stack of free blocks, only accessed by the thread of its slot.
+    struct alignas(64) Magazine
+    {
+        UInt32 count;
+        void *blocks[MAGAZINE_SIZE];
+    };
+
+    size_t m_slabSize;           //!< Size and alignment of a slab.
+    UInt32 m_blocksPerSlab;      //!< Number of blocks of a slab, minus the header.
+
+    UInt8 **m_slabs;             //!< Slabs by index, published before their blocks.
+    std::atomic<UInt32> m_numSlabs;
+    std::atomic_flag m_growing = ATOMIC_FLAG_INIT;
+
+    std::atomic<UInt64> m_head;  //!< Version counter (high) and first free block index (low).
+
+    Magazine *m_magazines;       //!< One magazine per thread slot.
+
+    //! Block address from its global index.
+    inline void* block(UInt32 idx) const
+    {
+        return m_slabs[idx / m_blocksPerSlab] + (idx % m_blocksPerSlab + 1) * BLOCK_SIZE;
+    }
+
+    //! Global index of a block, the slab index is stored into its header.
+    inline UInt32 index(void *ptr) const
+    {
+        UInt8 *slab = (UInt8*)((size_t)ptr & ~(m_slabSize - 1));
+        return *(UInt32*)slab * m_blocksPerSlab + (UInt32)(((UInt8*)ptr - slab) / BLOCK_SIZE) - 1;
+    }
+
+    //! Link to the next free block, stored into the free block itself.
+    inline std::atomic<UInt32>& link(UInt32 idx) const
+    {
+        return *reinterpret_cast<std::atomic<UInt32>*>(block(idx));
+    }
+
+    //! Push a chain of linked blocks in front of the global free list.
+    inline void pushChain(UInt32 first, UInt32 last)
+    {
+        UInt64 head = m_head.load(std::memory_order_relaxed);
+        UInt64 newHead;
+
+        do {
+            link(last).store((UInt32)head, std::memory_order_relaxed);
+            newHead = (((head >> 32) + 1) << 32) | first;
+        } while (!m_head.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed));
+    }
+
+    //! Pop the first block of the global free list, or NIL if empty.
+    inline UInt32 pop()
+    {
+        UInt64 head = m_head.load(std::memory_order_acquire);
+        UInt64 newHead;
+
+        do {
+            const UInt32 idx = (UInt32)head;
+            if (idx == NIL) {
+                return NIL;
+            }
+
+            // the block can be concurrently popped and reused, then the version differs
+            const UInt32 next = link(idx).load(std::memory_order_relaxed);
+            newHead = (((head >> 32) + 1) << 32) | next;
+        } while (!m_head.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire));
+
+        return (UInt32)head;
+    }
+
+    //! Refill an empty magazine with up to half of its capacity.
+    void refill(Magazine &magazine)
+    {
+        while (magazine.count < MAGAZINE_SIZE / 2) {
+            const UInt32 idx = pop();
+
+            if (idx == NIL) {
+                if (magazine.count > 0 || !grow()) {
+                    return;
+                }
+            } else {
+                magazine.blocks[magazine.count++] = block(idx);
+            }
+        }
+    }
+
+    //! Flush the n last blocks of a magazine to the global free list, in a single push.
+    void flush(Magazine &magazine, UInt32 n)
+    {
+        const UInt32 first = index(magazine.blocks[magazine.count - 1]);
+        UInt32 last = first;
+
+        for (UInt32 i = 1; i < n; ++i) {
+            const UInt32 idx = index(magazine.blocks[magazine.count - 1 - i]);
+            link(last).store(idx, std::memory_order_relaxed);
+            last = idx;
+        }
+
+        magazine.count -= n;
+        pushChain(first, last);
+    }
+
+    //! Allocate a new slab and push all its blocks to the global free list.
+    //! @return False if the maximal number of slabs is reached.
+    Bool grow()
+    {
+        // another thread is growing, retry the free list
+        if (m_growing.test_and_set(std::memory_order_acquire)) {
+            while (m_growing.test_and_set(std::memory_order_acquire)) {
+                // rare and short, spin
+            }
+
+            m_growing.clear(std::memory_order_release);
+            return True;
+        }
+
+        const UInt32 slabIndex = m_numSlabs.load(std::memory_order_relaxed);
+        if (slabIndex >= MAX_SLABS) {
+            m_growing.clear(std::memory_order_release);
+            return False;
+        }
+
+        UInt8 *slab = (UInt8*)O3D_B_ALIGNED_MALLOC(m_slabSize, m_slabSize);
+        if (!slab) {
+            m_growing.clear(std::memory_order_release);
+            return False;
+        }
+
+        *(UInt32*)slab = slabIndex;
+        m_slabs[slabIndex] = slab;
+        m_numSlabs.store(slabIndex + 1, std::memory_order_release);
+
+        const UInt32 first = slabIndex * m_blocksPerSlab;
+        const UInt32 last = first + m_blocksPerSlab - 1;
+
+        for (UInt32 idx = first; idx < last; ++idx) {
+            link(idx).store(idx + 1, std::memory_order_relaxed);
+        }
+
+        pushChain(first, last);
+
+        m_growing.clear(std::memory_order_release);
+        return True;
+    }
+};
+
 } // namespace o3d
 
 #endif // _O3D_BLOCKPOOLER_H
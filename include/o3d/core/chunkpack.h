@@ -0,0 +1,313 @@
+/**
+ * @file chunkpack.h
+ * @brief Indexed pack of files compressed by independent chunks.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_CHUNKPACK_H
+#define _O3D_CHUNKPACK_H
+
+#include "memorydbg.h"
+
+#include "string.h"
+#include "hashmap.h"
+#include "asset.h"
+#include "instream.h"
+#include "archivesource.h"
+#include "smartpointer.h"
+
+#include <vector>
+
+namespace o3d {
+
+class OutStream;
+
+/**
+ * @brief Pack of files, each file being split into fixed size chunks compressed
+ * independently, mounted with the pack:// protocol.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Seeking into a file of the pack only decompresses the chunks that are read.
+ * Layout (little endian):
+ * - header : magic, version, chunk size.
+ * - the chunks data, each one compressed with zlib, or stored when it does not shrink.
+ * - index : the entries (name, type, size, first chunk, number of chunks) followed by
+ *   the chunks (offset, compressed size).
+ * - trailer : index offset, magic.
+ * Use ChunkPackWriter or the o3dpack tool to create it.
+ */
+class O3D_API ChunkPack : public Asset
+{
+public:
+
+    //! Pack signature "O3PK".
+    static const UInt32 MAGIC = 0x4b50334f;
+
+    //! Format version.
+    static const UInt32 VERSION = 1;
+
+    //! Default uncompressed size of a chunk.
+    static const UInt32 DEFAULT_CHUNK_SIZE = 65536;
+
+    //! A compressed chunk of a file.
+    struct Chunk
+    {
+        UInt64 offset;          //!< Position into the pack.
+        UInt32 compressedSize;  //!< Size into the pack, equal to the chunk size if stored.
+    };
+
+    /**
+     * @brief Read the index of a pack.
+     * @param is An opened input stream on the pack, owned by the pack once constructed.
+     * @param packName Pack filename.
+     * @param packPath Pack path.
+     * @throw E_InvalidFormat if it is not a valid pack.
+     */
+    ChunkPack(InStream &is, const String &packName, const String &packPath);
+
+    virtual ~ChunkPack();
+
+    virtual void destroy() override;
+
+    virtual Int32 findFile(const String& fileName) override;
+
+    virtual Bool isPath(const String& path) const override;
+
+    virtual InStream* openInStream(const String& filename) override;
+    virtual InStream* openInStream(Int32 index) override;
+
+    virtual String location() const override;
+
+    virtual String name() const override;
+
+    virtual String fullPathName() const override;
+
+    virtual Int32 getNumFiles() const override;
+
+    //! Returns the protocol (pack://)
+    virtual String protocol() const override;
+
+    virtual String getFileName(Int32 index) const override;
+
+    virtual FileTypes getFileType(Int32 index) const override;
+
+    virtual UInt64 getFileSize(Int32 index) const override;
+
+    virtual void searchFirstFile(const String &path) override;
+
+    //! Get the uncompressed size of the chunks.
+    inline UInt32 getChunkSize() const { return m_chunkSize; }
+
+protected:
+
+    struct Entry
+    {
+        String name;            //!< Relative to the pack.
+        FileTypes type;
+        UInt64 size;
+        UInt32 firstChunk;
+        UInt32 numChunks;
+    };
+
+    SmartPtr<ArchiveSource> m_source;
+
+    String m_packPathName;       //!< absolute path of the pack file
+    String m_packFileName;       //!< pack file name
+
+    UInt32 m_chunkSize;
+
+    std::vector<Entry> m_entries;
+    std::vector<Chunk> m_chunks;
+
+    typedef stdext::hash_map<String, Int32, std::hash<String> > T_FileMap;
+    typedef T_FileMap::iterator IT_FileMap;
+    typedef T_FileMap::const_iterator CIT_FileMap;
+
+    T_FileMap m_fileMap;         //!< File map (absolute path, index)
+
+    void readIndex(InStream &is);
+};
+
+/**
+ * @brief Input stream on a file of a ChunkPack.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Only the chunk of the read position is decompressed, into a buffer of the size of
+ * a chunk, and the reads covering a whole chunk are decompressed directly into the
+ * destination. Seeking only moves the position. Distinct streams of the same pack can
+ * be used by distinct threads.
+ */
+class O3D_API ChunkPackInStream : public InStream
+{
+public:
+
+    /**
+     * @brief Open a file.
+     * @param source Source of the pack.
+     * @param chunkSize Uncompressed size of the chunks.
+     * @param size Size of the file.
+     * @param chunks Chunks of the file, copied.
+     * @param numChunks Number of chunks of the file.
+     */
+    ChunkPackInStream(
+            ArchiveSource *source,
+            UInt32 chunkSize,
+            UInt64 size,
+            const ChunkPack::Chunk *chunks,
+            UInt32 numChunks);
+
+    virtual ~ChunkPackInStream();
+
+    //! False
+    virtual Bool isMemory() const override;
+
+    virtual UInt32 reader(void *buf, UInt32 size, UInt32 count) override;
+
+    virtual void close() override;
+
+    virtual void reset(UInt64 n = 0) override;
+
+    virtual void seek(Int64 n) override;
+
+    virtual void end(Int64 n = 0) override;
+
+    virtual Int32 getAvailable() const override;
+
+    virtual Int32 getPosition() const override;
+
+    virtual Bool isEnd() const override;
+
+    virtual UInt8 peek() override;
+
+    virtual void ignore(Int32 limit, UInt8 delim) override;
+
+    virtual Int32 readLine(
+            String &str,
+            CharacterEncoding encoding = ENCODING_UTF8) override;
+
+    virtual Int32 readLine(
+            String &str,
+            Int32 limit,
+            UInt8 delim,
+            CharacterEncoding encoding = ENCODING_UTF8) override;
+
+    virtual Int32 readWord(
+            String &str,
+            CharacterEncoding encoding = ENCODING_UTF8) override;
+
+    //! Get the number of chunks decompressed since the opening.
+    inline UInt32 getNumDecompressedChunks() const { return m_numDecompressed; }
+
+private:
+
+    SmartPtr<ArchiveSource> m_source;
+
+    UInt32 m_chunkSize;
+    UInt64 m_size;
+    std::vector<ChunkPack::Chunk> m_chunks;
+
+    UInt8 *m_buffer;           //!< Decompressed chunk.
+    UInt8 *m_compressed;       //!< Compressed chunk, when the pack is not memory mapped.
+    Int64 m_current;           //!< Index of the chunk into the buffer, or -1.
+
+    UInt64 m_pos;
+    UInt32 m_numDecompressed;
+
+    //! Uncompressed size of a chunk.
+    inline UInt32 chunkLength(UInt32 index) const
+    {
+        return (UInt32)o3d::min<UInt64>(m_chunkSize, m_size - UInt64(index) * m_chunkSize);
+    }
+
+    //! Decompress a chunk to a destination of its uncompressed size.
+    void decompress(UInt32 index, UInt8 *dest);
+
+    //! Make the chunk of the current position the current one.
+    //! @return False at the end of the file.
+    Bool loadCurrent();
+
+    //! Next byte, or EOF.
+    Int32 nextByte();
+};
+
+/**
+ * @brief Write a ChunkPack.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The parents directories of the files are added automatically. The pack is valid once
+ * finish() is called.
+ */
+class O3D_API ChunkPackWriter
+{
+public:
+
+    /**
+     * @brief Start a pack.
+     * @param os Output stream, owned by the writer.
+     * @param chunkSize Uncompressed size of the chunks.
+     * @param level zlib compression level, from 0 (stored) to 9.
+     */
+    ChunkPackWriter(
+            OutStream *os,
+            UInt32 chunkSize = ChunkPack::DEFAULT_CHUNK_SIZE,
+            Int32 level = 6);
+
+    ~ChunkPackWriter();
+
+    //! Add a directory. The name is relative to the pack, with '/' separators.
+    void addDirectory(const String &name);
+
+    //! Add a file with the content of a stream.
+    //! The name is relative to the pack, with '/' separators.
+    void addFile(const String &name, InStream &is);
+
+    //! Write the index and close the stream.
+    void finish();
+
+    //! Get the total size of the added files.
+    inline UInt64 getUncompressedSize() const { return m_uncompressedSize; }
+
+    //! Get the size of the written data.
+    inline UInt64 getCompressedSize() const { return m_offset; }
+
+private:
+
+    struct Entry
+    {
+        String name;
+        FileTypes type;
+        UInt64 size;
+        UInt32 firstChunk;
+        UInt32 numChunks;
+    };
+
+    OutStream *m_os;
+
+    UInt32 m_chunkSize;
+    Int32 m_level;
+
+    std::vector<Entry> m_entries;
+    std::vector<ChunkPack::Chunk> m_chunks;
+
+    typedef stdext::hash_map<String, Int32, std::hash<String> > T_NameMap;
+    T_NameMap m_names;           //!< Entries names (name, index)
+
+    UInt64 m_offset;
+    UInt64 m_uncompressedSize;
+
+    UInt8 *m_buffer;
+    UInt8 *m_compressed;
+    UInt32 m_compressedMax;
+
+    void addParents(const String &name);
+
+    ChunkPackWriter(const ChunkPackWriter &);
+    ChunkPackWriter& operator= (const ChunkPackWriter &);
+};
+
+} // namespace o3d
+
+#endif // _O3D_CHUNKPACK_H
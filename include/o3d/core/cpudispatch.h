@@ -0,0 +1,140 @@
+/**
+ * @file cpudispatch.h
+ * @brief Runtime selection of the SIMD implementations of the kernels.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_CPUDISPATCH_H
+#define _O3D_CPUDISPATCH_H
+
+#include "processor.h"
+
+// x86 SIMD intrinsics, available whatever the compilation flags
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+    #define O3D_SIMD_X86
+#endif
+
+// Compile a function for an instruction set not enabled by the compilation flags.
+// It must be called only when CpuDispatch reports its support.
+#if defined(O3D_SIMD_X86) && (defined(__GNUC__) || defined(__clang__))
+    #define O3D_SIMD_TARGET(T) __attribute__((target(T)))
+#else
+    #define O3D_SIMD_TARGET(T)
+#endif
+
+#define O3D_SIMD_TARGET_SSE2 O3D_SIMD_TARGET("sse2")
+#define O3D_SIMD_TARGET_SSSE3 O3D_SIMD_TARGET("ssse3")
+#define O3D_SIMD_TARGET_SSE4_1 O3D_SIMD_TARGET("sse4.1")
+#define O3D_SIMD_TARGET_AVX O3D_SIMD_TARGET("avx")
+#define O3D_SIMD_TARGET_AVX2 O3D_SIMD_TARGET("avx2,fma")
+#define O3D_SIMD_TARGET_AVX512 O3D_SIMD_TARGET("avx512f,avx512bw,avx512vl,avx2,fma")
+
+namespace o3d {
+
+/**
+ * @brief Ordered SIMD levels, each one including the previous ones.
+ */
+enum SimdLevel
+{
+    SIMD_NONE = 0,    //!< Scalar code only.
+    SIMD_SSE2,        //!< SSE and SSE2.
+    SIMD_SSSE3,       //!< SSE3 and SSSE3.
+    SIMD_SSE4_1,      //!< SSE4.1.
+    SIMD_AVX,         //!< AVX, 256 bits float.
+    SIMD_AVX2,        //!< AVX2 and FMA3.
+    SIMD_AVX512       //!< AVX-512 F, BW and VL.
+};
+
+/**
+ * @brief Processor features detected once for the whole process, and SIMD level used
+ * to select the implementations of the kernels.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The detection is done at the first call, thread safe. The level can be limited,
+ * to compare the implementations or to work around a faulty one, before the first
+ * use of the kernels, because they keep their selection.
+ */
+class O3D_API CpuDispatch
+{
+public:
+
+    //! Processor detected at the first call.
+    static const Processor& getProcessor();
+
+    //! Highest level supported by the processor and the OS.
+    static SimdLevel getDetectedLevel();
+
+    //! Level used by the kernels, the detected one limited by the maximal one.
+    static SimdLevel getLevel();
+
+    //! Limit the level used by the kernels selected after this call.
+    static void setMaxLevel(SimdLevel level);
+
+    //! Get the maximal level (default SIMD_AVX512).
+    static SimdLevel getMaxLevel();
+
+    //! Name of a level, like "AVX2".
+    static const Char* getLevelName(SimdLevel level);
+
+    //! Report the detected and used levels into the log.
+    static void reportLog();
+};
+
+/**
+ * @brief Table of the implementations of a kernel, selecting the one of the highest
+ * level supported by CpuDispatch.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Usage is to keep the selected function pointer into a function local static or a
+ * class static set at initialization:
+ * @code
+ * static const BlendFunc blend = SimdKernel<BlendFunc>(blendScalar)
+ *         .add(SIMD_SSE2, blendSSE2)
+ *         .add(SIMD_AVX2, blendAVX2)
+ *         .get();
+ * @endcode
+ */
+template <class F>
+class SimdKernel
+{
+public:
+
+    //! Construct with the scalar implementation, always available.
+    SimdKernel(F scalar) :
+        m_func(scalar),
+        m_level(SIMD_NONE),
+        m_maxLevel(CpuDispatch::getLevel())
+    {
+    }
+
+    //! Add an implementation, selected if its level is supported and higher than the
+    //! one of the current selection.
+    SimdKernel& add(SimdLevel level, F func)
+    {
+        if (func && (level <= m_maxLevel) && (level >= m_level)) {
+            m_func = func;
+            m_level = level;
+        }
+
+        return *this;
+    }
+
+    //! Selected implementation.
+    inline F get() const { return m_func; }
+
+    //! Level of the selected implementation.
+    inline SimdLevel getLevel() const { return m_level; }
+
+private:
+
+    F m_func;
+    SimdLevel m_level;
+    SimdLevel m_maxLevel;
+};
+
+} // namespace o3d
+
+#endif // _O3D_CPUDISPATCH_H
@@ -0,0 +1,67 @@
+/**
+ * @file crc32c.h
+ * @brief CRC32C (Castagnoli) checksum calculation.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_CRC32C_H
+#define _O3D_CRC32C_H
+
+#include "memorydbg.h"
+#include "file.h"
+#include "smartarray.h"
+
+namespace o3d {
+
+/**
+ * @brief CRC32C computation, using the SSE4.2 crc32 instruction when available,
+ * selected at runtime, or a slicing by 8 tables implementation.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * For the integrity checks of the stored data, the result is the same as the iSCSI,
+ * ext4 or SSE4.2 CRC32C.
+ */
+class O3D_API CRC32CHash
+{
+public:
+
+    //! Default constructor, init a CRC32C for streaming using update.
+    CRC32CHash();
+    //! constructor, use an array and compute.
+    CRC32CHash(const UInt8 *data, UInt32 len);
+    //! constructor, use an uint8 smart array and compute.
+    CRC32CHash(const SmartArrayUInt8 &array);
+    //! constructor, use an open stream and compute.
+    CRC32CHash(InStream &is);
+
+    //! update the CRC32C checksum
+    void update(const UInt8 *data, UInt32 len);
+    //! update the CRC32C checksum
+    void update(const SmartArrayUInt8 &array);
+    //! update the CRC32C checksum, until the end of the stream
+    void update(InStream &is);
+
+    //! get the CRC32C of the data given until now
+    inline UInt32 get() const { return m_crc; }
+
+    //! get the CRC32C in 8+1 bytes hex
+    String getHex() const;
+
+    //! Compute or continue the CRC32C of a memory block.
+    //! @param crc Result of the previous block, 0 for the first.
+    static UInt32 compute(const void *data, size_t len, UInt32 crc = 0);
+
+    //! True if the crc32 instruction is used.
+    static Bool isHardware();
+
+protected:
+
+    UInt32 m_crc;
+};
+
+} // namespace o3d
+
+#endif // _O3D_CRC32C_H
@@ -52,6 +52,8 @@ public:
 
     virtual Bool isEnd() const;
 
+    virtual const UInt8* getDirectPointer(UInt32 size);
+
     virtual UInt8 peek();
 
     virtual void ignore(Int32 limit, UInt8 delim);
@@ -114,6 +116,8 @@ public:
 
     virtual Bool isEnd() const override;
 
+    virtual const UInt8* getDirectPointer(UInt32 size) override;
+
     virtual UInt8 peek() override;
 
     virtual void ignore(Int32 limit, UInt8 delim) override;
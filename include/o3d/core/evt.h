@@ -400,12 +400,16 @@ struct Signal
 
     mutable EvtContainer<ParamType> mContainer;
 
+    //! Emit the signal. The callbacks are iterated without copy nor allocation.
     void operator ()(Params... values) const
     {
-        T_FunctionArray lCallBacks;
-        mContainer.getCallBacks(lCallBacks);
+        if (mContainer.isEmpty()) {
+            return;
+        }
+
+        typename EvtContainer<ParamType>::Snapshot lCallBacks(mContainer);
 
-        for (IT_FunctionArray it = lCallBacks.begin() ; it != lCallBacks.end() ; it++)
+        for (typename EvtContainer<ParamType>::CIT_FunctionArray it = lCallBacks.begin() ; it != lCallBacks.end() ; it++)
         {
             (*it)->call(values...);
         }
@@ -441,17 +445,14 @@ struct Signal
             void (C::*funcPtr)(Params...),
             EvtHandler::ConnectionType _type=EvtHandler::CONNECTION_AUTO)
     {
-        //T_StdFunction func = std::bind((T_FunctionParamPtr)slot, std::ref(receiver), std::placeholders::_1);
-        auto func = binder((T_FunctionParamPtr)funcPtr, receiver, std::make_index_sequence<value>{});
-
+        // the method is stored inline and called on the receiver
         EvtLinkBase *link = new EvtLink<ParamType>(
                                 m_owner,
                                 receiver,
                                 //reinterpret_cast<void*>(receiver),
                                 &this->mContainer,
                                 String(""),
-                                new ParamType(func));
-                                //new ParamType((T_FunctionParamPtr)slot));
+                                new ParamType((T_FunctionParamPtr)funcPtr));
 
         receiver->connect(link, _type);
     }
@@ -463,15 +464,13 @@ struct Signal
             void (C::*funcPtr)(Params...),
             Thread *thread)
     {
-        auto func = binder((T_FunctionParamPtr)funcPtr, receiver, std::make_index_sequence<value>{});
-
         EvtLinkBase *link = new EvtLink<ParamType>(
                                 m_owner,
                                 receiver,
                                 //reinterpret_cast<void*>(receiver),
                                 &this->mContainer,
                                 String(""),
-                                new ParamType(func));
+                                new ParamType((T_FunctionParamPtr)funcPtr));
 
         receiver->connect(link, thread);
     }
@@ -579,12 +578,16 @@ struct Signal <>
 
     mutable EvtContainer<ParamType> mContainer;
 
+    //! Emit the signal. The callbacks are iterated without copy nor allocation.
     void operator ()() const
     {
-        T_FunctionArray lCallBacks;
-        mContainer.getCallBacks(lCallBacks);
+        if (mContainer.isEmpty()) {
+            return;
+        }
+
+        EvtContainer<ParamType>::Snapshot lCallBacks(mContainer);
 
-        for (IT_FunctionArray it = lCallBacks.begin() ; it != lCallBacks.end() ; it++)
+        for (EvtContainer<ParamType>::CIT_FunctionArray it = lCallBacks.begin() ; it != lCallBacks.end() ; it++)
         {
             (*it)->call();
         }
@@ -600,16 +603,13 @@ struct Signal <>
             void (C::*funcPtr)(),
             EvtHandler::ConnectionType _type=EvtHandler::CONNECTION_AUTO)
     {
-        T_StdFunction func = std::bind((T_FunctionParamPtr)funcPtr, receiver);
-
         EvtLinkBase *link = new EvtLink<ParamType>(
                                 m_owner,
                                 receiver,
                                 //reinterpret_cast<void*>(receiver),
                                 &this->mContainer,
                                 String(""),
-                                new ParamType(func));
-                                //new ParamType((T_FunctionParamPtr)slot));
+                                new ParamType((T_FunctionParamPtr)funcPtr));
 
         receiver->connect(link, _type);
     }
@@ -621,15 +621,13 @@ struct Signal <>
             void (C::*funcPtr)(),
             Thread *thread)
     {
-        T_StdFunction func = std::bind((T_FunctionParamPtr)funcPtr, receiver);
-
         EvtLinkBase *link = new EvtLink<ParamType>(
                                 m_owner,
                                 receiver,
                                 //reinterpret_cast<void*>(receiver),
                                 &this->mContainer,
                                 String(""),
-                                new ParamType(func));
+                                new ParamType((T_FunctionParamPtr)funcPtr));
 
         receiver->connect(link, thread);
     }
@@ -13,6 +13,7 @@
 #include "base.h"
 #include "mutex.h"
 
+#include <atomic>
 #include <vector>
 
 namespace o3d {
@@ -22,6 +23,10 @@ namespace o3d {
  * EventHandler object.
  * @author Emmanuel RUFFIO (emmanuel.ruffio@gmail.com)
  * @date 2007-11-13
+ * The callbacks are stored into an immutable and shared array, replaced at each
+ * add or remove (copy on write). An emitter holds a reference onto the current array
+ * during its iteration using a Snapshot, so it does not need any copy or allocation,
+ * and connections or disconnections during an emit does not invalidate it.
  */
 template <class T>
 class O3D_API_TEMPLATE EvtContainer
@@ -34,13 +39,57 @@ public:
 	typedef typename T_FunctionArray::iterator        IT_FunctionArray;
 	typedef typename T_FunctionArray::const_iterator CIT_FunctionArray;
 
+    //! Shared and immutable array of callbacks.
+    struct SlotArray
+    {
+        SlotArray(const T_FunctionArray &functions) :
+            refCount(1),
+            callBacks(functions)
+        {
+        }
+
+        std::atomic<Int32> refCount;
+        T_FunctionArray callBacks;
+    };
+
+    //! Reference onto the callbacks at a time, valid until its destruction.
+    class Snapshot
+    {
+    public:
+
+        Snapshot(const EvtContainer &container) :
+            m_slots(container.acquire())
+        {
+        }
+
+        ~Snapshot()
+        {
+            EvtContainer::release(m_slots);
+        }
+
+        inline Bool isEmpty() const { return m_slots == nullptr; }
+
+        inline CIT_FunctionArray begin() const { return m_slots ? m_slots->callBacks.begin() : CIT_FunctionArray(); }
+        inline CIT_FunctionArray end() const { return m_slots ? m_slots->callBacks.end() : CIT_FunctionArray(); }
+
+    private:
+
+        SlotArray *m_slots;
+
+        Snapshot(const Snapshot &);
+        Snapshot& operator= (const Snapshot &);
+    };
+
 private:
 
 	/* Members */
-	T_FunctionArray m_callBacks;
+    std::atomic<SlotArray*> m_slots;  //!< Current callbacks, null if empty.
 
 	mutable RecursiveMutex m_mutex;
 
+    //! Replace the current array (mutex must be locked).
+    void setCallBacks(const T_FunctionArray &functions);
+
 public:
 
 	/* Construtors */
@@ -52,12 +101,21 @@ public:
 
 	/* Accessors */
 	void getCallBacks(T_FunctionArray & _array) const;
+
+    //! Is there any connected callback.
+    inline Bool isEmpty() const { return m_slots.load(std::memory_order_relaxed) == nullptr; }
+
+    //! Get a reference onto the current callbacks, or null if none.
+    SlotArray* acquire() const;
+
+    //! Release a reference given by acquire.
+    static void release(SlotArray *slots);
 };
 
 
 template <class T>
 EvtContainer<T>::EvtContainer():
-	m_callBacks(),
+    m_slots(nullptr),
 	m_mutex()
 {
 }
@@ -67,10 +125,22 @@ EvtContainer<T>::~EvtContainer()
 {
 	RecurMutexLocker lLocker(m_mutex);
 
-	T_FunctionArray lCpy(m_callBacks);
+	T_FunctionArray lCpy;
+    getCallBacks(lCpy);
 
 	for (IT_FunctionArray it = lCpy.begin() ; it != lCpy.end() ; it++)
 		(*it)->getLink()->getReceiver()->disconnect((*it)->getLink());
+
+    release(m_slots.exchange(nullptr));
+}
+
+template <class T>
+void EvtContainer<T>::setCallBacks(const T_FunctionArray &functions)
+{
+    SlotArray *slots = functions.empty() ? nullptr : new SlotArray(functions);
+
+    // the previous one is deleted once the last emitter release it
+    release(m_slots.exchange(slots));
 }
 
 template <class T>
@@ -78,18 +148,23 @@ void EvtContainer<T>::addHandler(T_FunctionType _pFunc)
 {
 	RecurMutexLocker lLocker(m_mutex);
 
-	IT_FunctionArray it = m_callBacks.begin();
+    T_FunctionArray lCallBacks;
+    getCallBacks(lCallBacks);
+
+	IT_FunctionArray it = lCallBacks.begin();
 
-	while (it != m_callBacks.end())
+	while (it != lCallBacks.end())
 		if ((*it) == _pFunc)
 			break;
 		else
 			it++;
 
-	O3D_ASSERT(it == m_callBacks.end());
+	O3D_ASSERT(it == lCallBacks.end());
 
-	if (it == m_callBacks.end())
-		m_callBacks.push_back(_pFunc);
+    if (it == lCallBacks.end()) {
+		lCallBacks.push_back(_pFunc);
+        setCallBacks(lCallBacks);
+    }
 }
 
 template <class T>
@@ -97,10 +172,14 @@ void EvtContainer<T>::removeHandler(T_FunctionType _pFunc)
 {
 	RecurMutexLocker lLocker(m_mutex);
 
-	for (IT_FunctionArray it = m_callBacks.begin() ; it != m_callBacks.end() ; it++)
+    T_FunctionArray lCallBacks;
+    getCallBacks(lCallBacks);
+
+	for (IT_FunctionArray it = lCallBacks.begin() ; it != lCallBacks.end() ; it++)
 		if ((*it) == _pFunc)
 		{
-			m_callBacks.erase(it);
+			lCallBacks.erase(it);
+            setCallBacks(lCallBacks);
 			return;
 		}
 
@@ -111,7 +190,40 @@ template <class T>
 void EvtContainer<T>::getCallBacks(T_FunctionArray & _array) const
 {
 	RecurMutexLocker lLocker(m_mutex);
-	_array = m_callBacks;
+
+    SlotArray *slots = m_slots.load();
+    if (slots) {
+        _array = slots->callBacks;
+    } else {
+        _array.clear();
+    }
+}
+
+template <class T>
+typename EvtContainer<T>::SlotArray* EvtContainer<T>::acquire() const
+{
+    // fast path for a signal without connection
+    if (m_slots.load(std::memory_order_relaxed) == nullptr) {
+        return nullptr;
+    }
+
+    // the lock prevent the array to be released between the load and the reference
+	RecurMutexLocker lLocker(m_mutex);
+
+    SlotArray *slots = m_slots.load();
+    if (slots) {
+        ++slots->refCount;
+    }
+
+    return slots;
+}
+
+template <class T>
+void EvtContainer<T>::release(SlotArray *slots)
+{
+    if (slots && (--slots->refCount == 0)) {
+        delete slots;
+    }
 }
 
 } // namespace o3d
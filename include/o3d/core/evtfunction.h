@@ -81,6 +81,8 @@ protected:
  */
 class O3D_API EvtFunctionAsyncBase
 {
+    friend class EvtManager;
+
 protected:
 
     EvtHandler *m_sender;
@@ -90,6 +92,8 @@ protected:
 
     Thread *m_thread;
 
+    EvtFunctionAsyncBase *m_next;  //!< Intrusive link used by the EvtManager queues.
+
     /* Restricted */
     EvtFunctionAsyncBase(const EvtFunctionAsyncBase &);
 
@@ -100,7 +104,8 @@ public:
         m_sender(dup.getSender()),
         m_receiver(dup.getReceiver()),
         //m_baseThis(dup.getBaseThis()),
-        m_thread(dup.getThread())
+        m_thread(dup.getThread()),
+        m_next(nullptr)
     {
     }
 
@@ -120,6 +125,13 @@ public:
 
     virtual void process() = 0;
 
+#ifndef O3D_RAM_MEMORY_MANAGER
+    //! Posted events are allocated by the posting thread and deleted by the receiving
+    //! one, using the thread cached allocator (see MemoryManager::threadAlloc).
+    static void* operator new(std::size_t size);
+    static void operator delete(void *ptr, std::size_t size);
+#endif
+
 protected:
 
     inline void setReceiverSender(EvtHandler * /*_pHandler*/) { m_receiver->setSender(m_sender); }
@@ -260,6 +272,8 @@ public:
  * @brief Event function without parameters.
  * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
  * @date 2016-01-03
+ * A slot given as a class::method pointer is stored inline and called directly on
+ * the receiver, without the allocation and the indirection of a bound std::function.
  */
 template <typename... Args>
 class O3D_API_TEMPLATE EvtStdFunction: public EvtFunctionBase
@@ -267,10 +281,12 @@ class O3D_API_TEMPLATE EvtStdFunction: public EvtFunctionBase
 public:
 
     typedef std::function<void(Args...)> T_StdFunction;
+    typedef void (EvtHandler::*T_FunctionParamPtr)(Args...);
 
 private:
 
     T_StdFunction m_func;
+    T_FunctionParamPtr m_funcPtr;  //!< Method of the receiver, or null if m_func is used.
 
     /* Restricted */
     EvtStdFunction(const EvtStdFunction & _which);
@@ -279,7 +295,15 @@ public:
 
     EvtStdFunction(T_StdFunction _func):
         EvtFunctionBase(),
-        m_func(_func)
+        m_func(_func),
+        m_funcPtr(nullptr)
+    {
+    }
+
+    EvtStdFunction(T_FunctionParamPtr _funcPtr):
+        EvtFunctionBase(),
+        m_func(),
+        m_funcPtr(_funcPtr)
     {
     }
 
@@ -290,18 +314,39 @@ public:
         if (isSync())
         {
             setReceiverSender(m_sender);
-            m_func(values...);
+
+            if (m_funcPtr) {
+                (m_receiver->*m_funcPtr)(values...);
+            } else {
+                m_func(values...);
+            }
+
             resetReceiverSender();
         }
         else
         {
             // keep a standalone copy of the event functor with copy of each parameters
             EvtStdFunctionAsyncParam<Args...> *event =
-                    new EvtStdFunctionAsyncParam<Args...>(*this, m_func, values...);
+                    new EvtStdFunctionAsyncParam<Args...>(*this, getStdFunction(), values...);
 
             EvtManager::instance()->postEvent(event);
         }
     }
+
+private:
+
+    //! Get the slot as a std::function, for the posted events.
+    T_StdFunction getStdFunction() const
+    {
+        if (m_funcPtr) {
+            EvtHandler *receiver = m_receiver;
+            T_FunctionParamPtr funcPtr = m_funcPtr;
+
+            return [receiver, funcPtr] (Args... values) { (receiver->*funcPtr)(values...); };
+        } else {
+            return m_func;
+        }
+    }
 };
 
 
@@ -347,10 +392,12 @@ class O3D_API EvtStdFunction0Param : public EvtFunctionBase
 public:
 
     typedef std::function<void()> T_StdFunction;
+    typedef void (EvtHandler::*T_FunctionParamPtr)(void);
 
 private:
 
     T_StdFunction m_func;
+    T_FunctionParamPtr m_funcPtr;  //!< Method of the receiver, or null if m_func is used.
 
     /* Restricted */
     EvtStdFunction0Param(const EvtStdFunction0Param & _which);
@@ -359,6 +406,7 @@ public:
 
     /* Constructors */
     EvtStdFunction0Param(T_StdFunction _func);
+    EvtStdFunction0Param(T_FunctionParamPtr _funcPtr);
 
     virtual ~EvtStdFunction0Param();
 
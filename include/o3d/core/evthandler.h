@@ -138,17 +138,11 @@ private:
 	typedef T_ConnectionArray::iterator        IT_ConnectionArray;
 	typedef T_ConnectionArray::const_iterator  CIT_ConnectionArray;
 
-	typedef std::map<UInt32, std::vector<EvtHandler*> > T_SenderMap;
-    typedef T_SenderMap::iterator                       IT_SenderMap;
-    typedef T_SenderMap::const_iterator                 CIT_SenderMap;
-
 	// Members
 	T_ConnectionArray m_connections;	//! Contains the connections to all events.
 
     Thread * m_pAttachedThread;		//! Owner thread. null means the default thread.
 
-	T_SenderMap m_senders;			//! Contains the stack of sender for each thread.
-
 	static RecursiveMutex m_mutex;	//! Mutex shared by all objects.
 };
 
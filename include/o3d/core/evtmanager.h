@@ -12,16 +12,15 @@
 #define _O3D_EVTMANAGER_H
 
 #include "o3d/core/types.h"
+#include "o3d/core/mutex.h"
 
-#include <map>
-#include <list>
+#include <atomic>
 
 namespace o3d {
 
 class Thread;
 class EvtFunctionAsyncBase;
 class EvtHandler;
-class FastMutex;
 class Callback;
 
 /**
@@ -33,26 +32,60 @@ class Callback;
  * called at a specific time.
  * The event manager can be used with the o3d::Application event loop in way
  * to wake-up the application event loop when there is a new posted event to process.
+ *
+ * Each registered thread owns a lock-free multiple producers single consumer queue.
+ * Posting an event never lock nor allocate, the event object is itself the node of
+ * the queue. The consumer side takes all the posted events at once and process them
+ * by batch, in the order of posting.
  */
 class O3D_API EvtManager
 {
 private:
 
-    typedef std::list<EvtFunctionAsyncBase*> T_EventList;
-    typedef T_EventList::iterator            IT_EventList;
-    typedef T_EventList::const_iterator      CIT_EventList;
+    //! Maximum number of simultaneously registered threads.
+    static const UInt32 MAX_THREADS = 64;
+
+    /**
+     * @brief Events queue of a registered thread.
+     * Producers push on a lock-free LIFO stack. The consumer steals the whole stack,
+     * reverse it and append it to its FIFO list, protected by a mutex never taken
+     * by the producers.
+     */
+    struct EvtQueue
+    {
+        EvtQueue();
+
+        std::atomic<Thread*> thread;                   //!< Owner thread (null for main).
+        std::atomic<Bool> registered;                  //!< Slot in use.
+        std::atomic<Int32> producers;                  //!< Number of posting threads.
+        std::atomic<EvtFunctionAsyncBase*> posted;     //!< Lock-free stack of posted events.
+
+        FastMutex mutex;                               //!< Protect the consumer list.
+        EvtFunctionAsyncBase *head;                    //!< Consumer FIFO list.
+        EvtFunctionAsyncBase *tail;
+
+        //! Move the posted events into the consumer list. Must be called with the mutex.
+        void drain();
+
+        //! Take the whole consumer list. Must be called with the mutex.
+        EvtFunctionAsyncBase* takeAll();
 
-	typedef std::map<Thread *, T_EventList>	T_PoolMap;
-	typedef T_PoolMap::iterator				IT_PoolMap;
-	typedef T_PoolMap::const_iterator		CIT_PoolMap;
+        //! Take the events for a specific receiver. Must be called with the mutex.
+        EvtFunctionAsyncBase* take(EvtHandler *receiver);
+
+        //! Is there some events for a specific receiver, or any if null.
+        //! Must be called with the mutex.
+        Bool hasEvents(EvtHandler *receiver) const;
+    };
 
 	// Members
-	T_PoolMap m_poolMap;
+    EvtQueue* m_queues[MAX_THREADS];          //!< Queues, never released until destruction.
+    std::atomic<UInt32> m_numQueues;          //!< Number of created queues.
 
-    mutable FastMutex m_mutex;
+    mutable FastMutex m_mutex;                //!< Only for registration.
 
-	Bool m_mainMessage;
-	Bool m_isAutoWakeUp;
+    std::atomic<Bool> m_mainMessage;
+    std::atomic<Bool> m_isAutoWakeUp;
 
     Callback *m_wakeUpCallback;
 
@@ -62,8 +95,23 @@ private:
 	EvtManager(const EvtManager &);
 	EvtManager & operator = (const EvtManager &);
 
-	IT_PoolMap getPoolMap(UInt32);
-	CIT_PoolMap getPoolMap(UInt32) const;
+    //! Find the registered queue of a thread, or null.
+    EvtQueue* findQueue(Thread *thread) const;
+
+    //! Find the registered queue of a thread by its id, or throw an error.
+    EvtQueue* getQueue(UInt32 threadId) const;
+
+    //! Find the registered queue of a thread, or throw an error.
+    EvtQueue* getQueue(Thread *thread) const;
+
+    //! Process and delete a list of events.
+    static UInt32 processList(EvtFunctionAsyncBase *list);
+
+    //! Delete a list of events.
+    static void deleteList(EvtFunctionAsyncBase *list);
+
+    //! Reset the main message state if necessary.
+    void resetMainMessage(EvtQueue *queue);
 
 	// Constructors
 	EvtManager();
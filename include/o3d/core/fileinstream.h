@@ -65,7 +65,7 @@ public:
     virtual Bool isEnd() const override;
 
     //! Get the C file descriptor.
-    int getFD() const;
+    virtual int getFD() const override;
 
     //! Get the stdio C file stream.
     FILE* getFile() const;
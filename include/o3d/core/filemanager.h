@@ -13,6 +13,9 @@
 #include "asset.h"
 #include "instream.h"
 #include "fileoutstream.h"
+#include "filereadqueue.h"
+#include "assetcache.h"
+#include "virtualfileindex.h"
 
 #include "memorydbg.h"
 
@@ -60,6 +63,9 @@ struct O3D_API BlockData
  * Using file manager to open a file on the system, or any others virtual files
  * mounted into this manager (zip, asset manager...).
  * Zip files can be mounted virtually for a reading access only.
+ * The files of the mounted assets are resolved using a case insensitive hashed index,
+ * updated at each mount and unmount. The local files are always looked up on the
+ * file system.
  * This manager is thread safe.
  * By default on Android it support for the asset manager.
  */
@@ -179,7 +185,8 @@ public:
 
     /**
      * @brief openInputStream Open an input stream.
-     *        It can be a FileInStream or a SharedDataInStream.
+     *        It can be a FileInStream, a MmapInStream for the files of at least the
+     *        mapping threshold size, or a SharedDataInStream.
      * @param filename
      * @return nullptr or a new input stream.
      */
@@ -193,6 +200,57 @@ public:
       */
     FileOutStream* openOutStream(const String &filename, FileOutStream::Mode mode);
 
+    //! Set the minimal size of the files opened as a MmapInStream by openInStream.
+    //! Zero disables the memory mapping (default is 1MB).
+    inline void setMmapThreshold(UInt64 size) { m_mmapThreshold = size; }
+
+    //! Get the minimal size of the files opened as a MmapInStream.
+    inline UInt64 getMmapThreshold() const { return m_mmapThreshold; }
+
+    //-----------------------------------------------------------------------------------
+    // Asynchronous reads
+    //-----------------------------------------------------------------------------------
+
+    /**
+     * @brief readAsync Submit an asynchronous read of a file on file system or on assets.
+     *        The close or overlapping pending reads of the same file are coalesced.
+     * @param filename File to read.
+     * @param offset Offset of the range to read.
+     * @param length Length of the range to read, 0 for until the end of the file.
+     * @param priority Higher are read first.
+     * @param tag Optional user tag, to cancel the reads of an object at once.
+     * @param callback Optional callback, called by an I/O thread once the read is
+     *        done or failed, or by the canceling thread.
+     * @return The new pending request.
+     */
+    SmartPtr<FileReadRequest> readAsync(
+            const String &filename,
+            UInt64 offset = 0,
+            UInt32 length = 0,
+            Int32 priority = 0,
+            const void *tag = nullptr,
+            const FileReadRequest::T_Callback &callback = nullptr);
+
+    //! Cancel every pending asynchronous read having a specific tag.
+    //! @return The number of canceled reads.
+    UInt32 cancelReads(const void *tag);
+
+    //! Get the queue of the asynchronous reads, started at the first use.
+    FileReadQueue* getReadQueue();
+
+    //-----------------------------------------------------------------------------------
+    // Converted resources cache
+    //-----------------------------------------------------------------------------------
+
+    //! Define the cache of the converted resources, checked by the resources before
+    //! redoing a conversion. The cache is shared, and the previous one is deleted once
+    //! it is no longer used. Null disables the cache (default).
+    void setAssetCache(AssetCache *cache);
+
+    //! Get the cache of the converted resources, or null if disabled. Keep the returned
+    //! pointer for the duration of the use, the cache can be replaced meanwhile.
+    SmartPtr<AssetCache> getAssetCache() const;
+
 	//-----------------------------------------------------------------------------------
     // Assets support
 	//-----------------------------------------------------------------------------------
@@ -203,7 +261,8 @@ public:
     //! Return the packs files extension.
     inline String getPackExt()const { return m_packExt; }
 
-    //! Add an asset handler. Can be a Zip or any other supported protocol.
+    //! Add an asset handler. Can be a Zip (zip://), a ChunkPack (pack://) or any other
+    //! supported protocol.
 	//! @return true if it was not already added.
     Bool mountAsset(const String &protocol, const String &assetName);
 
@@ -222,7 +281,8 @@ public:
     //! Get a mounted asset.
     Asset* getAsset(const String &assetName);
 
-    //! Initialize file search for file contained in asset.
+    //! Initialize file search for the files contained in a directory of the assets.
+    //! Only the direct children of the indexed directory are returned.
     void searchFirstVirtualFile(const String &path);
 
 	//! Return the next file name (empty string if finished).
@@ -307,14 +367,38 @@ protected:
     String m_defaultWorkingDir;   //!< root absolute path
     String m_oldWorkingDir;       //!< old working absolute path
 
+    UInt64 m_mmapThreshold;       //!< minimal size of the memory mapped input files
+
+    FileReadQueue *m_readQueue;   //!< asynchronous reads, created on demand
+    SmartPtr<AssetCache> m_assetCache;  //!< cache of the converted resources, or null
+
     T_AssetList m_assets;	      //!< List of mounted assets
+    VirtualFileIndex m_index;     //!< Index of the files of the indexable assets
+
+    VirtualFileIndex::T_Children m_curChildren;  //!< indexed files listed by findNextFile
+    size_t m_curChild;            //!< current position into the indexed files
+    UInt32 m_curGeneration;       //!< generation of the index when the listing started
 
     Int32 m_curFilePos;           //!< current position of used file by findNextFile
     IT_AssetList m_curAssetIt;    //!< current position of used pack by findNextFile
 
+    //! Find a file into the assets, using the index next the assets not indexed.
+    //! The mutex must be locked.
+    Asset* findAssetFile(const String &filename, Int32 &index) const;
+
+    //! Find a directory into the assets. The mutex must be locked.
+    Bool isAssetPath(const String &path) const;
+
     //! return a iterator on an asset name
     IT_AssetList findAsset(const String &assetName);
 
+    //! Creation of an archive asset from its opened stream, name and path.
+    typedef Asset* (*ArchiveFactory)(InStream &is, const String &name, const String &path);
+
+    //! Mount an archive file (zip://, pack://) created by factory, and index it.
+    //! @return False if the archive is already mounted.
+    Bool mountArchive(const String &protocol, const String &assetName, ArchiveFactory factory);
+
     //! Flow control for file reading and writing (independantly).
     BlockData m_flowCtrl[NUM_FILE_SPEED_MANAGER];
 
@@ -0,0 +1,247 @@
+/**
+ * @file filereadqueue.h
+ * @brief Asynchronous file read requests processed by a set of I/O threads.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_FILEREADQUEUE_H
+#define _O3D_FILEREADQUEUE_H
+
+#include "thread.h"
+#include "smartarray.h"
+#include "smartcounter.h"
+#include "smartpointer.h"
+
+#include <atomic>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace o3d {
+
+class FileReadQueue;
+
+/**
+ * @brief An asynchronous read of a range of a file, created by FileReadQueue::submit
+ * or FileManager::readAsync.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The callback is called exactly once when the request is done, failed or canceled,
+ * by an I/O thread or by the thread canceling it. The data are valid once done.
+ */
+class O3D_API FileReadRequest : public SmartCounter<FileReadRequest>, NonCopyable<>
+{
+    friend class FileReadQueue;
+
+public:
+
+    enum State
+    {
+        STATE_PENDING = 0,   //!< Waiting into the queue.
+        STATE_READING,       //!< Read by an I/O thread.
+        STATE_DONE,          //!< Data are available.
+        STATE_FAILED,        //!< File not found, offset out of the file or short read.
+        STATE_CANCELED       //!< Canceled before its read.
+    };
+
+    typedef std::function<void(FileReadRequest*)> T_Callback;
+
+    virtual ~FileReadRequest();
+
+    //! Get the absolute or relative filename given at submit.
+    inline const String& getFileName() const { return m_filename; }
+
+    //! Get the offset of the range to read.
+    inline UInt64 getOffset() const { return m_offset; }
+
+    //! Get the requested length, 0 meaning until the end of the file.
+    inline UInt32 getLength() const { return m_length; }
+
+    //! Get the priority, higher first.
+    inline Int32 getPriority() const { return m_priority; }
+
+    //! Get the user tag given at submit, used by FileReadQueue::cancelAll.
+    inline const void* getTag() const { return m_tag; }
+
+    //! Get the current state.
+    inline State getState() const { return (State)m_state.load(); }
+
+    //! Is the request done, failed or canceled.
+    inline Bool isFinished() const { return m_state.load() >= STATE_DONE; }
+
+    //! Is the request done with its data.
+    inline Bool isDone() const { return m_state.load() == STATE_DONE; }
+
+    //! Get the read data, shorter than the requested length at the end of the file.
+    //! Valid once done.
+    inline const SmartArrayUInt8& getData() const { return m_data; }
+
+    //! Wait until the request is done, failed or canceled.
+    //! @return True if done.
+    Bool wait();
+
+    //! Cancel the request if it is not read yet.
+    //! @return True if canceled by this call.
+    Bool cancel();
+
+private:
+
+    FileReadRequest(
+            FileReadQueue *queue,
+            const String &filename,
+            UInt64 offset,
+            UInt32 length,
+            Int32 priority,
+            const void *tag,
+            const T_Callback &callback);
+
+    FileReadQueue *m_queue;
+
+    String m_filename;
+    UInt64 m_offset;
+    UInt32 m_length;
+    Int32 m_priority;
+    const void *m_tag;
+    T_Callback m_callback;
+
+    UInt64 m_sequence;          //!< Submit order, for the same priority.
+    std::atomic<Int32> m_state;
+
+    SmartArrayUInt8 m_data;
+
+    FastMutex m_mutex;
+    WaitCondition m_finished;
+
+    //! Set the final state, wake up the waiting threads and call the callback.
+    void finish(State state);
+};
+
+/**
+ * @brief Queue of asynchronous file reads processed by a small set of I/O threads.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Files are opened using the FileManager, so the files of the mounted assets can be
+ * read too. The pending requests are processed by priority, and for the same priority
+ * in submit order. When an I/O thread takes a request it coalesces the others pending
+ * requests of the same file having a close or an overlapping range, and performs a
+ * single read. The coalesced requests share the read buffer without copy.
+ */
+class O3D_API FileReadQueue
+{
+public:
+
+    //! Maximal distance between two ranges to coalesce them.
+    static const UInt32 COALESCE_GAP = 65536;
+
+    //! Maximal size of a coalesced read, excepted for the reads until the end of file.
+    static const UInt32 COALESCE_MAX = 4*1024*1024;
+
+    //! Start the I/O threads.
+    //! @param numThreads Number of I/O threads, at least 1.
+    FileReadQueue(UInt32 numThreads = 2);
+
+    //! Stop the I/O threads. The pending requests are canceled.
+    ~FileReadQueue();
+
+    /**
+     * @brief Submit an asynchronous read.
+     * @param filename File to read.
+     * @param offset Offset of the range to read.
+     * @param length Length of the range to read, 0 for until the end of the file.
+     * @param priority Higher are processed first.
+     * @param tag Optional user tag, to cancel a set of requests at once.
+     * @param callback Optional callback, called once the request is finished.
+     * @return The new pending request.
+     */
+    SmartPtr<FileReadRequest> submit(
+            const String &filename,
+            UInt64 offset = 0,
+            UInt32 length = 0,
+            Int32 priority = 0,
+            const void *tag = nullptr,
+            const FileReadRequest::T_Callback &callback = nullptr);
+
+    //! Cancel a request if it is not read yet.
+    //! @return True if canceled by this call.
+    Bool cancel(FileReadRequest *request);
+
+    //! Cancel every pending request having a specific tag.
+    //! @return The number of canceled requests.
+    UInt32 cancelAll(const void *tag);
+
+    //! Get the number of pending requests.
+    UInt32 getNumPending() const;
+
+    //! Get the number of performed reads, lesser than the number of requests when
+    //! some requests are coalesced.
+    inline UInt64 getNumReads() const { return m_numReads.load(); }
+
+    //! Get the number of I/O threads.
+    inline UInt32 getNumThreads() const { return (UInt32)m_threads.size(); }
+
+private:
+
+    class IOThread : public Runnable
+    {
+    public:
+
+        IOThread(FileReadQueue *queue, UInt32 index);
+
+        virtual Int32 run(void *);
+
+        Thread m_thread;
+        FileReadQueue *m_queue;
+        UInt32 m_index;
+    };
+
+    //! Ordered by decreasing priority, next by submit order.
+    struct Key
+    {
+        Int32 priority;
+        UInt64 sequence;
+
+        inline Bool operator< (const Key &other) const
+        {
+            return (priority > other.priority) ||
+                   ((priority == other.priority) && (sequence < other.sequence));
+        }
+    };
+
+    typedef std::map<Key, SmartPtr<FileReadRequest> > T_RequestMap;
+    typedef std::unordered_multimap<String, FileReadRequest*, std::hash<String> > T_FileMap;
+
+    std::vector<IOThread*> m_threads;
+
+    mutable FastMutex m_mutex;
+    WaitCondition m_wakeUp;
+
+    T_RequestMap m_pending;        //!< Pending requests, referenced.
+    T_FileMap m_files;             //!< Pending requests per filename.
+
+    UInt64 m_nextSequence;
+    Bool m_running;
+
+    std::atomic<UInt64> m_numReads;
+
+    //! Remove a pending request from the queue. m_mutex must be locked.
+    //! @return The reference of the queue on the request.
+    SmartPtr<FileReadRequest> remove(FileReadRequest *request);
+
+    //! Wait for the next request, and take it with the pending requests to coalesce.
+    //! @return False when the queue is stopped.
+    Bool take(std::vector<SmartPtr<FileReadRequest> > &group);
+
+    //! Read the range of a group of requests and finish them.
+    void process(std::vector<SmartPtr<FileReadRequest> > &group);
+
+    FileReadQueue(const FileReadQueue &dup);
+    FileReadQueue& operator=(const FileReadQueue &dup);
+};
+
+} // namespace o3d
+
+#endif // _O3D_FILEREADQUEUE_H
@@ -0,0 +1,200 @@
+/**
+ * @file framearena.h
+ * @brief Per frame linear allocator for transient data.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_FRAMEARENA_H
+#define _O3D_FRAMEARENA_H
+
+#include "base.h"
+#include "memorydbg.h"
+
+#include <vector>
+#include <type_traits>
+
+namespace o3d {
+
+/**
+ * @brief Linear (bump) allocator for the data rebuilt at each frame.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Allocations are never released individually, the whole arena is reset by endFrame().
+ * Data allocated with FRAME_SINGLE are valid until the next endFrame(), and data
+ * allocated with FRAME_DOUBLE survive one more frame (double buffering).
+ * When a buffer overflows, extra blocks are allocated and the buffer is grown at the
+ * next reset, so the steady state frames do not use the general heap.
+ * Not thread-safe, it is dedicated to the thread that performs the frames.
+ */
+class O3D_API FrameArena
+{
+public:
+
+    //! Lifetime of an allocation.
+    enum Lifetime
+    {
+        FRAME_SINGLE = 0,   //!< Valid until the end of the current frame.
+        FRAME_DOUBLE = 1    //!< Valid until the end of the next frame.
+    };
+
+    //! Default alignment of the allocations.
+    static const size_t DEFAULT_ALIGN = 16;
+
+    //! Construct the arena.
+    //! @param initialSize Initial size in bytes of each buffer.
+    FrameArena(size_t initialSize = 256*1024);
+
+    ~FrameArena();
+
+    //! Allocate a block.
+    //! @param size Size in bytes.
+    //! @param align Alignment, a power of two lesser or equal to DEFAULT_ALIGN*4.
+    //! @param lifetime Lifetime of the block.
+    void* allocate(size_t size, size_t align = DEFAULT_ALIGN, Lifetime lifetime = FRAME_SINGLE);
+
+    //! Allocate a non initialized array of n elements of type T.
+    template <class T>
+    inline T* allocateArray(size_t n, Lifetime lifetime = FRAME_SINGLE)
+    {
+        return static_cast<T*>(allocate(n * sizeof(T), alignof(T) > DEFAULT_ALIGN ? alignof(T) : DEFAULT_ALIGN, lifetime));
+    }
+
+    //! End the current frame. Reset the single frame buffer and the oldest of the
+    //! double frame buffers.
+    void endFrame();
+
+    //! Get the number of the current frame, incremented by endFrame().
+    inline UInt32 getFrameId() const { return m_frameId; }
+
+    //! Get the size allocated during the current frame (both lifetimes).
+    inline size_t getUsedSize() const { return m_frameUsed; }
+
+    //! Get the maximal size allocated during a frame since the creation or the last reset.
+    inline size_t getHighWaterMark() const { return m_highWaterMark; }
+
+    //! Reset the high-water mark.
+    inline void resetHighWaterMark() { m_highWaterMark = 0; }
+
+    //! Get the total size reserved by the buffers.
+    size_t getCapacity() const;
+
+    //! Get the number of general heap allocations done since the creation.
+    inline UInt32 getNumHeapAllocs() const { return m_numHeapAllocs; }
+
+private:
+
+    struct Buffer
+    {
+        UInt8 *data;
+        size_t size;
+        size_t offset;
+
+        std::vector<UInt8*> overflows;  //!< Extra blocks allocated when full.
+        size_t overflowSize;
+        size_t overflowOffset;          //!< Offset into the last extra block.
+        size_t overflowLast;            //!< Size of the last extra block.
+    };
+
+    Buffer m_single;
+    Buffer m_double[2];
+    UInt32 m_current;          //!< Index of the double buffer of the current frame.
+
+    UInt32 m_frameId;
+    size_t m_frameUsed;
+    size_t m_highWaterMark;
+    UInt32 m_numHeapAllocs;
+
+    void initBuffer(Buffer &buffer, size_t size);
+    void releaseBuffer(Buffer &buffer);
+    void resetBuffer(Buffer &buffer);
+    void* allocateFrom(Buffer &buffer, size_t size, size_t align);
+
+    FrameArena(const FrameArena &);
+    FrameArena& operator= (const FrameArena &);
+};
+
+/**
+ * @brief STL allocator adapter over a FrameArena.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Deallocation does nothing. A container using it must not be used after the end of
+ * the lifetime of its allocations, it must be recreated (not cleared) at each frame.
+ */
+template <class T>
+class FrameAllocator
+{
+public:
+
+    typedef T value_type;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef FrameAllocator<U> other;
+    };
+
+    // an assigned container takes the arena of the source
+    typedef std::true_type propagate_on_container_copy_assignment;
+    typedef std::true_type propagate_on_container_move_assignment;
+    typedef std::true_type propagate_on_container_swap;
+
+    FrameAllocator(FrameArena *arena = nullptr, FrameArena::Lifetime lifetime = FrameArena::FRAME_SINGLE) :
+        m_arena(arena),
+        m_lifetime(lifetime)
+    {
+    }
+
+    template <class U>
+    FrameAllocator(const FrameAllocator<U> &dup) :
+        m_arena(dup.getArena()),
+        m_lifetime(dup.getLifetime())
+    {
+    }
+
+    inline T* allocate(size_t n)
+    {
+        O3D_ASSERT(m_arena != nullptr);
+        return m_arena->allocateArray<T>(n, m_lifetime);
+    }
+
+    inline void deallocate(T*, size_t)
+    {
+    }
+
+    inline FrameArena* getArena() const { return m_arena; }
+    inline FrameArena::Lifetime getLifetime() const { return m_lifetime; }
+
+    template <class U>
+    inline Bool operator== (const FrameAllocator<U> &cmp) const
+    {
+        return (m_arena == cmp.getArena()) && (m_lifetime == cmp.getLifetime());
+    }
+
+    template <class U>
+    inline Bool operator!= (const FrameAllocator<U> &cmp) const
+    {
+        return !(*this == cmp);
+    }
+
+private:
+
+    FrameArena *m_arena;
+    FrameArena::Lifetime m_lifetime;
+};
+
+//! Vector allocated into a FrameArena.
+template <class T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace o3d
+
+#endif // _O3D_FRAMEARENA_H
@@ -14,6 +14,7 @@
 #include "closable.h"
 
 #include <type_traits>
+#include <vector>
 
 namespace o3d {
 
@@ -72,6 +73,113 @@ public:
     //! is the end of the stream reached
     virtual Bool isEnd() const = 0;
 
+    /**
+     * @brief Get a pointer on the next size bytes and move the position after them, when
+     * the data of the stream are in memory.
+     * @return Null if the stream data are not in memory or if less than size bytes are
+     * available, and the position is unchanged.
+     * @note The pointer is valid until the stream is closed.
+     */
+    virtual const UInt8* getDirectPointer(UInt32 size);
+
+    /**
+     * @brief Get the whole data of the stream when it is a memory mapping of a file.
+     * @param size Receives the size of the data in bytes, 0 if not mapped.
+     * @return Null if the stream is not a mapping.
+     * @note The pointer is valid until the stream is closed.
+     */
+    virtual const UInt8* getMappedData(UInt64 &size) const;
+
+    //! Enable the borrowing of the data by the SmartArray read from the stream, when the
+    //! stream supports it (see MmapInStream). Does nothing by default.
+    virtual void setBorrowing(Bool borrowing);
+
+    //! Is the borrowing of the data enabled (default false).
+    virtual Bool isBorrowing() const;
+
+    /**
+     * @brief Get the C file descriptor of the stream when it reads a file, usable for
+     * positional reads (pread) independently of the stream position.
+     * @return -1 if the stream does not read a file descriptor.
+     */
+    virtual int getFD() const;
+
+    /**
+     * @brief Get a pointer on the next size bytes that remains valid after the stream is
+     * closed, and move the position after them. Only when the borrowing is enabled.
+     * @param alignment Required alignment of the data in bytes.
+     * @param releaser Receives the function to call with owner when the data is released.
+     * @param owner Receives the owner of the data.
+     * @return Null if the borrowing is disabled or not supported, if less than size bytes
+     * are available or if the data is not aligned, and the position is unchanged.
+     */
+    virtual const UInt8* borrowDirectPointer(
+            UInt32 size,
+            UInt32 alignment,
+            void (*&releaser)(void*),
+            void *&owner);
+
+    /**
+     * @brief Read an array of an arithmetic type using a single read, and convert it from
+     * little endian only on big endian targets.
+     * @return The number of read elements.
+     */
+    template <class T>
+    UInt32 readArray(T *buf, UInt32 count)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be read as array");
+
+        const UInt32 numElt = reader(buf, sizeof(T), count) / sizeof(T);
+
+        #ifdef O3D_BIG_ENDIAN
+        if (sizeof(T) > 1) {
+            System::swapBytesArray(buf, sizeof(T), numElt);
+        }
+        #endif
+
+        return numElt;
+    }
+
+    /**
+     * @brief Read an array of an arithmetic type, referring directly to the stream data
+     * when they are in memory, correctly aligned and without endian conversion. Otherwise
+     * the elements are read into the scratch array.
+     * @return The elements, valid until the stream is closed or the scratch is modified,
+     * or null if there is not enough data.
+     */
+    template <class T>
+    const T* readArray(UInt32 count, std::vector<T> &scratch)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be read as array");
+
+        if (count == 0) {
+            return nullptr;
+        }
+
+        #ifndef O3D_BIG_ENDIAN
+        if (isMemory()) {
+            const UInt8 *data = getDirectPointer(count * sizeof(T));
+            if (data) {
+                if (((size_t)data & (alignof(T) - 1)) == 0) {
+                    return (const T*)data;
+                }
+
+                scratch.resize(count);
+                memcpy(scratch.data(), data, count * sizeof(T));
+
+                return scratch.data();
+            }
+        }
+        #endif
+
+        scratch.resize(count);
+        if (readArray(scratch.data(), count) != count) {
+            return nullptr;
+        }
+
+        return scratch.data();
+    }
+
     //! Read buf with size * count.
 //    template <typename T>
 //    UInt32 read(T* buf, UInt32 size, UInt32 count)
@@ -393,6 +501,31 @@ public:
     }
 };
 
+/**
+ * @brief Enable or disable the borrowing of the data of an input stream for a scope,
+ * and restore the previous state at destruction (useful with C++ exceptions).
+ */
+class O3D_API InStreamBorrowing : NonCopyable<>
+{
+public:
+
+    //! Constructor. Set the borrowing state of the stream.
+    InStreamBorrowing(InStream &is, Bool borrowing = True) :
+        m_is(is),
+        m_previous(is.isBorrowing())
+    {
+        m_is.setBorrowing(borrowing);
+    }
+
+    //! Destructor. Restore the previous borrowing state.
+    ~InStreamBorrowing() { m_is.setBorrowing(m_previous); }
+
+private:
+
+    InStream &m_is;
+    Bool m_previous;
+};
+
 
 template <class _T>
 struct StreamObjectIsEnumRead
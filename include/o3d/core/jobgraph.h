@@ -0,0 +1,182 @@
+/**
+ * @file jobgraph.h
+ * @brief Graph of fine-grained jobs with dependencies, processed by the WorkerPool.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_JOBGRAPH_H
+#define _O3D_JOBGRAPH_H
+
+#include "workerpool.h"
+
+#include <functional>
+#include <initializer_list>
+
+namespace o3d {
+
+class JobGraph;
+
+/**
+ * @brief A job is a unit of work of a JobGraph. It is run once all its dependencies
+ * are done.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Jobs are created and owned by a JobGraph.
+ */
+class O3D_API Job : public Runnable
+{
+    friend class JobGraph;
+
+public:
+
+    typedef std::function<void()> T_JobFunction;
+
+    virtual ~Job();
+
+    //! Run this job after another one. Must be called before the job is submitted,
+    //! it mean before JobGraph::start() or at creation using JobGraph::add().
+    void dependsOn(Job *job);
+
+    //! Add a continuation, a new job of the same graph run once this one is done.
+    //! Can be called at any time, including from a running job.
+    //! @return The continuation job.
+    Job* then(T_JobFunction func);
+
+    //! Is the job done (executed, failed or canceled).
+    Bool isDone() const;
+
+    //! Is the job canceled, because of a failure of one of its dependencies.
+    inline Bool isCanceled() const { return m_canceled.load(); }
+
+    //! Owner graph.
+    inline JobGraph* getGraph() const { return m_graph; }
+
+    virtual Int32 run(void *);
+
+private:
+
+    Job(JobGraph *graph, T_JobFunction func);
+
+    //! Release one dependency, and submit the job when there is no more.
+    void release();
+
+    JobGraph *m_graph;
+    T_JobFunction m_func;
+
+    std::atomic<Int32> m_numDeps;   //!< Remaining dependencies, +1 until submitted.
+    std::atomic<Bool> m_canceled;
+
+    FastMutex m_mutex;              //!< Protect successors, done and failed states.
+    std::vector<Job*> m_successors;
+    Bool m_done;
+    Bool m_failed;                  //!< Its function thrown an exception.
+    Bool m_submitted;
+};
+
+/**
+ * @brief A graph of jobs with explicit dependencies, for fan-out, fan-in and
+ * continuations, processed by a WorkerPool.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Usage :
+ * @code
+ * JobGraph graph;
+ * Job *read = graph.add([&] () { readFile(); });
+ * Job *decode = read->then([&] () { decode(); });
+ * Job *mip1 = graph.add([&] () { mipmaps(0); }, {decode});
+ * Job *mip2 = graph.add([&] () { mipmaps(1); }, {decode});
+ * graph.add([&] () { upload(); }, {mip1, mip2});
+ * graph.start();
+ * graph.wait();
+ * @endcode
+ * Jobs throwing an exception are reported as failed, and their successors are
+ * canceled (never run, but done).
+ */
+class O3D_API JobGraph
+{
+public:
+
+    typedef Job::T_JobFunction T_JobFunction;
+
+    //! Function for parallelFor, called with a [first, last[ range of indices.
+    typedef std::function<void(UInt32, UInt32)> T_RangeFunction;
+
+    //! Construct an empty graph.
+    //! @param pool Pool of workers, or null to use the shared WorkerPool instance.
+    JobGraph(WorkerPool *pool = nullptr);
+
+    //! Destructor. Wait for the end of the graph if started and delete the jobs.
+    ~JobGraph();
+
+    //! Add a new job.
+    //! @param func Job function.
+    //! @param dependencies Jobs of this graph to wait before running this one.
+    //! @return The new job. If the graph is already started the job is submitted
+    //! as soon as its dependencies are done.
+    Job* add(T_JobFunction func, std::initializer_list<Job*> dependencies = {});
+
+    //! Submit every job. Jobs without dependencies are immediately pushed to the pool.
+    void start();
+
+    //! Wait until every job is done. The calling thread help to process the pending
+    //! jobs of the pool while waiting.
+    void wait();
+
+    //! Is the graph started.
+    inline Bool isStarted() const { return m_started.load(); }
+
+    //! Is every job of the graph done.
+    inline Bool isDone() const { return m_numRemaining.load() == 0; }
+
+    //! Is at least one job failed.
+    inline Bool isFailed() const { return m_failed.load(); }
+
+    //! Get the number of jobs.
+    UInt32 getNumJobs() const;
+
+    //! Get the pool of workers.
+    inline WorkerPool* getPool() const { return m_pool; }
+
+    //! Process a range of indices in parallel, and return once all are processed.
+    //! @param begin First index.
+    //! @param end Last index excluded.
+    //! @param grain Maximal number of indices per job. If 0 it is deduced from the
+    //! number of workers.
+    //! @param func Function called for each sub-range [first, last[.
+    //! @param pool Pool of workers, or null to use the shared WorkerPool instance.
+    static void parallelFor(
+            UInt32 begin,
+            UInt32 end,
+            UInt32 grain,
+            const T_RangeFunction &func,
+            WorkerPool *pool = nullptr);
+
+private:
+
+    friend class Job;
+
+    WorkerPool *m_pool;
+
+    mutable FastMutex m_mutex;   //!< Protect the jobs list.
+    std::vector<Job*> m_jobs;
+
+    std::atomic<Bool> m_started;
+    std::atomic<Bool> m_failed;
+    std::atomic<Int32> m_numRemaining;
+
+    FastMutex m_doneMutex;
+    WaitCondition m_doneCond;
+
+    //! Called by a job once done.
+    void jobDone();
+
+    JobGraph(const JobGraph &dup);
+    JobGraph& operator=(const JobGraph &dup);
+};
+
+} // namespace o3d
+
+#endif // _O3D_JOBGRAPH_H
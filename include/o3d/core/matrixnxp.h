@@ -29,7 +29,7 @@ namespace o3d {
  *  | a0p-1 a1p-1 a2p-1 .....  a(n-1)p-1 |
  *  |_                                  _|
  */
-class MatrixNxP
+class O3D_API MatrixNxP
 {
 public:
 
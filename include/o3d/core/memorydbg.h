@@ -331,8 +331,9 @@ inline void alignedFree(void *ptr)
 	#define O3D_FAST_ALLOC(_S)   MemoryManager::instance()->fastAlloc((_S),__FILE__,__LINE__)
 	#define O3D_FAST_FREE(_P,_S) MemoryManager::instance()->freeFastAlloc((_P),(_S),__FILE__,__LINE__)
 #else
-	#define O3D_FAST_ALLOC(_S)   MemoryManager::instance()->fastAlloc((_S))
-	#define O3D_FAST_FREE(_P,_S) MemoryManager::instance()->freeFastAlloc((_P),(_S))
+	// thread cached, without the memory manager lock
+	#define O3D_FAST_ALLOC(_S)   MemoryManager::threadAlloc((_S))
+	#define O3D_FAST_FREE(_P,_S) MemoryManager::threadFree((_P),(_S))
 #endif // O3D_FAST_MEMORY_MANAGER
 
 //---------------------------------------------------------------------------------------
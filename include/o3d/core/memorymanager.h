@@ -28,7 +28,8 @@ class Logger;
 /**
  * @brief Memory manager for log, reports memories allocations and to detect memory
  * leaks. It also provide some current value like allocations total size, peaks, and
- * a fast memory allocator for small memory blocks of fixed size (16,32,64bytes)
+ * a fast memory allocator for small memory blocks of fixed size (16,32,64bytes),
+ * and a scalable thread cached allocator for blocks up to some KB.
  * @details Log details meaning :
  * ++ mean central memory allocation (malloc, new, new [])");
  * -- mean central memory free (free, delete, delete [])");
@@ -120,6 +121,26 @@ public:
 	void freeFastAlloc(void* ptr, size_t size, const Char* file, Int32 line);
 
 
+	// -------------------------------------------------------------------------------
+	// Thread cached allocator Operations
+	// -------------------------------------------------------------------------------
+
+	//! Maximal block size served by the thread cached allocator.
+	static const size_t THREAD_ALLOC_MAX_SIZE = 4096;
+
+	//! Allocation of a small memory block from the cache of the calling thread.
+	//! Blocks are grouped by size classes up to THREAD_ALLOC_MAX_SIZE, and the caches
+	//! are refilled and released by batch from a central pool, so most of the calls
+	//! are lock free. Bigger sizes use the system allocator. Always 16 bytes aligned.
+	//! @note Static, it does not lock the memory manager like instance().
+	//! Allocations are counted as MEM_FAST.
+	static void* threadAlloc(size_t size);
+
+	//! Release a block given by threadAlloc, with the same size. It can be released by
+	//! another thread than the allocating one.
+	static void threadFree(void* ptr, size_t size);
+
+
 	// -------------------------------------------------------------------------------
 	// Graphic Memory Operations
 	// -------------------------------------------------------------------------------
@@ -251,6 +272,9 @@ private:
 	//! write memory leak report
 	void reportLeaks();
 
+	//! Merge the statistics of the thread cached allocator into the MEM_FAST module.
+	void mergeThreadAllocStats() const;
+
 	//! memory block structure
     struct TBlock
 	{
@@ -383,10 +407,15 @@ private:
 
 	FastMemoryPool m_fastMemoryPool;
 
-	MemoryModule m_memory[NUM_MEMORY_TYPE];   //!< memory volumes
+	mutable MemoryModule m_memory[NUM_MEMORY_TYPE];   //!< memory volumes
 
     Logger *m_logger;
 
+	mutable Int64 m_threadAllocCurrent;    //!< Thread cached allocator size at the last merge.
+	mutable Int64 m_threadAllocTotal;      //!< Thread cached allocator total at the last merge.
+	mutable UInt64 m_threadAllocNews;      //!< Thread cached allocator allocations at the last merge.
+	mutable UInt64 m_threadAllocDeletes;   //!< Thread cached allocator releases at the last merge.
+
 	//! Conversion from graphic target to string.
 	const Char* gfxType2String(GraphicTarget target);
 
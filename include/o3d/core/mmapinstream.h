@@ -0,0 +1,146 @@
+/**
+ * @file mmapinstream.h
+ * @brief Memory mapped file input stream.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_MMAPINSTREAM_H
+#define _O3D_MMAPINSTREAM_H
+
+#include "instream.h"
+#include "smartarray.h"
+#include "refcounter.h"
+
+namespace o3d {
+
+class BaseFile;
+
+/**
+ * @brief Input stream over a read only memory mapping of a file.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The whole file is mapped at the construction, and the reads are memory copies.
+ * getDirectPointer() gives an access to the mapped data without any copy.
+ * When borrowing is enabled, the SmartArray read from the stream refer directly to the
+ * mapping instead of owning a copy of the data. The mapping is then kept until the
+ * stream and all the borrowing arrays are released. The pages are mapped in copy on
+ * write, so a borrowing array can be modified without altering the file.
+ */
+class O3D_API MmapInStream : public InStream
+{
+public:
+
+    /**
+     * @brief Map a file.
+     * @param filename Name of the file.
+     * @throw E_FileNotFoundOrInvalidRights if the file cannot be opened or mapped.
+     */
+    MmapInStream(const String &filename);
+
+    /**
+     * @brief Map a file.
+     * @param file File info.
+     * @throw E_FileNotFoundOrInvalidRights if the file cannot be opened or mapped.
+     */
+    MmapInStream(const BaseFile &file);
+
+    virtual ~MmapInStream();
+
+    //! True
+    virtual Bool isMemory() const override;
+
+    virtual UInt32 reader(void *buf, UInt32 size, UInt32 count) override;
+
+    //! Release the mapping, unless some arrays still borrow it.
+    virtual void close() override;
+
+    virtual void reset(UInt64 n = 0) override;
+
+    virtual void seek(Int64 n) override;
+
+    virtual void end(Int64 n = 0) override;
+
+    virtual Int32 getAvailable() const override;
+
+    virtual Int32 getPosition() const override;
+
+    virtual Bool isEnd() const override;
+
+    virtual UInt8 peek() override;
+
+    virtual void ignore(Int32 limit, UInt8 delim) override;
+
+    virtual Int32 readLine(
+            String &str,
+            CharacterEncoding encoding = ENCODING_UTF8) override;
+
+    virtual Int32 readLine(
+            String &str,
+            Int32 limit,
+            UInt8 delim,
+            CharacterEncoding encoding = ENCODING_UTF8) override;
+
+    virtual Int32 readWord(
+            String &str,
+            CharacterEncoding encoding = ENCODING_UTF8) override;
+
+    //! Get a pointer on the next size bytes and move the position after them.
+    //! @return Null if less than size bytes are available, and the position is unchanged.
+    //! @note The pointer is valid until the stream is closed.
+    virtual const UInt8* getDirectPointer(UInt32 size) override;
+
+    //! Get the mapped data.
+    inline const UInt8* getData() const { return m_data; }
+
+    //! Get the size of the mapped data in bytes.
+    inline UInt64 getSize() const { return m_size; }
+
+    //! Get the mapped data and its size.
+    virtual const UInt8* getMappedData(UInt64 &size) const override;
+
+    //! Enable the borrowing of the mapped data by the SmartArray read from the stream.
+    virtual void setBorrowing(Bool borrowing) override;
+
+    //! Is the borrowing of the mapped data enabled (default false).
+    virtual Bool isBorrowing() const override;
+
+    //! Get a pointer on the next size bytes of the mapping, keeping the mapping alive
+    //! until releaser is called with owner.
+    //! @return Null if the borrowing is disabled, if there is not enough data, or if the
+    //! data is not aligned. Nothing is read in this case.
+    virtual const UInt8* borrowDirectPointer(
+            UInt32 size,
+            UInt32 alignment,
+            void (*&releaser)(void*),
+            void *&owner) override;
+
+private:
+
+    //! Mapping shared by the stream and the borrowing arrays.
+    struct Region
+    {
+        AtomicRefCounter counter;
+        UInt8 *data;
+        UInt64 size;
+    };
+
+    Region *m_region;
+
+    const UInt8 *m_data;
+    const UInt8 *m_pos;
+    UInt64 m_size;
+
+    Bool m_borrowing;
+
+    void map(const String &filename);
+
+    //! Release a reference to a region, and unmap it when no longer used.
+    static void releaseRegion(void *region);
+};
+
+} // namespace o3d
+
+#endif // _O3D_MMAPINSTREAM_H
@@ -37,6 +37,42 @@ public:
     //! flush the stream.
     virtual void flush() = 0;
 
+    /**
+     * @brief Write an array of an arithmetic type using a single write, converted to
+     * little endian only on big endian targets, by blocks into a temporary buffer.
+     * @return The number of written elements.
+     */
+    template <class T>
+    UInt32 writeArray(const T *buf, UInt32 count)
+    {
+        static_assert(std::is_arithmetic<T>::value, "Only arithmetic types can be written as array");
+
+        #ifdef O3D_BIG_ENDIAN
+        if (sizeof(T) > 1) {
+            T block[1024];
+            UInt32 numElt = 0;
+
+            while (numElt < count) {
+                const UInt32 n = o3d::min<UInt32>(count - numElt, 1024);
+
+                memcpy(block, buf + numElt, n * sizeof(T));
+                System::swapBytesArray(block, sizeof(T), n);
+
+                const UInt32 written = writer(block, sizeof(T), n) / sizeof(T);
+                numElt += written;
+
+                if (written != n) {
+                    break;
+                }
+            }
+
+            return numElt;
+        }
+        #endif
+
+        return writer(buf, sizeof(T), count) / sizeof(T);
+    }
+
     //! Write buf with size * count.
 //    template <typename T>
 //    UInt32 write(const T* buf, UInt32 size, UInt32 count)
@@ -74,6 +74,9 @@ public:
 
     virtual void searchFirstFile(const String &path) override;
 
+    //! False, the files are discovered on demand.
+    virtual Bool isIndexable() const override;
+
 protected:
 
     struct AssetToken
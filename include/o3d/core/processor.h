@@ -48,6 +48,27 @@ public:
 	//! Has SSE4_2 support
     Bool hasSSE4_2() const { return m_has_sse4_2; }
 
+	//! Has AVX support, including the OS support of the YMM registers
+    Bool hasAVX() const { return m_has_avx; }
+
+	//! Has AVX2 support
+    Bool hasAVX2() const { return m_has_avx2; }
+
+	//! Has FMA3 support
+    Bool hasFMA() const { return m_has_fma; }
+
+	//! Has F16C (half float conversions) support
+    Bool hasF16C() const { return m_has_f16c; }
+
+	//! Has AVX-512 foundation support, including the OS support of the ZMM registers
+    Bool hasAVX512F() const { return m_has_avx512f; }
+
+	//! Has AVX-512 byte and word support
+    Bool hasAVX512BW() const { return m_has_avx512bw; }
+
+	//! Has AVX-512 vector length (128 and 256 bits) support
+    Bool hasAVX512VL() const { return m_has_avx512vl; }
+
 	//! Has MMX support
     Bool hasMMX() const { return m_has_mmx; }
 
@@ -114,6 +135,13 @@ private:
     Bool m_has_ssse3;
     Bool m_has_sse4_1;
     Bool m_has_sse4_2;
+    Bool m_has_avx;
+    Bool m_has_avx2;
+    Bool m_has_fma;
+    Bool m_has_f16c;
+    Bool m_has_avx512f;
+    Bool m_has_avx512bw;
+    Bool m_has_avx512vl;
     Bool m_is_htt;
 
     Int32 m_stepping;
@@ -0,0 +1,75 @@
+/**
+ * @file refcounter.h
+ * @brief Reference counter policies.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_REFCOUNTER_H
+#define _O3D_REFCOUNTER_H
+
+#include "base.h"
+
+#include <atomic>
+
+namespace o3d {
+
+/**
+ * @brief Thread-safe reference counter, the default policy of the smart containers.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The default constructor is trivial, so it can be part of a raw allocation and
+ * initialized by reset().
+ */
+class AtomicRefCounter
+{
+public:
+
+    AtomicRefCounter() = default;
+    explicit AtomicRefCounter(Int32 value) : m_value(value) {}
+
+    //! Set the value, when nothing else can access the counter.
+    inline void reset(Int32 value) { m_value.store(value, std::memory_order_relaxed); }
+
+    //! Get the current value.
+    inline Int32 get() const { return m_value.load(std::memory_order_relaxed); }
+
+    //! Increment and return the new value.
+    inline Int32 increment() { return m_value.fetch_add(1, std::memory_order_relaxed) + 1; }
+
+    //! Decrement and return the new value. The release of the last reference sees all
+    //! the previous accesses done through the others references.
+    inline Int32 decrement() { return m_value.fetch_sub(1, std::memory_order_acq_rel) - 1; }
+
+private:
+
+    std::atomic<Int32> m_value;
+};
+
+/**
+ * @brief Non thread-safe reference counter, for the single-threaded hot paths.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ */
+class LocalRefCounter
+{
+public:
+
+    LocalRefCounter() = default;
+    explicit LocalRefCounter(Int32 value) : m_value(value) {}
+
+    inline void reset(Int32 value) { m_value = value; }
+    inline Int32 get() const { return m_value; }
+    inline Int32 increment() { return ++m_value; }
+    inline Int32 decrement() { return --m_value; }
+
+private:
+
+    Int32 m_value;
+};
+
+} // namespace o3d
+
+#endif // _O3D_REFCOUNTER_H
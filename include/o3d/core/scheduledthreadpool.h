@@ -12,15 +12,24 @@
 
 #include "threadfactory.h"
 
+#include <atomic>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
 namespace o3d {
 
 /**
  * @brief ScheduledRunnable
  * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
  * @date 2013-11-28
+ * The timestamp and the delay are protected by the mutex of the pool, the cancel and
+ * done states are atomic.
  */
 class O3D_API ScheduledRunnable : public Runnable
 {
+    friend class ScheduledThreadPool;
+
 public:
 
     ScheduledRunnable();
@@ -49,6 +58,12 @@ public:
      */
     Int64 getDelay() const;
 
+    /**
+     * @brief getId
+     * @return Unique identifier given by the pool, or 0.
+     */
+    UInt64 getId() const;
+
     /**
      * @brief cancel Cancel.
      */
@@ -70,24 +85,33 @@ public:
 
 private:
 
-    FastMutex m_mutex;
-
     Int64 m_delay;
 
-    Bool m_running;
-    Bool m_cancel;
-    Bool m_done;
+    std::atomic<Bool> m_cancel;
+    std::atomic<Bool> m_done;
 
     Runnable *m_runnable;
 
     Int64 m_timestamp; //!< When the task must be performed
+
+    UInt64 m_id;       //!< Identifier into the pool
+
+    // intrusive link into a slot of the timing wheel or into the due list
+    ScheduledRunnable *m_prev;
+    ScheduledRunnable *m_next;
+    void *m_list;      //!< Owning list, null when picked or running
+    UInt64 m_expires;  //!< Expiration tick
 };
 
 /**
  * @brief ScheduledThreadPool
  * Manage a pool of a limited number of thread, and a list of Runnable object
  * to process at regular interval of time.
- * @note Works with a microseconds precision.
+ * Pending tasks are stored into a hierarchical timing wheel, giving an O(1) insertion
+ * and cancellation. At each tick the due tasks are moved in a single pass to the due
+ * list, and the workers take them by batch.
+ * @note Works with a tick precision, one millisecond by default. A timestamp is
+ * rounded up to the next tick.
  * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
  * @date 2013-11-27
  */
@@ -99,8 +123,9 @@ public:
      * @brief ScheduledThreadPool
      * @param numThread Parallels running threads
      * @param threadFactory A specifi thread factory, or use a default in null.
+     * @param tickResolution Duration of a tick of the timing wheel, in microseconds.
      */
-    ScheduledThreadPool(UInt32 numThread, ThreadFactory *threadFactory = nullptr);
+    ScheduledThreadPool(UInt32 numThread, ThreadFactory *threadFactory = nullptr, UInt32 tickResolution = 1000);
 
     virtual ~ScheduledThreadPool();
 
@@ -109,12 +134,24 @@ public:
      * @param runnable If run returns <0 the task is canceled
      * @param initialDelay Delay before the first execution
      * @param delay Delay between each execution
+     * @return The identifier of the task, for cancel.
      */
-    void schedule(Runnable *runnable,
+    UInt64 schedule(Runnable *runnable,
             Int32 initialDelay,
             Int32 delay,
             TimeUnit unit = TIME_MILLISECOND);
 
+    /**
+     * @brief cancel Cancel a scheduled task. A pending task is deleted immediately, and
+     * a running one once its current run is done.
+     * @param id Identifier returned by schedule.
+     * @return True if the task was found.
+     */
+    Bool cancel(UInt64 id);
+
+    //! Get the number of scheduled tasks (pending, due, and running).
+    UInt32 getNumTasks() const;
+
     //! Set as daemon. If true, thread are not terminated at destructor.
     void setDaemon(Bool daemon);
 
@@ -129,6 +166,10 @@ public:
 
     ScheduledRunnable *getNextTask();
 
+    //! Take up to maxTasks due tasks at once.
+    //! @return The number of tasks appended to tasks.
+    UInt32 getNextTasks(std::vector<ScheduledRunnable*> &tasks, UInt32 maxTasks);
+
     //! Wait for new task signal.
     void waitForNewTask();
 
@@ -138,6 +179,9 @@ public:
     //! Reinject a task for a further execution.
     void put(ScheduledRunnable *task);
 
+    //! Reinject, or delete if canceled, a batch of executed tasks.
+    void put(std::vector<ScheduledRunnable*> &tasks);
+
     //! Is threads running
     Bool isRunning() const;
 
@@ -156,34 +200,67 @@ private:
 
     private:
 
-        FastMutex m_mutex;
-
         ScheduledThreadPool *m_pool;
-        ScheduledRunnable *m_task;
+        std::vector<ScheduledRunnable*> m_tasks;
     };
 
-    RecursiveMutex m_mutex;
+    //! Intrusive list of tasks.
+    struct TaskList
+    {
+        ScheduledRunnable *head;
+        ScheduledRunnable *tail;
+    };
+
+    enum Wheel
+    {
+        WHEEL_BITS = 8,
+        WHEEL_SIZE = 1 << WHEEL_BITS,
+        WHEEL_MASK = WHEEL_SIZE - 1,
+        WHEEL_LEVELS = 4     //!< 2^32 ticks, about 49 days at one millisecond
+    };
+
+    mutable RecursiveMutex m_mutex;
     Semaphore m_waitingTask;
 
     Bool m_daemon;
     Bool m_running;
     Bool m_terminate;
 
-    typedef std::list<ScheduledRunnable*> T_ScheduledRunnableList;
-    typedef T_ScheduledRunnableList::iterator IT_ScheduledRunnableList;
-    typedef T_ScheduledRunnableList::const_iterator CIT_ScheduledRunnableList;
+    Int64 m_startTime;        //!< Time in microseconds of the tick 0
+    UInt32 m_tickResolution;  //!< Duration of a tick in microseconds
+    UInt64 m_currentTick;     //!< Last processed tick
+
+    TaskList m_wheel[WHEEL_LEVELS][WHEEL_SIZE];
+    UInt32 m_numPending;      //!< Number of tasks into the wheel
+
+    TaskList m_dueTasks;      //!< Due tasks, waiting for a worker
+    UInt32 m_numDue;
 
-    T_ScheduledRunnableList m_pendingTasks;
-    T_ScheduledRunnableList m_pickedTasks;
+    UInt64 m_nextId;
+
+    typedef std::unordered_map<UInt64, ScheduledRunnable*> T_TaskMap;
+    typedef T_TaskMap::iterator IT_TaskMap;
+
+    T_TaskMap m_tasks;        //!< All the tasks by identifier
 
     typedef std::list<Thread*> T_ThreadList;
     typedef T_ThreadList::iterator IT_ThreadList;
     typedef T_ThreadList::const_iterator CIT_ThreadList;
 
     T_ThreadList m_threads;
+
+    UInt64 timestampToTick(Int64 timestamp) const;
+
+    void insert(ScheduledRunnable *task);
+    void advance(UInt64 tick);
+
+    void clearTasks();
+    void releaseTask(ScheduledRunnable *task);
+
+    static void pushBack(TaskList &list, ScheduledRunnable *task);
+    void unlink(ScheduledRunnable *task);
 };
 
 } // namespace o3d
 
 #endif // _O3D_SCHEDULEDTHREADPOOL_H
-
@@ -12,6 +12,10 @@
 
 #include "base.h"
 #include "memorydbg.h"
+#include "refcounter.h"
+
+#include <type_traits>
+#include <cstddef>
 
 namespace o3d {
 
@@ -20,15 +24,19 @@ class OutStream;
 
 /**
  * @class SmartArray Fixed size array with reference counter and auto-destruction.
+ * The reference counter is atomic by default, so distinct SmartArray sharing the same
+ * data can be used by distinct threads. LocalRefCounter can be given for the single
+ * threaded hot paths. For trivial types the counter and the data are in a single
+ * allocation, the counter being in its header.
  */
-template<class T>
+template<class T, class C = AtomicRefCounter>
 class O3D_API_TEMPLATE SmartArray
 {
 public:
 
 	//! default constructor.
 	SmartArray() :
-        m_counter(nullptr),
+        m_header(nullptr),
 		m_size(0),
         m_data(nullptr)
 	{
@@ -36,23 +44,20 @@ public:
 
 	//! initialization constructor.
     SmartArray(Int32 size) :
-        m_counter(nullptr),
-		m_size(size)
+        m_header(nullptr),
+		m_size(size),
+        m_data(nullptr)
 	{
         //O3D_ASSERT(size);
-
-        m_counter = new Int32;
-		(*m_counter) = 1;
-
-        m_data = new T[m_size];
+        create(size);
 	}
 
 	//! copy constructor
 	SmartArray(const SmartArray &dup) :
+        m_header(dup.m_header),
 		m_size(dup.m_size),
 		m_data(dup.m_data)
 	{
-		m_counter = dup.m_counter;
 		useIt();
 	}
 
@@ -62,47 +67,56 @@ public:
 	//! @param own If true this smart object will own it, in other case it simply duplicate it.
 	//! @note If own if true, the given data ptr should be previously allocated using a new [].
     SmartArray(T *data, Int32 size, Bool own) :
-        m_counter(nullptr),
-		m_size(size)
+        m_header(nullptr),
+		m_size(size),
+        m_data(nullptr)
 	{
 		O3D_ASSERT(data && size);
 
-        m_counter = new Int32;
-		(*m_counter) = 1;
-
         if (!own) {
-            m_data = new T[m_size];
+            create(m_size);
 			memcpy(m_data, data, m_size * sizeof(T));
         } else {
+            createHeader(data);
 			m_data = data;
         }
 	}
 
+	//! Initialization constructor from data owned by another object.
+	//! @param data Array to refer, without copy.
+	//! @param size Number of element of data.
+	//! @param releaser Function called with owner when the array is no longer used.
+	//! @param owner Owner of data.
+    SmartArray(T *data, Int32 size, void (*releaser)(void*), void *owner) :
+        m_header(nullptr),
+		m_size(size),
+        m_data(data)
+	{
+		O3D_ASSERT(data && size && releaser);
+
+        createHeader(nullptr);
+        m_header->releaser = releaser;
+        m_header->owner = owner;
+	}
+
 	//! Initialization constructor from const data.
 	//! @param data Const array to duplicate.
 	//! @param size Number of element of data.
     SmartArray(const T *data, Int32 size) :
-        m_counter(nullptr),
-		m_size(size)
+        m_header(nullptr),
+		m_size(size),
+        m_data(nullptr)
 	{
 		O3D_ASSERT(data && size);
 
-        m_counter = new Int32;
-		(*m_counter) = 1;
-
-        m_data = new T[m_size];
+        create(m_size);
 		memcpy(m_data, data, m_size * sizeof(T));
 	}
 
 	//! Destructor.
 	~SmartArray()
 	{
-		releaseIt();
-
-        if (noLongerUsed()) {
-			deleteArray(m_data);
-			deletePtr(m_counter);
-		}
+        release();
 	}
 
 	//! Affectation.
@@ -110,22 +124,13 @@ public:
 	{
 		// Check if it's the same data
         if (m_data != ptr.m_data) {
-            if (m_data) {
-				// If not, release the old pointer
-				releaseIt();
-
-                if (noLongerUsed()) {
-                    deleteArray(m_data);
-					deletePtr(m_counter);
-
-					m_size = 0;
-				}
-			}
+            // If not, release the old pointer
+            release();
 
 			m_data = ptr.m_data;
 			m_size = ptr.m_size;
 
-			m_counter = ptr.m_counter;
+			m_header = ptr.m_header;
 			useIt();
 		}
 		return *this;
@@ -150,13 +155,13 @@ public:
 	inline const T* getData() const { return m_data; }
 
 	//! Get reference counter value.
-    inline Int32 getReferenceCounter() const { return (*m_counter); }
+    inline Int32 getReferenceCounter() const { return m_header ? m_header->counter.get() : 0; }
 
 	//! Return true if counter value is 0. If the object is totally released.
     inline Bool noLongerUsed() const
 	{
-        if (m_counter) {
-			return ((*m_counter) == 0);
+        if (m_header) {
+			return (m_header->counter.get() == 0);
         } else {
             return True;
         }
@@ -187,21 +192,7 @@ public:
             return False;
         }
 
-		releaseIt();
-
-        if (noLongerUsed()) {
-            deleteArray(m_data);
-			deletePtr(m_counter);
-
-			m_size = 0;
-            return True;
-		}
-
-        m_data = nullptr;
-        m_counter = nullptr;
-		m_size = 0;
-
-        return False;
+        return release();
 	}
 
 	//! Allocate the data array of the given size.
@@ -209,10 +200,7 @@ public:
 	{
 		releaseCheckAndDelete();
 
-        m_counter = new Int32;
-		(*m_counter) = 1;
-
-        m_data = new T[size];
+        create(size);
 		m_size = size;
 	}
 
@@ -221,26 +209,92 @@ public:
 
 protected:
 
-    Int32 *m_counter;  //!< Reference counter.
+    //! Shared header, followed by the data for trivial types.
+    struct Header
+    {
+        C counter;     //!< Reference counter.
+        T *external;   //!< Data allocated apart, or null if it follows the header.
+
+        void (*releaser)(void*);  //!< Release function of a data owned by another object.
+        void *owner;              //!< Owner given to the release function.
+    };
+
+    //! Data in the same allocation as the header.
+    static const Bool INLINE_DATA =
+            std::is_trivially_default_constructible<T>::value &&
+            std::is_trivially_destructible<T>::value &&
+            alignof(T) <= alignof(std::max_align_t);
+
+    //! Offset of the data after the header.
+    static const size_t DATA_OFFSET = (sizeof(Header) + alignof(T) - 1) & ~(alignof(T) - 1);
+
+    Header *m_header;  //!< Reference counter and data owner.
 
-    Int32 m_size;     //!< Size of the array.
+    Int32 m_size;      //!< Size of the array.
     T *m_data;         //!< Array data.
 
+    //! Create the header and the data for a new array.
+    inline void create(Int32 size)
+    {
+        if (INLINE_DATA) {
+            UInt8 *block = (UInt8*)O3D_MALLOC(DATA_OFFSET + size * sizeof(T));
+
+            m_header = (Header*)block;
+            m_header->counter.reset(1);
+            m_header->external = nullptr;
+            m_header->releaser = nullptr;
+
+            m_data = (T*)(block + DATA_OFFSET);
+        } else {
+            m_data = new T[size];
+            createHeader(m_data);
+        }
+    }
+
+    //! Create a header alone for an external data.
+    inline void createHeader(T *external)
+    {
+        m_header = (Header*)O3D_MALLOC(sizeof(Header));
+        m_header->counter.reset(1);
+        m_header->external = external;
+        m_header->releaser = nullptr;
+    }
+
 	//! Use object.
 	inline void useIt()
 	{
-        if (m_counter) {
-			(*m_counter)++;
+        if (m_header) {
+			m_header->counter.increment();
         }
 	}
 
-	//! Release object.
-	inline void releaseIt()
+	//! Release object, and delete it if no longer used.
+	//! @return True if deleted.
+	inline Bool release()
 	{
-        if (m_counter) {
-			(*m_counter)--;
-			O3D_ASSERT((*m_counter) >=0);
+        Bool deleted = False;
+
+        if (m_header) {
+			const Int32 counter = m_header->counter.decrement();
+			O3D_ASSERT(counter >= 0);
+
+            if (counter == 0) {
+                if (m_header->external) {
+                    deleteArray(m_header->external);
+                } else if (m_header->releaser) {
+                    m_header->releaser(m_header->owner);
+                }
+
+                O3D_FREE(m_header);
+                deleted = True;
+            }
 		}
+
+        m_header = nullptr;
+        m_data = nullptr;
+        m_size = 0;
+
+        return deleted;
 	}
 };
 
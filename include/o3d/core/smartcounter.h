@@ -12,6 +12,7 @@
 
 #include "base.h"
 #include "memorydbg.h"
+#include "refcounter.h"
 
 namespace o3d {
 
@@ -22,8 +23,10 @@ namespace o3d {
  * A smart counter is used to known if an object is actually in use or not. UseIt add
  * an user, and release it, remove an user of the object. If the counter is equal to
  * zero the object can be deleted.
+ * The counter is atomic by default, and LocalRefCounter can be given for objects that
+ * are never shared between threads.
  */
-template <class T>
+template <class T, class C = AtomicRefCounter>
 class O3D_API_TEMPLATE SmartCounter
 {
 public:
@@ -47,17 +50,20 @@ public:
 	//! Virtual destructor.
 	virtual ~SmartCounter() {}
 
-	//! use object/release object
-	inline void useIt() { m_counter++; }
-	inline void releaseIt() { m_counter--; O3D_ASSERT(m_counter >= 0); }
+	//! use object
+	inline void useIt() { m_counter.increment(); }
+	//! release object and return the new counter value
+	inline Int32 releaseIt() { const Int32 counter = m_counter.decrement(); O3D_ASSERT(counter >= 0); return counter; }
 
 	//! get counter value
-	inline Int32 getReferenceCounter() const { return m_counter; }
+	inline Int32 getReferenceCounter() const { return m_counter.get(); }
 
 	//! return true if counter value is 0. If the object is totally released
-	inline Bool noLongerUsed() const { return (m_counter == 0); }
+	inline Bool noLongerUsed() const { return (m_counter.get() == 0); }
 	//! return true if it can be deleted
-	inline Bool canRemove() const { return ((m_counter <= 1 && m_id != -1) || (m_counter == 0 && m_id == -1)); }
+	inline Bool canRemove() const { return canRemove(m_counter.get()); }
+	//! return true if it can be deleted given the counter value returned by releaseIt
+	inline Bool canRemove(Int32 counter) const { return ((counter <= 1 && m_id != -1) || (counter == 0 && m_id == -1)); }
 	//! is it owned by a manager
 	inline Bool isOwned() const { return (m_id != -1); }
 
@@ -69,21 +75,20 @@ public:
 	//! Delete the object
 	virtual Bool deleteIt()
 	{
-		deletePtr(const_cast<SmartCounter<T>*>(this));
+		deletePtr(const_cast<SmartCounter<T, C>*>(this));
 		return True;
 	}
 
 	//! Release, next, check if the object is totally release,
 	//! and finally delete it if it is no longer used.
-	template<class U>
-	static Bool checkAndDelete(SmartCounter<U> *pCounter)
+	template<class U, class D>
+	static Bool checkAndDelete(SmartCounter<U, D> *pCounter)
 	{
         if (pCounter == nullptr)
 			return False;
 
-		pCounter->releaseIt();
-
-		if (pCounter->canRemove())
+		// decide on the released value, the counter can be changed by another thread
+		if (pCounter->canRemove(pCounter->releaseIt()))
 			return pCounter->deleteIt();
 
 		return False;
@@ -91,7 +96,7 @@ public:
 
 protected:
 
-	Int32 m_counter;               //!< Usages counter
+	C m_counter;                   //!< Usages counter
 	Int32 m_id;                    //!< Object unique identifier
 };
 
@@ -20,6 +20,8 @@ namespace o3d {
  * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
  * @date 2005-07-31
  * Pointer manager with counter and auto-destruction for SmartCounter inherited data.
+ * Distinct SmartPtr on the same object can be used by distinct threads when its counter
+ * is atomic, but a same SmartPtr must not be modified concurrently.
  */
 template<class T>
 class O3D_API_TEMPLATE SmartPtr
@@ -112,9 +114,7 @@ public:
 			return False;
         }
 
-		m_pData->releaseIt();
-
-        if (m_pData->canRemove()) {
+        if (release(m_pData, 0)) {
 			m_pData->deleteIt();
 			return True;
 		}
@@ -131,6 +131,21 @@ public:
 private:
 
     T *m_pData;  //!< data pointer (must inherit from SmartCounter)
+
+    //! Release when releaseIt returns the counter value (SmartCounter), deciding on it.
+    template<class U>
+    static auto release(U *pData, int) -> decltype(pData->releaseIt() + 0, Bool())
+    {
+        return pData->canRemove(pData->releaseIt());
+    }
+
+    //! Release for the objects managing their own counter.
+    template<class U>
+    static Bool release(U *pData, long)
+    {
+        pData->releaseIt();
+        return pData->canRemove();
+    }
 };
 
 
@@ -0,0 +1,135 @@
+/**
+ * @file sparsematrix.h
+ * @brief Compressed sparse row matrix and iterative solvers.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_SPARSEMATRIX_H
+#define _O3D_SPARSEMATRIX_H
+
+#include "base.h"
+#include "memorydbg.h"
+#include "vectornd.h"
+
+#include <vector>
+
+namespace o3d {
+
+class MatrixNxP;
+
+/**
+ * @brief Sparse matrix in compressed sparse row (CSR) format, with a matrix-vector
+ * product and the usual solvers for large systems (constraints, IK, deformations).
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The non zero entries of the row i are columns[k] and values[k] for k from
+ * rowOffsets[i] to rowOffsets[i+1]-1, sorted by column.
+ * A copy of the entries sliced by 8 rows, stored column by column and padded to the
+ * longest row of the slice, is kept for the product. It is computed with SSE2 or AVX2
+ * gathers when available, selected at runtime through CpuDispatch.
+ */
+class O3D_API SparseMatrix
+{
+public:
+
+    //! An entry of the matrix, for the construction.
+    struct Entry
+    {
+        UInt32 row;
+        UInt32 col;
+        Float value;
+    };
+
+    //! Empty matrix.
+    SparseMatrix();
+
+    //! Build from a list of entries in any order, the duplicates are summed.
+    SparseMatrix(UInt32 rows, UInt32 cols, const std::vector<Entry> &entries);
+
+    //! Build from a dense matrix, keeping the entries greater than threshold in
+    //! absolute value.
+    explicit SparseMatrix(const MatrixNxP &mat, Float threshold = 0.f);
+
+    //! (Re)build from a list of entries in any order, the duplicates are summed.
+    void build(UInt32 rows, UInt32 cols, const std::vector<Entry> &entries);
+
+    //! Number of rows.
+    inline UInt32 getNbrRows() const { return m_rows; }
+    //! Number of columns.
+    inline UInt32 getNbrCols() const { return m_cols; }
+    //! Number of stored entries.
+    inline UInt32 getNumNonZeros() const { return (UInt32)m_values.size(); }
+
+    //! Offset of the first entry of each row, plus the total at the end.
+    inline const UInt32* getRowOffsets() const { return m_rowOffsets.data(); }
+    //! Column of each entry.
+    inline const UInt32* getColumns() const { return m_columns.data(); }
+    //! Value of each entry.
+    inline const Float* getValues() const { return m_values.data(); }
+
+    //! Return an entry, 0 if it is not stored (binary search in the row).
+    Float getData(UInt32 i, UInt32 j) const;
+
+    //! y = M * x, with x of getNbrCols() and y of getNbrRows() elements.
+    void multiply(const Float *x, Float *y) const;
+
+    //! Product vector = matrix * vector.
+    VectorND operator* (const VectorND &vec) const;
+
+    //! One Gauss-Seidel iteration for M*x = b, like MatrixNxP::gaussSeidelStep().
+    void gaussSeidelStep(VectorND &x, const VectorND &b) const;
+
+    //! Solve M*x = b for a symmetric positive definite matrix with the conjugate
+    //! gradient, preconditioned by the inverse of the diagonal (Jacobi).
+    //! @param x Initial guess and result.
+    //! @param tolerance Stop when |b - M*x| <= tolerance * |b|.
+    //! @param residual If not null receives the final relative residual.
+    //! @return The number of iterations.
+    UInt32 solveConjugateGradient(
+            const VectorND &b,
+            VectorND &x,
+            UInt32 maxIterations,
+            Float tolerance,
+            Float *residual = nullptr) const;
+
+    //! Solve the boxed linear complementarity problem of the constraint solvers with
+    //! a projected Gauss-Seidel : lo <= x <= hi and w = M*x - b, with w = 0 where
+    //! x is strictly inside, w >= 0 where x = lo and w <= 0 where x = hi.
+    //! The diagonal must be positive.
+    //! @param x Initial guess (warm start) and result.
+    //! @param tolerance Stop when no component changes by more than tolerance times
+    //! the greatest of 1 and the largest component of x.
+    //! @param relaxation Successive over relaxation factor, from 1 to less than 2.
+    //! @return The number of iterations.
+    UInt32 solveProjectedGaussSeidel(
+            const VectorND &b,
+            VectorND &x,
+            const VectorND &lo,
+            const VectorND &hi,
+            UInt32 maxIterations,
+            Float tolerance,
+            Float relaxation = 1.f) const;
+
+private:
+
+    UInt32 m_rows;
+    UInt32 m_cols;
+
+    std::vector<UInt32> m_rowOffsets;
+    std::vector<UInt32> m_columns;
+    std::vector<Float> m_values;
+    std::vector<UInt32> m_diagonal;      //!< Entry of the diagonal of each row, or ~0.
+
+    std::vector<UInt32> m_sliceOffsets;  //!< First entry of each slice of 8 rows, plus the total.
+    std::vector<UInt32> m_sliceColumns;  //!< 8 columns for each step of a slice.
+    std::vector<Float> m_sliceValues;    //!< 8 values for each step of a slice.
+
+    void buildSlices();
+};
+
+} // namespace o3d
+
+#endif // _O3D_SPARSEMATRIX_H
@@ -35,11 +35,16 @@ public:
 	virtual ~Task();
 
 	//! Force to kill the task.
+	//! @note A task processed by the worker pool can only be canceled if it is not
+	//! started yet, otherwise this method wait for its end.
 	void kill();
 
 	//! Wait the task to finish.
 	void waitFinish();
 
+	//! Is the task is processed by the worker pool or by its own thread.
+	inline Bool isPooled() const { return m_pooled; }
+
 	//! Is the task was perform.
 	inline Bool isExecuted() const { return m_executed; }
 
@@ -81,7 +86,9 @@ public:
 protected:
 
 	//! Start the task. The task manager start the task by this way.
-	//! @param asynchronous If TRUE the task is executed asynchronously.
+	//! @param asynchronous If TRUE the task is executed asynchronously, into the
+	//! worker pool, or into its own thread when a specific priority or CPU affinity
+	//! is defined.
 	void start(Bool asynchronous);
 
 	//! Main.
@@ -95,6 +102,15 @@ protected:
 
 	Thread m_thread;      //!< Thread of the task if threaded.
 	Bool m_executed;  //!< TRUE when execution was perform.
+
+	Bool m_pooled;    //!< TRUE when processed by the worker pool.
+	Bool m_running;   //!< TRUE while queued or running into the worker pool.
+
+	FastMutex m_runMutex;       //!< Protect m_running.
+	WaitCondition m_runCond;    //!< Signaled when a pooled task is done.
+
+	//! Mark a pooled task as done and wake up any waiting thread.
+	void releasePooled();
 };
 
 } // namespace o3d
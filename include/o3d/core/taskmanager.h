@@ -20,6 +20,9 @@ namespace o3d {
 //! @class TaskManager
 //-------------------------------------------------------------------------------------
 //! Manage asynchronous task.
+//! Asynchronous tasks are dispatched into the shared WorkerPool, excepted those with a
+//! specific thread priority or CPU affinity that are run into their own thread.
+//! The finalize of the tasks is always synchronized with the main thread.
 //---------------------------------------------------------------------------------------
 class O3D_API TaskManager : public EvtHandler
 {
@@ -35,7 +38,9 @@ public:
 	//! @param task The task to process.
 	void addTask(Task *task);
 
-	//! Define the number of maximum simultaneous running tasks.
+	//! Define the number of maximum simultaneous running tasks. A task is counted
+	//! from its start until its finalize. Default is twice the number of workers
+	//! of the WorkerPool, and 5 at least.
 	//! @param max If 0 task are processed immediately. If there is one or many pending task,
 	//! so they would be processed now.
 	void setNumMaxTasks(UInt32 max);
@@ -0,0 +1,339 @@
+/**
+ * @file tiledarray2d.h
+ * @brief Template 2D array stored by square tiles.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_TILEDARRAY2D_H
+#define _O3D_TILEDARRAY2D_H
+
+#include "templatearray2d.h"
+
+namespace o3d {
+
+/**
+ * @class TiledArray2D
+ * @brief Template 2D array with the same accessors as TemplateArray2D, but stored by
+ * tiles of 2^SHIFT x 2^SHIFT elements (8x8 by default).
+ * The tiles are stored row by row, and the elements of a tile row by row, such as a 2D
+ * neighbourhood lies in a few cache lines whatever the direction it is walked. This
+ * suits the heightmap and lightmap processing walking along arbitrary directions,
+ * where the row major storage touches a new cache line at each row.
+ * The size is padded to a multiple of the tile size. Use the row and column iterators
+ * or getTile() for the sequential accesses, rather than operator ().
+ */
+template <class T, Int32 SHIFT = 3>
+class O3D_API_TEMPLATE TiledArray2D
+{
+public:
+
+    enum {
+        TILE_SIZE = 1 << SHIFT,                //!< Width and height of a tile.
+        TILE_MASK = TILE_SIZE - 1,
+        TILE_ELT = TILE_SIZE * TILE_SIZE       //!< Number of elements of a tile.
+    };
+
+    /**
+     * @brief Iterator along a row or a column, crossing the tiles.
+     */
+    template <class P>
+    class LineIterator
+    {
+    public:
+
+        LineIterator(P *ptr, Int32 pos, Int32 innerStep, Int32 outerStep) :
+            m_ptr(ptr),
+            m_pos(pos),
+            m_innerStep(innerStep),
+            m_outerStep(outerStep)
+        {
+        }
+
+        inline P& operator* () const { return *m_ptr; }
+        inline P* operator-> () const { return m_ptr; }
+
+        //! Next element, jumping to the next tile at its border.
+        inline LineIterator& operator++ ()
+        {
+            ++m_pos;
+            m_ptr += (m_pos & TILE_MASK) ? m_innerStep : m_outerStep;
+            return *this;
+        }
+
+        //! Position along the line (i for a row, j for a column).
+        inline Int32 pos() const { return m_pos; }
+
+        inline Bool operator!= (const LineIterator &it) const { return m_pos != it.m_pos; }
+        inline Bool operator== (const LineIterator &it) const { return m_pos == it.m_pos; }
+
+    private:
+
+        P *m_ptr;
+        Int32 m_pos;
+        Int32 m_innerStep;
+        Int32 m_outerStep;
+    };
+
+    typedef LineIterator<T> LineIt;
+    typedef LineIterator<const T> ConstLineIt;
+
+    explicit TiledArray2D(Int32 width = 0, Int32 height = 0, const T &value = T());
+
+    //! Construct from a row major array.
+    explicit TiledArray2D(const TemplateArray2D<T> &array);
+
+    TiledArray2D(const TiledArray2D<T, SHIFT> &which);
+
+    ~TiledArray2D();
+
+    TiledArray2D<T, SHIFT>& operator= (const TiledArray2D<T, SHIFT> &which);
+
+    //! Delete the memory allocated by the object.
+    void destroy();
+
+    //! Resize, the content is lost when the size changes.
+    void setSize(Int32 w, Int32 h);
+
+    inline T& operator() (Int32 i, Int32 j) { return m_pData[index(i, j)]; }
+    inline const T& operator() (Int32 i, Int32 j) const { return m_pData[index(i, j)]; }
+
+    inline Int32 width() const { return m_width; }
+    inline Int32 height() const { return m_height; }
+    inline Int32 elt() const { return m_width * m_height; }
+    inline Bool isEmpty() const { return ((m_width == 0) || (m_height == 0)); }
+
+    //! Number of tiles along x.
+    inline Int32 numTilesX() const { return m_tilesX; }
+    //! Number of tiles along y.
+    inline Int32 numTilesY() const { return m_tilesY; }
+
+    //! Elements of the tile (tx,ty), TILE_ELT contiguous elements stored row by row.
+    //! The tiles of the right and bottom borders can contain padding elements.
+    inline T* getTile(Int32 tx, Int32 ty) { return m_pData + (tx + ty * m_tilesX) * TILE_ELT; }
+    inline const T* getTile(Int32 tx, Int32 ty) const { return m_pData + (tx + ty * m_tilesX) * TILE_ELT; }
+
+    //! The whole storage, numTilesX() * numTilesY() tiles.
+    inline T* getData() { return m_pData; }
+    inline const T* getData() const { return m_pData; }
+
+    //! Position in the storage of the element (i,j).
+    inline Int32 index(Int32 i, Int32 j) const
+    {
+    #ifdef O3DARRAY2D_INDEX_DEBUBBING
+        O3D_ASSERT((i >= 0) && (i < m_width));
+        O3D_ASSERT((j >= 0) && (j < m_height));
+    #endif
+
+        return (((j >> SHIFT) * m_tilesX + (i >> SHIFT)) << (2 * SHIFT)) + ((j & TILE_MASK) << SHIFT) + (i & TILE_MASK);
+    }
+
+    //! Iterator on the row j, starting at the column i.
+    inline LineIt rowBegin(Int32 j, Int32 i = 0) { return LineIt(m_pData + index(i, j), i, 1, TILE_ELT - TILE_MASK); }
+    //! End of the row j.
+    inline LineIt rowEnd(Int32 /*j*/) { return LineIt(nullptr, m_width, 0, 0); }
+
+    inline ConstLineIt rowBegin(Int32 j, Int32 i = 0) const { return ConstLineIt(m_pData + index(i, j), i, 1, TILE_ELT - TILE_MASK); }
+    inline ConstLineIt rowEnd(Int32 /*j*/) const { return ConstLineIt(nullptr, m_width, 0, 0); }
+
+    //! Iterator on the column i, starting at the row j.
+    inline LineIt columnBegin(Int32 i, Int32 j = 0)
+    {
+        return LineIt(m_pData + index(i, j), j, TILE_SIZE, m_tilesX * TILE_ELT - TILE_MASK * TILE_SIZE);
+    }
+    //! End of the column i.
+    inline LineIt columnEnd(Int32 /*i*/) { return LineIt(nullptr, m_height, 0, 0); }
+
+    inline ConstLineIt columnBegin(Int32 i, Int32 j = 0) const
+    {
+        return ConstLineIt(m_pData + index(i, j), j, TILE_SIZE, m_tilesX * TILE_ELT - TILE_MASK * TILE_SIZE);
+    }
+    inline ConstLineIt columnEnd(Int32 /*i*/) const { return ConstLineIt(nullptr, m_height, 0, 0); }
+
+    //! Fill all the elements, including the padding.
+    void fill(const T &which);
+
+    //! Resize and copy a row major array.
+    void fromArray2D(const TemplateArray2D<T> &array);
+
+    //! Resize and copy to a row major array.
+    void toArray2D(TemplateArray2D<T> &array) const;
+
+protected:
+
+    T *m_pData;
+
+    Int32 m_width;
+    Int32 m_height;
+
+    Int32 m_tilesX;
+    Int32 m_tilesY;
+
+    inline Int32 storageSize() const { return m_tilesX * m_tilesY * TILE_ELT; }
+};
+
+typedef TiledArray2D<UInt8> TiledArray2DUInt8;
+typedef TiledArray2D<UInt16> TiledArray2DUInt16;
+typedef TiledArray2D<Int32> TiledArray2DInt32;
+typedef TiledArray2D<Float> TiledArray2DFloat;
+
+/*---------------------------------------------------------------------------------------
+  IMPLEMENTATION : class TiledArray2D
+---------------------------------------------------------------------------------------*/
+template <class T, Int32 SHIFT>
+TiledArray2D<T, SHIFT>::TiledArray2D(Int32 width, Int32 height, const T &value) :
+    m_pData(nullptr),
+    m_width(0),
+    m_height(0),
+    m_tilesX(0),
+    m_tilesY(0)
+{
+    setSize(width, height);
+    fill(value);
+}
+
+template <class T, Int32 SHIFT>
+TiledArray2D<T, SHIFT>::TiledArray2D(const TemplateArray2D<T> &array) :
+    m_pData(nullptr),
+    m_width(0),
+    m_height(0),
+    m_tilesX(0),
+    m_tilesY(0)
+{
+    fromArray2D(array);
+}
+
+template <class T, Int32 SHIFT>
+TiledArray2D<T, SHIFT>::TiledArray2D(const TiledArray2D<T, SHIFT> &which) :
+    m_pData(nullptr),
+    m_width(0),
+    m_height(0),
+    m_tilesX(0),
+    m_tilesY(0)
+{
+    *this = which;
+}
+
+template <class T, Int32 SHIFT>
+TiledArray2D<T, SHIFT>::~TiledArray2D()
+{
+    deleteArray(m_pData);
+}
+
+template <class T, Int32 SHIFT>
+TiledArray2D<T, SHIFT>& TiledArray2D<T, SHIFT>::operator= (const TiledArray2D<T, SHIFT> &which)
+{
+    if (this != &which) {
+        setSize(which.m_width, which.m_height);
+
+        const Int32 size = storageSize();
+        for (Int32 k = 0; k < size; ++k) {
+            m_pData[k] = which.m_pData[k];
+        }
+    }
+
+    return *this;
+}
+
+template <class T, Int32 SHIFT>
+void TiledArray2D<T, SHIFT>::destroy()
+{
+    deleteArray(m_pData);
+
+    m_width = m_height = 0;
+    m_tilesX = m_tilesY = 0;
+}
+
+template <class T, Int32 SHIFT>
+void TiledArray2D<T, SHIFT>::setSize(Int32 w, Int32 h)
+{
+    if ((m_width == w) && (m_height == h)) {
+        return;
+    }
+
+    deleteArray(m_pData);
+
+    m_width = w;
+    m_height = h;
+
+    if (w * h > 0) {
+        m_tilesX = (w + TILE_MASK) >> SHIFT;
+        m_tilesY = (h + TILE_MASK) >> SHIFT;
+
+        m_pData = new T[storageSize()];
+    } else {
+        m_tilesX = m_tilesY = 0;
+    }
+}
+
+template <class T, Int32 SHIFT>
+void TiledArray2D<T, SHIFT>::fill(const T &which)
+{
+    const Int32 size = storageSize();
+    for (Int32 k = 0; k < size; ++k) {
+        m_pData[k] = which;
+    }
+}
+
+template <class T, Int32 SHIFT>
+void TiledArray2D<T, SHIFT>::fromArray2D(const TemplateArray2D<T> &array)
+{
+    setSize(array.width(), array.height());
+
+    if (isEmpty()) {
+        return;
+    }
+
+    // the padding of the border tiles repeats the last column and row
+    const T *src = array.getData();
+
+    for (Int32 ty = 0; ty < m_tilesY; ++ty) {
+        for (Int32 tx = 0; tx < m_tilesX; ++tx) {
+            T *tile = getTile(tx, ty);
+
+            for (Int32 y = 0; y < TILE_SIZE; ++y) {
+                const Int32 j = o3d::min((ty << SHIFT) + y, m_height - 1);
+                const T *row = src + j * m_width;
+
+                for (Int32 x = 0; x < TILE_SIZE; ++x) {
+                    *tile++ = row[o3d::min((tx << SHIFT) + x, m_width - 1)];
+                }
+            }
+        }
+    }
+}
+
+template <class T, Int32 SHIFT>
+void TiledArray2D<T, SHIFT>::toArray2D(TemplateArray2D<T> &array) const
+{
+    array.setSize(m_width, m_height);
+
+    if (isEmpty()) {
+        return;
+    }
+
+    T *dst = array.getData();
+
+    for (Int32 ty = 0; ty < m_tilesY; ++ty) {
+        const Int32 rows = o3d::min<Int32>(TILE_SIZE, m_height - (ty << SHIFT));
+
+        for (Int32 tx = 0; tx < m_tilesX; ++tx) {
+            const Int32 cols = o3d::min<Int32>(TILE_SIZE, m_width - (tx << SHIFT));
+            const T *tile = getTile(tx, ty);
+
+            for (Int32 y = 0; y < rows; ++y) {
+                T *row = dst + ((ty << SHIFT) + y) * m_width + (tx << SHIFT);
+
+                for (Int32 x = 0; x < cols; ++x) {
+                    row[x] = tile[(y << SHIFT) + x];
+                }
+            }
+        }
+    }
+}
+
+} // namespace o3d
+
+#endif // _O3D_TILEDARRAY2D_H
@@ -0,0 +1,80 @@
+/**
+ * @file typedpool.h
+ * @brief Thread-safe pool of objects of a given type.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_TYPEDPOOL_H
+#define _O3D_TYPEDPOOL_H
+
+#include "debug.h"
+#include "blockpooler.h"
+
+#include <utility>
+#include <new>
+
+namespace o3d {
+
+/**
+ * @brief Construct and destroy objects into a ConcurrentBlockPooler.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Objects can be created on a thread and destroyed on another one. The pool must
+ * outlive its objects, remaining objects are not destroyed with the pool, only their
+ * memory is released.
+ * @note Only for objects of type T exactly, not of a derived type.
+ */
+template <class T>
+class O3D_API_TEMPLATE TypedPool : NonCopyable<>
+{
+public:
+
+    typedef ConcurrentBlockPooler<sizeof(T), (alignof(T) > 16 ? alignof(T) : 16)> T_Pooler;
+
+    //! Default constructor.
+    //! @param numBlock Minimal number of objects of a slab.
+    TypedPool(UInt32 numBlock = 256) :
+        m_pooler(numBlock)
+    {
+    }
+
+    //! Create a new object, forwarding the arguments to its constructor.
+    template <class ...Args>
+    T* create(Args&&... args)
+    {
+        void *ptr = m_pooler.allocate();
+        if (!ptr) {
+            O3D_ERROR(E_InvalidAllocation("Typed pool is full"));
+        }
+
+        try {
+            return ::new(ptr) T(std::forward<Args>(args)...);
+        } catch (...) {
+            m_pooler.free(ptr);
+            throw;
+        }
+    }
+
+    //! Destroy an object created by this pool.
+    void destroy(T *object)
+    {
+        if (object) {
+            object->~T();
+            m_pooler.free(object);
+        }
+    }
+
+    //! Get the number of objects that can be created without a new slab.
+    inline UInt32 getCapacity() const { return m_pooler.getCapacity(); }
+
+private:
+
+    T_Pooler m_pooler;
+};
+
+} // namespace o3d
+
+#endif // _O3D_TYPEDPOOL_H
@@ -0,0 +1,101 @@
+/**
+ * @file virtualfileindex.h
+ * @brief Hashed index of the files of the mounted assets.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_VIRTUALFILEINDEX_H
+#define _O3D_VIRTUALFILEINDEX_H
+
+#include "asset.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace o3d {
+
+/**
+ * @brief Unified hashed index of the files and directories of many assets, used by
+ * the FileManager to resolve a path in constant time.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The keys are the case folded absolute paths without trailing slash. When many
+ * entries have the same key the first added one is kept, so the assets must be added
+ * in their precedence order. The parents directories of the entries are indexed as
+ * implicit directories, until the location of their asset, and each directory
+ * references its direct children for the listings.
+ */
+class O3D_API VirtualFileIndex
+{
+public:
+
+    struct Entry
+    {
+        String name;        //!< Absolute path, without trailing slash.
+        Asset *asset;       //!< Asset containing the entry.
+        Int32 index;        //!< Index into the asset, or -1 for an implicit directory.
+        FileTypes type;
+    };
+
+    typedef std::vector<Int32> T_Children;
+
+    VirtualFileIndex();
+
+    ~VirtualFileIndex();
+
+    //! Get the key of an absolute path, case folded and without trailing slash.
+    static String foldPath(const String &path);
+
+    //! Add the entries of an asset, after the ones of the previously added assets.
+    void addAsset(Asset *asset);
+
+    //! Rebuild the index from a list of assets, in precedence order. The assets
+    //! that are not indexable are ignored.
+    void rebuild(const T_AssetList &assets);
+
+    //! Remove every entry.
+    void clear();
+
+    //! Find an entry given its absolute path.
+    //! @return The entry or null if not found.
+    const Entry* find(const String &path) const;
+
+    //! Get the entries indices of the direct children of a directory.
+    //! @return The children or null if the path is not an indexed directory.
+    const T_Children* children(const String &path) const;
+
+    //! Get an entry by its index.
+    inline const Entry& getEntry(Int32 index) const { return m_entries[index]; }
+
+    //! Get the number of entries, including the implicit directories.
+    inline UInt32 getNumEntries() const { return (UInt32)m_entries.size(); }
+
+    //! Get the generation, incremented each time the index is modified. The entries
+    //! indices and the children taken before a modification are no longer valid.
+    inline UInt32 getGeneration() const { return m_generation; }
+
+private:
+
+    typedef std::unordered_map<String, Int32, std::hash<String> > T_EntryMap;
+    typedef std::unordered_map<String, T_Children, std::hash<String> > T_ChildrenMap;
+
+    std::vector<Entry> m_entries;
+
+    T_EntryMap m_entryMap;         //!< Entries by key.
+    T_ChildrenMap m_childrenMap;   //!< Children entries by directory key.
+
+    UInt32 m_generation;
+
+    //! Add an entry if its key is not already indexed, and its parents directories.
+    void add(const String &name, Asset *asset, Int32 index, FileTypes type, const String &rootKey);
+
+    VirtualFileIndex(const VirtualFileIndex &dup);
+    VirtualFileIndex& operator=(const VirtualFileIndex &dup);
+};
+
+} // namespace o3d
+
+#endif // _O3D_VIRTUALFILEINDEX_H
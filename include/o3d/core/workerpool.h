@@ -0,0 +1,117 @@
+/**
+ * @file workerpool.h
+ * @brief Persistent work-stealing pool of worker threads.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_WORKERPOOL_H
+#define _O3D_WORKERPOOL_H
+
+#include "thread.h"
+
+#include <atomic>
+#include <deque>
+#include <vector>
+
+namespace o3d {
+
+/**
+ * @brief Persistent pool of worker threads with a work-stealing scheduling.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Each worker owns a double ended queue of runnables. A worker pops from the back of
+ * its own queue (LIFO, cache friendly for nested work) and when it is empty it steals
+ * from the front of the queues of the others workers (FIFO, oldest work first).
+ * Runnables pushed from a non worker thread are distributed in round robin.
+ * The pool does not take the ownership of the runnables, and run them with a null
+ * parameter.
+ */
+class O3D_API WorkerPool
+{
+public:
+
+    //! Get the singleton instance. Created with one worker per CPU, minus the main thread.
+    static WorkerPool* instance();
+    //! Delete the singleton instance. Wait for the running runnables, pending are dropped.
+    static void destroy();
+
+    //! Create a pool with a specific number of workers.
+    //! @param numWorkers If 0 the number of worker is deduced from the number of CPU.
+    WorkerPool(UInt32 numWorkers = 0);
+
+    //! Destructor. Wait for the running runnables, pending are dropped.
+    ~WorkerPool();
+
+    //! Get the number of workers threads.
+    inline UInt32 getNumWorkers() const { return (UInt32)m_workers.size(); }
+
+    //! Get the number of pushed runnables not started yet.
+    inline UInt32 getNumPending() const { return (UInt32)m_numPending.load(); }
+
+    //! Get the worker index of the calling thread, or -1 if it is not a worker of this pool.
+    Int32 getCurrentWorker() const;
+
+    //! Push a runnable to process.
+    //! If the calling thread is a worker of this pool the runnable is pushed into its
+    //! own queue, otherwise into the next worker queue.
+    void push(Runnable *runnable);
+
+    //! Remove a runnable if it is not started yet.
+    //! @return True if the runnable was found and removed.
+    Bool cancel(Runnable *runnable);
+
+    //! Process one pending runnable from the calling thread if there is one.
+    //! Useful to help the pool while waiting for a result.
+    //! @return True if a runnable was processed.
+    Bool runPending();
+
+private:
+
+    class Worker : public Runnable
+    {
+    public:
+
+        Worker(WorkerPool *pool, UInt32 index);
+        virtual ~Worker();
+
+        virtual Int32 run(void *);
+
+        Thread m_thread;
+        FastMutex m_mutex;
+        std::deque<Runnable*> m_queue;
+
+        WorkerPool *m_pool;
+        UInt32 m_index;
+    };
+
+    std::vector<Worker*> m_workers;
+
+    FastMutex m_sleepMutex;
+    WaitCondition m_wakeUp;
+
+    std::atomic<Int32> m_numPending;   //!< Total number of queued runnables.
+    std::atomic<Int32> m_numSleeping;  //!< Number of workers waiting for work.
+    std::atomic<UInt32> m_nextWorker;  //!< Round robin for non worker threads.
+    std::atomic<Bool> m_running;
+
+    //! Pop from the back of the queue of a worker, or steal from the front of the others.
+    Runnable* pop(UInt32 index);
+
+    //! Steal from the front of any queue except the given one (-1 for any).
+    Runnable* steal(Int32 except);
+
+    //! Wait until there is some pending work or the pool is stopped.
+    void waitForWork();
+
+    static std::atomic<WorkerPool*> m_instance;
+
+    WorkerPool(const WorkerPool &dup);
+    WorkerPool& operator=(const WorkerPool &dup);
+};
+
+} // namespace o3d
+
+#endif // _O3D_WORKERPOOL_H
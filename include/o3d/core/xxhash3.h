@@ -0,0 +1,90 @@
+/**
+ * @file xxhash3.h
+ * @brief XXH3 64 and 128 bits non cryptographic hash calculation.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_XXHASH3_H
+#define _O3D_XXHASH3_H
+
+#include "memorydbg.h"
+#include "file.h"
+#include "smartarray.h"
+
+namespace o3d {
+
+/**
+ * @brief XXH3 hash computation, compatible with the xxHash 0.8 XXH3_64bits and
+ * XXH3_128bits functions (default secret, optional seed).
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * Many times faster than MD5 or SHA1, for the content keys and the changes detection
+ * of large data, but not for security usage. The stripes accumulation uses AVX2 or
+ * SSE2 when available, selected at runtime.
+ */
+class O3D_API XXH3Hash
+{
+public:
+
+    //! Default constructor, init a XXH3 for streaming using update and finalize.
+    XXH3Hash(UInt64 seed = 0);
+    //! constructor, use an array, compute and finalize.
+    XXH3Hash(const UInt8 *data, UInt32 len, UInt64 seed = 0);
+    //! constructor, use an uint8 smart array, compute and finalize.
+    XXH3Hash(const SmartArrayUInt8 &array, UInt64 seed = 0);
+    //! constructor, use an open stream, compute and finalize.
+    XXH3Hash(InStream &is, UInt64 seed = 0);
+
+    ~XXH3Hash();
+
+    //! true if update can be called.
+    inline Bool isStreaming() const { return m_privateData != nullptr; }
+
+    //! update the XXH3 checksum
+    void update(const UInt8 *data, UInt32 len);
+    //! update the XXH3 checksum
+    void update(const SmartArrayUInt8 &array);
+    //! update the XXH3 checksum, until the end of the stream
+    void update(InStream &is);
+
+    //! finalize the XXH3 checksum before get64, getRaw or getHex
+    void finalize();
+
+    //! get the 64 bits XXH3
+    inline UInt64 get64() const { return m_hash64; }
+
+    //! get the 128 bits XXH3 low part
+    inline UInt64 get128Low() const { return m_hash128[0]; }
+
+    //! get the 128 bits XXH3 high part
+    inline UInt64 get128High() const { return m_hash128[1]; }
+
+    //! get the 128 bits XXH3 in 16 bytes, big-endian canonical form
+    inline const SmartArrayUInt8& getRaw() const { return m_rawDigest; }
+
+    //! get the 128 bits XXH3 in 32+1 bytes hex
+    String getHex() const;
+
+    //! Compute the 64 bits XXH3 of a memory block.
+    static UInt64 hash64(const void *data, size_t len, UInt64 seed = 0);
+
+    //! Compute the 128 bits XXH3 of a memory block.
+    static void hash128(const void *data, size_t len, UInt64 &low, UInt64 &high, UInt64 seed = 0);
+
+protected:
+
+    UInt64 m_hash64;
+    UInt64 m_hash128[2];            //!< low and high parts
+    SmartArrayUInt8 m_rawDigest;    //!< the 128 bits result in 16 bytes array
+
+    void *m_privateData;
+
+    void setResult(UInt64 hash64, UInt64 low, UInt64 high);
+};
+
+} // namespace o3d
+
+#endif // _O3D_XXHASH3_H
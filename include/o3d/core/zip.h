@@ -15,6 +15,7 @@
 #include "string.h"
 #include "hashmap.h"
 #include "asset.h"
+#include "zipentryinstream.h"
 
 #include <vector>
 #include <list>
@@ -82,6 +83,8 @@ typedef T_ZipTokenVector::const_iterator CIT_ZipTokenVector;
  * @brief ZIP file management for decompression. You must attach a File opened
  * in reading and binary mode to Zip. Then you can get file from this archive with
  * OpenFile.
+ * The returned streams are ZipEntryInStream, inflated progressively, and distinct
+ * threads can read distinct entries at the same time.
  */
 class O3D_API Zip : public Asset
 {
@@ -89,7 +92,8 @@ public:
 
     /**
      * @brief Zip
-     * @param is An opened input stream on the zip file.
+     * @param is An opened input stream on the zip file, owned by the zip once
+     *        constructed.
      * @param zipName Zip filename
      * @param zipPath Zip path.
      */
@@ -150,7 +154,7 @@ public:
 
 protected:
 
-    InStream *m_is;          //!< the zip stream object
+    SmartPtr<ArchiveSource> m_source;  //!< the zip stream object, shared with the entries
 
 	String m_zipPathName;	 //!< absolute path of the zip file
 	String m_zipFileName;	 //!< zip file name
@@ -165,7 +169,7 @@ protected:
 
 	// internal methods
 	// read the header and return true it's not the last
-	Bool readHeader();
+	Bool readHeader(InStream &is);
 };
 
 typedef ::std::list<Zip*> T_ZipList;
@@ -0,0 +1,132 @@
+/**
+ * @file zipentryinstream.h
+ * @brief Streaming input stream on a zip archive entry.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_ZIPENTRYINSTREAM_H
+#define _O3D_ZIPENTRYINSTREAM_H
+
+#include "instream.h"
+#include "archivesource.h"
+#include "smartpointer.h"
+
+struct z_stream_s;
+
+namespace o3d {
+
+/**
+ * @brief Streaming input stream on a stored or deflated entry of a zip archive.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * The entry is inflated progressively into a small window as the data is read, and
+ * the large reads are inflated directly into the destination buffer. The compressed
+ * data is read at its position using the ArchiveSource, so many entries of the same
+ * archive can be read at the same time, each stream being used by a single thread.
+ * Seeking backward into a deflated entry restarts the inflate from its beginning.
+ */
+class O3D_API ZipEntryInStream : public InStream
+{
+public:
+
+    //! Size of the uncompressed data window.
+    static const UInt32 WINDOW_SIZE = 32768;
+
+    //! Size of the compressed data window, when the archive is not memory mapped.
+    static const UInt32 INPUT_SIZE = 16384;
+
+    /**
+     * @brief Open an entry.
+     * @param source Source of the archive.
+     * @param offset Position of the entry data into the archive.
+     * @param compressedSize Size of the entry data into the archive.
+     * @param size Uncompressed size of the entry.
+     * @param deflated True if the entry is deflated, false if it is stored.
+     */
+    ZipEntryInStream(
+            ArchiveSource *source,
+            UInt64 offset,
+            UInt32 compressedSize,
+            UInt32 size,
+            Bool deflated);
+
+    virtual ~ZipEntryInStream();
+
+    //! False
+    virtual Bool isMemory() const override;
+
+    virtual UInt32 reader(void *buf, UInt32 size, UInt32 count) override;
+
+    virtual void close() override;
+
+    virtual void reset(UInt64 n = 0) override;
+
+    virtual void seek(Int64 n) override;
+
+    virtual void end(Int64 n = 0) override;
+
+    virtual Int32 getAvailable() const override;
+
+    virtual Int32 getPosition() const override;
+
+    virtual Bool isEnd() const override;
+
+    virtual UInt8 peek() override;
+
+    virtual void ignore(Int32 limit, UInt8 delim) override;
+
+    virtual Int32 readLine(
+            String &str,
+            CharacterEncoding encoding = ENCODING_UTF8) override;
+
+    virtual Int32 readLine(
+            String &str,
+            Int32 limit,
+            UInt8 delim,
+            CharacterEncoding encoding = ENCODING_UTF8) override;
+
+    virtual Int32 readWord(
+            String &str,
+            CharacterEncoding encoding = ENCODING_UTF8) override;
+
+private:
+
+    SmartPtr<ArchiveSource> m_source;
+
+    UInt64 m_offset;           //!< Position of the entry into the archive.
+    UInt32 m_compressedSize;
+    UInt32 m_size;
+
+    z_stream_s *m_zstream;     //!< Inflate state, null for a stored entry.
+    UInt8 *m_input;            //!< Compressed data window, null if memory mapped.
+    UInt32 m_inputPos;         //!< Compressed bytes read from the source.
+
+    UInt8 *m_window;           //!< Uncompressed data window.
+    UInt32 m_windowPos;        //!< Read position into the window.
+    UInt32 m_windowSize;       //!< Size of the data into the window.
+
+    UInt32 m_pos;              //!< Read position into the entry.
+    UInt32 m_streamPos;        //!< Position of the next produced byte.
+
+    //! Produce the next uncompressed bytes.
+    UInt32 produce(UInt8 *dest, UInt32 len);
+
+    //! Refill the window, and return the number of available bytes.
+    UInt32 fillWindow();
+
+    //! Next byte, or EOF.
+    Int32 nextByte();
+
+    //! Restart from the beginning of the entry.
+    void restart();
+
+    //! Move to an absolute position.
+    void seekTo(UInt32 pos);
+};
+
+} // namespace o3d
+
+#endif // _O3D_ZIPENTRYINSTREAM_H
@@ -13,6 +13,7 @@
 #include "o3d/core/memorydbg.h"
 #include "o3d/core/radixsort.h"
 #include "o3d/core/templatearray.h"
+#include "o3d/core/framearena.h"
 
 #include "shader/shadable.h"
 #include "scene/sceneentity.h"
@@ -178,6 +179,8 @@ protected:
 		UInt32 numVertices;
 	};
 
+	typedef FrameVector<DrawSet> T_DrawSetList;
+
 	UInt32 m_numFaces;				//!< Total faces number.
 	UInt32 m_inputSize;				//!< Input faces list size.
 
@@ -192,7 +195,7 @@ protected:
 	FaceArrayUInt16 m_faceArrayUInt16;
 	FaceArrayUInt32 m_faceArrayUInt32;
 
-	std::list<DrawSet> m_processList;   //!< Final process draw list.
+	T_DrawSetList m_processList;        //!< Final process draw list, rebuilt at each sort.
 };
 
 } // namespace o3d
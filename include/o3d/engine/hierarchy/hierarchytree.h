@@ -100,6 +100,13 @@ public:
 	//! Import the tree as child of the root
     virtual Bool readFromFile(InStream &is) override;
 
+    //! Export the objects of the root for a scene snapshot, as a single sized block.
+    Bool writeSnapshot(OutStream &os);
+
+    //! Import the objects of a scene snapshot as child of the root. The block of the
+    //! objects is read at once, next the objects are imported from memory.
+    Bool readSnapshot(InStream &is);
+
 	//! get the last imported root objects list
 	inline const T_SceneObjectList& getLastImportedObjects() const { return m_lastImportedObjects; }
 
@@ -114,6 +121,9 @@ protected:
     RootNode* m_root;    //!< root of the tree
 
 	T_SceneObjectList m_lastImportedObjects;
+
+    //! Create and read an object, and add it as child of the root.
+    void importObject(InStream &is);
 };
 
 } // namespace o3d
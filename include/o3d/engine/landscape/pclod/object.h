@@ -387,9 +387,15 @@ public:
 
 	const String & getDataFileName() const { return m_dataFileName; }
 
+	/* Return the full path of the data file */
+	String getDataFullPathName() const;
+
 	/* Load the datas of the zone (must be initialized first) */
 	void load();
 
+	/* Load the datas of the zone from the content of its data file */
+	void load(InStream & _dataIs);
+
 	/* Unload all datas which are not used any more */
 	void unload();
 
@@ -13,6 +13,7 @@
 #include "o3d/core/templatearray2d.h"
 #include "o3d/core/vector2.h"
 #include "o3d/core/debug.h"
+#include "o3d/core/filereadqueue.h"
 
 #include "o3d/engine/landscape/pclod/object.h"
 #include "o3d/engine/landscape/pclod/pclodrenderer.h"
@@ -57,6 +58,8 @@ private:
 		Vector2ui zoneExtension;
 
 		SPCLODTopZone pZone;
+
+		SmartPtr<FileReadRequest> dataRequest;	//!< Pending asynchronous read of the zone data
 	};
 
 	/* Class in charge of updating the visible counter of a topzone */
@@ -134,6 +137,13 @@ private:
 	//! - Do nothing if the zone is already loaded */
 	void rtLoadZone(UInt32 _zoneId, PCLODZoneManage & _zoneInfo);
 
+	//! Create the zone from its header if it is not created yet.
+	PCLODTopZone * rtCreateZone(PCLODZoneInfo & _zoneInfo);
+
+	//! Submit the asynchronous read of the data of a zone, before its loading.
+	//! Higher priority zones are read first.
+	void rtRequestZone(UInt32 _zoneId, Int32 _priority);
+
 	//! Remove a zone. (REFRESH THREAD)
 	//! - The zone must not be visible.
 	//! - If the zone still belongs to an other object, it will be removed
@@ -24,6 +24,8 @@
 
 #include "o3d/core/memorydbg.h"
 
+#include <vector>
+
 namespace o3d {
 
 //! Define the number max of bones on a vertex
@@ -380,6 +382,9 @@ protected:
 
 	//! Compute the progressive mesh for each face arrays.
 	void computeProgressive();
+
+	//! Get the non empty triangles face arrays sorted by identifier.
+	void getSortedTriangleArrays(std::vector<FaceArray*> &faceArrays) const;
 };
 
 } // namespace o3d
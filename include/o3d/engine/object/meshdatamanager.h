@@ -21,6 +21,7 @@
 #include "o3d/core/taskmanager.h"
 
 #include <map>
+#include <vector>
 
 namespace o3d {
 
@@ -74,6 +75,15 @@ public:
 	//! Read a mesh data object from a file a returns it.
     MeshData* readMeshData(InStream &is);
 
+    //! Write a list of mesh data objects, for a further readMeshDataList.
+    void writeMeshDataList(OutStream &os, const std::vector<MeshData*> &list);
+
+    //! Read a list of mesh data objects, and load those not already existing. The files
+    //! are decoded in parallel by the worker pool, next the geometries are created and
+    //! the mesh data added in the order of the list, whatever the asynchronous mode.
+    //! @return The number of loaded mesh data.
+    UInt32 readMeshDataList(InStream &is);
+
 	//! Is a mesh data exists.
     //! @param resourceName Resource name to search for.
     Bool isMeshData(const String &resourceName);
@@ -433,6 +433,13 @@ public:
 	//! @param whatExport Define what kind of managers to export.
 	Bool exportScene(const String &sceneFilename, const SceneIO &whatExport);
 
+    //! Export the scene files like exportScene, but using the snapshot layout, imported
+    //! by importScene too. The used mesh data are listed first, to decode them in
+    //! parallel, next the objects of the root are stored as a single sized block.
+    //! @param sceneFilename Absolute filename of the scene, or relative to current working directory.
+    //! @param whatExport Define what kind of managers to export.
+    Bool exportSceneSnapshot(const String &sceneFilename, const SceneIO &whatExport);
+
 	//! Get the current scene import/export data information.
 	inline const SceneIO& getCurSceneIO() const { return m_curSceneIO; }
 
@@ -551,6 +558,9 @@ protected:
 
 	Float m_lastUpdateDuration;    //!< Duration of the last scene update.
 	Float m_lastDisplayDuration;   //!< Duration of the last scene display.
+
+    //! Export the scene files using the classic or the snapshot layout.
+    Bool exportScene(const String &sceneFilename, const SceneIO &whatExport, Bool snapshot);
 };
 
 } // namespace o3d
@@ -12,6 +12,7 @@
 
 #include "texture.h"
 #include "o3d/core/task.h"
+#include "o3d/core/filereadqueue.h"
 #include "o3d/core/memorydbg.h"
 
 namespace o3d {
@@ -177,6 +178,12 @@ public:
 			const String &zn,
 			Bool mipmaps);
 
+	//! Read the files asynchronously, and add the task to the TaskManager once they
+	//! are read, so no worker is blocked by the reading. The texture is the tag of the
+	//! reads.
+	//! @param priority Priority of the reads, higher first.
+	void submit(Int32 priority = 0);
+
 	virtual Bool execute();
 
 	virtual Bool finalize();
@@ -188,6 +195,9 @@ private:
 	String m_filenames[6];  //!< Absolute filenames.
 	Image m_pictures[6];    //!< Picture containers.
 	Bool m_mipmaps;     //!< TRUE if use mipmaps at finalize.
+
+	SmartPtr<FileReadRequest> m_requests[6];  //!< Finished reads of the files, if submitted.
+	std::atomic<Int32> m_numReading;          //!< Number of unfinished reads.
 };
 
 } // namespace o3d
@@ -12,6 +12,7 @@
 
 #include "texture.h"
 #include "o3d/core/task.h"
+#include "o3d/core/filereadqueue.h"
 #include "o3d/core/memorydbg.h"
 
 namespace o3d {
@@ -166,6 +167,11 @@ public:
 			const String &filename,
 			Bool mipmaps);
 
+	//! Read the file asynchronously, and add the task to the TaskManager once it is
+	//! read, so no worker is blocked by the reading. The texture is the tag of the read.
+	//! @param priority Priority of the read, higher first.
+	void submit(Int32 priority = 0);
+
     virtual Bool execute() override;
 
     virtual Bool finalize() override;
@@ -175,6 +181,7 @@ private:
 	Texture2D *m_texture;  //!< Texture 2d to load with the picture.
 
 	String m_filename;     //!< Absolute filename.
+	SmartPtr<FileReadRequest> m_request;  //!< Finished read of the file, if submitted.
 	Image m_picture;       //!< Picture container.
     Bool m_mipmaps;        //!< TRUE if use mipmaps at finalize.
 };
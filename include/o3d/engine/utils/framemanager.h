@@ -12,6 +12,7 @@
 
 #include "o3d/core/base.h"
 #include "o3d/core/memorydbg.h"
+#include "o3d/core/framearena.h"
 #include "../enginetype.h"
 
 namespace o3d {
@@ -82,6 +83,19 @@ public:
     //! Get the current numbers of drawn vertices (actually renderer frame).
     UInt32 getCurrentNumVertices() const;
 
+    //! Get the arena of the transient data of the frames, reset at the end of each
+    //! scene display.
+    inline FrameArena& getFrameArena() { return m_frameArena; }
+
+    //! End the frame of the arena. Called at the end of the scene display.
+    inline void endFrame() { m_frameArena.endFrame(); }
+
+    //! Get the maximal size in bytes used by the frame arena during a frame.
+    inline size_t getFrameArenaHighWaterMark() const { return m_frameArena.getHighWaterMark(); }
+
+    //! Get the size in bytes reserved by the frame arena.
+    inline size_t getFrameArenaCapacity() const { return m_frameArena.getCapacity(); }
+
 protected:
 
 	struct Frame
@@ -110,6 +124,8 @@ protected:
 	Float m_frameDuration;	//!< Duration of the last frame in seconds.
     Int64 m_frameLastTime;	//!< Time at the previous computeFrameDuration().
     Int64 m_frameNewTime;	//!< Time at the last computeFrameDuration().
+
+    FrameArena m_frameArena;  //!< Transient data of the frames.
 };
 
 } // namespace o3d
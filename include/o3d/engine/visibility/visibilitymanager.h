@@ -13,6 +13,7 @@
 #include "o3d/core/memorydbg.h"
 #include "o3d/core/baseobject.h"
 #include "o3d/core/templatearray.h"
+#include "o3d/core/framearena.h"
 #include "o3d/engine/scene/sceneentity.h"
 
 namespace o3d {
@@ -42,6 +43,10 @@ public:
 
 	O3D_DECLARE_DYNAMIC_CLASS(VisibilityManager)
 
+    //! Lists rebuilt at each processVisibility, allocated into the frame arena.
+    typedef FrameVector<SceneObject*> T_DrawList;
+    typedef FrameVector<Light*> T_LightList;
+
 	//! Default constructor.
 	//! @param parent Parent object.
 	VisibilityManager(BaseObject *parent);
@@ -104,13 +109,14 @@ public:
 	void draw(const DrawInfo &drawInfo);
 
 	//! Add an object to the drawing list.
-	inline void addObjectToDraw(SceneObject* object) { m_drawList.push(object); }
+	inline void addObjectToDraw(SceneObject* object) { m_drawList.push_back(object); }
 
     //! Add an effective light to the effective lights list.
-    inline void addEffectiveLight(Light* light) { m_effectiveLightList.push(light); }
+    inline void addEffectiveLight(Light* light) { m_effectiveLightList.push_back(light); }
 
     //! Get actives lights for this current processing.
-    const TemplateArray<Light*> getEffectiveLights() const;
+    //! @note Valid until the next processVisibility or the end of the frame.
+    inline const T_LightList& getEffectiveLights() const { return m_effectiveLightList; }
 
 protected:
 
@@ -121,8 +127,8 @@ protected:
 	Bool m_useMaxDistance;    //!< Is the max distance is used (enable by default).
 	Bool m_useMaxZFar;        //!< Max distance used is zFar value of the current camera (this is default).
 
-    TemplateArray<SceneObject*> m_drawList;      //!< Object draw list.
-    TemplateArray<Light*> m_effectiveLightList;  //!< Effective lights list
+    T_DrawList m_drawList;              //!< Object draw list.
+    T_LightList m_effectiveLightList;   //!< Effective lights list
 };
 
 } // namespace o3d
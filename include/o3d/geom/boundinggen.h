@@ -20,6 +20,7 @@ class AABBoxExt;
 class BSphere;
 class AABBox;
 class OBBox;
+struct ConstBatchVectors;
 
 //---------------------------------------------------------------------------------------
 //! @class BoundingGen
@@ -53,6 +54,9 @@ public:
 		m_maxV.maxOf(m_maxV, v);
 	}
 
+	//! Update the bounding computation (first pass) for an array of vertices.
+	void firstPass(const ConstBatchVectors &vertices, UInt32 numVertices);
+
 	//! All vertices have been checked so we finalize the first pass.
 	//! Axis-aligned bounding box can be asked after this first flush.
 	void flushFirstPass(UInt32 vertices);
@@ -93,6 +97,9 @@ public:
 		m_covariance(1,2) = m_covariance(1,2) + (yi_minus_my * zi_minus_mz);
 	}
 
+	//! Make the second pass for an array of vertices.
+	void secondPass(const ConstBatchVectors &vertices, UInt32 numVertices);
+
 	//! Compute the covariance matrix.
 	void flushSecondPass(UInt32 vertices);
 
@@ -150,6 +157,9 @@ public:
 		m_maxDotT = o3d::max(dot,m_maxDotT);
 	}
 
+	//! Update the bounding computation (third pass) for an array of vertices.
+	void thirdPass(const ConstBatchVectors &vertices, UInt32 numVertices);
+
 	//! Compute some variables.
 	//! Oriented bounding box can be asked after this third pass.
 	void flushThirdPass();
@@ -195,6 +205,10 @@ public:
 		}
 	}
 
+	//! Update the bounding computation (fourth pass) for an array of vertices.
+	//! Sequential by nature, each vertex depends on the sphere grown by the previous ones.
+	void fourthPass(const ConstBatchVectors &vertices, UInt32 numVertices);
+
 	//! Set a bounding sphere.
 	void getBoundingSphere(class BSphere &bSphere);
 
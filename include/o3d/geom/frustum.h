@@ -47,6 +47,26 @@ public:
 //		FAR
 	};
 
+	//! Array of spheres, each component in a contiguous array (SoA).
+	struct SphereArray
+	{
+		const Float *x;       //!< Centers X.
+		const Float *y;       //!< Centers Y.
+		const Float *z;       //!< Centers Z.
+		const Float *radius;  //!< Radius.
+	};
+
+	//! Array of axis aligned boxes, each component in a contiguous array (SoA).
+	struct BoxArray
+	{
+		const Float *x;       //!< Centers X.
+		const Float *y;       //!< Centers Y.
+		const Float *z;       //!< Centers Z.
+		const Float *halfX;   //!< Half sizes X.
+		const Float *halfY;   //!< Half sizes Y.
+		const Float *halfZ;   //!< Half sizes Z.
+	};
+
 	//! Call this every time the camera moves to update the frustum.
 	void computeFrustum(const Matrix4 &projection, const Matrix4 &modelview);
 
@@ -83,6 +103,46 @@ public:
 	//! Returns the clip result between the frustum and a cone (without near and far).
 	Geometry::Clipping coneInFrustumLight(const BCone &cone) const;
 
+	//! Cull an array of spheres, testing several spheres at once with SIMD.
+	//! @param visible Bitmask of (n+31)/32 words, the bit i%32 of the word i/32 is set
+	//! if the sphere i is inside or intersects the frustum.
+	//! @param hints Optional plane index of each sphere, kept from a frame to the next.
+	//! The plane that rejected a sphere is tested first the next time. Initialize them
+	//! to 0, valid values are from 0 to 5.
+	//! @return The number of visible spheres.
+	UInt32 spheresInFrustum(
+			const SphereArray &spheres,
+			UInt32 n,
+			UInt32 *visible,
+			UInt8 *hints = nullptr) const;
+
+	//! Cull an array of spheres (without near and far). @see spheresInFrustum
+	UInt32 spheresInFrustumLight(
+			const SphereArray &spheres,
+			UInt32 n,
+			UInt32 *visible,
+			UInt8 *hints = nullptr) const;
+
+	//! Cull an array of axis aligned boxes, testing several boxes at once with SIMD.
+	//! @see spheresInFrustum for the parameters.
+	UInt32 boxesInFrustum(
+			const BoxArray &boxes,
+			UInt32 n,
+			UInt32 *visible,
+			UInt8 *hints = nullptr) const;
+
+	//! Cull an array of axis aligned boxes (without near and far). @see boxesInFrustum
+	UInt32 boxesInFrustumLight(
+			const BoxArray &boxes,
+			UInt32 n,
+			UInt32 *visible,
+			UInt8 *hints = nullptr) const;
+
+	//! Convert a visibility bitmask of n objects into the list of the visible indices.
+	//! @param indices Destination, sized for the number of visible objects.
+	//! @return The number of indices.
+	static UInt32 compactVisible(const UInt32 *visible, UInt32 n, UInt32 *indices);
+
 	//! Return the clip result between the frustum and a oriented bounding box.
     //! @todo
 	Geometry::Clipping boxInFrustum(const OBBox &box) const;
@@ -102,6 +162,14 @@ public:
 private:
 
 	Plane m_planes[6];      //!< Six planes of the frustum.
+
+	UInt32 cull(
+			UInt32 numPlanes,
+			const SphereArray *spheres,
+			const BoxArray *boxes,
+			UInt32 n,
+			UInt32 *visible,
+			UInt8 *hints) const;
 };
 
 } // namespace o3d
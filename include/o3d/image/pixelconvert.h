@@ -0,0 +1,45 @@
+/**
+ * @file pixelconvert.h
+ * @brief Conversions of arrays of 8 bits RGB and RGBA pixels.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#ifndef _O3D_PIXELCONVERT_H
+#define _O3D_PIXELCONVERT_H
+
+#include "o3d/core/base.h"
+#include "o3d/core/memorydbg.h"
+
+namespace o3d {
+
+/**
+ * @brief Conversions of arrays of 8 bits per component pixels, using SSSE3 or AVX2
+ * when available, selected at runtime through CpuDispatch.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ */
+class O3D_API PixelConvert
+{
+public:
+
+    //! Expand RGB pixels into RGBA pixels, with an opaque alpha.
+    //! @param dst Destination of numPixels*4 bytes, not overlapping the source.
+    static void rgbToRgba(const UInt8 *src, UInt8 *dst, UInt32 numPixels);
+
+    //! Pack RGBA pixels into RGB pixels, dropping the alpha.
+    //! @param dst Destination of numPixels*3 bytes, not overlapping the source.
+    static void rgbaToRgb(const UInt8 *src, UInt8 *dst, UInt32 numPixels);
+
+    //! Swap in place the red and blue components of RGB pixels.
+    static void swapRBRgb(UInt8 *data, UInt32 numPixels);
+
+    //! Swap in place the red and blue components of RGBA pixels.
+    static void swapRBRgba(UInt8 *data, UInt32 numPixels);
+};
+
+} // namespace o3d
+
+#endif // _O3D_PIXELCONVERT_H
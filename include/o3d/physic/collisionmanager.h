@@ -11,6 +11,7 @@
 #define _O3D_COLLISIONMANAGER_H
 
 #include "o3d/core/memorydbg.h"
+#include "o3d/core/typedpool.h"
 #include "o3d/physic/collision.h"
 #include "o3d/physic/physicentity.h"
 #include "o3d/physic/rigidbodycollider.h"
@@ -23,7 +24,7 @@ namespace o3d {
  * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
  * @date 2006-06-01
  * Manage all collision between the rigid bodies of an PhysicentityManager.
- * The collision are stored in a linked list. It also use a garbage collector
+ * The collision are stored in a linked list. They are allocated into a pool
  * to avoid allocating/de-allocating too much memory.
  */
 class O3D_API CollisionManager
@@ -57,7 +58,7 @@ protected:
     T_PhysicEntityList m_entityList;    //!< list of all objects involved in collision detection
 
 	T_CollisionList m_collisionList;    //!< the list of collision to resolve
-	T_CollisionList m_garbageCollector; //!< a list of collision to re-use
+	TypedPool<Collision> m_collisionPool; //!< collisions allocator, usable from any thread
 };
 
 } // namespace o3d
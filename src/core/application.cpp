@@ -12,6 +12,7 @@
 
 #include "o3d/core/classfactory.h"
 #include "o3d/core/taskmanager.h"
+#include "o3d/core/workerpool.h"
 #include "o3d/core/display.h"
 #include "o3d/core/filemanager.h"
 #include "o3d/core/thread.h"
@@ -23,6 +24,7 @@
 #include "o3d/core/stringmap.h"
 #include "o3d/core/appwindow.h"
 #include "o3d/core/debug.h"
+#include "o3d/core/asynclogger.h"
 #include "o3d/core/gl.h"
 
 #include <algorithm>
@@ -70,6 +72,13 @@ void Application::init(AppSettings settings, Int32 argc, Char **argv, void *app)
     // Get the application name and path
     getBaseNamePrivate(argc, argv);
 
+#ifndef O3D_ANDROID
+    if (settings.asyncLog) {
+        Debug::instance()->setDefaultLog(new AsyncLogger(getAppName() + ".log"));
+        AsyncLogger::installCrashHandler();
+    }
+#endif
+
     if (settings.clearLog) {
         Debug::instance()->getDefaultLog().clearLog();
     }
@@ -154,9 +163,15 @@ void Application::quit()
 	// terminate the task manager if running
 	TaskManager::destroy();
 
+	// and the workers threads
+	WorkerPool::destroy();
+
     // timer manager before thread
     TimerManager::destroy();
 
+    // the log writers, next logs are written synchronously
+    AsyncLogger::stopAll();
+
 	// wait all threads terminate
 	ThreadManager::waitEndThreads();
 
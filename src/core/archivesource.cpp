@@ -0,0 +1,98 @@
+/**
+ * @file archivesource.cpp
+ * @brief Implementation of ArchiveSource.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/archivesource.h"
+
+#include "o3d/core/instream.h"
+#include "o3d/core/debug.h"
+
+#ifdef O3D_WINDOWS
+    #include "o3d/core/architecture.h"
+    #include <io.h>
+#else
+    #include <unistd.h>
+    #include <errno.h>
+#endif
+
+using namespace o3d;
+
+ArchiveSource::ArchiveSource(InStream *is) :
+    m_is(is),
+    m_data(nullptr),
+    m_size(0),
+    m_fd(-1)
+{
+    if (!m_is) {
+        O3D_ERROR(E_InvalidPrecondition("Stream must be valid"));
+    }
+
+    m_data = m_is->getMappedData(m_size);
+    if (!m_data) {
+        m_fd = m_is->getFD();
+    }
+}
+
+ArchiveSource::~ArchiveSource()
+{
+    deletePtr(m_is);
+}
+
+UInt32 ArchiveSource::readAt(UInt64 pos, void *buf, UInt32 size)
+{
+    if (m_data) {
+        if (pos >= m_size) {
+            return 0;
+        }
+
+        const UInt32 len = (UInt32)o3d::min<UInt64>(size, m_size - pos);
+        memcpy(buf, m_data + pos, len);
+
+        return len;
+    }
+
+    if (m_fd >= 0) {
+        UInt8 *dest = (UInt8*)buf;
+        UInt32 total = 0;
+
+        while (total < size) {
+        #ifdef O3D_WINDOWS
+            OVERLAPPED overlapped;
+            memset(&overlapped, 0, sizeof(OVERLAPPED));
+            overlapped.Offset = (DWORD)((pos + total) & 0xffffffff);
+            overlapped.OffsetHigh = (DWORD)((pos + total) >> 32);
+
+            DWORD read = 0;
+            if (!ReadFile((HANDLE)_get_osfhandle(m_fd), dest + total, size - total, &read, &overlapped)) {
+                break;
+            }
+        #else
+            const ssize_t read = ::pread(m_fd, dest + total, size - total, (off_t)(pos + total));
+            if (read < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+        #endif
+            if (read == 0) {
+                break;
+            }
+
+            total += (UInt32)read;
+        }
+
+        return total;
+    }
+
+    FastMutexLocker locker(m_mutex);
+
+    m_is->reset(pos);
+    return m_is->reader(buf, 1, size);
+}
@@ -0,0 +1,408 @@
+/**
+ * @file assetcache.cpp
+ * @brief Implementation of AssetCache.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/assetcache.h"
+
+#include "o3d/core/filemanager.h"
+#include "o3d/core/fileinstream.h"
+#include "o3d/core/fileoutstream.h"
+#include "o3d/core/filelisting.h"
+#include "o3d/core/localdir.h"
+#include "o3d/core/debug.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace o3d;
+
+static const Char *INDEX_FILE_NAME = "cache.idx";
+
+// Size of the header of an entry file
+static const UInt32 ENTRY_HEADER_SIZE = 3 * sizeof(UInt32);
+
+//---------------------------------------------------------------------------------------
+// AssetCache::Key
+//---------------------------------------------------------------------------------------
+
+AssetCache::Key::Key(const String &kind, UInt32 version)
+{
+    addString(kind);
+    addValue(version);
+}
+
+AssetCache::Key& AssetCache::Key::addData(const void *data, UInt32 size)
+{
+    O3D_ASSERT(m_hex.isEmpty());
+
+    if (size > 0) {
+        m_hash.update(reinterpret_cast<const UInt8*>(data), size);
+    }
+
+    return *this;
+}
+
+AssetCache::Key& AssetCache::Key::addString(const String &str)
+{
+    CString utf8 = str.toUtf8();
+
+    // the length separates the consecutive strings
+    addValue((UInt32)utf8.length());
+    return addData(utf8.getData(), (UInt32)utf8.length());
+}
+
+const String& AssetCache::Key::getHex()
+{
+    if (m_hex.isEmpty()) {
+        m_hash.finalize();
+        m_hex = m_hash.getHex();
+    }
+
+    return m_hex;
+}
+
+//---------------------------------------------------------------------------------------
+// AssetCache
+//---------------------------------------------------------------------------------------
+
+AssetCache::AssetCache(const String &path, UInt64 budget) :
+    m_budget(budget),
+    m_size(0),
+    m_clock(0)
+{
+    m_path = FileManager::instance()->getFullFileName(path);
+    m_path.replace('\\', '/');
+    m_path.trimRight('/', True);
+
+    memset(&m_stats, 0, sizeof(Stats));
+
+    // create the missing directories, from the deepest existing one
+    T_StringList missing;
+    String existing(m_path);
+
+    while (!existing.isEmpty() && !LocalDir(existing).exists()) {
+        const Int32 pos = existing.reverseFind('/');
+        if (pos < 0) {
+            O3D_ERROR(E_InvalidParameter("Invalid asset cache path " + m_path));
+        }
+
+        missing.push_front(existing.sub(pos + 1));
+        existing.truncate(pos > 0 ? pos : 1);
+    }
+
+    for (const String &name : missing) {
+        LocalDir(existing).makeDir(name);
+        existing << '/' << name;
+    }
+
+    load();
+
+    FastMutexLocker locker(m_mutex);
+    evict();
+}
+
+AssetCache::~AssetCache()
+{
+    flush();
+}
+
+String AssetCache::entryFileName(const String &key)
+{
+    return key + ".bin";
+}
+
+void AssetCache::load()
+{
+    FastMutexLocker locker(m_mutex);
+
+    LocalDir dir(m_path);
+
+    // interrupted stores
+    T_StringList temporaries = dir.findFiles("*.tmp", FILE_FILE);
+    for (const String &temporary : temporaries) {
+        try {
+            dir.removeFile(temporary);
+        } catch (E_BaseException &) {
+            // written by another process
+        }
+    }
+
+    T_FLItem_List files = dir.findFilesInfos("*.bin", FILE_FILE);
+    for (const FLItem &file : files) {
+        Entry entry;
+        entry.size = file.FileSize;
+        entry.lastUse = 0;
+
+        m_entries[file.FileName.sub(0, file.FileName.length() - 4)] = entry;
+        m_size += entry.size;
+    }
+
+    // restore the last uses
+    if (dir.check(INDEX_FILE_NAME) != BaseDir::SUCCESS) {
+        return;
+    }
+
+    try {
+        FileInStream is(m_path + '/' + INDEX_FILE_NAME);
+
+        UInt32 magic, version, count;
+        is >> magic >> version >> m_clock >> count;
+
+        if ((magic != MAGIC) || (version != VERSION)) {
+            m_clock = 0;
+            return;
+        }
+
+        String key;
+        UInt64 lastUse;
+
+        for (UInt32 i = 0; i < count; ++i) {
+            is >> key >> lastUse;
+
+            T_EntryMap::iterator it = m_entries.find(key);
+            if (it != m_entries.end()) {
+                it->second.lastUse = lastUse;
+            }
+        }
+    } catch (E_BaseException &) {
+        // a partial index, the remaining entries are the first evicted
+    }
+}
+
+void AssetCache::flush()
+{
+    FastMutexLocker locker(m_mutex);
+
+    try {
+        FileOutStream os(m_path + '/' + INDEX_FILE_NAME);
+
+        os << MAGIC << VERSION << m_clock << (UInt32)m_entries.size();
+
+        for (T_EntryMap::const_iterator cit = m_entries.begin(); cit != m_entries.end(); ++cit) {
+            os << cit->first << cit->second.lastUse;
+        }
+    } catch (E_BaseException &) {
+        // the last uses are lost, not the entries
+    }
+}
+
+void AssetCache::setBudget(UInt64 budget)
+{
+    FastMutexLocker locker(m_mutex);
+
+    m_budget = budget;
+    evict();
+}
+
+UInt64 AssetCache::getBudget() const
+{
+    FastMutexLocker locker(m_mutex);
+    return m_budget;
+}
+
+Bool AssetCache::fetch(const String &key, SmartArrayUInt8 &data)
+{
+    {
+        FastMutexLocker locker(m_mutex);
+
+        if (m_entries.find(key) == m_entries.end()) {
+            ++m_stats.misses;
+            return False;
+        }
+    }
+
+    // read without lock, an entry file is never rewritten in place
+    Bool valid = False;
+    SmartArrayUInt8 content;
+
+    try {
+        FileInStream is(m_path + '/' + entryFileName(key));
+
+        UInt32 magic, version, size;
+        is >> magic >> version >> size;
+
+        if ((magic == MAGIC) && (version == VERSION) && (is.getAvailable() == (Int32)size)) {
+            content = SmartArrayUInt8(size);
+            valid = is.reader(content.getData(), 1, size) == size;
+        }
+    } catch (E_BaseException &) {
+        // evicted meanwhile, or unreadable
+    }
+
+    FastMutexLocker locker(m_mutex);
+
+    T_EntryMap::iterator it = m_entries.find(key);
+
+    if (!valid) {
+        if (it != m_entries.end()) {
+            removeEntry(it);
+        }
+
+        ++m_stats.misses;
+        return False;
+    }
+
+    if (it != m_entries.end()) {
+        it->second.lastUse = ++m_clock;
+    }
+
+    ++m_stats.hits;
+    m_stats.bytesRead += content.getNumElt();
+
+    data = content;
+    return True;
+}
+
+Bool AssetCache::store(const String &key, const UInt8 *data, UInt32 size)
+{
+    const String fileName = entryFileName(key);
+    String tempName(key);
+
+    {
+        FastMutexLocker locker(m_mutex);
+        tempName << '.' << ++m_clock << ".tmp";
+    }
+
+    LocalDir dir(m_path);
+
+    try {
+        FileOutStream os(m_path + '/' + tempName);
+
+        os << MAGIC << VERSION << size;
+        if (os.writer(data, 1, size) != size) {
+            O3D_ERROR(E_InvalidResult("Unable to write the asset cache entry " + fileName));
+        }
+
+        os.close();
+    } catch (E_BaseException &) {
+        try {
+            dir.removeFile(tempName);
+        } catch (E_BaseException &) {
+        }
+
+        return False;
+    }
+
+    FastMutexLocker locker(m_mutex);
+
+    T_EntryMap::iterator it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        removeEntry(it);
+    }
+
+    try {
+        dir.rename(tempName, fileName);
+    } catch (E_BaseException &) {
+        try {
+            dir.removeFile(tempName);
+        } catch (E_BaseException &) {
+        }
+
+        return False;
+    }
+
+    Entry entry;
+    entry.size = ENTRY_HEADER_SIZE + size;
+    entry.lastUse = ++m_clock;
+
+    m_entries[key] = entry;
+    m_size += entry.size;
+
+    ++m_stats.stores;
+    m_stats.bytesWritten += size;
+
+    evict();
+
+    return True;
+}
+
+Bool AssetCache::contains(const String &key) const
+{
+    FastMutexLocker locker(m_mutex);
+    return m_entries.find(key) != m_entries.end();
+}
+
+void AssetCache::remove(const String &key)
+{
+    FastMutexLocker locker(m_mutex);
+
+    T_EntryMap::iterator it = m_entries.find(key);
+    if (it != m_entries.end()) {
+        removeEntry(it);
+    }
+}
+
+void AssetCache::clear()
+{
+    FastMutexLocker locker(m_mutex);
+
+    while (!m_entries.empty()) {
+        removeEntry(m_entries.begin());
+    }
+}
+
+AssetCache::Stats AssetCache::getStats() const
+{
+    FastMutexLocker locker(m_mutex);
+
+    Stats stats = m_stats;
+    stats.numEntries = (UInt32)m_entries.size();
+    stats.size = m_size;
+    stats.budget = m_budget;
+
+    return stats;
+}
+
+void AssetCache::resetStats()
+{
+    FastMutexLocker locker(m_mutex);
+    memset(&m_stats, 0, sizeof(Stats));
+}
+
+void AssetCache::removeEntry(T_EntryMap::iterator it)
+{
+    try {
+        LocalDir(m_path).removeFile(entryFileName(it->first));
+    } catch (E_BaseException &) {
+        // already removed by another process
+    }
+
+    m_size -= it->second.size;
+    m_entries.erase(it);
+}
+
+void AssetCache::evict()
+{
+    if (m_size <= m_budget) {
+        return;
+    }
+
+    // down to 7/8 of the budget, to not sort the entries at each following store
+    const UInt64 target = m_budget - m_budget / 8;
+
+    std::vector<T_EntryMap::iterator> entries;
+    entries.reserve(m_entries.size());
+
+    for (T_EntryMap::iterator it = m_entries.begin(); it != m_entries.end(); ++it) {
+        entries.push_back(it);
+    }
+
+    std::sort(entries.begin(), entries.end(), [] (T_EntryMap::iterator a, T_EntryMap::iterator b) {
+        return a->second.lastUse < b->second.lastUse;
+    });
+
+    for (T_EntryMap::iterator it : entries) {
+        if (m_size <= target) {
+            break;
+        }
+
+        removeEntry(it);
+        ++m_stats.evictions;
+    }
+}
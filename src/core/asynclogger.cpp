@@ -0,0 +1,881 @@
+/**
+ * @file asynclogger.cpp
+ * @brief Implementation of AsyncLogger.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/asynclogger.h"
+
+#include "o3d/core/architecture.h"
+#include "o3d/core/filemanager.h"
+#include "o3d/core/debug.h"
+#include "o3d/core/datetime.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <exception>
+#include <vector>
+
+#ifndef O3D_WINDOWS
+    #include <signal.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace o3d;
+
+// Size of the batch from which it is written before the end of the pending records
+static const size_t BATCH_SIZE = 65536;
+
+// Living async loggers, for the flush on crash
+static FastMutex ms_loggersMutex;
+static std::vector<AsyncLogger*> ms_loggers;
+
+#ifndef O3D_WINDOWS
+// Living async loggers, for the flush from a fatal signal, without lock
+static const UInt32 MAX_SIGNAL_LOGGERS = 8;
+static std::atomic<AsyncLogger*> ms_signalLoggers[MAX_SIGNAL_LOGGERS];
+#endif
+
+// Logger whose writing is done by the calling thread. A log from the writing itself,
+// like a failure, must not wait for it.
+static thread_local const AsyncLogger* t_writing = nullptr;
+
+namespace {
+
+//! Lock the write mutex of a logger and mark the calling thread as its writer.
+class WriteLocker
+{
+public:
+
+    WriteLocker(const AsyncLogger *logger, FastMutex &mutex) :
+        m_mutex(mutex),
+        m_previous(t_writing)
+    {
+        m_mutex.lock();
+        t_writing = logger;
+    }
+
+    ~WriteLocker()
+    {
+        t_writing = m_previous;
+        m_mutex.unlock();
+    }
+
+private:
+
+    FastMutex &m_mutex;
+    const AsyncLogger *m_previous;
+};
+
+//! Length of a null terminated wide string.
+Int32 textLength(const WChar *text)
+{
+    Int32 length = 0;
+    while (text[length]) {
+        ++length;
+    }
+
+    return length;
+}
+
+//! Encode length characters of a wide string in UTF-8, at most 4 bytes per character.
+//! Async-signal-safe.
+//! @return The number of written bytes.
+size_t encodeUtf8(Char *out, const WChar *text, Int32 length)
+{
+    UInt8 *dst = reinterpret_cast<UInt8*>(out);
+    UInt8 *start = dst;
+
+    for (Int32 i = 0; i < length; ++i) {
+        UInt32 c = (UInt32)text[i];
+
+        // UTF-16 surrogates pair
+        if (sizeof(WChar) == 2 && c >= 0xD800 && c < 0xDC00 && i + 1 < length) {
+            const UInt32 low = (UInt32)text[i + 1];
+            if (low >= 0xDC00 && low < 0xE000) {
+                c = 0x10000 + ((c - 0xD800) << 10) + (low - 0xDC00);
+                ++i;
+            }
+        }
+
+        if (c < 0x80) {
+            *dst++ = (UInt8)c;
+        } else if (c < 0x800) {
+            *dst++ = (UInt8)(0xC0 | (c >> 6));
+            *dst++ = (UInt8)(0x80 | (c & 0x3F));
+        } else if (c < 0x10000) {
+            *dst++ = (UInt8)(0xE0 | (c >> 12));
+            *dst++ = (UInt8)(0x80 | ((c >> 6) & 0x3F));
+            *dst++ = (UInt8)(0x80 | (c & 0x3F));
+        } else {
+            *dst++ = (UInt8)(0xF0 | ((c >> 18) & 0x07));
+            *dst++ = (UInt8)(0x80 | ((c >> 12) & 0x3F));
+            *dst++ = (UInt8)(0x80 | ((c >> 6) & 0x3F));
+            *dst++ = (UInt8)(0x80 | (c & 0x3F));
+        }
+    }
+
+    return dst - start;
+}
+
+//! Append a null terminated wide string encoded in UTF-8, without the terminator.
+void encodeUtf8(std::vector<Char> &out, const WChar *text)
+{
+    const Int32 length = textLength(text);
+    if (!length) {
+        return;
+    }
+
+    // at most 4 bytes per character, or per surrogates pair
+    const size_t size = out.size();
+    out.resize(size + length * 4);
+
+    out.resize(size + encodeUtf8(out.data() + size, text, length));
+}
+
+#ifndef O3D_WINDOWS
+//! Format the time of a record like "[%.5f] " without the C library. Async-signal-safe.
+//! @return The number of written bytes, at most 32.
+size_t formatSignalTime(Char *out, Int64 time, Int64 frequency)
+{
+    UInt64 seconds = time > 0 ? (UInt64)(time / frequency) : 0;
+    UInt64 fraction = time > 0 ? (UInt64)(time % frequency) * 100000 / frequency : 0;
+
+    Char digits[20];
+    Int32 n = 0;
+    do {
+        digits[n++] = (Char)('0' + seconds % 10);
+        seconds /= 10;
+    } while (seconds && n < 20);
+
+    Char *dst = out;
+    *dst++ = '[';
+
+    while (n > 0) {
+        *dst++ = digits[--n];
+    }
+
+    *dst++ = '.';
+
+    for (Int32 i = 4; i >= 0; --i) {
+        dst[i] = (Char)('0' + fraction % 10);
+        fraction /= 10;
+    }
+
+    dst += 5;
+    *dst++ = ']';
+    *dst++ = ' ';
+
+    return dst - out;
+}
+
+//! Write a whole buffer, retrying on interruption. Async-signal-safe.
+void writeAll(int fd, const Char *data, size_t size)
+{
+    while (size > 0) {
+        const ssize_t written = ::write(fd, data, size);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return;
+        }
+
+        data += written;
+        size -= (size_t)written;
+    }
+}
+#endif
+
+} // anonymous namespace
+
+AsyncLogger::Writer::Writer(AsyncLogger *logger) :
+    m_logger(logger)
+{
+}
+
+Int32 AsyncLogger::Writer::run(void *)
+{
+    m_logger->process();
+    return 0;
+}
+
+AsyncLogger::AsyncLogger(const String &logname, UInt32 capacity, OverflowPolicy policy) :
+    m_records(nullptr),
+    m_mask(0),
+    m_enqueuePos(0),
+    m_dequeuePos(0),
+    m_policy(policy),
+    m_sampleRate(8),
+    m_sampleCount(0),
+    m_numDropped(0),
+    m_numReported(0),
+    m_logLevel(INFO),
+    m_flushDelay(50),
+    m_running(False),
+    m_sleeping(False),
+    m_numBlocked(0),
+    m_consuming(False),
+    m_writer(this),
+    m_thread(&m_writer),
+    m_logFilename(logname),
+    m_os(nullptr),
+    m_epochBase(0),
+    m_lastSecond(-1),
+    m_dateUs(False),
+    m_timeFrequency(System::getTimeFrequency()),
+    m_signalBuffer(nullptr),
+    m_signalFd(-1)
+{
+    m_batch.reserve(BATCH_SIZE * 2);
+
+    m_absolutefname = FileManager::instance()->getFullFileName(m_logFilename);
+    m_os = FileManager::instance()->openOutStream(m_absolutefname, FileOutStream::APPEND);
+
+    // power of two number of records
+    UInt32 size = 2;
+    while (size < capacity) {
+        size <<= 1;
+    }
+
+    m_mask = size - 1;
+    m_records = new Record[size];
+
+    for (UInt32 i = 0; i < size; ++i) {
+        m_records[i].sequence.store(i, std::memory_order_relaxed);
+        m_records[i].heap = nullptr;
+    }
+
+    // epoch time of the origin of System::getTime(), in microseconds
+    m_epochBase = System::getEpochTime() / 10 -
+                  (Int64)((Double)System::getTime() * 1000000.0 / System::getTimeFrequency());
+
+    {
+        FastMutexLocker locker(ms_loggersMutex);
+        ms_loggers.push_back(this);
+    }
+
+#ifndef O3D_WINDOWS
+    // preallocated, nothing can be allocated from a signal handler
+    m_signalBuffer = new Char[SIGNAL_BUFFER_SIZE];
+    openSignalFd();
+
+    for (UInt32 i = 0; i < MAX_SIGNAL_LOGGERS; ++i) {
+        AsyncLogger *expected = nullptr;
+        if (ms_signalLoggers[i].compare_exchange_strong(expected, this)) {
+            break;
+        }
+    }
+#endif
+
+    m_running = True;
+
+    m_thread.start();
+    m_thread.setName("o3d-logger");
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    {
+        FastMutexLocker locker(ms_loggersMutex);
+        ms_loggers.erase(std::remove(ms_loggers.begin(), ms_loggers.end(), this), ms_loggers.end());
+    }
+
+#ifndef O3D_WINDOWS
+    for (UInt32 i = 0; i < MAX_SIGNAL_LOGGERS; ++i) {
+        AsyncLogger *expected = this;
+        ms_signalLoggers[i].compare_exchange_strong(expected, nullptr);
+    }
+#endif
+
+    stop();
+
+    // records pushed after the last drain
+    flush();
+
+#ifndef O3D_WINDOWS
+    if (m_signalFd >= 0) {
+        ::close(m_signalFd);
+    }
+
+    deleteArray(m_signalBuffer);
+#endif
+
+    deleteArray(m_records);
+    deletePtr(m_os);
+}
+
+void AsyncLogger::setLogFileName(const String &name)
+{
+    const String absoluteName = FileManager::instance()->getFullFileName(name);
+
+    setStream(FileManager::instance()->openOutStream(absoluteName, FileOutStream::APPEND));
+
+    WriteLocker locker(this, m_writeMutex);
+    m_logFilename = name;
+    m_absolutefname = absoluteName;
+
+#ifndef O3D_WINDOWS
+    openSignalFd();
+#endif
+}
+
+const String& AsyncLogger::getLogFileName() const
+{
+    return m_logFilename;
+}
+
+void AsyncLogger::log(LogLevel level, const String &str)
+{
+    // minimal log level
+    if (level < m_logLevel.load(std::memory_order_relaxed)) {
+        return;
+    }
+
+    if (t_writing == this) {
+        ++m_numDropped;
+        return;
+    }
+
+    const Int64 time = System::getTime();
+
+    if (!m_running.load()) {
+        writeRecord(time, str);
+        return;
+    }
+
+    if (level < ERROR) {
+        const OverflowPolicy policy = getOverflowPolicy();
+
+        if (policy == OVERFLOW_SAMPLE) {
+            const UInt32 pending = m_enqueuePos.load(std::memory_order_relaxed) -
+                                   m_dequeuePos.load(std::memory_order_relaxed);
+
+            if (pending >= getCapacity() / 4 * 3 && (m_sampleCount++ % m_sampleRate.load()) != 0) {
+                ++m_numDropped;
+                return;
+            }
+        }
+
+        if (tryPush(time, str)) {
+            // let the pending records grow to make large batches, until the half
+            if (m_enqueuePos.load() - m_dequeuePos.load() >= getCapacity() / 2) {
+                wakeUpWriter();
+            }
+
+            return;
+        } else if (policy != OVERFLOW_BLOCK) {
+            ++m_numDropped;
+            wakeUpWriter();
+            return;
+        }
+    }
+
+    // wait for a free record, the errors are never dropped
+    while (!tryPush(time, str)) {
+        if (!m_running.load()) {
+            writeRecord(time, str);
+            return;
+        }
+
+        FastMutexLocker locker(m_sleepMutex);
+        ++m_numBlocked;
+        m_wakeUp.wakeOne();
+        m_freed.wait(m_sleepMutex, 10);
+        --m_numBlocked;
+    }
+
+    // and written as soon as possible
+    wakeUpWriter();
+}
+
+void AsyncLogger::setDateFormat(const String &format)
+{
+    WriteLocker locker(this, m_writeMutex);
+
+    // pending records use the previous format
+    drain();
+
+    m_dateFormat = format;
+    m_dateUs = format.sub("%f", 0) >= 0;
+    m_lastSecond = -1;
+}
+
+const String& AsyncLogger::getDateFormat() const
+{
+    return m_dateFormat;
+}
+
+void AsyncLogger::clearLog()
+{
+    // pending records are written and the file closed before to recreate it
+    setStream(nullptr);
+    setStream(FileManager::instance()->openOutStream(m_absolutefname, FileOutStream::CREATE));
+}
+
+void AsyncLogger::setLogLevel(LogLevel minLevel)
+{
+    m_logLevel = minLevel;
+}
+
+Logger::LogLevel AsyncLogger::getLogLevel() const
+{
+    return (LogLevel)m_logLevel.load();
+}
+
+void AsyncLogger::setOverflowPolicy(OverflowPolicy policy, UInt32 sampleRate)
+{
+    m_sampleRate = o3d::max<UInt32>(sampleRate, 1);
+    m_policy = policy;
+}
+
+void AsyncLogger::setFlushDelay(UInt32 ms)
+{
+    m_flushDelay = o3d::max<UInt32>(ms, 1);
+}
+
+void AsyncLogger::flush()
+{
+    WriteLocker locker(this, m_writeMutex);
+    drain();
+}
+
+void AsyncLogger::stop()
+{
+    {
+        FastMutexLocker locker(m_sleepMutex);
+
+        if (!m_running.load()) {
+            return;
+        }
+
+        m_running = False;
+
+        m_wakeUp.wakeAll();
+        m_freed.wakeAll();
+    }
+
+    m_thread.waitFinish();
+
+    flush();
+}
+
+void AsyncLogger::flushAll()
+{
+    FastMutexLocker locker(ms_loggersMutex);
+
+    for (AsyncLogger *logger : ms_loggers) {
+        logger->flush();
+    }
+}
+
+void AsyncLogger::stopAll()
+{
+    FastMutexLocker locker(ms_loggersMutex);
+
+    for (AsyncLogger *logger : ms_loggers) {
+        logger->stop();
+    }
+}
+
+void AsyncLogger::flushOnCrash()
+{
+    // the crashing thread can own the locks, and the writer can be in the middle of a
+    // batch, so wait for them only a short delay
+    Bool locked = False;
+    for (Int32 i = 0; i < 100 && !(locked = ms_loggersMutex.tryLock()); ++i) {
+        System::waitMs(1);
+    }
+
+    if (!locked) {
+        return;
+    }
+
+    for (AsyncLogger *logger : ms_loggers) {
+        // crashed during its own writing
+        if (t_writing == logger) {
+            continue;
+        }
+
+        locked = False;
+        for (Int32 i = 0; i < 100 && !(locked = logger->m_writeMutex.tryLock()); ++i) {
+            System::waitMs(1);
+        }
+
+        if (locked) {
+            const AsyncLogger *previous = t_writing;
+            t_writing = logger;
+
+            logger->drain();
+
+            t_writing = previous;
+            logger->m_writeMutex.unlock();
+        }
+    }
+
+    ms_loggersMutex.unlock();
+}
+
+#ifndef O3D_WINDOWS
+void AsyncLogger::flushOnSignal()
+{
+    for (UInt32 i = 0; i < MAX_SIGNAL_LOGGERS; ++i) {
+        AsyncLogger *logger = ms_signalLoggers[i].load();
+        if (logger) {
+            logger->writeOnSignal();
+        }
+    }
+}
+
+void AsyncLogger::openSignalFd()
+{
+    const int fd = ::open(m_absolutefname.toUtf8().getData(), O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0644);
+    const int previous = m_signalFd.exchange(fd);
+
+    if (previous >= 0) {
+        ::close(previous);
+    }
+}
+
+void AsyncLogger::writeOnSignal()
+{
+    // popped by a thread, possibly the crashed one
+    if (m_consuming.exchange(True, std::memory_order_acquire)) {
+        return;
+    }
+
+    const int fd = m_signalFd.load();
+    UInt32 pos = m_dequeuePos.load(std::memory_order_relaxed);
+    size_t size = 0;
+
+    for (;;) {
+        Record &record = m_records[pos & m_mask];
+
+        if ((Int32)(record.sequence.load(std::memory_order_acquire) - (pos + 1)) < 0) {
+            break;
+        }
+
+        const WChar *text = record.heap ? record.heap : record.text;
+
+        // the time, at most 4 bytes per character, and the new line, truncated to the buffer
+        Int32 length = o3d::min<Int32>(textLength(text), (SIGNAL_BUFFER_SIZE - 33) / 4);
+
+        if (size + 33 + length * 4 > SIGNAL_BUFFER_SIZE) {
+            writeAll(fd, m_signalBuffer, size);
+            size = 0;
+        }
+
+        size += formatSignalTime(m_signalBuffer + size, record.time, m_timeFrequency);
+        size += encodeUtf8(m_signalBuffer + size, text, length);
+        m_signalBuffer[size++] = '\n';
+
+        // the allocated message is leaked, it cannot be released from a signal handler
+        record.heap = nullptr;
+
+        record.sequence.store(pos + m_mask + 1, std::memory_order_release);
+        m_dequeuePos.store(++pos, std::memory_order_release);
+    }
+
+    if (size > 0) {
+        writeAll(fd, m_signalBuffer, size);
+    }
+
+    m_consuming.store(False, std::memory_order_release);
+}
+#endif
+
+//---------------------------------------------------------------------------------------
+// Crash handlers
+//---------------------------------------------------------------------------------------
+
+static std::atomic<Bool> ms_crashHandler(False);
+static std::terminate_handler ms_previousTerminate = nullptr;
+
+static void onTerminate()
+{
+    AsyncLogger::flushOnCrash();
+
+    if (ms_previousTerminate) {
+        ms_previousTerminate();
+    }
+
+    abort();
+}
+
+#ifdef O3D_WINDOWS
+static LPTOP_LEVEL_EXCEPTION_FILTER ms_previousFilter = nullptr;
+
+static LONG WINAPI onUnhandledException(EXCEPTION_POINTERS *info)
+{
+    AsyncLogger::flushOnCrash();
+
+    if (ms_previousFilter) {
+        return ms_previousFilter(info);
+    }
+
+    return EXCEPTION_CONTINUE_SEARCH;
+}
+#else
+static const int ms_fatalSignals[] = { SIGSEGV, SIGBUS, SIGFPE, SIGILL, SIGABRT, 0 };
+static struct sigaction ms_previousActions[5];
+
+static void onFatalSignal(int sig)
+{
+    // only async-signal-safe calls, the full flush is done by the terminate handler
+    AsyncLogger::flushOnSignal();
+
+    // restore the previous handler and raise again
+    for (Int32 i = 0; ms_fatalSignals[i]; ++i) {
+        if (ms_fatalSignals[i] == sig) {
+            sigaction(sig, &ms_previousActions[i], nullptr);
+            break;
+        }
+    }
+
+    raise(sig);
+}
+#endif
+
+void AsyncLogger::installCrashHandler()
+{
+    if (ms_crashHandler.exchange(True)) {
+        return;
+    }
+
+    ms_previousTerminate = std::set_terminate(onTerminate);
+
+#ifdef O3D_WINDOWS
+    ms_previousFilter = SetUnhandledExceptionFilter(onUnhandledException);
+#else
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+
+    action.sa_handler = onFatalSignal;
+    sigemptyset(&action.sa_mask);
+
+    for (Int32 i = 0; ms_fatalSignals[i]; ++i) {
+        sigaction(ms_fatalSignals[i], &action, &ms_previousActions[i]);
+    }
+#endif
+}
+
+//---------------------------------------------------------------------------------------
+// Ring buffer and writing
+//---------------------------------------------------------------------------------------
+
+Bool AsyncLogger::tryPush(Int64 time, const String &str)
+{
+    UInt32 pos = m_enqueuePos.load(std::memory_order_relaxed);
+    Record *record = nullptr;
+
+    for (;;) {
+        record = &m_records[pos & m_mask];
+
+        const UInt32 sequence = record->sequence.load(std::memory_order_acquire);
+        const Int32 diff = (Int32)(sequence - pos);
+
+        if (diff == 0) {
+            // free record, try to take it
+            if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // full
+            return False;
+        } else {
+            // taken by another thread
+            pos = m_enqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    record->time = time;
+
+    const Int32 length = str.length();
+    WChar *text = record->text;
+
+    if ((UInt32)length >= INLINE_LENGTH) {
+        text = record->heap = new WChar[length + 1];
+    }
+
+    if (length > 0) {
+        memcpy(text, str.getData(), length * sizeof(WChar));
+    }
+
+    text[length] = 0;
+
+    record->sequence.store(pos + 1, std::memory_order_release);
+    return True;
+}
+
+void AsyncLogger::writeRecord(Int64 time, const String &str)
+{
+    WriteLocker locker(this, m_writeMutex);
+
+    // keep the order with the pushed records
+    drain();
+
+    format(time, str.length() > 0 ? str.getData() : L"");
+    writeBatch();
+}
+
+UInt32 AsyncLogger::drain()
+{
+    // popped from a signal handler
+    if (m_consuming.exchange(True, std::memory_order_acquire)) {
+        return 0;
+    }
+
+    UInt32 count = 0;
+    UInt32 pos = m_dequeuePos.load(std::memory_order_relaxed);
+
+    for (;;) {
+        Record &record = m_records[pos & m_mask];
+
+        if ((Int32)(record.sequence.load(std::memory_order_acquire) - (pos + 1)) < 0) {
+            break;
+        }
+
+        format(record.time, record.heap ? record.heap : record.text);
+        deleteArray(record.heap);
+
+        // free for the next round of the ring
+        record.sequence.store(pos + m_mask + 1, std::memory_order_release);
+        m_dequeuePos.store(++pos, std::memory_order_release);
+
+        ++count;
+
+        if (m_batch.size() >= BATCH_SIZE) {
+            writeBatch();
+        }
+    }
+
+    const UInt64 dropped = m_numDropped.load();
+    if (dropped != m_numReported) {
+        String msg("<WRN> AsyncLogger: ");
+        msg << (dropped - m_numReported) << " log records dropped";
+
+        format(System::getTime(), msg.getData());
+        m_numReported = dropped;
+    }
+
+    writeBatch();
+
+    m_consuming.store(False, std::memory_order_release);
+
+    return count;
+}
+
+void AsyncLogger::format(Int64 time, const WChar *text)
+{
+    // same format as FileLogger
+    if (m_dateFormat.isValid()) {
+        const Int64 us = m_epochBase + (Int64)((Double)time * 1000000.0 / System::getTimeFrequency());
+        const Int64 second = us / 1000000;
+
+        // the date changes once per second, except with the microseconds
+        if (m_dateUs || second != m_lastSecond) {
+            DateTime date;
+            date.fromTimeUs(us, False);
+
+            String str = date.buildString(m_dateFormat);
+            if (!str.isEmpty()) {
+                str += ' ';
+            }
+
+            m_lastDate = str.toUtf8();
+            m_lastSecond = second;
+        }
+
+        if (m_lastDate.length() > 0) {
+            m_batch.insert(m_batch.end(), m_lastDate.getData(), m_lastDate.getData() + m_lastDate.length());
+        }
+    }
+
+    Char head[64];
+    Int32 len = snprintf(head, sizeof(head), "[%.5f] ", (Float)time / System::getTimeFrequency());
+    if (len > 0) {
+        m_batch.insert(m_batch.end(), head, head + o3d::min<Int32>(len, sizeof(head) - 1));
+    }
+
+    encodeUtf8(m_batch, text);
+
+    m_batch.push_back('\n');
+}
+
+void AsyncLogger::writeBatch()
+{
+    if (m_batch.empty()) {
+        return;
+    }
+
+    if (!m_os) {
+        // kept until the file is reopened, not forever
+        if (m_batch.size() >= BATCH_SIZE * 16) {
+            m_batch.clear();
+        }
+
+        return;
+    }
+
+    m_os->writer(m_batch.data(), 1, (UInt32)m_batch.size());
+    m_os->flush();
+
+    m_batch.clear();
+}
+
+void AsyncLogger::setStream(OutStream *os)
+{
+    WriteLocker locker(this, m_writeMutex);
+
+    // the pending records into the previous file
+    drain();
+
+    deletePtr(m_os);
+    m_os = os;
+
+    // and those kept while there was no file
+    writeBatch();
+}
+
+void AsyncLogger::wakeUpWriter()
+{
+    if (m_sleeping.load()) {
+        FastMutexLocker locker(m_sleepMutex);
+        m_wakeUp.wakeOne();
+    }
+}
+
+void AsyncLogger::process()
+{
+    while (m_running.load()) {
+        {
+            WriteLocker locker(this, m_writeMutex);
+            drain();
+        }
+
+        if (m_numBlocked.load() > 0) {
+            FastMutexLocker locker(m_sleepMutex);
+            m_freed.wakeAll();
+        }
+
+        // wait for more records to write them by batches. a caller pushing after the
+        // m_sleeping change sees it, or the pending records are seen here.
+        FastMutexLocker locker(m_sleepMutex);
+        m_sleeping = True;
+
+        const UInt32 pending = m_enqueuePos.load() - m_dequeuePos.load();
+
+        if (m_running.load() && pending < getCapacity() / 2 && m_numBlocked.load() == 0) {
+            m_wakeUp.wait(m_sleepMutex, m_flushDelay.load());
+        }
+
+        m_sleeping = False;
+    }
+}
@@ -0,0 +1,794 @@
+/**
+ * @file batchmath.cpp
+ * @brief Implementation of BatchMath.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/batchmath.h"
+
+#include "o3d/core/cpudispatch.h"
+
+#ifdef O3D_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+using namespace o3d;
+
+typedef void (*TransformFunc)(
+        const Float *m,
+        const ConstBatchVectors &src,
+        const BatchVectors &dst,
+        UInt32 n,
+        Bool point);
+
+typedef void (*NormalizeFunc)(const ConstBatchVectors &src, const BatchVectors &dst, UInt32 n);
+
+typedef void (*BoundsFunc)(const ConstBatchVectors &src, UInt32 n, Float *min, Float *max, Float *sum);
+
+namespace {
+
+enum Layout
+{
+    LAYOUT_SOA = 0,   //!< stride of 1
+    LAYOUT_AOS3,      //!< packed xyz
+    LAYOUT_STRIDED    //!< any other stride
+};
+
+template <class T>
+inline Layout layoutOf(const T &v)
+{
+    if (v.stride == 1) {
+        return LAYOUT_SOA;
+    } else if ((v.stride == 3) && (v.y == v.x + 1) && (v.z == v.x + 2)) {
+        return LAYOUT_AOS3;
+    } else {
+        return LAYOUT_STRIDED;
+    }
+}
+
+//---------------------------------------------------------------------------------------
+// Scalar, also used for the remaining vectors of the SIMD versions
+//---------------------------------------------------------------------------------------
+
+inline void transformOne(const Float *m, const ConstBatchVectors &src, const BatchVectors &dst, UInt32 i, Bool point)
+{
+    const UInt32 s = i * src.stride;
+    const UInt32 d = i * dst.stride;
+
+    const Float x = src.x[s], y = src.y[s], z = src.z[s];
+
+    Float ox = m[0]*x + m[4]*y + m[8]*z;
+    Float oy = m[1]*x + m[5]*y + m[9]*z;
+    Float oz = m[2]*x + m[6]*y + m[10]*z;
+
+    if (point) {
+        ox += m[12];
+        oy += m[13];
+        oz += m[14];
+    }
+
+    dst.x[d] = ox;
+    dst.y[d] = oy;
+    dst.z[d] = oz;
+}
+
+inline void normalizeOne(const ConstBatchVectors &src, const BatchVectors &dst, UInt32 i)
+{
+    const UInt32 s = i * src.stride;
+    const UInt32 d = i * dst.stride;
+
+    const Float x = src.x[s], y = src.y[s], z = src.z[s];
+    Float len = Math::sqrt(x*x + y*y + z*z);
+
+    if (len < Limits<Float>::epsilon()) {
+        dst.x[d] = 1.f;
+        dst.y[d] = 0.f;
+        dst.z[d] = 0.f;
+    } else {
+        len = 1.f / len;
+        dst.x[d] = x * len;
+        dst.y[d] = y * len;
+        dst.z[d] = z * len;
+    }
+}
+
+inline void boundsRange(const ConstBatchVectors &src, UInt32 first, UInt32 last, Float *min, Float *max, Float *sum)
+{
+    for (UInt32 i = first; i < last; ++i) {
+        const UInt32 s = i * src.stride;
+        const Float v[3] = { src.x[s], src.y[s], src.z[s] };
+
+        for (Int32 c = 0; c < 3; ++c) {
+            min[c] = o3d::min(min[c], v[c]);
+            max[c] = o3d::max(max[c], v[c]);
+            sum[c] += v[c];
+        }
+    }
+}
+
+void transformScalar(const Float *m, const ConstBatchVectors &src, const BatchVectors &dst, UInt32 n, Bool point)
+{
+    // local copy, else reloaded after each store because the destination can alias it
+    Float c[16];
+    memcpy(c, m, sizeof(c));
+
+    for (UInt32 i = 0; i < n; ++i) {
+        transformOne(c, src, dst, i, point);
+    }
+}
+
+void normalizeScalar(const ConstBatchVectors &src, const BatchVectors &dst, UInt32 n)
+{
+    for (UInt32 i = 0; i < n; ++i) {
+        normalizeOne(src, dst, i);
+    }
+}
+
+void boundsScalar(const ConstBatchVectors &src, UInt32 n, Float *min, Float *max, Float *sum)
+{
+    min[0] = max[0] = src.x[0];
+    min[1] = max[1] = src.y[0];
+    min[2] = max[2] = src.z[0];
+    sum[0] = sum[1] = sum[2] = 0.f;
+
+    boundsRange(src, 0, n, min, max, sum);
+}
+
+#ifdef O3D_SIMD_X86
+
+//---------------------------------------------------------------------------------------
+// SSE2, 4 vectors per iteration
+//---------------------------------------------------------------------------------------
+
+//! [x0 y0 z0 x1] [y1 z1 x2 y2] [z2 x3 y3 z3] to [x0..x3] [y0..y3] [z0..z3]
+O3D_SIMD_TARGET_SSE2
+inline void deinterleaveSSE2(__m128 a, __m128 b, __m128 c, __m128 &x, __m128 &y, __m128 &z)
+{
+    const __m128 u = _mm_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2));
+    x = _mm_shuffle_ps(a, u, _MM_SHUFFLE(2, 0, 3, 0));
+
+    const __m128 v = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const __m128 w = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    y = _mm_shuffle_ps(v, w, _MM_SHUFFLE(2, 0, 2, 0));
+
+    const __m128 p = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 q = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+    z = _mm_shuffle_ps(p, q, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+//! Inverse of deinterleaveSSE2
+O3D_SIMD_TARGET_SSE2
+inline void interleaveSSE2(__m128 x, __m128 y, __m128 z, __m128 &a, __m128 &b, __m128 &c)
+{
+    const __m128 xy01 = _mm_unpacklo_ps(x, y);
+    const __m128 xy23 = _mm_unpackhi_ps(x, y);
+
+    a = _mm_shuffle_ps(xy01, _mm_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+    b = _mm_shuffle_ps(_mm_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0));
+    c = _mm_shuffle_ps(
+            _mm_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+            _mm_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+O3D_SIMD_TARGET_SSE2
+inline void loadSSE2(Layout layout, const ConstBatchVectors &v, UInt32 i, __m128 &x, __m128 &y, __m128 &z)
+{
+    if (layout == LAYOUT_SOA) {
+        x = _mm_loadu_ps(v.x + i);
+        y = _mm_loadu_ps(v.y + i);
+        z = _mm_loadu_ps(v.z + i);
+    } else if (layout == LAYOUT_AOS3) {
+        const Float *p = v.x + i * 3;
+        deinterleaveSSE2(_mm_loadu_ps(p), _mm_loadu_ps(p + 4), _mm_loadu_ps(p + 8), x, y, z);
+    } else {
+        const UInt32 s = v.stride;
+        const Float *px = v.x + i * s, *py = v.y + i * s, *pz = v.z + i * s;
+
+        x = _mm_setr_ps(px[0], px[s], px[2*s], px[3*s]);
+        y = _mm_setr_ps(py[0], py[s], py[2*s], py[3*s]);
+        z = _mm_setr_ps(pz[0], pz[s], pz[2*s], pz[3*s]);
+    }
+}
+
+O3D_SIMD_TARGET_SSE2
+inline void storeSSE2(Layout layout, const BatchVectors &v, UInt32 i, __m128 x, __m128 y, __m128 z)
+{
+    if (layout == LAYOUT_SOA) {
+        _mm_storeu_ps(v.x + i, x);
+        _mm_storeu_ps(v.y + i, y);
+        _mm_storeu_ps(v.z + i, z);
+    } else if (layout == LAYOUT_AOS3) {
+        Float *p = v.x + i * 3;
+        __m128 a, b, c;
+        interleaveSSE2(x, y, z, a, b, c);
+
+        _mm_storeu_ps(p, a);
+        _mm_storeu_ps(p + 4, b);
+        _mm_storeu_ps(p + 8, c);
+    } else {
+        O3D_ALIGN(16) Float t[12];
+        _mm_store_ps(t, x);
+        _mm_store_ps(t + 4, y);
+        _mm_store_ps(t + 8, z);
+
+        const UInt32 s = v.stride;
+        for (UInt32 k = 0; k < 4; ++k) {
+            const UInt32 d = (i + k) * s;
+            v.x[d] = t[k];
+            v.y[d] = t[4+k];
+            v.z[d] = t[8+k];
+        }
+    }
+}
+
+O3D_SIMD_TARGET_SSE2
+void transformSSE2(const Float *m, const ConstBatchVectors &src, const BatchVectors &dst, UInt32 n, Bool point)
+{
+    const Layout srcLayout = layoutOf(src);
+    const Layout dstLayout = layoutOf(dst);
+
+    const __m128 m0 = _mm_set1_ps(m[0]), m1 = _mm_set1_ps(m[1]), m2 = _mm_set1_ps(m[2]);
+    const __m128 m4 = _mm_set1_ps(m[4]), m5 = _mm_set1_ps(m[5]), m6 = _mm_set1_ps(m[6]);
+    const __m128 m8 = _mm_set1_ps(m[8]), m9 = _mm_set1_ps(m[9]), m10 = _mm_set1_ps(m[10]);
+
+    const __m128 tx = point ? _mm_set1_ps(m[12]) : _mm_setzero_ps();
+    const __m128 ty = point ? _mm_set1_ps(m[13]) : _mm_setzero_ps();
+    const __m128 tz = point ? _mm_set1_ps(m[14]) : _mm_setzero_ps();
+
+    UInt32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        loadSSE2(srcLayout, src, i, x, y, z);
+
+        const __m128 ox = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m0, x), _mm_mul_ps(m4, y)), _mm_mul_ps(m8, z)), tx);
+        const __m128 oy = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m1, x), _mm_mul_ps(m5, y)), _mm_mul_ps(m9, z)), ty);
+        const __m128 oz = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(m2, x), _mm_mul_ps(m6, y)), _mm_mul_ps(m10, z)), tz);
+
+        storeSSE2(dstLayout, dst, i, ox, oy, oz);
+    }
+
+    for (; i < n; ++i) {
+        transformOne(m, src, dst, i, point);
+    }
+}
+
+O3D_SIMD_TARGET_SSE2
+void normalizeSSE2(const ConstBatchVectors &src, const BatchVectors &dst, UInt32 n)
+{
+    const Layout srcLayout = layoutOf(src);
+    const Layout dstLayout = layoutOf(dst);
+
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 eps = _mm_set1_ps(Limits<Float>::epsilon());
+
+    UInt32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        loadSSE2(srcLayout, src, i, x, y, z);
+
+        const __m128 len = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z)));
+        const __m128 valid = _mm_cmpge_ps(len, eps);
+        const __m128 inv = _mm_div_ps(one, len);
+
+        x = _mm_or_ps(_mm_and_ps(valid, _mm_mul_ps(x, inv)), _mm_andnot_ps(valid, one));
+        y = _mm_and_ps(valid, _mm_mul_ps(y, inv));
+        z = _mm_and_ps(valid, _mm_mul_ps(z, inv));
+
+        storeSSE2(dstLayout, dst, i, x, y, z);
+    }
+
+    for (; i < n; ++i) {
+        normalizeOne(src, dst, i);
+    }
+}
+
+O3D_SIMD_TARGET_SSE2
+void boundsSSE2(const ConstBatchVectors &src, UInt32 n, Float *min, Float *max, Float *sum)
+{
+    const Layout layout = layoutOf(src);
+
+    __m128 minX = _mm_set1_ps(src.x[0]), minY = _mm_set1_ps(src.y[0]), minZ = _mm_set1_ps(src.z[0]);
+    __m128 maxX = minX, maxY = minY, maxZ = minZ;
+    __m128 sumX = _mm_setzero_ps(), sumY = _mm_setzero_ps(), sumZ = _mm_setzero_ps();
+
+    UInt32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128 x, y, z;
+        loadSSE2(layout, src, i, x, y, z);
+
+        minX = _mm_min_ps(minX, x); minY = _mm_min_ps(minY, y); minZ = _mm_min_ps(minZ, z);
+        maxX = _mm_max_ps(maxX, x); maxY = _mm_max_ps(maxY, y); maxZ = _mm_max_ps(maxZ, z);
+        sumX = _mm_add_ps(sumX, x); sumY = _mm_add_ps(sumY, y); sumZ = _mm_add_ps(sumZ, z);
+    }
+
+    O3D_ALIGN(16) Float t[9][4];
+    _mm_store_ps(t[0], minX); _mm_store_ps(t[1], minY); _mm_store_ps(t[2], minZ);
+    _mm_store_ps(t[3], maxX); _mm_store_ps(t[4], maxY); _mm_store_ps(t[5], maxZ);
+    _mm_store_ps(t[6], sumX); _mm_store_ps(t[7], sumY); _mm_store_ps(t[8], sumZ);
+
+    for (Int32 c = 0; c < 3; ++c) {
+        min[c] = o3d::min(o3d::min(t[c][0], t[c][1]), o3d::min(t[c][2], t[c][3]));
+        max[c] = o3d::max(o3d::max(t[3+c][0], t[3+c][1]), o3d::max(t[3+c][2], t[3+c][3]));
+        sum[c] = (t[6+c][0] + t[6+c][1]) + (t[6+c][2] + t[6+c][3]);
+    }
+
+    boundsRange(src, i, n, min, max, sum);
+}
+
+//---------------------------------------------------------------------------------------
+// AVX2, 8 vectors per iteration
+//---------------------------------------------------------------------------------------
+
+//! Same as deinterleaveSSE2 on each 128 bits lane.
+O3D_SIMD_TARGET_AVX2
+inline void deinterleaveAVX2(__m256 a, __m256 b, __m256 c, __m256 &x, __m256 &y, __m256 &z)
+{
+    const __m256 u = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2));
+    x = _mm256_shuffle_ps(a, u, _MM_SHUFFLE(2, 0, 3, 0));
+
+    const __m256 v = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const __m256 w = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    y = _mm256_shuffle_ps(v, w, _MM_SHUFFLE(2, 0, 2, 0));
+
+    const __m256 p = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m256 q = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+    z = _mm256_shuffle_ps(p, q, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+//! Same as interleaveSSE2 on each 128 bits lane.
+O3D_SIMD_TARGET_AVX2
+inline void interleaveAVX2(__m256 x, __m256 y, __m256 z, __m256 &a, __m256 &b, __m256 &c)
+{
+    const __m256 xy01 = _mm256_unpacklo_ps(x, y);
+    const __m256 xy23 = _mm256_unpackhi_ps(x, y);
+
+    a = _mm256_shuffle_ps(xy01, _mm256_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+    b = _mm256_shuffle_ps(_mm256_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0));
+    c = _mm256_shuffle_ps(
+            _mm256_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+            _mm256_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+O3D_SIMD_TARGET_AVX2
+inline void loadAVX2(Layout layout, const ConstBatchVectors &v, UInt32 i, __m256i offsets, __m256 &x, __m256 &y, __m256 &z)
+{
+    if (layout == LAYOUT_SOA) {
+        x = _mm256_loadu_ps(v.x + i);
+        y = _mm256_loadu_ps(v.y + i);
+        z = _mm256_loadu_ps(v.z + i);
+    } else if (layout == LAYOUT_AOS3) {
+        // lane 0 with the vectors 0..3, lane 1 with the vectors 4..7
+        const Float *p = v.x + i * 3;
+        const __m256 r0 = _mm256_loadu_ps(p);
+        const __m256 r1 = _mm256_loadu_ps(p + 8);
+        const __m256 r2 = _mm256_loadu_ps(p + 16);
+
+        deinterleaveAVX2(
+                _mm256_permute2f128_ps(r0, r1, 0x30),
+                _mm256_permute2f128_ps(r0, r2, 0x21),
+                _mm256_permute2f128_ps(r1, r2, 0x30),
+                x, y, z);
+    } else {
+        const UInt32 s = i * v.stride;
+        x = _mm256_i32gather_ps(v.x + s, offsets, 4);
+        y = _mm256_i32gather_ps(v.y + s, offsets, 4);
+        z = _mm256_i32gather_ps(v.z + s, offsets, 4);
+    }
+}
+
+O3D_SIMD_TARGET_AVX2
+inline void storeAVX2(Layout layout, const BatchVectors &v, UInt32 i, __m256 x, __m256 y, __m256 z)
+{
+    if (layout == LAYOUT_SOA) {
+        _mm256_storeu_ps(v.x + i, x);
+        _mm256_storeu_ps(v.y + i, y);
+        _mm256_storeu_ps(v.z + i, z);
+    } else if (layout == LAYOUT_AOS3) {
+        Float *p = v.x + i * 3;
+        __m256 a, b, c;
+        interleaveAVX2(x, y, z, a, b, c);
+
+        _mm256_storeu_ps(p, _mm256_permute2f128_ps(a, b, 0x20));
+        _mm256_storeu_ps(p + 8, _mm256_permute2f128_ps(c, a, 0x30));
+        _mm256_storeu_ps(p + 16, _mm256_permute2f128_ps(b, c, 0x31));
+    } else {
+        O3D_ALIGN(32) Float t[24];
+        _mm256_store_ps(t, x);
+        _mm256_store_ps(t + 8, y);
+        _mm256_store_ps(t + 16, z);
+
+        const UInt32 s = v.stride;
+        for (UInt32 k = 0; k < 8; ++k) {
+            const UInt32 d = (i + k) * s;
+            v.x[d] = t[k];
+            v.y[d] = t[8+k];
+            v.z[d] = t[16+k];
+        }
+    }
+}
+
+O3D_SIMD_TARGET_AVX2
+inline __m256i offsetsAVX2(UInt32 stride)
+{
+    return _mm256_mullo_epi32(_mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7), _mm256_set1_epi32((Int32)stride));
+}
+
+O3D_SIMD_TARGET_AVX2
+void transformAVX2(const Float *m, const ConstBatchVectors &src, const BatchVectors &dst, UInt32 n, Bool point)
+{
+    const Layout srcLayout = layoutOf(src);
+    const Layout dstLayout = layoutOf(dst);
+    const __m256i offsets = offsetsAVX2(src.stride);
+
+    const __m256 m0 = _mm256_set1_ps(m[0]), m1 = _mm256_set1_ps(m[1]), m2 = _mm256_set1_ps(m[2]);
+    const __m256 m4 = _mm256_set1_ps(m[4]), m5 = _mm256_set1_ps(m[5]), m6 = _mm256_set1_ps(m[6]);
+    const __m256 m8 = _mm256_set1_ps(m[8]), m9 = _mm256_set1_ps(m[9]), m10 = _mm256_set1_ps(m[10]);
+
+    const __m256 tx = point ? _mm256_set1_ps(m[12]) : _mm256_setzero_ps();
+    const __m256 ty = point ? _mm256_set1_ps(m[13]) : _mm256_setzero_ps();
+    const __m256 tz = point ? _mm256_set1_ps(m[14]) : _mm256_setzero_ps();
+
+    UInt32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        loadAVX2(srcLayout, src, i, offsets, x, y, z);
+
+        const __m256 ox = _mm256_fmadd_ps(m8, z, _mm256_fmadd_ps(m4, y, _mm256_fmadd_ps(m0, x, tx)));
+        const __m256 oy = _mm256_fmadd_ps(m9, z, _mm256_fmadd_ps(m5, y, _mm256_fmadd_ps(m1, x, ty)));
+        const __m256 oz = _mm256_fmadd_ps(m10, z, _mm256_fmadd_ps(m6, y, _mm256_fmadd_ps(m2, x, tz)));
+
+        storeAVX2(dstLayout, dst, i, ox, oy, oz);
+    }
+
+    for (; i < n; ++i) {
+        transformOne(m, src, dst, i, point);
+    }
+}
+
+O3D_SIMD_TARGET_AVX2
+void normalizeAVX2(const ConstBatchVectors &src, const BatchVectors &dst, UInt32 n)
+{
+    const Layout srcLayout = layoutOf(src);
+    const Layout dstLayout = layoutOf(dst);
+    const __m256i offsets = offsetsAVX2(src.stride);
+
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 eps = _mm256_set1_ps(Limits<Float>::epsilon());
+
+    UInt32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        loadAVX2(srcLayout, src, i, offsets, x, y, z);
+
+        const __m256 len = _mm256_sqrt_ps(_mm256_fmadd_ps(z, z, _mm256_fmadd_ps(y, y, _mm256_mul_ps(x, x))));
+        const __m256 valid = _mm256_cmp_ps(len, eps, _CMP_GE_OQ);
+        const __m256 inv = _mm256_div_ps(one, len);
+
+        x = _mm256_blendv_ps(one, _mm256_mul_ps(x, inv), valid);
+        y = _mm256_and_ps(valid, _mm256_mul_ps(y, inv));
+        z = _mm256_and_ps(valid, _mm256_mul_ps(z, inv));
+
+        storeAVX2(dstLayout, dst, i, x, y, z);
+    }
+
+    for (; i < n; ++i) {
+        normalizeOne(src, dst, i);
+    }
+}
+
+O3D_SIMD_TARGET_AVX2
+void boundsAVX2(const ConstBatchVectors &src, UInt32 n, Float *min, Float *max, Float *sum)
+{
+    const Layout layout = layoutOf(src);
+    const __m256i offsets = offsetsAVX2(src.stride);
+
+    __m256 minX = _mm256_set1_ps(src.x[0]), minY = _mm256_set1_ps(src.y[0]), minZ = _mm256_set1_ps(src.z[0]);
+    __m256 maxX = minX, maxY = minY, maxZ = minZ;
+    __m256 sumX = _mm256_setzero_ps(), sumY = _mm256_setzero_ps(), sumZ = _mm256_setzero_ps();
+
+    UInt32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256 x, y, z;
+        loadAVX2(layout, src, i, offsets, x, y, z);
+
+        minX = _mm256_min_ps(minX, x); minY = _mm256_min_ps(minY, y); minZ = _mm256_min_ps(minZ, z);
+        maxX = _mm256_max_ps(maxX, x); maxY = _mm256_max_ps(maxY, y); maxZ = _mm256_max_ps(maxZ, z);
+        sumX = _mm256_add_ps(sumX, x); sumY = _mm256_add_ps(sumY, y); sumZ = _mm256_add_ps(sumZ, z);
+    }
+
+    O3D_ALIGN(32) Float t[9][8];
+    _mm256_store_ps(t[0], minX); _mm256_store_ps(t[1], minY); _mm256_store_ps(t[2], minZ);
+    _mm256_store_ps(t[3], maxX); _mm256_store_ps(t[4], maxY); _mm256_store_ps(t[5], maxZ);
+    _mm256_store_ps(t[6], sumX); _mm256_store_ps(t[7], sumY); _mm256_store_ps(t[8], sumZ);
+
+    for (Int32 c = 0; c < 3; ++c) {
+        min[c] = t[c][0];
+        max[c] = t[3+c][0];
+        sum[c] = 0.f;
+
+        for (Int32 k = 0; k < 8; ++k) {
+            min[c] = o3d::min(min[c], t[c][k]);
+            max[c] = o3d::max(max[c], t[3+c][k]);
+            sum[c] += t[6+c][k];
+        }
+    }
+
+    boundsRange(src, i, n, min, max, sum);
+}
+
+//---------------------------------------------------------------------------------------
+// AVX-512, 16 vectors per iteration
+//---------------------------------------------------------------------------------------
+
+//! Same as deinterleaveSSE2 on each 128 bits lane.
+O3D_SIMD_TARGET_AVX512
+inline void deinterleaveAVX512(__m512 a, __m512 b, __m512 c, __m512 &x, __m512 &y, __m512 &z)
+{
+    const __m512 u = _mm512_shuffle_ps(b, c, _MM_SHUFFLE(0, 1, 0, 2));
+    x = _mm512_shuffle_ps(a, u, _MM_SHUFFLE(2, 0, 3, 0));
+
+    const __m512 v = _mm512_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const __m512 w = _mm512_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    y = _mm512_shuffle_ps(v, w, _MM_SHUFFLE(2, 0, 2, 0));
+
+    const __m512 p = _mm512_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m512 q = _mm512_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+    z = _mm512_shuffle_ps(p, q, _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+//! Same as interleaveSSE2 on each 128 bits lane.
+O3D_SIMD_TARGET_AVX512
+inline void interleaveAVX512(__m512 x, __m512 y, __m512 z, __m512 &a, __m512 &b, __m512 &c)
+{
+    const __m512 xy01 = _mm512_unpacklo_ps(x, y);
+    const __m512 xy23 = _mm512_unpackhi_ps(x, y);
+
+    a = _mm512_shuffle_ps(xy01, _mm512_shuffle_ps(z, x, _MM_SHUFFLE(1, 1, 0, 0)), _MM_SHUFFLE(2, 0, 1, 0));
+    b = _mm512_shuffle_ps(_mm512_shuffle_ps(y, z, _MM_SHUFFLE(1, 1, 1, 1)), xy23, _MM_SHUFFLE(1, 0, 2, 0));
+    c = _mm512_shuffle_ps(
+            _mm512_shuffle_ps(z, x, _MM_SHUFFLE(3, 3, 2, 2)),
+            _mm512_shuffle_ps(y, z, _MM_SHUFFLE(3, 3, 3, 3)),
+            _MM_SHUFFLE(2, 0, 2, 0));
+}
+
+O3D_SIMD_TARGET_AVX512
+inline void loadAVX512(Layout layout, const ConstBatchVectors &v, UInt32 i, __m512i offsets, __m512 &x, __m512 &y, __m512 &z)
+{
+    if (layout == LAYOUT_SOA) {
+        x = _mm512_loadu_ps(v.x + i);
+        y = _mm512_loadu_ps(v.y + i);
+        z = _mm512_loadu_ps(v.z + i);
+    } else if (layout == LAYOUT_AOS3) {
+        // the lane k with the vectors 4k..4k+3, from the 128 bits parts of 48 floats
+        const Float *p = v.x + i * 3;
+        const __m512 r0 = _mm512_loadu_ps(p);
+        const __m512 r1 = _mm512_loadu_ps(p + 16);
+        const __m512 r2 = _mm512_loadu_ps(p + 32);
+
+        const __m512i ia = _mm512_setr_epi32(0, 1, 2, 3, 12, 13, 14, 15, 24, 25, 26, 27, 0, 0, 0, 0);
+        const __m512i ib = _mm512_setr_epi32(4, 5, 6, 7, 16, 17, 18, 19, 28, 29, 30, 31, 0, 0, 0, 0);
+        const __m512i ic = _mm512_setr_epi32(8, 9, 10, 11, 20, 21, 22, 23, 0, 0, 0, 0, 0, 0, 0, 0);
+
+        const __m512 a = _mm512_insertf32x4(_mm512_permutex2var_ps(r0, ia, r1), _mm512_extractf32x4_ps(r2, 1), 3);
+        const __m512 b = _mm512_insertf32x4(_mm512_permutex2var_ps(r0, ib, r1), _mm512_extractf32x4_ps(r2, 2), 3);
+        const __m512 c = _mm512_shuffle_f32x4(_mm512_permutex2var_ps(r0, ic, r1), r2, _MM_SHUFFLE(3, 0, 1, 0));
+
+        deinterleaveAVX512(a, b, c, x, y, z);
+    } else {
+        const UInt32 s = i * v.stride;
+        x = _mm512_i32gather_ps(offsets, v.x + s, 4);
+        y = _mm512_i32gather_ps(offsets, v.y + s, 4);
+        z = _mm512_i32gather_ps(offsets, v.z + s, 4);
+    }
+}
+
+O3D_SIMD_TARGET_AVX512
+inline void storeAVX512(Layout layout, const BatchVectors &v, UInt32 i, __m512i offsets, __m512 x, __m512 y, __m512 z)
+{
+    if (layout == LAYOUT_SOA) {
+        _mm512_storeu_ps(v.x + i, x);
+        _mm512_storeu_ps(v.y + i, y);
+        _mm512_storeu_ps(v.z + i, z);
+    } else if (layout == LAYOUT_AOS3) {
+        Float *p = v.x + i * 3;
+        __m512 a, b, c;
+        interleaveAVX512(x, y, z, a, b, c);
+
+        const __m512i i0 = _mm512_setr_epi32(0, 1, 2, 3, 16, 17, 18, 19, 0, 0, 0, 0, 4, 5, 6, 7);
+        const __m512i i1 = _mm512_setr_epi32(4, 5, 6, 7, 20, 21, 22, 23, 0, 0, 0, 0, 8, 9, 10, 11);
+        const __m512i i2 = _mm512_setr_epi32(8, 9, 10, 11, 28, 29, 30, 31, 0, 0, 0, 0, 12, 13, 14, 15);
+
+        _mm512_storeu_ps(p, _mm512_insertf32x4(_mm512_permutex2var_ps(a, i0, b), _mm512_extractf32x4_ps(c, 0), 2));
+        _mm512_storeu_ps(p + 16, _mm512_insertf32x4(_mm512_permutex2var_ps(b, i1, c), _mm512_extractf32x4_ps(a, 2), 2));
+        _mm512_storeu_ps(p + 32, _mm512_insertf32x4(_mm512_permutex2var_ps(c, i2, a), _mm512_extractf32x4_ps(b, 3), 2));
+    } else {
+        const UInt32 s = i * v.stride;
+        _mm512_i32scatter_ps(v.x + s, offsets, x, 4);
+        _mm512_i32scatter_ps(v.y + s, offsets, y, 4);
+        _mm512_i32scatter_ps(v.z + s, offsets, z, 4);
+    }
+}
+
+O3D_SIMD_TARGET_AVX512
+inline __m512i offsetsAVX512(UInt32 stride)
+{
+    return _mm512_mullo_epi32(
+                _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15),
+                _mm512_set1_epi32((Int32)stride));
+}
+
+O3D_SIMD_TARGET_AVX512
+void transformAVX512(const Float *m, const ConstBatchVectors &src, const BatchVectors &dst, UInt32 n, Bool point)
+{
+    const Layout srcLayout = layoutOf(src);
+    const Layout dstLayout = layoutOf(dst);
+    const __m512i srcOffsets = offsetsAVX512(src.stride);
+    const __m512i dstOffsets = offsetsAVX512(dst.stride);
+
+    const __m512 m0 = _mm512_set1_ps(m[0]), m1 = _mm512_set1_ps(m[1]), m2 = _mm512_set1_ps(m[2]);
+    const __m512 m4 = _mm512_set1_ps(m[4]), m5 = _mm512_set1_ps(m[5]), m6 = _mm512_set1_ps(m[6]);
+    const __m512 m8 = _mm512_set1_ps(m[8]), m9 = _mm512_set1_ps(m[9]), m10 = _mm512_set1_ps(m[10]);
+
+    const __m512 tx = point ? _mm512_set1_ps(m[12]) : _mm512_setzero_ps();
+    const __m512 ty = point ? _mm512_set1_ps(m[13]) : _mm512_setzero_ps();
+    const __m512 tz = point ? _mm512_set1_ps(m[14]) : _mm512_setzero_ps();
+
+    UInt32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 x, y, z;
+        loadAVX512(srcLayout, src, i, srcOffsets, x, y, z);
+
+        const __m512 ox = _mm512_fmadd_ps(m8, z, _mm512_fmadd_ps(m4, y, _mm512_fmadd_ps(m0, x, tx)));
+        const __m512 oy = _mm512_fmadd_ps(m9, z, _mm512_fmadd_ps(m5, y, _mm512_fmadd_ps(m1, x, ty)));
+        const __m512 oz = _mm512_fmadd_ps(m10, z, _mm512_fmadd_ps(m6, y, _mm512_fmadd_ps(m2, x, tz)));
+
+        storeAVX512(dstLayout, dst, i, dstOffsets, ox, oy, oz);
+    }
+
+    for (; i < n; ++i) {
+        transformOne(m, src, dst, i, point);
+    }
+}
+
+O3D_SIMD_TARGET_AVX512
+void normalizeAVX512(const ConstBatchVectors &src, const BatchVectors &dst, UInt32 n)
+{
+    const Layout srcLayout = layoutOf(src);
+    const Layout dstLayout = layoutOf(dst);
+    const __m512i srcOffsets = offsetsAVX512(src.stride);
+    const __m512i dstOffsets = offsetsAVX512(dst.stride);
+
+    const __m512 one = _mm512_set1_ps(1.f);
+    const __m512 eps = _mm512_set1_ps(Limits<Float>::epsilon());
+
+    UInt32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 x, y, z;
+        loadAVX512(srcLayout, src, i, srcOffsets, x, y, z);
+
+        const __m512 len = _mm512_sqrt_ps(_mm512_fmadd_ps(z, z, _mm512_fmadd_ps(y, y, _mm512_mul_ps(x, x))));
+        const __mmask16 valid = _mm512_cmp_ps_mask(len, eps, _CMP_GE_OQ);
+        const __m512 inv = _mm512_div_ps(one, len);
+
+        x = _mm512_mask_mul_ps(one, valid, x, inv);
+        y = _mm512_maskz_mul_ps(valid, y, inv);
+        z = _mm512_maskz_mul_ps(valid, z, inv);
+
+        storeAVX512(dstLayout, dst, i, dstOffsets, x, y, z);
+    }
+
+    for (; i < n; ++i) {
+        normalizeOne(src, dst, i);
+    }
+}
+
+O3D_SIMD_TARGET_AVX512
+void boundsAVX512(const ConstBatchVectors &src, UInt32 n, Float *min, Float *max, Float *sum)
+{
+    const Layout layout = layoutOf(src);
+    const __m512i offsets = offsetsAVX512(src.stride);
+
+    __m512 minX = _mm512_set1_ps(src.x[0]), minY = _mm512_set1_ps(src.y[0]), minZ = _mm512_set1_ps(src.z[0]);
+    __m512 maxX = minX, maxY = minY, maxZ = minZ;
+    __m512 sumX = _mm512_setzero_ps(), sumY = _mm512_setzero_ps(), sumZ = _mm512_setzero_ps();
+
+    UInt32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m512 x, y, z;
+        loadAVX512(layout, src, i, offsets, x, y, z);
+
+        minX = _mm512_min_ps(minX, x); minY = _mm512_min_ps(minY, y); minZ = _mm512_min_ps(minZ, z);
+        maxX = _mm512_max_ps(maxX, x); maxY = _mm512_max_ps(maxY, y); maxZ = _mm512_max_ps(maxZ, z);
+        sumX = _mm512_add_ps(sumX, x); sumY = _mm512_add_ps(sumY, y); sumZ = _mm512_add_ps(sumZ, z);
+    }
+
+    min[0] = _mm512_reduce_min_ps(minX); min[1] = _mm512_reduce_min_ps(minY); min[2] = _mm512_reduce_min_ps(minZ);
+    max[0] = _mm512_reduce_max_ps(maxX); max[1] = _mm512_reduce_max_ps(maxY); max[2] = _mm512_reduce_max_ps(maxZ);
+    sum[0] = _mm512_reduce_add_ps(sumX); sum[1] = _mm512_reduce_add_ps(sumY); sum[2] = _mm512_reduce_add_ps(sumZ);
+
+    boundsRange(src, i, n, min, max, sum);
+}
+
+#endif // O3D_SIMD_X86
+
+TransformFunc transformKernel()
+{
+    static const TransformFunc func = SimdKernel<TransformFunc>(transformScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, transformSSE2)
+            .add(SIMD_AVX2, transformAVX2)
+            .add(SIMD_AVX512, transformAVX512)
+#endif
+            .get();
+
+    return func;
+}
+
+} // anonymous namespace
+
+void BatchMath::transformPoints(
+        const Matrix4 &m,
+        const ConstBatchVectors &src,
+        const BatchVectors &dst,
+        UInt32 n)
+{
+    transformKernel()(m.getData(), src, dst, n, True);
+}
+
+void BatchMath::transformNormals(
+        const Matrix4 &m,
+        const ConstBatchVectors &src,
+        const BatchVectors &dst,
+        UInt32 n)
+{
+    transformKernel()(m.getData(), src, dst, n, False);
+}
+
+void BatchMath::normalize(
+        const ConstBatchVectors &src,
+        const BatchVectors &dst,
+        UInt32 n)
+{
+    static const NormalizeFunc func = SimdKernel<NormalizeFunc>(normalizeScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, normalizeSSE2)
+            .add(SIMD_AVX2, normalizeAVX2)
+            .add(SIMD_AVX512, normalizeAVX512)
+#endif
+            .get();
+
+    func(src, dst, n);
+}
+
+void BatchMath::bounds(
+        const ConstBatchVectors &src,
+        UInt32 n,
+        Vector3 &min,
+        Vector3 &max,
+        Vector3 *sum)
+{
+    static const BoundsFunc func = SimdKernel<BoundsFunc>(boundsScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, boundsSSE2)
+            .add(SIMD_AVX2, boundsAVX2)
+            .add(SIMD_AVX512, boundsAVX512)
+#endif
+            .get();
+
+    if (n == 0) {
+        return;
+    }
+
+    Float s[3];
+    func(src, n, min.getData(), max.getData(), s);
+
+    if (sum) {
+        sum->set(s[0], s[1], s[2]);
+    }
+}
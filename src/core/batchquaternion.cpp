@@ -0,0 +1,1191 @@
+/**
+ * @file batchquaternion.cpp
+ * @brief Implementation of BatchQuaternion.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/batchquaternion.h"
+
+#include "o3d/core/cpudispatch.h"
+
+#include <math.h>
+
+#ifdef O3D_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+using namespace o3d;
+
+typedef void (*InterpolateFunc)(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n, Bool corrected);
+
+typedef void (*InterpolateDualFunc)(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n);
+
+typedef void (*ConvertFunc)(const Float *src, Float *dst, UInt32 n);
+
+namespace {
+
+//---------------------------------------------------------------------------------------
+// Scalar, also used for the remaining quaternions of the SIMD versions
+//---------------------------------------------------------------------------------------
+
+//! Adjust t such as the normalized linear interpolation gets close to the spherical one,
+//! from the cosine d of the angle between the quaternions.
+inline Float correctedT(Float d, Float t)
+{
+    const Float h = t - 0.5f;
+    const Float a = 1.0904f + d * (-3.2452f + d * (3.55645f - d * 1.43519f));
+    const Float b = 0.848013f + d * (-1.06021f + d * 0.215638f);
+    const Float k = a * h * h + b;
+
+    return t + t * h * (t - 1.f) * k;
+}
+
+inline void normalizeValues(Float x, Float y, Float z, Float w, Float *dst)
+{
+    const Float len2 = x*x + y*y + z*z + w*w;
+
+    if (len2 == 0.f) {
+        dst[0] = dst[1] = dst[2] = 0.f;
+        dst[3] = 1.f;
+    } else {
+        const Float s = 1.f / sqrtf(len2);
+        dst[0] = x * s;
+        dst[1] = y * s;
+        dst[2] = z * s;
+        dst[3] = w * s;
+    }
+}
+
+inline void interpolateOne(const Float *a, const Float *b, Float t, Float *dst, BatchQuaternion::Interpolation mode)
+{
+    const Float cosom = a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3];
+    const Float sign = cosom < 0.f ? -1.f : 1.f;
+
+    Float u, v;
+
+    if (mode == BatchQuaternion::SLERP) {
+        const Float c = cosom * sign;
+
+        if ((1.f - c) > Limits<Float>::epsilon()) {
+            const Float omega = acosf(c);
+            const Float sinom = sinf(omega);
+
+            u = sinf((1.f - t) * omega) / sinom;
+            v = sinf(t * omega) / sinom;
+        } else {
+            // very close quaternions
+            u = 1.f - t;
+            v = t;
+        }
+    } else {
+        if (mode == BatchQuaternion::NLERP_CORRECTED) {
+            t = correctedT(cosom * sign, t);
+        }
+
+        u = 1.f - t;
+        v = t;
+    }
+
+    v *= sign;
+    normalizeValues(a[0]*u + b[0]*v, a[1]*u + b[1]*v, a[2]*u + b[2]*v, a[3]*u + b[3]*v, dst);
+}
+
+inline void rotationOne(const Float *q, Float *m)
+{
+    const Float x2 = q[0] + q[0], y2 = q[1] + q[1], z2 = q[2] + q[2];
+    const Float xx = q[0] * x2, xy = q[0] * y2, xz = q[0] * z2;
+    const Float yy = q[1] * y2, yz = q[1] * z2, zz = q[2] * z2;
+    const Float wx = q[3] * x2, wy = q[3] * y2, wz = q[3] * z2;
+
+    m[0] = 1.f - (yy + zz); m[1] = xy + wz;         m[2] = xz - wy;          m[3] = 0.f;
+    m[4] = xy - wz;         m[5] = 1.f - (xx + zz); m[6] = yz + wx;          m[7] = 0.f;
+    m[8] = xz + wy;         m[9] = yz - wx;         m[10] = 1.f - (xx + yy); m[11] = 0.f;
+}
+
+inline void toMatrixOne(const Float *q, Float *m)
+{
+    rotationOne(q, m);
+
+    m[12] = m[13] = m[14] = 0.f;
+    m[15] = 1.f;
+}
+
+//! Unit real part and dual part orthogonal to it.
+inline void normalizeDualValues(const Float *r, const Float *d, Float *dst)
+{
+    const Float len2 = r[0]*r[0] + r[1]*r[1] + r[2]*r[2] + r[3]*r[3];
+
+    if (len2 == 0.f) {
+        dst[0] = dst[1] = dst[2] = 0.f;
+        dst[3] = 1.f;
+        dst[4] = dst[5] = dst[6] = dst[7] = 0.f;
+    } else {
+        const Float s = 1.f / sqrtf(len2);
+        const Float rx = r[0] * s, ry = r[1] * s, rz = r[2] * s, rw = r[3] * s;
+        const Float dx = d[0] * s, dy = d[1] * s, dz = d[2] * s, dw = d[3] * s;
+        const Float k = rx*dx + ry*dy + rz*dz + rw*dw;
+
+        dst[0] = rx; dst[1] = ry; dst[2] = rz; dst[3] = rw;
+        dst[4] = dx - rx*k; dst[5] = dy - ry*k; dst[6] = dz - rz*k; dst[7] = dw - rw*k;
+    }
+}
+
+inline void interpolateDualOne(const Float *a, const Float *b, Float t, Float *dst)
+{
+    const Float cosom = a[0]*b[0] + a[1]*b[1] + a[2]*b[2] + a[3]*b[3];
+    const Float u = 1.f - t;
+    const Float v = cosom < 0.f ? -t : t;
+
+    Float r[4], d[4];
+    for (Int32 c = 0; c < 4; ++c) {
+        r[c] = a[c]*u + b[c]*v;
+        d[c] = a[4+c]*u + b[4+c]*v;
+    }
+
+    normalizeDualValues(r, d, dst);
+}
+
+inline void dualToMatrixOne(const Float *q, Float *m)
+{
+    rotationOne(q, m);
+
+    // 2 * dual * conjugate(real)
+    const Float rx = q[0], ry = q[1], rz = q[2], rw = q[3];
+    const Float dx = q[4], dy = q[5], dz = q[6], dw = q[7];
+
+    m[12] = 2.f * (rw*dx - dw*rx + ry*dz - rz*dy);
+    m[13] = 2.f * (rw*dy - dw*ry + rz*dx - rx*dz);
+    m[14] = 2.f * (rw*dz - dw*rz + rx*dy - ry*dx);
+    m[15] = 1.f;
+}
+
+void interpolateScalar(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n, Bool corrected)
+{
+    const BatchQuaternion::Interpolation mode = corrected ? BatchQuaternion::NLERP_CORRECTED : BatchQuaternion::NLERP;
+
+    for (UInt32 i = 0; i < n; ++i) {
+        interpolateOne(from + i*4, to + i*4, t[i], dst + i*4, mode);
+    }
+}
+
+void normalizeScalar(const Float *src, Float *dst, UInt32 n)
+{
+    for (UInt32 i = 0; i < n; ++i) {
+        const Float *q = src + i*4;
+        normalizeValues(q[0], q[1], q[2], q[3], dst + i*4);
+    }
+}
+
+void toMatrixScalar(const Float *src, Float *matrices, UInt32 n)
+{
+    for (UInt32 i = 0; i < n; ++i) {
+        toMatrixOne(src + i*4, matrices + i*16);
+    }
+}
+
+void interpolateDualScalar(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n)
+{
+    for (UInt32 i = 0; i < n; ++i) {
+        interpolateDualOne(from + i*8, to + i*8, t[i], dst + i*8);
+    }
+}
+
+void normalizeDualScalar(const Float *src, Float *dst, UInt32 n)
+{
+    for (UInt32 i = 0; i < n; ++i) {
+        normalizeDualValues(src + i*8, src + i*8 + 4, dst + i*8);
+    }
+}
+
+void dualToMatrixScalar(const Float *src, Float *matrices, UInt32 n)
+{
+    for (UInt32 i = 0; i < n; ++i) {
+        dualToMatrixOne(src + i*8, matrices + i*16);
+    }
+}
+
+#ifdef O3D_SIMD_X86
+
+//---------------------------------------------------------------------------------------
+// SSE2, 4 quaternions per iteration
+//---------------------------------------------------------------------------------------
+
+//! Components of 4 quaternions.
+struct QuatSSE2
+{
+    __m128 x, y, z, w;
+};
+
+O3D_SIMD_TARGET_SSE2
+inline void transposeSSE2(__m128 &r0, __m128 &r1, __m128 &r2, __m128 &r3)
+{
+    const __m128 t0 = _mm_unpacklo_ps(r0, r1);
+    const __m128 t1 = _mm_unpacklo_ps(r2, r3);
+    const __m128 t2 = _mm_unpackhi_ps(r0, r1);
+    const __m128 t3 = _mm_unpackhi_ps(r2, r3);
+
+    r0 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(1,0,1,0));
+    r1 = _mm_shuffle_ps(t0, t1, _MM_SHUFFLE(3,2,3,2));
+    r2 = _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(1,0,1,0));
+    r3 = _mm_shuffle_ps(t2, t3, _MM_SHUFFLE(3,2,3,2));
+}
+
+//! Load the quaternions q, q+stride, q+2*stride and q+3*stride.
+O3D_SIMD_TARGET_SSE2
+inline QuatSSE2 loadSSE2(const Float *q, UInt32 stride)
+{
+    QuatSSE2 r = {
+        _mm_loadu_ps(q), _mm_loadu_ps(q + stride), _mm_loadu_ps(q + 2*stride), _mm_loadu_ps(q + 3*stride) };
+
+    transposeSSE2(r.x, r.y, r.z, r.w);
+    return r;
+}
+
+O3D_SIMD_TARGET_SSE2
+inline void storeSSE2(Float *q, UInt32 stride, QuatSSE2 r)
+{
+    transposeSSE2(r.x, r.y, r.z, r.w);
+
+    _mm_storeu_ps(q, r.x);
+    _mm_storeu_ps(q + stride, r.y);
+    _mm_storeu_ps(q + 2*stride, r.z);
+    _mm_storeu_ps(q + 3*stride, r.w);
+}
+
+O3D_SIMD_TARGET_SSE2
+inline __m128 dotSSE2(const QuatSSE2 &a, const QuatSSE2 &b)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z)), _mm_mul_ps(a.w, b.w));
+}
+
+//! r = a*u + b*v
+O3D_SIMD_TARGET_SSE2
+inline QuatSSE2 blendSSE2(const QuatSSE2 &a, const QuatSSE2 &b, __m128 u, __m128 v)
+{
+    const QuatSSE2 r = {
+        _mm_add_ps(_mm_mul_ps(a.x, u), _mm_mul_ps(b.x, v)),
+        _mm_add_ps(_mm_mul_ps(a.y, u), _mm_mul_ps(b.y, v)),
+        _mm_add_ps(_mm_mul_ps(a.z, u), _mm_mul_ps(b.z, v)),
+        _mm_add_ps(_mm_mul_ps(a.w, u), _mm_mul_ps(b.w, v)) };
+
+    return r;
+}
+
+O3D_SIMD_TARGET_SSE2
+inline QuatSSE2 scaleSSE2(const QuatSSE2 &a, __m128 s)
+{
+    const QuatSSE2 r = { _mm_mul_ps(a.x, s), _mm_mul_ps(a.y, s), _mm_mul_ps(a.z, s), _mm_mul_ps(a.w, s) };
+    return r;
+}
+
+//! Inverse of the length, and the mask of the null quaternions.
+O3D_SIMD_TARGET_SSE2
+inline __m128 invLengthSSE2(const QuatSSE2 &q, __m128 &null)
+{
+    const __m128 len2 = dotSSE2(q, q);
+    null = _mm_cmpeq_ps(len2, _mm_setzero_ps());
+
+    return _mm_div_ps(_mm_set1_ps(1.f), _mm_sqrt_ps(len2));
+}
+
+//! The null quaternions become the identity.
+O3D_SIMD_TARGET_SSE2
+inline QuatSSE2 identityIfSSE2(const QuatSSE2 &q, __m128 null)
+{
+    const QuatSSE2 r = {
+        _mm_andnot_ps(null, q.x),
+        _mm_andnot_ps(null, q.y),
+        _mm_andnot_ps(null, q.z),
+        _mm_or_ps(_mm_andnot_ps(null, q.w), _mm_and_ps(null, _mm_set1_ps(1.f))) };
+
+    return r;
+}
+
+O3D_SIMD_TARGET_SSE2
+inline __m128 correctedSSE2(__m128 d, __m128 t)
+{
+    const __m128 h = _mm_sub_ps(t, _mm_set1_ps(0.5f));
+
+    __m128 a = _mm_sub_ps(_mm_set1_ps(3.55645f), _mm_mul_ps(d, _mm_set1_ps(1.43519f)));
+    a = _mm_add_ps(_mm_set1_ps(-3.2452f), _mm_mul_ps(d, a));
+    a = _mm_add_ps(_mm_set1_ps(1.0904f), _mm_mul_ps(d, a));
+
+    __m128 b = _mm_add_ps(_mm_set1_ps(-1.06021f), _mm_mul_ps(d, _mm_set1_ps(0.215638f)));
+    b = _mm_add_ps(_mm_set1_ps(0.848013f), _mm_mul_ps(d, b));
+
+    const __m128 k = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(a, h), h), b);
+    return _mm_add_ps(t, _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, h), _mm_sub_ps(t, _mm_set1_ps(1.f))), k));
+}
+
+//! Store the matrices of 4 quaternions, with the translations tx, ty, tz.
+O3D_SIMD_TARGET_SSE2
+inline void matricesSSE2(const QuatSSE2 &q, __m128 tx, __m128 ty, __m128 tz, Float *m)
+{
+    const __m128 one = _mm_set1_ps(1.f);
+    const __m128 zero = _mm_setzero_ps();
+
+    const __m128 x2 = _mm_add_ps(q.x, q.x), y2 = _mm_add_ps(q.y, q.y), z2 = _mm_add_ps(q.z, q.z);
+    const __m128 xx = _mm_mul_ps(q.x, x2), xy = _mm_mul_ps(q.x, y2), xz = _mm_mul_ps(q.x, z2);
+    const __m128 yy = _mm_mul_ps(q.y, y2), yz = _mm_mul_ps(q.y, z2), zz = _mm_mul_ps(q.z, z2);
+    const __m128 wx = _mm_mul_ps(q.w, x2), wy = _mm_mul_ps(q.w, y2), wz = _mm_mul_ps(q.w, z2);
+
+    // the components of each column for the 4 quaternions
+    __m128 c[4][4] = {
+        { _mm_sub_ps(one, _mm_add_ps(yy, zz)), _mm_add_ps(xy, wz), _mm_sub_ps(xz, wy), zero },
+        { _mm_sub_ps(xy, wz), _mm_sub_ps(one, _mm_add_ps(xx, zz)), _mm_add_ps(yz, wx), zero },
+        { _mm_add_ps(xz, wy), _mm_sub_ps(yz, wx), _mm_sub_ps(one, _mm_add_ps(xx, yy)), zero },
+        { tx, ty, tz, one } };
+
+    for (Int32 col = 0; col < 4; ++col) {
+        transposeSSE2(c[col][0], c[col][1], c[col][2], c[col][3]);
+
+        for (Int32 k = 0; k < 4; ++k) {
+            _mm_storeu_ps(m + k*16 + col*4, c[col][k]);
+        }
+    }
+}
+
+O3D_SIMD_TARGET_SSE2
+void interpolateSSE2(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n, Bool corrected)
+{
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    const __m128 one = _mm_set1_ps(1.f);
+
+    UInt32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const QuatSSE2 a = loadSSE2(from + i*4, 4);
+        const QuatSSE2 b = loadSSE2(to + i*4, 4);
+
+        // shortest path, negate b when the dot product is negative
+        const __m128 cosom = dotSSE2(a, b);
+        const __m128 sign = _mm_and_ps(_mm_cmplt_ps(cosom, _mm_setzero_ps()), signMask);
+
+        __m128 v = _mm_loadu_ps(t + i);
+        if (corrected) {
+            v = correctedSSE2(_mm_xor_ps(cosom, sign), v);
+        }
+
+        const __m128 u = _mm_sub_ps(one, v);
+
+        __m128 null;
+        const QuatSSE2 r = blendSSE2(a, b, u, _mm_xor_ps(v, sign));
+        const __m128 s = invLengthSSE2(r, null);
+
+        storeSSE2(dst + i*4, 4, identityIfSSE2(scaleSSE2(r, s), null));
+    }
+
+    interpolateScalar(from + i*4, to + i*4, t + i, dst + i*4, n - i, corrected);
+}
+
+O3D_SIMD_TARGET_SSE2
+void normalizeSSE2(const Float *src, Float *dst, UInt32 n)
+{
+    UInt32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const QuatSSE2 q = loadSSE2(src + i*4, 4);
+
+        __m128 null;
+        const __m128 s = invLengthSSE2(q, null);
+
+        storeSSE2(dst + i*4, 4, identityIfSSE2(scaleSSE2(q, s), null));
+    }
+
+    normalizeScalar(src + i*4, dst + i*4, n - i);
+}
+
+O3D_SIMD_TARGET_SSE2
+void toMatrixSSE2(const Float *src, Float *matrices, UInt32 n)
+{
+    const __m128 zero = _mm_setzero_ps();
+
+    UInt32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        matricesSSE2(loadSSE2(src + i*4, 4), zero, zero, zero, matrices + i*16);
+    }
+
+    toMatrixScalar(src + i*4, matrices + i*16, n - i);
+}
+
+//! Normalize the real part r and make the dual part d orthogonal to it.
+O3D_SIMD_TARGET_SSE2
+inline void orthonormalizeSSE2(QuatSSE2 &r, QuatSSE2 &d)
+{
+    __m128 null;
+    const __m128 s = invLengthSSE2(r, null);
+
+    r = scaleSSE2(r, s);
+    d = scaleSSE2(d, s);
+
+    const __m128 k = dotSSE2(r, d);
+    d.x = _mm_andnot_ps(null, _mm_sub_ps(d.x, _mm_mul_ps(r.x, k)));
+    d.y = _mm_andnot_ps(null, _mm_sub_ps(d.y, _mm_mul_ps(r.y, k)));
+    d.z = _mm_andnot_ps(null, _mm_sub_ps(d.z, _mm_mul_ps(r.z, k)));
+    d.w = _mm_andnot_ps(null, _mm_sub_ps(d.w, _mm_mul_ps(r.w, k)));
+
+    r = identityIfSSE2(r, null);
+}
+
+O3D_SIMD_TARGET_SSE2
+void interpolateDualSSE2(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n)
+{
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    const __m128 one = _mm_set1_ps(1.f);
+
+    UInt32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const QuatSSE2 ar = loadSSE2(from + i*8, 8), ad = loadSSE2(from + i*8 + 4, 8);
+        const QuatSSE2 br = loadSSE2(to + i*8, 8), bd = loadSSE2(to + i*8 + 4, 8);
+
+        const __m128 sign = _mm_and_ps(_mm_cmplt_ps(dotSSE2(ar, br), _mm_setzero_ps()), signMask);
+        const __m128 v = _mm_loadu_ps(t + i);
+        const __m128 u = _mm_sub_ps(one, v);
+
+        QuatSSE2 r = blendSSE2(ar, br, u, _mm_xor_ps(v, sign));
+        QuatSSE2 d = blendSSE2(ad, bd, u, _mm_xor_ps(v, sign));
+
+        orthonormalizeSSE2(r, d);
+
+        storeSSE2(dst + i*8, 8, r);
+        storeSSE2(dst + i*8 + 4, 8, d);
+    }
+
+    interpolateDualScalar(from + i*8, to + i*8, t + i, dst + i*8, n - i);
+}
+
+O3D_SIMD_TARGET_SSE2
+void normalizeDualSSE2(const Float *src, Float *dst, UInt32 n)
+{
+    UInt32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        QuatSSE2 r = loadSSE2(src + i*8, 8), d = loadSSE2(src + i*8 + 4, 8);
+
+        orthonormalizeSSE2(r, d);
+
+        storeSSE2(dst + i*8, 8, r);
+        storeSSE2(dst + i*8 + 4, 8, d);
+    }
+
+    normalizeDualScalar(src + i*8, dst + i*8, n - i);
+}
+
+O3D_SIMD_TARGET_SSE2
+void dualToMatrixSSE2(const Float *src, Float *matrices, UInt32 n)
+{
+    const __m128 two = _mm_set1_ps(2.f);
+
+    UInt32 i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const QuatSSE2 r = loadSSE2(src + i*8, 8), d = loadSSE2(src + i*8 + 4, 8);
+
+        // 2 * dual * conjugate(real)
+        const __m128 tx = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(r.w, d.x), _mm_mul_ps(d.w, r.x)), _mm_sub_ps(_mm_mul_ps(r.y, d.z), _mm_mul_ps(r.z, d.y)));
+        const __m128 ty = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(r.w, d.y), _mm_mul_ps(d.w, r.y)), _mm_sub_ps(_mm_mul_ps(r.z, d.x), _mm_mul_ps(r.x, d.z)));
+        const __m128 tz = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(r.w, d.z), _mm_mul_ps(d.w, r.z)), _mm_sub_ps(_mm_mul_ps(r.x, d.y), _mm_mul_ps(r.y, d.x)));
+
+        matricesSSE2(r, _mm_mul_ps(two, tx), _mm_mul_ps(two, ty), _mm_mul_ps(two, tz), matrices + i*16);
+    }
+
+    dualToMatrixScalar(src + i*8, matrices + i*16, n - i);
+}
+
+//---------------------------------------------------------------------------------------
+// AVX2, 8 quaternions per iteration
+//---------------------------------------------------------------------------------------
+
+//! Components of 8 quaternions.
+struct QuatAVX2
+{
+    __m256 x, y, z, w;
+};
+
+//! Same as transposeSSE2 on each 128 bits lane.
+O3D_SIMD_TARGET_AVX2
+inline void transposeAVX2(__m256 &r0, __m256 &r1, __m256 &r2, __m256 &r3)
+{
+    const __m256 t0 = _mm256_unpacklo_ps(r0, r1);
+    const __m256 t1 = _mm256_unpacklo_ps(r2, r3);
+    const __m256 t2 = _mm256_unpackhi_ps(r0, r1);
+    const __m256 t3 = _mm256_unpackhi_ps(r2, r3);
+
+    r0 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1,0,1,0));
+    r1 = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3,2,3,2));
+    r2 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1,0,1,0));
+    r3 = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(3,2,3,2));
+}
+
+//! The row k holds the quaternions k and k+4, such as the components are in order.
+O3D_SIMD_TARGET_AVX2
+inline __m256 loadRowAVX2(const Float *q, UInt32 stride, UInt32 k)
+{
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(q + k*stride)), _mm_loadu_ps(q + (k+4)*stride), 1);
+}
+
+O3D_SIMD_TARGET_AVX2
+inline QuatAVX2 loadAVX2(const Float *q, UInt32 stride)
+{
+    QuatAVX2 r = {
+        loadRowAVX2(q, stride, 0), loadRowAVX2(q, stride, 1), loadRowAVX2(q, stride, 2), loadRowAVX2(q, stride, 3) };
+
+    transposeAVX2(r.x, r.y, r.z, r.w);
+    return r;
+}
+
+O3D_SIMD_TARGET_AVX2
+inline void storeAVX2(Float *q, UInt32 stride, QuatAVX2 r)
+{
+    transposeAVX2(r.x, r.y, r.z, r.w);
+
+    const __m256 rows[4] = { r.x, r.y, r.z, r.w };
+    for (UInt32 k = 0; k < 4; ++k) {
+        _mm_storeu_ps(q + k*stride, _mm256_castps256_ps128(rows[k]));
+        _mm_storeu_ps(q + (k+4)*stride, _mm256_extractf128_ps(rows[k], 1));
+    }
+}
+
+O3D_SIMD_TARGET_AVX2
+inline __m256 dotAVX2(const QuatAVX2 &a, const QuatAVX2 &b)
+{
+    return _mm256_fmadd_ps(a.w, b.w, _mm256_fmadd_ps(a.z, b.z, _mm256_fmadd_ps(a.y, b.y, _mm256_mul_ps(a.x, b.x))));
+}
+
+O3D_SIMD_TARGET_AVX2
+inline QuatAVX2 blendAVX2(const QuatAVX2 &a, const QuatAVX2 &b, __m256 u, __m256 v)
+{
+    const QuatAVX2 r = {
+        _mm256_fmadd_ps(a.x, u, _mm256_mul_ps(b.x, v)),
+        _mm256_fmadd_ps(a.y, u, _mm256_mul_ps(b.y, v)),
+        _mm256_fmadd_ps(a.z, u, _mm256_mul_ps(b.z, v)),
+        _mm256_fmadd_ps(a.w, u, _mm256_mul_ps(b.w, v)) };
+
+    return r;
+}
+
+O3D_SIMD_TARGET_AVX2
+inline QuatAVX2 scaleAVX2(const QuatAVX2 &a, __m256 s)
+{
+    const QuatAVX2 r = { _mm256_mul_ps(a.x, s), _mm256_mul_ps(a.y, s), _mm256_mul_ps(a.z, s), _mm256_mul_ps(a.w, s) };
+    return r;
+}
+
+O3D_SIMD_TARGET_AVX2
+inline __m256 invLengthAVX2(const QuatAVX2 &q, __m256 &null)
+{
+    const __m256 len2 = dotAVX2(q, q);
+    null = _mm256_cmp_ps(len2, _mm256_setzero_ps(), _CMP_EQ_OQ);
+
+    return _mm256_div_ps(_mm256_set1_ps(1.f), _mm256_sqrt_ps(len2));
+}
+
+O3D_SIMD_TARGET_AVX2
+inline QuatAVX2 identityIfAVX2(const QuatAVX2 &q, __m256 null)
+{
+    const QuatAVX2 r = {
+        _mm256_andnot_ps(null, q.x),
+        _mm256_andnot_ps(null, q.y),
+        _mm256_andnot_ps(null, q.z),
+        _mm256_blendv_ps(q.w, _mm256_set1_ps(1.f), null) };
+
+    return r;
+}
+
+O3D_SIMD_TARGET_AVX2
+inline __m256 correctedAVX2(__m256 d, __m256 t)
+{
+    const __m256 h = _mm256_sub_ps(t, _mm256_set1_ps(0.5f));
+
+    __m256 a = _mm256_fnmadd_ps(d, _mm256_set1_ps(1.43519f), _mm256_set1_ps(3.55645f));
+    a = _mm256_fmadd_ps(d, a, _mm256_set1_ps(-3.2452f));
+    a = _mm256_fmadd_ps(d, a, _mm256_set1_ps(1.0904f));
+
+    __m256 b = _mm256_fmadd_ps(d, _mm256_set1_ps(0.215638f), _mm256_set1_ps(-1.06021f));
+    b = _mm256_fmadd_ps(d, b, _mm256_set1_ps(0.848013f));
+
+    const __m256 k = _mm256_fmadd_ps(_mm256_mul_ps(a, h), h, b);
+    return _mm256_fmadd_ps(_mm256_mul_ps(_mm256_mul_ps(t, h), _mm256_sub_ps(t, _mm256_set1_ps(1.f))), k, t);
+}
+
+O3D_SIMD_TARGET_AVX2
+inline void matricesAVX2(const QuatAVX2 &q, __m256 tx, __m256 ty, __m256 tz, Float *m)
+{
+    const __m256 one = _mm256_set1_ps(1.f);
+    const __m256 zero = _mm256_setzero_ps();
+
+    const __m256 x2 = _mm256_add_ps(q.x, q.x), y2 = _mm256_add_ps(q.y, q.y), z2 = _mm256_add_ps(q.z, q.z);
+    const __m256 xx = _mm256_mul_ps(q.x, x2), xy = _mm256_mul_ps(q.x, y2), xz = _mm256_mul_ps(q.x, z2);
+    const __m256 yy = _mm256_mul_ps(q.y, y2), yz = _mm256_mul_ps(q.y, z2), zz = _mm256_mul_ps(q.z, z2);
+    const __m256 wx = _mm256_mul_ps(q.w, x2), wy = _mm256_mul_ps(q.w, y2), wz = _mm256_mul_ps(q.w, z2);
+
+    __m256 c[4][4] = {
+        { _mm256_sub_ps(one, _mm256_add_ps(yy, zz)), _mm256_add_ps(xy, wz), _mm256_sub_ps(xz, wy), zero },
+        { _mm256_sub_ps(xy, wz), _mm256_sub_ps(one, _mm256_add_ps(xx, zz)), _mm256_add_ps(yz, wx), zero },
+        { _mm256_add_ps(xz, wy), _mm256_sub_ps(yz, wx), _mm256_sub_ps(one, _mm256_add_ps(xx, yy)), zero },
+        { tx, ty, tz, one } };
+
+    // c[col][k] holds the column col of the quaternions k and k+4
+    for (Int32 col = 0; col < 4; ++col) {
+        transposeAVX2(c[col][0], c[col][1], c[col][2], c[col][3]);
+    }
+
+    for (Int32 k = 0; k < 4; ++k) {
+        _mm256_storeu_ps(m + k*16, _mm256_permute2f128_ps(c[0][k], c[1][k], 0x20));
+        _mm256_storeu_ps(m + k*16 + 8, _mm256_permute2f128_ps(c[2][k], c[3][k], 0x20));
+        _mm256_storeu_ps(m + (k+4)*16, _mm256_permute2f128_ps(c[0][k], c[1][k], 0x31));
+        _mm256_storeu_ps(m + (k+4)*16 + 8, _mm256_permute2f128_ps(c[2][k], c[3][k], 0x31));
+    }
+}
+
+O3D_SIMD_TARGET_AVX2
+void interpolateAVX2(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n, Bool corrected)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.f);
+    const __m256 one = _mm256_set1_ps(1.f);
+
+    UInt32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const QuatAVX2 a = loadAVX2(from + i*4, 4);
+        const QuatAVX2 b = loadAVX2(to + i*4, 4);
+
+        const __m256 cosom = dotAVX2(a, b);
+        const __m256 sign = _mm256_and_ps(_mm256_cmp_ps(cosom, _mm256_setzero_ps(), _CMP_LT_OQ), signMask);
+
+        __m256 v = _mm256_loadu_ps(t + i);
+        if (corrected) {
+            v = correctedAVX2(_mm256_xor_ps(cosom, sign), v);
+        }
+
+        const __m256 u = _mm256_sub_ps(one, v);
+
+        __m256 null;
+        const QuatAVX2 r = blendAVX2(a, b, u, _mm256_xor_ps(v, sign));
+        const __m256 s = invLengthAVX2(r, null);
+
+        storeAVX2(dst + i*4, 4, identityIfAVX2(scaleAVX2(r, s), null));
+    }
+
+    // leave the AVX state before the SSE2 remainder, the compiler does not for a tail call
+    _mm256_zeroupper();
+
+    interpolateSSE2(from + i*4, to + i*4, t + i, dst + i*4, n - i, corrected);
+}
+
+O3D_SIMD_TARGET_AVX2
+void normalizeAVX2(const Float *src, Float *dst, UInt32 n)
+{
+    UInt32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const QuatAVX2 q = loadAVX2(src + i*4, 4);
+
+        __m256 null;
+        const __m256 s = invLengthAVX2(q, null);
+
+        storeAVX2(dst + i*4, 4, identityIfAVX2(scaleAVX2(q, s), null));
+    }
+
+    _mm256_zeroupper();
+
+    normalizeSSE2(src + i*4, dst + i*4, n - i);
+}
+
+O3D_SIMD_TARGET_AVX2
+void toMatrixAVX2(const Float *src, Float *matrices, UInt32 n)
+{
+    const __m256 zero = _mm256_setzero_ps();
+
+    UInt32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        matricesAVX2(loadAVX2(src + i*4, 4), zero, zero, zero, matrices + i*16);
+    }
+
+    _mm256_zeroupper();
+
+    toMatrixSSE2(src + i*4, matrices + i*16, n - i);
+}
+
+O3D_SIMD_TARGET_AVX2
+inline void orthonormalizeAVX2(QuatAVX2 &r, QuatAVX2 &d)
+{
+    __m256 null;
+    const __m256 s = invLengthAVX2(r, null);
+
+    r = scaleAVX2(r, s);
+    d = scaleAVX2(d, s);
+
+    const __m256 k = dotAVX2(r, d);
+    d.x = _mm256_andnot_ps(null, _mm256_fnmadd_ps(r.x, k, d.x));
+    d.y = _mm256_andnot_ps(null, _mm256_fnmadd_ps(r.y, k, d.y));
+    d.z = _mm256_andnot_ps(null, _mm256_fnmadd_ps(r.z, k, d.z));
+    d.w = _mm256_andnot_ps(null, _mm256_fnmadd_ps(r.w, k, d.w));
+
+    r = identityIfAVX2(r, null);
+}
+
+O3D_SIMD_TARGET_AVX2
+void interpolateDualAVX2(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n)
+{
+    const __m256 signMask = _mm256_set1_ps(-0.f);
+    const __m256 one = _mm256_set1_ps(1.f);
+
+    UInt32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const QuatAVX2 ar = loadAVX2(from + i*8, 8), ad = loadAVX2(from + i*8 + 4, 8);
+        const QuatAVX2 br = loadAVX2(to + i*8, 8), bd = loadAVX2(to + i*8 + 4, 8);
+
+        const __m256 sign = _mm256_and_ps(_mm256_cmp_ps(dotAVX2(ar, br), _mm256_setzero_ps(), _CMP_LT_OQ), signMask);
+        const __m256 v = _mm256_loadu_ps(t + i);
+        const __m256 u = _mm256_sub_ps(one, v);
+
+        QuatAVX2 r = blendAVX2(ar, br, u, _mm256_xor_ps(v, sign));
+        QuatAVX2 d = blendAVX2(ad, bd, u, _mm256_xor_ps(v, sign));
+
+        orthonormalizeAVX2(r, d);
+
+        storeAVX2(dst + i*8, 8, r);
+        storeAVX2(dst + i*8 + 4, 8, d);
+    }
+
+    _mm256_zeroupper();
+
+    interpolateDualSSE2(from + i*8, to + i*8, t + i, dst + i*8, n - i);
+}
+
+O3D_SIMD_TARGET_AVX2
+void normalizeDualAVX2(const Float *src, Float *dst, UInt32 n)
+{
+    UInt32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        QuatAVX2 r = loadAVX2(src + i*8, 8), d = loadAVX2(src + i*8 + 4, 8);
+
+        orthonormalizeAVX2(r, d);
+
+        storeAVX2(dst + i*8, 8, r);
+        storeAVX2(dst + i*8 + 4, 8, d);
+    }
+
+    _mm256_zeroupper();
+
+    normalizeDualSSE2(src + i*8, dst + i*8, n - i);
+}
+
+O3D_SIMD_TARGET_AVX2
+void dualToMatrixAVX2(const Float *src, Float *matrices, UInt32 n)
+{
+    const __m256 two = _mm256_set1_ps(2.f);
+
+    UInt32 i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const QuatAVX2 r = loadAVX2(src + i*8, 8), d = loadAVX2(src + i*8 + 4, 8);
+
+        const __m256 tx = _mm256_fmsub_ps(r.w, d.x, _mm256_fmsub_ps(d.w, r.x, _mm256_fmsub_ps(r.y, d.z, _mm256_mul_ps(r.z, d.y))));
+        const __m256 ty = _mm256_fmsub_ps(r.w, d.y, _mm256_fmsub_ps(d.w, r.y, _mm256_fmsub_ps(r.z, d.x, _mm256_mul_ps(r.x, d.z))));
+        const __m256 tz = _mm256_fmsub_ps(r.w, d.z, _mm256_fmsub_ps(d.w, r.z, _mm256_fmsub_ps(r.x, d.y, _mm256_mul_ps(r.y, d.x))));
+
+        matricesAVX2(r, _mm256_mul_ps(two, tx), _mm256_mul_ps(two, ty), _mm256_mul_ps(two, tz), matrices + i*16);
+    }
+
+    _mm256_zeroupper();
+
+    dualToMatrixSSE2(src + i*8, matrices + i*16, n - i);
+}
+
+//---------------------------------------------------------------------------------------
+// AVX-512, 16 quaternions per iteration
+//---------------------------------------------------------------------------------------
+
+//! Components of 16 quaternions.
+struct QuatAVX512
+{
+    __m512 x, y, z, w;
+};
+
+//! Same as transposeSSE2 on each 128 bits lane.
+O3D_SIMD_TARGET_AVX512
+inline void transposeAVX512(__m512 &r0, __m512 &r1, __m512 &r2, __m512 &r3)
+{
+    const __m512 t0 = _mm512_unpacklo_ps(r0, r1);
+    const __m512 t1 = _mm512_unpacklo_ps(r2, r3);
+    const __m512 t2 = _mm512_unpackhi_ps(r0, r1);
+    const __m512 t3 = _mm512_unpackhi_ps(r2, r3);
+
+    r0 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(1,0,1,0));
+    r1 = _mm512_shuffle_ps(t0, t1, _MM_SHUFFLE(3,2,3,2));
+    r2 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(1,0,1,0));
+    r3 = _mm512_shuffle_ps(t2, t3, _MM_SHUFFLE(3,2,3,2));
+}
+
+//! The row k holds the quaternions k, k+4, k+8 and k+12.
+O3D_SIMD_TARGET_AVX512
+inline __m512 loadRowAVX512(const Float *q, UInt32 stride, UInt32 k)
+{
+    __m512 r = _mm512_castps128_ps512(_mm_loadu_ps(q + k*stride));
+    r = _mm512_insertf32x4(r, _mm_loadu_ps(q + (k+4)*stride), 1);
+    r = _mm512_insertf32x4(r, _mm_loadu_ps(q + (k+8)*stride), 2);
+    return _mm512_insertf32x4(r, _mm_loadu_ps(q + (k+12)*stride), 3);
+}
+
+O3D_SIMD_TARGET_AVX512
+inline QuatAVX512 loadAVX512(const Float *q, UInt32 stride)
+{
+    QuatAVX512 r = {
+        loadRowAVX512(q, stride, 0), loadRowAVX512(q, stride, 1), loadRowAVX512(q, stride, 2), loadRowAVX512(q, stride, 3) };
+
+    transposeAVX512(r.x, r.y, r.z, r.w);
+    return r;
+}
+
+O3D_SIMD_TARGET_AVX512
+inline void storeAVX512(Float *q, UInt32 stride, QuatAVX512 r)
+{
+    transposeAVX512(r.x, r.y, r.z, r.w);
+
+    const __m512 rows[4] = { r.x, r.y, r.z, r.w };
+    for (UInt32 k = 0; k < 4; ++k) {
+        _mm_storeu_ps(q + k*stride, _mm512_castps512_ps128(rows[k]));
+        _mm_storeu_ps(q + (k+4)*stride, _mm512_extractf32x4_ps(rows[k], 1));
+        _mm_storeu_ps(q + (k+8)*stride, _mm512_extractf32x4_ps(rows[k], 2));
+        _mm_storeu_ps(q + (k+12)*stride, _mm512_extractf32x4_ps(rows[k], 3));
+    }
+}
+
+O3D_SIMD_TARGET_AVX512
+inline __m512 dotAVX512(const QuatAVX512 &a, const QuatAVX512 &b)
+{
+    return _mm512_fmadd_ps(a.w, b.w, _mm512_fmadd_ps(a.z, b.z, _mm512_fmadd_ps(a.y, b.y, _mm512_mul_ps(a.x, b.x))));
+}
+
+O3D_SIMD_TARGET_AVX512
+inline QuatAVX512 blendAVX512(const QuatAVX512 &a, const QuatAVX512 &b, __m512 u, __m512 v)
+{
+    const QuatAVX512 r = {
+        _mm512_fmadd_ps(a.x, u, _mm512_mul_ps(b.x, v)),
+        _mm512_fmadd_ps(a.y, u, _mm512_mul_ps(b.y, v)),
+        _mm512_fmadd_ps(a.z, u, _mm512_mul_ps(b.z, v)),
+        _mm512_fmadd_ps(a.w, u, _mm512_mul_ps(b.w, v)) };
+
+    return r;
+}
+
+O3D_SIMD_TARGET_AVX512
+inline QuatAVX512 scaleAVX512(const QuatAVX512 &a, __m512 s)
+{
+    const QuatAVX512 r = { _mm512_mul_ps(a.x, s), _mm512_mul_ps(a.y, s), _mm512_mul_ps(a.z, s), _mm512_mul_ps(a.w, s) };
+    return r;
+}
+
+O3D_SIMD_TARGET_AVX512
+inline __m512 invLengthAVX512(const QuatAVX512 &q, __mmask16 &null)
+{
+    const __m512 len2 = dotAVX512(q, q);
+    null = _mm512_cmp_ps_mask(len2, _mm512_setzero_ps(), _CMP_EQ_OQ);
+
+    return _mm512_div_ps(_mm512_set1_ps(1.f), _mm512_sqrt_ps(len2));
+}
+
+O3D_SIMD_TARGET_AVX512
+inline QuatAVX512 identityIfAVX512(const QuatAVX512 &q, __mmask16 null)
+{
+    const __m512 zero = _mm512_setzero_ps();
+    const QuatAVX512 r = {
+        _mm512_mask_mov_ps(q.x, null, zero),
+        _mm512_mask_mov_ps(q.y, null, zero),
+        _mm512_mask_mov_ps(q.z, null, zero),
+        _mm512_mask_mov_ps(q.w, null, _mm512_set1_ps(1.f)) };
+
+    return r;
+}
+
+O3D_SIMD_TARGET_AVX512
+inline __m512 correctedAVX512(__m512 d, __m512 t)
+{
+    const __m512 h = _mm512_sub_ps(t, _mm512_set1_ps(0.5f));
+
+    __m512 a = _mm512_fnmadd_ps(d, _mm512_set1_ps(1.43519f), _mm512_set1_ps(3.55645f));
+    a = _mm512_fmadd_ps(d, a, _mm512_set1_ps(-3.2452f));
+    a = _mm512_fmadd_ps(d, a, _mm512_set1_ps(1.0904f));
+
+    __m512 b = _mm512_fmadd_ps(d, _mm512_set1_ps(0.215638f), _mm512_set1_ps(-1.06021f));
+    b = _mm512_fmadd_ps(d, b, _mm512_set1_ps(0.848013f));
+
+    const __m512 k = _mm512_fmadd_ps(_mm512_mul_ps(a, h), h, b);
+    return _mm512_fmadd_ps(_mm512_mul_ps(_mm512_mul_ps(t, h), _mm512_sub_ps(t, _mm512_set1_ps(1.f))), k, t);
+}
+
+O3D_SIMD_TARGET_AVX512
+inline void matricesAVX512(const QuatAVX512 &q, __m512 tx, __m512 ty, __m512 tz, Float *m)
+{
+    const __m512 one = _mm512_set1_ps(1.f);
+    const __m512 zero = _mm512_setzero_ps();
+
+    const __m512 x2 = _mm512_add_ps(q.x, q.x), y2 = _mm512_add_ps(q.y, q.y), z2 = _mm512_add_ps(q.z, q.z);
+    const __m512 xx = _mm512_mul_ps(q.x, x2), xy = _mm512_mul_ps(q.x, y2), xz = _mm512_mul_ps(q.x, z2);
+    const __m512 yy = _mm512_mul_ps(q.y, y2), yz = _mm512_mul_ps(q.y, z2), zz = _mm512_mul_ps(q.z, z2);
+    const __m512 wx = _mm512_mul_ps(q.w, x2), wy = _mm512_mul_ps(q.w, y2), wz = _mm512_mul_ps(q.w, z2);
+
+    __m512 c[4][4] = {
+        { _mm512_sub_ps(one, _mm512_add_ps(yy, zz)), _mm512_add_ps(xy, wz), _mm512_sub_ps(xz, wy), zero },
+        { _mm512_sub_ps(xy, wz), _mm512_sub_ps(one, _mm512_add_ps(xx, zz)), _mm512_add_ps(yz, wx), zero },
+        { _mm512_add_ps(xz, wy), _mm512_sub_ps(yz, wx), _mm512_sub_ps(one, _mm512_add_ps(xx, yy)), zero },
+        { tx, ty, tz, one } };
+
+    // c[col][k] holds the column col of the quaternions k, k+4, k+8 and k+12
+    for (Int32 col = 0; col < 4; ++col) {
+        transposeAVX512(c[col][0], c[col][1], c[col][2], c[col][3]);
+    }
+
+    // then regroup the 4 columns of each quaternion
+    for (Int32 k = 0; k < 4; ++k) {
+        const __m512 t0 = _mm512_shuffle_f32x4(c[0][k], c[1][k], 0x44);
+        const __m512 t1 = _mm512_shuffle_f32x4(c[2][k], c[3][k], 0x44);
+        const __m512 t2 = _mm512_shuffle_f32x4(c[0][k], c[1][k], 0xee);
+        const __m512 t3 = _mm512_shuffle_f32x4(c[2][k], c[3][k], 0xee);
+
+        _mm512_storeu_ps(m + k*16, _mm512_shuffle_f32x4(t0, t1, 0x88));
+        _mm512_storeu_ps(m + (k+4)*16, _mm512_shuffle_f32x4(t0, t1, 0xdd));
+        _mm512_storeu_ps(m + (k+8)*16, _mm512_shuffle_f32x4(t2, t3, 0x88));
+        _mm512_storeu_ps(m + (k+12)*16, _mm512_shuffle_f32x4(t2, t3, 0xdd));
+    }
+}
+
+O3D_SIMD_TARGET_AVX512
+void interpolateAVX512(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n, Bool corrected)
+{
+    const __m512 one = _mm512_set1_ps(1.f);
+
+    UInt32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const QuatAVX512 a = loadAVX512(from + i*4, 4);
+        const QuatAVX512 b = loadAVX512(to + i*4, 4);
+
+        const __m512 cosom = dotAVX512(a, b);
+        const __mmask16 negative = _mm512_cmp_ps_mask(cosom, _mm512_setzero_ps(), _CMP_LT_OQ);
+
+        __m512 v = _mm512_loadu_ps(t + i);
+        if (corrected) {
+            v = correctedAVX512(_mm512_abs_ps(cosom), v);
+        }
+
+        const __m512 u = _mm512_sub_ps(one, v);
+
+        __mmask16 null;
+        const QuatAVX512 r = blendAVX512(a, b, u, _mm512_mask_sub_ps(v, negative, _mm512_setzero_ps(), v));
+        const __m512 s = invLengthAVX512(r, null);
+
+        storeAVX512(dst + i*4, 4, identityIfAVX512(scaleAVX512(r, s), null));
+    }
+
+    interpolateAVX2(from + i*4, to + i*4, t + i, dst + i*4, n - i, corrected);
+}
+
+O3D_SIMD_TARGET_AVX512
+void normalizeAVX512(const Float *src, Float *dst, UInt32 n)
+{
+    UInt32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const QuatAVX512 q = loadAVX512(src + i*4, 4);
+
+        __mmask16 null;
+        const __m512 s = invLengthAVX512(q, null);
+
+        storeAVX512(dst + i*4, 4, identityIfAVX512(scaleAVX512(q, s), null));
+    }
+
+    normalizeAVX2(src + i*4, dst + i*4, n - i);
+}
+
+O3D_SIMD_TARGET_AVX512
+void toMatrixAVX512(const Float *src, Float *matrices, UInt32 n)
+{
+    const __m512 zero = _mm512_setzero_ps();
+
+    UInt32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        matricesAVX512(loadAVX512(src + i*4, 4), zero, zero, zero, matrices + i*16);
+    }
+
+    toMatrixAVX2(src + i*4, matrices + i*16, n - i);
+}
+
+O3D_SIMD_TARGET_AVX512
+inline void orthonormalizeAVX512(QuatAVX512 &r, QuatAVX512 &d)
+{
+    __mmask16 null;
+    const __m512 s = invLengthAVX512(r, null);
+
+    r = scaleAVX512(r, s);
+    d = scaleAVX512(d, s);
+
+    // the dual part of a null real part is zeroed
+    const __mmask16 valid = _mm512_knot(null);
+    const __m512 k = dotAVX512(r, d);
+
+    d.x = _mm512_maskz_mov_ps(valid, _mm512_fnmadd_ps(r.x, k, d.x));
+    d.y = _mm512_maskz_mov_ps(valid, _mm512_fnmadd_ps(r.y, k, d.y));
+    d.z = _mm512_maskz_mov_ps(valid, _mm512_fnmadd_ps(r.z, k, d.z));
+    d.w = _mm512_maskz_mov_ps(valid, _mm512_fnmadd_ps(r.w, k, d.w));
+
+    r = identityIfAVX512(r, null);
+}
+
+O3D_SIMD_TARGET_AVX512
+void interpolateDualAVX512(const Float *from, const Float *to, const Float *t, Float *dst, UInt32 n)
+{
+    const __m512 one = _mm512_set1_ps(1.f);
+
+    UInt32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const QuatAVX512 ar = loadAVX512(from + i*8, 8), ad = loadAVX512(from + i*8 + 4, 8);
+        const QuatAVX512 br = loadAVX512(to + i*8, 8), bd = loadAVX512(to + i*8 + 4, 8);
+
+        const __mmask16 negative = _mm512_cmp_ps_mask(dotAVX512(ar, br), _mm512_setzero_ps(), _CMP_LT_OQ);
+        const __m512 v = _mm512_loadu_ps(t + i);
+        const __m512 u = _mm512_sub_ps(one, v);
+        const __m512 sv = _mm512_mask_sub_ps(v, negative, _mm512_setzero_ps(), v);
+
+        QuatAVX512 r = blendAVX512(ar, br, u, sv);
+        QuatAVX512 d = blendAVX512(ad, bd, u, sv);
+
+        orthonormalizeAVX512(r, d);
+
+        storeAVX512(dst + i*8, 8, r);
+        storeAVX512(dst + i*8 + 4, 8, d);
+    }
+
+    interpolateDualAVX2(from + i*8, to + i*8, t + i, dst + i*8, n - i);
+}
+
+O3D_SIMD_TARGET_AVX512
+void normalizeDualAVX512(const Float *src, Float *dst, UInt32 n)
+{
+    UInt32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        QuatAVX512 r = loadAVX512(src + i*8, 8), d = loadAVX512(src + i*8 + 4, 8);
+
+        orthonormalizeAVX512(r, d);
+
+        storeAVX512(dst + i*8, 8, r);
+        storeAVX512(dst + i*8 + 4, 8, d);
+    }
+
+    normalizeDualAVX2(src + i*8, dst + i*8, n - i);
+}
+
+O3D_SIMD_TARGET_AVX512
+void dualToMatrixAVX512(const Float *src, Float *matrices, UInt32 n)
+{
+    const __m512 two = _mm512_set1_ps(2.f);
+
+    UInt32 i = 0;
+    for (; i + 16 <= n; i += 16) {
+        const QuatAVX512 r = loadAVX512(src + i*8, 8), d = loadAVX512(src + i*8 + 4, 8);
+
+        const __m512 tx = _mm512_fmsub_ps(r.w, d.x, _mm512_fmsub_ps(d.w, r.x, _mm512_fmsub_ps(r.y, d.z, _mm512_mul_ps(r.z, d.y))));
+        const __m512 ty = _mm512_fmsub_ps(r.w, d.y, _mm512_fmsub_ps(d.w, r.y, _mm512_fmsub_ps(r.z, d.x, _mm512_mul_ps(r.x, d.z))));
+        const __m512 tz = _mm512_fmsub_ps(r.w, d.z, _mm512_fmsub_ps(d.w, r.z, _mm512_fmsub_ps(r.x, d.y, _mm512_mul_ps(r.y, d.x))));
+
+        matricesAVX512(r, _mm512_mul_ps(two, tx), _mm512_mul_ps(two, ty), _mm512_mul_ps(two, tz), matrices + i*16);
+    }
+
+    dualToMatrixAVX2(src + i*8, matrices + i*16, n - i);
+}
+
+#endif // O3D_SIMD_X86
+
+} // anonymous namespace
+
+void BatchQuaternion::interpolate(
+        const Float *from,
+        const Float *to,
+        const Float *t,
+        Float *dst,
+        UInt32 n,
+        Interpolation mode)
+{
+    static const InterpolateFunc func = SimdKernel<InterpolateFunc>(interpolateScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, interpolateSSE2)
+            .add(SIMD_AVX2, interpolateAVX2)
+            .add(SIMD_AVX512, interpolateAVX512)
+#endif
+            .get();
+
+    if (mode == SLERP) {
+        for (UInt32 i = 0; i < n; ++i) {
+            interpolateOne(from + i*4, to + i*4, t[i], dst + i*4, SLERP);
+        }
+    } else {
+        func(from, to, t, dst, n, mode == NLERP_CORRECTED);
+    }
+}
+
+void BatchQuaternion::normalize(const Float *src, Float *dst, UInt32 n)
+{
+    static const ConvertFunc func = SimdKernel<ConvertFunc>(normalizeScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, normalizeSSE2)
+            .add(SIMD_AVX2, normalizeAVX2)
+            .add(SIMD_AVX512, normalizeAVX512)
+#endif
+            .get();
+
+    func(src, dst, n);
+}
+
+void BatchQuaternion::toMatrix4(const Float *src, Float *matrices, UInt32 n)
+{
+    static const ConvertFunc func = SimdKernel<ConvertFunc>(toMatrixScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, toMatrixSSE2)
+            .add(SIMD_AVX2, toMatrixAVX2)
+            .add(SIMD_AVX512, toMatrixAVX512)
+#endif
+            .get();
+
+    func(src, matrices, n);
+}
+
+void BatchQuaternion::interpolateDual(
+        const Float *from,
+        const Float *to,
+        const Float *t,
+        Float *dst,
+        UInt32 n)
+{
+    static const InterpolateDualFunc func = SimdKernel<InterpolateDualFunc>(interpolateDualScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, interpolateDualSSE2)
+            .add(SIMD_AVX2, interpolateDualAVX2)
+            .add(SIMD_AVX512, interpolateDualAVX512)
+#endif
+            .get();
+
+    func(from, to, t, dst, n);
+}
+
+void BatchQuaternion::normalizeDual(const Float *src, Float *dst, UInt32 n)
+{
+    static const ConvertFunc func = SimdKernel<ConvertFunc>(normalizeDualScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, normalizeDualSSE2)
+            .add(SIMD_AVX2, normalizeDualAVX2)
+            .add(SIMD_AVX512, normalizeDualAVX512)
+#endif
+            .get();
+
+    func(src, dst, n);
+}
+
+void BatchQuaternion::dualToMatrix4(const Float *src, Float *matrices, UInt32 n)
+{
+    static const ConvertFunc func = SimdKernel<ConvertFunc>(dualToMatrixScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, dualToMatrixSSE2)
+            .add(SIMD_AVX2, dualToMatrixAVX2)
+            .add(SIMD_AVX512, dualToMatrixAVX512)
+#endif
+            .get();
+
+    func(src, matrices, n);
+}
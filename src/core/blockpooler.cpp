@@ -0,0 +1,71 @@
+/**
+ * @file blockpooler.cpp
+ * @brief Implementation of BlockPooler.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/blockpooler.h"
+
+using namespace o3d;
+
+// One bit per used slot
+static std::atomic<UInt64> O3D_BlockPoolerSlots(0);
+
+// Not yet acquired slot
+static const UInt32 O3D_BlockPoolerSlotUnset = 0xfffffffe;
+
+// Trivial, so still valid during the destruction of the other thread local data
+static thread_local UInt32 O3D_BlockPoolerSlot = O3D_BlockPoolerSlotUnset;
+
+//! Release the slot at the thread exit.
+struct BlockPoolerSlotReleaser
+{
+    ~BlockPoolerSlotReleaser()
+    {
+        const UInt32 slot = O3D_BlockPoolerSlot;
+
+        // the next uses from this thread go to the global free lists
+        O3D_BlockPoolerSlot = BlockPoolerThreadSlot::NO_SLOT;
+
+        if (slot < BlockPoolerThreadSlot::MAX_SLOTS) {
+            O3D_BlockPoolerSlots.fetch_and(~(UInt64(1) << slot), std::memory_order_release);
+        }
+    }
+};
+
+static thread_local BlockPoolerSlotReleaser O3D_BlockPoolerSlotReleaser;
+
+UInt32 BlockPoolerThreadSlot::get()
+{
+    if (O3D_BlockPoolerSlot != O3D_BlockPoolerSlotUnset) {
+        return O3D_BlockPoolerSlot;
+    }
+
+    UInt64 slots = O3D_BlockPoolerSlots.load(std::memory_order_relaxed);
+    UInt32 slot;
+
+    do {
+        if (slots == ~UInt64(0)) {
+            O3D_BlockPoolerSlot = NO_SLOT;
+            return NO_SLOT;
+        }
+
+        // lowest free slot
+        slot = 0;
+        while (slots & (UInt64(1) << slot)) {
+            ++slot;
+        }
+    } while (!O3D_BlockPoolerSlots.compare_exchange_weak(
+                 slots, slots | (UInt64(1) << slot), std::memory_order_acquire, std::memory_order_relaxed));
+
+    O3D_BlockPoolerSlot = slot;
+
+    // odr-use to construct the releaser of this thread
+    (void)&O3D_BlockPoolerSlotReleaser;
+
+    return slot;
+}
@@ -0,0 +1,724 @@
+/**
+ * @file chunkpack.cpp
+ * @brief Implementation of ChunkPack.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/chunkpack.h"
+
+#include "o3d/core/filemanager.h"
+#include "o3d/core/outstream.h"
+#include "o3d/core/templatearray.h"
+#include "o3d/core/debug.h"
+
+#ifdef _MSC_VER
+	#include <zlib/zlib.h>
+#else
+	#include <zlib.h>
+#endif
+
+using namespace o3d;
+
+// Size of the trailer (index offset, magic)
+static const Int32 O3D_ChunkPackTrailerSize = 12;
+
+// Minimal size of an entry (name length, type, size, first chunk, number of chunks)
+static const UInt32 O3D_ChunkPackMinEntrySize = 4 + 1 + 8 + 4 + 4;
+
+// Size of a chunk (offset, compressed size)
+static const UInt32 O3D_ChunkPackChunkSize = 8 + 4;
+
+ChunkPack::ChunkPack(InStream &is, const String &packName, const String &packPath) :
+    m_packPathName(packPath),
+    m_packFileName(packName),
+    m_chunkSize(0)
+{
+    readIndex(is);
+
+    // the stream is owned once the pack is valid
+    m_source = new ArchiveSource(&is);
+}
+
+ChunkPack::~ChunkPack()
+{
+    destroy();
+}
+
+void ChunkPack::destroy()
+{
+    m_entries.clear();
+    m_chunks.clear();
+    m_fileMap.clear();
+
+    // deleted once the opened files are closed
+    m_source = nullptr;
+}
+
+//! Number of bytes of the index remaining after the current position, the trailer excluded.
+static UInt64 indexSize(const InStream &is)
+{
+    const Int32 available = is.getAvailable();
+    return available > O3D_ChunkPackTrailerSize ? UInt64(available - O3D_ChunkPackTrailerSize) : 0;
+}
+
+void ChunkPack::readIndex(InStream &is)
+{
+    UInt32 magic, version;
+    is >> magic
+       >> version
+       >> m_chunkSize;
+
+    if ((magic != MAGIC) || (version > VERSION) || (m_chunkSize == 0)) {
+        O3D_ERROR(E_InvalidFormat(fullPathName()));
+    }
+
+    UInt64 indexOffset;
+
+    const Int32 headerSize = is.getPosition();
+
+    is.end(-O3D_ChunkPackTrailerSize);
+    const Int32 trailerPos = is.getPosition();
+
+    is >> indexOffset
+       >> magic;
+
+    // the index lies between the header and the trailer
+    if ((magic != MAGIC) || (trailerPos < headerSize) ||
+        (indexOffset < UInt64(headerSize)) || (indexOffset > UInt64(trailerPos))) {
+        O3D_ERROR(E_InvalidFormat(fullPathName()));
+    }
+
+    is.reset(indexOffset);
+
+    // the counts are checked against the size of the index before any allocation, a
+    // corrupted or truncated pack must not lead to a huge one
+    UInt32 numEntries;
+    is >> numEntries;
+
+    if (UInt64(numEntries) * O3D_ChunkPackMinEntrySize > indexSize(is)) {
+        O3D_ERROR(E_InvalidFormat(fullPathName()));
+    }
+
+    m_entries.resize(numEntries);
+
+    UInt8 type;
+    for (UInt32 i = 0; i < numEntries; ++i) {
+        Entry &entry = m_entries[i];
+
+        is >> entry.name
+           >> type
+           >> entry.size
+           >> entry.firstChunk
+           >> entry.numChunks;
+
+        entry.type = type ? FILE_DIR : FILE_FILE;
+
+        m_fileMap[m_packPathName + '/' + entry.name] = (Int32)i;
+    }
+
+    UInt32 numChunks;
+    is >> numChunks;
+
+    if (UInt64(numChunks) * O3D_ChunkPackChunkSize > indexSize(is)) {
+        O3D_ERROR(E_InvalidFormat(fullPathName()));
+    }
+
+    m_chunks.resize(numChunks);
+
+    for (UInt32 i = 0; i < numChunks; ++i) {
+        is >> m_chunks[i].offset
+           >> m_chunks[i].compressedSize;
+    }
+
+    for (const Entry &entry : m_entries) {
+        if ((UInt64(entry.firstChunk) + entry.numChunks > numChunks) ||
+            ((entry.size + m_chunkSize - 1) / m_chunkSize != entry.numChunks)) {
+            O3D_ERROR(E_InvalidFormat(fullPathName()));
+        }
+    }
+}
+
+Int32 ChunkPack::findFile(const String &filename)
+{
+    String absFilename = FileManager::instance()->getFullFileName(filename);
+
+    CIT_FileMap it = m_fileMap.find(absFilename);
+    if (it == m_fileMap.end()) {
+        return -1;
+    } else {
+        return it->second;
+    }
+}
+
+Bool ChunkPack::isPath(const String &path) const
+{
+    CIT_FileMap cit = m_fileMap.find(path);
+    if (cit != m_fileMap.end()) {
+        return m_entries[cit->second].type == FILE_DIR;
+    }
+
+    return False;
+}
+
+InStream* ChunkPack::openInStream(const String &filename)
+{
+    Int32 index = findFile(filename);
+
+    if (index != -1) {
+        return openInStream(index);
+    } else {
+        O3D_ERROR(E_FileNotFoundOrInvalidRights("", filename));
+    }
+}
+
+InStream* ChunkPack::openInStream(Int32 index)
+{
+    if ((index < 0) || (index >= (Int32)m_entries.size())) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    const Entry &entry = m_entries[index];
+
+    return new ChunkPackInStream(
+                m_source,
+                m_chunkSize,
+                entry.size,
+                m_chunks.data() + entry.firstChunk,
+                entry.numChunks);
+}
+
+String ChunkPack::location() const
+{
+    return m_packPathName;
+}
+
+String ChunkPack::name() const
+{
+    return m_packFileName;
+}
+
+String ChunkPack::fullPathName() const
+{
+    return m_packPathName + '/' + m_packFileName;
+}
+
+Int32 ChunkPack::getNumFiles() const
+{
+    return (Int32)m_entries.size();
+}
+
+String ChunkPack::protocol() const
+{
+    return "pack://";
+}
+
+String ChunkPack::getFileName(Int32 index) const
+{
+    if ((index >= 0) && (index < (Int32)m_entries.size())) {
+        return m_packPathName + '/' + m_entries[index].name;
+    } else {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+}
+
+FileTypes ChunkPack::getFileType(Int32 index) const
+{
+    if ((index >= 0) && (index < (Int32)m_entries.size())) {
+        return m_entries[index].type;
+    } else {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+}
+
+UInt64 ChunkPack::getFileSize(Int32 index) const
+{
+    if ((index >= 0) && (index < (Int32)m_entries.size())) {
+        return m_entries[index].size;
+    } else {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+}
+
+void ChunkPack::searchFirstFile(const String &path)
+{
+    // nothing
+}
+
+//
+// ChunkPackInStream
+//
+
+ChunkPackInStream::ChunkPackInStream(
+        ArchiveSource *source,
+        UInt32 chunkSize,
+        UInt64 size,
+        const ChunkPack::Chunk *chunks,
+        UInt32 numChunks) :
+    m_source(source),
+    m_chunkSize(chunkSize),
+    m_size(size),
+    m_chunks(chunks, chunks + numChunks),
+    m_buffer(nullptr),
+    m_compressed(nullptr),
+    m_current(-1),
+    m_pos(0),
+    m_numDecompressed(0)
+{
+    if (!source) {
+        O3D_ERROR(E_InvalidPrecondition("Source must be valid"));
+    }
+}
+
+ChunkPackInStream::~ChunkPackInStream()
+{
+    close();
+}
+
+Bool ChunkPackInStream::isMemory() const
+{
+    return False;
+}
+
+void ChunkPackInStream::close()
+{
+    deleteArray(m_buffer);
+    deleteArray(m_compressed);
+
+    m_source = nullptr;
+    m_chunks.clear();
+
+    m_current = -1;
+    m_pos = m_size = 0;
+}
+
+void ChunkPackInStream::decompress(UInt32 index, UInt8 *dest)
+{
+    const ChunkPack::Chunk &chunk = m_chunks[index];
+    const UInt32 len = chunkLength(index);
+    const UInt8 *src = nullptr;
+
+    if (m_source->getData()) {
+        // directly from the mapping
+        if (chunk.offset + chunk.compressedSize > m_source->getSize()) {
+            O3D_ERROR(E_InvalidFormat("Truncated pack chunk"));
+        }
+
+        src = m_source->getData() + chunk.offset;
+    } else {
+        if (!m_compressed) {
+            m_compressed = new UInt8[compressBound(m_chunkSize)];
+        }
+
+        if ((chunk.compressedSize > compressBound(m_chunkSize)) ||
+            (m_source->readAt(chunk.offset, m_compressed, chunk.compressedSize) != chunk.compressedSize)) {
+            O3D_ERROR(E_InvalidFormat("Truncated pack chunk"));
+        }
+
+        src = m_compressed;
+    }
+
+    if (chunk.compressedSize == len) {
+        // stored
+        memcpy(dest, src, len);
+    } else {
+        uLongf destLen = len;
+        if ((uncompress(dest, &destLen, src, chunk.compressedSize) != Z_OK) || (destLen != len)) {
+            O3D_ERROR(E_InvalidFormat("Corrupted pack chunk"));
+        }
+    }
+
+    ++m_numDecompressed;
+}
+
+Bool ChunkPackInStream::loadCurrent()
+{
+    if (m_pos >= m_size) {
+        return False;
+    }
+
+    const Int64 index = (Int64)(m_pos / m_chunkSize);
+    if (index != m_current) {
+        if (!m_buffer) {
+            m_buffer = new UInt8[m_chunkSize];
+        }
+
+        // invalid until fully decompressed
+        m_current = -1;
+        decompress((UInt32)index, m_buffer);
+        m_current = index;
+    }
+
+    return True;
+}
+
+Int32 ChunkPackInStream::nextByte()
+{
+    if (!loadCurrent()) {
+        return EOF;
+    }
+
+    return m_buffer[m_pos++ % m_chunkSize];
+}
+
+UInt32 ChunkPackInStream::reader(void *buf, UInt32 size, UInt32 count)
+{
+    const UInt32 len = (UInt32)o3d::min<UInt64>(UInt64(size) * count, m_size - m_pos);
+    UInt8 *dest = (UInt8*)buf;
+    UInt32 total = 0;
+
+    while (total < len) {
+        const UInt32 index = (UInt32)(m_pos / m_chunkSize);
+        const UInt32 inChunk = (UInt32)(m_pos % m_chunkSize);
+        const UInt32 n = o3d::min(len - total, chunkLength(index) - inChunk);
+
+        if ((inChunk == 0) && (n == chunkLength(index)) && (index != m_current)) {
+            // a whole chunk directly to the destination
+            decompress(index, dest + total);
+        } else {
+            loadCurrent();
+            memcpy(dest + total, m_buffer + inChunk, n);
+        }
+
+        total += n;
+        m_pos += n;
+    }
+
+    return total;
+}
+
+void ChunkPackInStream::reset(UInt64 n)
+{
+    if (n > m_size) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    m_pos = n;
+}
+
+void ChunkPackInStream::seek(Int64 n)
+{
+    if ((Int64(m_pos) + n < 0) || (UInt64(Int64(m_pos) + n) > m_size)) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    m_pos += n;
+}
+
+void ChunkPackInStream::end(Int64 n)
+{
+    if (n > 0) {
+        O3D_ERROR(E_IndexOutOfRange("value must be negative"));
+    }
+
+    if (UInt64(-n) > m_size) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    m_pos = m_size + n;
+}
+
+Int32 ChunkPackInStream::getAvailable() const
+{
+    return (Int32)(m_size - m_pos);
+}
+
+Int32 ChunkPackInStream::getPosition() const
+{
+    return (Int32)m_pos;
+}
+
+Bool ChunkPackInStream::isEnd() const
+{
+    return m_pos >= m_size;
+}
+
+UInt8 ChunkPackInStream::peek()
+{
+    if (!loadCurrent()) {
+        return (UInt8)EOF;
+    }
+
+    return m_buffer[m_pos % m_chunkSize];
+}
+
+void ChunkPackInStream::ignore(Int32 limit, UInt8 delim)
+{
+    Int32 counter = 0;
+
+    while ((counter < limit) && !isEnd() && (peek() != delim)) {
+        ++m_pos;
+        ++counter;
+    }
+}
+
+Int32 ChunkPackInStream::readLine(String &str, CharacterEncoding encoding)
+{
+    ArrayChar read;
+
+    Int32 c;
+    while (((c = nextByte()) != '\n') && (c != EOF)) {
+        if (c != '\r') {
+            read.push((Char)c);
+        }
+    }
+
+    if ((read.getSize() == 0) && (c == EOF)) {
+        // empty string
+        str.destroy();
+        return EOF;
+    }
+
+    read.push(0);
+
+    // set using the specified encoding
+    if (encoding == ENCODING_UTF8) {
+        str.fromUtf8(read.getData());
+    } else if (encoding == ENCODING_ANSI) {
+        str.set(read.getData(),0);
+    } else {
+        O3D_ERROR(E_InvalidParameter("Unsupported character encoding"));
+    }
+
+    return str.length();
+}
+
+Int32 ChunkPackInStream::readLine(String &str, Int32 limit, UInt8 delim, CharacterEncoding encoding)
+{
+    ArrayChar read;
+
+    Int32 c = EOF, counter = 0;
+
+    while ((counter < limit) && ((c = nextByte()) != '\n') && (c != EOF) && (c != delim)) {
+        if (c != '\r') {
+            read.push((Char)c);
+        }
+
+        ++counter;
+    }
+
+    if ((read.getSize() == 0) && (c == EOF)) {
+        // empty string
+        str.destroy();
+        return EOF;
+    }
+
+    read.push(0);
+
+    // set using the specified encoding
+    if (encoding == ENCODING_UTF8) {
+        str.fromUtf8(read.getData());
+    } else if (encoding == ENCODING_ANSI) {
+        str.set(read.getData(),0);
+    } else {
+        O3D_ERROR(E_InvalidParameter("Unsupported character encoding"));
+    }
+
+    return str.length();
+}
+
+Int32 ChunkPackInStream::readWord(String &str, CharacterEncoding encoding)
+{
+    ArrayChar read;
+
+    Int32 c;
+    while (((c = nextByte()) != ' ') && (c != EOF) && (c != '\n') && (c != '\r')) {
+        read.push((Char)c);
+    }
+
+    if ((read.getSize() == 0) && (c == EOF)) {
+        return EOF;
+    }
+
+    read.push(0);
+
+    // set using the specified encoding
+    if (encoding == ENCODING_UTF8) {
+        str.fromUtf8(read.getData());
+    } else if (encoding == ENCODING_ANSI) {
+        str.set(read.getData(),0);
+    } else {
+        O3D_ERROR(E_InvalidParameter("Unsupported character encoding"));
+    }
+
+    return str.length();
+}
+
+//
+// ChunkPackWriter
+//
+
+ChunkPackWriter::ChunkPackWriter(OutStream *os, UInt32 chunkSize, Int32 level) :
+    m_os(os),
+    m_chunkSize(chunkSize),
+    m_level(level),
+    m_offset(0),
+    m_uncompressedSize(0),
+    m_buffer(nullptr),
+    m_compressed(nullptr),
+    m_compressedMax(0)
+{
+    if (!m_os) {
+        O3D_ERROR(E_InvalidPrecondition("Stream must be valid"));
+    }
+
+    if ((m_chunkSize == 0) || (m_level < 0) || (m_level > 9)) {
+        deletePtr(m_os);
+        O3D_ERROR(E_InvalidParameter("Invalid chunk size or compression level"));
+    }
+
+    m_buffer = new UInt8[m_chunkSize];
+    m_compressedMax = (UInt32)compressBound(m_chunkSize);
+    m_compressed = new UInt8[m_compressedMax];
+
+    *m_os << ChunkPack::MAGIC
+          << ChunkPack::VERSION
+          << m_chunkSize;
+
+    m_offset = 12;
+}
+
+ChunkPackWriter::~ChunkPackWriter()
+{
+    deletePtr(m_os);
+    deleteArray(m_buffer);
+    deleteArray(m_compressed);
+}
+
+void ChunkPackWriter::addParents(const String &name)
+{
+    Int32 pos = 0;
+    while ((pos = name.find('/', pos)) > 0) {
+        addDirectory(name.sub(0, pos));
+        ++pos;
+    }
+}
+
+void ChunkPackWriter::addDirectory(const String &name)
+{
+    String lname(name);
+    lname.replace('\\', '/');
+    lname.trimRight('/', True);
+
+    if (lname.isEmpty() || (m_names.find(lname) != m_names.end())) {
+        return;
+    }
+
+    addParents(lname);
+
+    Entry entry;
+    entry.name = lname;
+    entry.type = FILE_DIR;
+    entry.size = 0;
+    entry.firstChunk = (UInt32)m_chunks.size();
+    entry.numChunks = 0;
+
+    m_names[lname] = (Int32)m_entries.size();
+    m_entries.push_back(entry);
+}
+
+void ChunkPackWriter::addFile(const String &name, InStream &is)
+{
+    if (!m_os) {
+        O3D_ERROR(E_InvalidOperation("The pack is finished"));
+    }
+
+    String lname(name);
+    lname.replace('\\', '/');
+
+    if (m_names.find(lname) != m_names.end()) {
+        O3D_ERROR(E_InvalidParameter("Duplicate pack entry " + lname));
+    }
+
+    addParents(lname);
+
+    Entry entry;
+    entry.name = lname;
+    entry.type = FILE_FILE;
+    entry.size = 0;
+    entry.firstChunk = (UInt32)m_chunks.size();
+    entry.numChunks = 0;
+
+    for (;;) {
+        UInt32 filled = 0;
+        while (filled < m_chunkSize) {
+            const UInt32 read = is.reader(m_buffer + filled, 1, m_chunkSize - filled);
+            if (read == 0) {
+                break;
+            }
+
+            filled += read;
+        }
+
+        if (filled == 0) {
+            break;
+        }
+
+        ChunkPack::Chunk chunk;
+        chunk.offset = m_offset;
+        chunk.compressedSize = filled;
+
+        const UInt8 *data = m_buffer;
+
+        if (m_level > 0) {
+            uLongf len = m_compressedMax;
+            if ((compress2(m_compressed, &len, m_buffer, filled, m_level) == Z_OK) && (len < filled)) {
+                chunk.compressedSize = (UInt32)len;
+                data = m_compressed;
+            }
+        }
+
+        // stored when it does not shrink
+        m_os->writer(data, 1, chunk.compressedSize);
+
+        m_offset += chunk.compressedSize;
+        m_chunks.push_back(chunk);
+
+        entry.size += filled;
+        ++entry.numChunks;
+
+        if (filled < m_chunkSize) {
+            break;
+        }
+    }
+
+    m_uncompressedSize += entry.size;
+
+    m_names[lname] = (Int32)m_entries.size();
+    m_entries.push_back(entry);
+}
+
+void ChunkPackWriter::finish()
+{
+    if (!m_os) {
+        O3D_ERROR(E_InvalidOperation("The pack is finished"));
+    }
+
+    const UInt64 indexOffset = m_offset;
+
+    *m_os << (UInt32)m_entries.size();
+    for (const Entry &entry : m_entries) {
+        *m_os << entry.name
+              << (UInt8)(entry.type == FILE_DIR ? 1 : 0)
+              << entry.size
+              << entry.firstChunk
+              << entry.numChunks;
+    }
+
+    *m_os << (UInt32)m_chunks.size();
+    for (const ChunkPack::Chunk &chunk : m_chunks) {
+        *m_os << chunk.offset
+              << chunk.compressedSize;
+    }
+
+    *m_os << indexOffset
+          << ChunkPack::MAGIC;
+
+    m_os->flush();
+    m_os->close();
+
+    deletePtr(m_os);
+}
@@ -0,0 +1,94 @@
+/**
+ * @file cpudispatch.cpp
+ * @brief Implementation of CpuDispatch.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/cpudispatch.h"
+
+#include "o3d/core/debug.h"
+
+#include <atomic>
+
+using namespace o3d;
+
+static std::atomic<Int32> ms_maxLevel(SIMD_AVX512);
+
+static SimdLevel detectLevel(const Processor &processor)
+{
+    if (!processor.hasSSE() || !processor.hasSSE2()) {
+        return SIMD_NONE;
+    } else if (!processor.hasSSE3() || !processor.hasSSSE3()) {
+        return SIMD_SSE2;
+    } else if (!processor.hasSSE4_1()) {
+        return SIMD_SSSE3;
+    } else if (!processor.hasAVX()) {
+        return SIMD_SSE4_1;
+    } else if (!processor.hasAVX2() || !processor.hasFMA()) {
+        return SIMD_AVX;
+    } else if (!processor.hasAVX512F() || !processor.hasAVX512BW() || !processor.hasAVX512VL()) {
+        return SIMD_AVX2;
+    } else {
+        return SIMD_AVX512;
+    }
+}
+
+const Processor& CpuDispatch::getProcessor()
+{
+    // the construction measures the frequency, done once
+    static const Processor processor;
+    return processor;
+}
+
+SimdLevel CpuDispatch::getDetectedLevel()
+{
+    static const SimdLevel level = detectLevel(getProcessor());
+    return level;
+}
+
+SimdLevel CpuDispatch::getLevel()
+{
+    return (SimdLevel)o3d::min<Int32>(getDetectedLevel(), ms_maxLevel.load());
+}
+
+void CpuDispatch::setMaxLevel(SimdLevel level)
+{
+    ms_maxLevel.store(level);
+}
+
+SimdLevel CpuDispatch::getMaxLevel()
+{
+    return (SimdLevel)ms_maxLevel.load();
+}
+
+const Char* CpuDispatch::getLevelName(SimdLevel level)
+{
+    switch (level) {
+        case SIMD_NONE:
+            return "NONE";
+        case SIMD_SSE2:
+            return "SSE2";
+        case SIMD_SSSE3:
+            return "SSSE3";
+        case SIMD_SSE4_1:
+            return "SSE4.1";
+        case SIMD_AVX:
+            return "AVX";
+        case SIMD_AVX2:
+            return "AVX2";
+        case SIMD_AVX512:
+            return "AVX-512";
+        default:
+            return "UNKNOWN";
+    }
+}
+
+void CpuDispatch::reportLog()
+{
+    O3D_MESSAGE(String("SIMD level: ") << getLevelName(getLevel()) <<
+                " (detected " << getLevelName(getDetectedLevel()) << ")");
+}
@@ -0,0 +1,356 @@
+/**
+ * @file crc32c.cpp
+ * @brief CRC32C (Castagnoli) checksum calculation.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details The hardware version computes three interleaved CRC, next combined using
+ * the zeros operators of Mark Adler (crc32c.c, zlib license).
+ */
+
+#include "o3d/core/precompiled.h"
+
+#include "o3d/core/crc32c.h"
+#include "o3d/core/stringutils.h"
+#include "o3d/core/instream.h"
+#include "o3d/core/cpudispatch.h"
+
+#ifdef O3D_SIMD_X86
+    #include <nmmintrin.h>
+#endif
+
+using namespace o3d;
+
+// reflected Castagnoli polynomial
+static const UInt32 POLY = 0x82F63B78;
+
+// length of each of the three interleaved blocks
+static const size_t LONG_BLOCK = 8192;
+static const size_t SHORT_BLOCK = 256;
+
+namespace {
+
+//! Multiply a vector by a GF(2) 32x32 matrix.
+UInt32 gf2MatrixTimes(const UInt32 *mat, UInt32 vec)
+{
+    UInt32 sum = 0;
+
+    while (vec) {
+        if (vec & 1) {
+            sum ^= *mat;
+        }
+
+        vec >>= 1;
+        ++mat;
+    }
+
+    return sum;
+}
+
+void gf2MatrixSquare(UInt32 *square, const UInt32 *mat)
+{
+    for (Int32 n = 0; n < 32; ++n) {
+        square[n] = gf2MatrixTimes(mat, mat[n]);
+    }
+}
+
+//! Operator appending len zeros to a CRC, len must be a power of two.
+void zerosOperator(UInt32 *even, size_t len)
+{
+    UInt32 odd[32];
+
+    // one zero bit
+    odd[0] = POLY;
+    UInt32 row = 1;
+    for (Int32 n = 1; n < 32; ++n) {
+        odd[n] = row;
+        row <<= 1;
+    }
+
+    gf2MatrixSquare(even, odd);   // two zero bits
+    gf2MatrixSquare(odd, even);   // four zero bits
+
+    // first square gives one zero byte, next two, four...
+    do {
+        gf2MatrixSquare(even, odd);
+        len >>= 1;
+        if (len == 0) {
+            return;
+        }
+
+        gf2MatrixSquare(odd, even);
+        len >>= 1;
+    } while (len);
+
+    for (Int32 n = 0; n < 32; ++n) {
+        even[n] = odd[n];
+    }
+}
+
+struct Tables
+{
+    UInt32 slicing[8][256];
+    UInt32 longShift[4][256];
+    UInt32 shortShift[4][256];
+    Bool hardware;
+
+    Tables()
+    {
+        for (UInt32 n = 0; n < 256; ++n) {
+            UInt32 crc = n;
+            for (Int32 k = 0; k < 8; ++k) {
+                crc = crc & 1 ? (crc >> 1) ^ POLY : crc >> 1;
+            }
+
+            slicing[0][n] = crc;
+        }
+
+        for (UInt32 n = 0; n < 256; ++n) {
+            UInt32 crc = slicing[0][n];
+            for (Int32 k = 1; k < 8; ++k) {
+                crc = slicing[0][crc & 0xff] ^ (crc >> 8);
+                slicing[k][n] = crc;
+            }
+        }
+
+        initShift(longShift, LONG_BLOCK);
+        initShift(shortShift, SHORT_BLOCK);
+
+        hardware = False;
+
+    #ifdef O3D_SIMD_X86
+        // not a SIMD level, SSE4.2 is not implied by SSE4.1
+        hardware = CpuDispatch::getLevel() >= SIMD_SSE4_1 && CpuDispatch::getProcessor().hasSSE4_2();
+    #endif
+    }
+
+    static void initShift(UInt32 shift[4][256], size_t len)
+    {
+        UInt32 op[32];
+        zerosOperator(op, len);
+
+        for (UInt32 n = 0; n < 256; ++n) {
+            shift[0][n] = gf2MatrixTimes(op, n);
+            shift[1][n] = gf2MatrixTimes(op, n << 8);
+            shift[2][n] = gf2MatrixTimes(op, n << 16);
+            shift[3][n] = gf2MatrixTimes(op, n << 24);
+        }
+    }
+};
+
+inline const Tables& tables()
+{
+    static const Tables instance;
+    return instance;
+}
+
+//! Apply a zeros operator to a CRC.
+inline UInt32 shift(const UInt32 op[4][256], UInt32 crc)
+{
+    return op[0][crc & 0xff] ^ op[1][(crc >> 8) & 0xff] ^ op[2][(crc >> 16) & 0xff] ^ op[3][crc >> 24];
+}
+
+UInt32 computeSoftware(const Tables &t, const UInt8 *next, size_t len, UInt32 crc)
+{
+    crc = ~crc;
+
+    while (len && ((size_t)next & 7)) {
+        crc = t.slicing[0][(crc ^ *next++) & 0xff] ^ (crc >> 8);
+        --len;
+    }
+
+    while (len >= 8) {
+        UInt32 lo, hi;
+        memcpy(&lo, next, 4);
+        memcpy(&hi, next + 4, 4);
+    #ifdef O3D_BIG_ENDIAN
+        System::swapBytes4(&lo);
+        System::swapBytes4(&hi);
+    #endif
+        lo ^= crc;
+
+        crc = t.slicing[7][lo & 0xff] ^ t.slicing[6][(lo >> 8) & 0xff] ^
+              t.slicing[5][(lo >> 16) & 0xff] ^ t.slicing[4][lo >> 24] ^
+              t.slicing[3][hi & 0xff] ^ t.slicing[2][(hi >> 8) & 0xff] ^
+              t.slicing[1][(hi >> 16) & 0xff] ^ t.slicing[0][hi >> 24];
+
+        next += 8;
+        len -= 8;
+    }
+
+    while (len) {
+        crc = t.slicing[0][(crc ^ *next++) & 0xff] ^ (crc >> 8);
+        --len;
+    }
+
+    return ~crc;
+}
+
+#ifdef O3D_SIMD_X86
+
+#ifdef O3D_IX64
+    typedef UInt64 Word;
+    #define O3D_CRC32C_WORD(crc, p) (UInt32)_mm_crc32_u64(crc, *reinterpret_cast<const UInt64*>(p))
+#else
+    typedef UInt32 Word;
+    #define O3D_CRC32C_WORD(crc, p) _mm_crc32_u32(crc, *reinterpret_cast<const UInt32*>(p))
+#endif
+
+//! Three interleaved CRC of a block each, to hide the latency of the instruction.
+O3D_SIMD_TARGET("sse4.2")
+inline const UInt8* computeTriple(
+        const UInt32 op[4][256],
+        size_t blockLen,
+        const UInt8 *next,
+        size_t &len,
+        UInt32 &crc0)
+{
+    while (len >= blockLen * 3) {
+        UInt32 crc1 = 0;
+        UInt32 crc2 = 0;
+        const UInt8 *end = next + blockLen;
+
+        do {
+            crc0 = O3D_CRC32C_WORD(crc0, next);
+            crc1 = O3D_CRC32C_WORD(crc1, next + blockLen);
+            crc2 = O3D_CRC32C_WORD(crc2, next + 2*blockLen);
+            next += sizeof(Word);
+        } while (next < end);
+
+        crc0 = shift(op, crc0) ^ crc1;
+        crc0 = shift(op, crc0) ^ crc2;
+
+        next += blockLen * 2;
+        len -= blockLen * 3;
+    }
+
+    return next;
+}
+
+O3D_SIMD_TARGET("sse4.2")
+UInt32 computeHardware(const Tables &t, const UInt8 *next, size_t len, UInt32 crc)
+{
+    UInt32 crc0 = ~crc;
+
+    // aligned words
+    while (len && ((size_t)next & (sizeof(Word) - 1))) {
+        crc0 = _mm_crc32_u8(crc0, *next++);
+        --len;
+    }
+
+    next = computeTriple(t.longShift, LONG_BLOCK, next, len, crc0);
+    next = computeTriple(t.shortShift, SHORT_BLOCK, next, len, crc0);
+
+    while (len >= sizeof(Word)) {
+        crc0 = O3D_CRC32C_WORD(crc0, next);
+        next += sizeof(Word);
+        len -= sizeof(Word);
+    }
+
+    while (len) {
+        crc0 = _mm_crc32_u8(crc0, *next++);
+        --len;
+    }
+
+    return ~crc0;
+}
+
+#undef O3D_CRC32C_WORD
+
+#endif // O3D_SIMD_X86
+
+} // anonymous namespace
+
+CRC32CHash::CRC32CHash() :
+    m_crc(0)
+{
+}
+
+CRC32CHash::CRC32CHash(const UInt8 *data, UInt32 len) :
+    m_crc(0)
+{
+    update(data, len);
+}
+
+CRC32CHash::CRC32CHash(const SmartArrayUInt8 &array) :
+    m_crc(0)
+{
+    update(array);
+}
+
+CRC32CHash::CRC32CHash(InStream &is) :
+    m_crc(0)
+{
+    update(is);
+}
+
+void CRC32CHash::update(const UInt8 *data, UInt32 len)
+{
+    if (data && len) {
+        m_crc = compute(data, len, m_crc);
+    }
+}
+
+void CRC32CHash::update(const SmartArrayUInt8 &array)
+{
+    if (array.isValid()) {
+        m_crc = compute(array.getData(), array.getSizeInBytes(), m_crc);
+    }
+}
+
+void CRC32CHash::update(InStream &is)
+{
+    // directly from the memory streams
+    if (is.isMemory() && is.getAvailable() > 0) {
+        const Int32 size = is.getAvailable();
+        const UInt8 *data = is.getDirectPointer(size);
+
+        if (data) {
+            m_crc = compute(data, size, m_crc);
+            return;
+        }
+    }
+
+    // stream
+    const Int32 BUF_SIZE = 65536;
+
+    UInt8 *buf = new UInt8[BUF_SIZE];
+    Int32 size;
+
+    while (is.getAvailable() > 0) {
+        size = o3d::min(is.getAvailable(), BUF_SIZE);
+
+        is.read(buf, size);
+        m_crc = compute(buf, size, m_crc);
+    }
+
+    deleteArray(buf);
+}
+
+String CRC32CHash::getHex() const
+{
+    const UInt8 raw[4] = {
+        (UInt8)(m_crc >> 24), (UInt8)(m_crc >> 16), (UInt8)(m_crc >> 8), (UInt8)m_crc
+    };
+
+    return StringUtils::toHex(raw, 4, False);
+}
+
+UInt32 CRC32CHash::compute(const void *data, size_t len, UInt32 crc)
+{
+    const Tables &t = tables();
+    const UInt8 *next = reinterpret_cast<const UInt8*>(data);
+
+#ifdef O3D_SIMD_X86
+    if (t.hardware) {
+        return computeHardware(t, next, len, crc);
+    }
+#endif
+
+    return computeSoftware(t, next, len, crc);
+}
+
+Bool CRC32CHash::isHardware()
+{
+    return tables().hardware;
+}
@@ -16,6 +16,36 @@ InStream::~InStream()
 
 }
 
+const UInt8* InStream::getDirectPointer(UInt32)
+{
+    return nullptr;
+}
+
+const UInt8* InStream::getMappedData(UInt64 &size) const
+{
+    size = 0;
+    return nullptr;
+}
+
+void InStream::setBorrowing(Bool)
+{
+}
+
+Bool InStream::isBorrowing() const
+{
+    return False;
+}
+
+int InStream::getFD() const
+{
+    return -1;
+}
+
+const UInt8* InStream::borrowDirectPointer(UInt32, UInt32, void (*&)(void*), void *&)
+{
+    return nullptr;
+}
+
 DataInStream::DataInStream(const ArrayUInt8 &array, Bool own) :
     m_own(own),
     m_data(&array),
@@ -114,6 +144,18 @@ Bool DataInStream::isEnd() const
     return m_pos > m_data->getData() + m_data->getSize() - 1;
 }
 
+const UInt8* DataInStream::getDirectPointer(UInt32 size)
+{
+    if (m_pos + size > m_data->getData() + m_data->getSize()) {
+        return nullptr;
+    }
+
+    const UInt8 *ptr = m_pos;
+    m_pos += size;
+
+    return ptr;
+}
+
 UInt8 DataInStream::peek()
 {
     if (m_pos > m_data->getData() + m_data->getSize() - 1) {
@@ -342,6 +384,18 @@ Bool SharedDataInStream::isEnd() const
     return m_pos > m_data.getData() + m_data.getSize() - 1;
 }
 
+const UInt8* SharedDataInStream::getDirectPointer(UInt32 size)
+{
+    if (m_pos + size > m_data.getData() + m_data.getSize()) {
+        return nullptr;
+    }
+
+    const UInt8 *ptr = m_pos;
+    m_pos += size;
+
+    return ptr;
+}
+
 UInt8 SharedDataInStream::peek()
 {
     if (m_pos > m_data.getData() + m_data.getSize() - 1)
@@ -46,7 +46,8 @@ EvtFunctionAsyncBase::EvtFunctionAsyncBase() :
     m_sender(nullptr),
     m_receiver(nullptr),
     //m_baseThis(nullptr),
-    m_thread(nullptr)
+    m_thread(nullptr),
+    m_next(nullptr)
 {
 }
 
@@ -54,6 +55,18 @@ EvtFunctionAsyncBase::~EvtFunctionAsyncBase()
 {
 }
 
+#ifndef O3D_RAM_MEMORY_MANAGER
+void* EvtFunctionAsyncBase::operator new(std::size_t size)
+{
+    return MemoryManager::threadAlloc(size);
+}
+
+void EvtFunctionAsyncBase::operator delete(void *ptr, std::size_t size)
+{
+    MemoryManager::threadFree(ptr, size);
+}
+#endif
+
 EvtFunction0Param::EvtFunction0Param(T_FunctionParamPtr _func):
     EvtFunctionBase(),
     m_funcPtr(_func)
@@ -96,13 +109,22 @@ void EvtFunctionAsync0Param::process()
 
 EvtStdFunction0Param::EvtStdFunction0Param(T_StdFunction _func):
     EvtFunctionBase(),
-    m_func(_func)
+    m_func(_func),
+    m_funcPtr(nullptr)
+{
+}
+
+EvtStdFunction0Param::EvtStdFunction0Param(T_FunctionParamPtr _funcPtr):
+    EvtFunctionBase(),
+    m_func(),
+    m_funcPtr(_funcPtr)
 {
 }
 
 EvtStdFunction0Param::EvtStdFunction0Param(const EvtStdFunction0Param & _which):
     EvtFunctionBase(_which),
-    m_func(_which.m_func)
+    m_func(_which.m_func),
+    m_funcPtr(_which.m_funcPtr)
 {
 }
 
@@ -117,9 +139,20 @@ void EvtStdFunction0Param::call()
     if (m_link->isSync())
     {
         setReceiverSender(m_sender);
-        m_func();
+
+        if (m_funcPtr) {
+            (m_receiver->*m_funcPtr)();
+        } else {
+            m_func();
+        }
+
         resetReceiverSender();
     }
+    else if (m_funcPtr)
+    {
+        EvtFunctionAsync0Param *event = new EvtFunctionAsync0Param(*this, m_funcPtr);
+        EvtManager::instance()->postEvent(event);
+    }
     else
     {
         EvtStdFunctionAsync0Param *event = new EvtStdFunctionAsync0Param(*this, m_func);
@@ -113,51 +113,57 @@ void EvtHandler::connect(EvtLinkBase * _pLink, Thread * _pThread)
 	m_connections.push_back(EvtConnection(_pLink));
 }
 
-void EvtHandler::setSender(EvtHandler * _pHandler)
+namespace {
+
+struct SenderEntry
 {
-	RecurMutexLocker lLocker(m_mutex);
+    EvtHandler *receiver;
+    EvtHandler *sender;
+};
 
-	#ifdef _DEBUG
-		std::vector<EvtHandler *> & lStack = m_senders[ThreadManager::getThreadId()];
-		lStack.push_back(_pHandler);
+}
 
-		if (lStack.size() > O3D_EVT_HANDLER_DEBUG_STACK_SIZE_TRESHOLD)
+// Stack of the senders of the events processed by the calling thread. Lock and
+// allocation free, compared to a per handler map of threads.
+static thread_local std::vector<SenderEntry> t_senders;
+
+void EvtHandler::setSender(EvtHandler * _pHandler)
+{
+	#ifdef _DEBUG
+        UInt32 lDepth = 0;
+        for (const SenderEntry &entry : t_senders) {
+            if (entry.receiver == this) {
+                ++lDepth;
+            }
+        }
+
+		if (lDepth >= O3D_EVT_HANDLER_DEBUG_STACK_SIZE_TRESHOLD)
 			O3D_ERROR(E_InvalidOperation("Infinite recursive event call detected"));
-	#else
-		m_senders[ThreadManager::getThreadId()].push_back(_pHandler);
 	#endif
+
+    t_senders.push_back({this, _pHandler});
 }
 
 void EvtHandler::resetSender()
 {
-	RecurMutexLocker lLocker(m_mutex);
-
-	IT_SenderMap it = m_senders.find(ThreadManager::getThreadId());
-
-	O3D_ASSERT((it != m_senders.end()) && !it->second.empty());
-
-	if (it != m_senders.end())
-	{
-		if (!it->second.empty())
-			it->second.pop_back();
+    // events are processed recursively, so the top is for this receiver
+	O3D_ASSERT(!t_senders.empty() && (t_senders.back().receiver == this));
 
-		if (it->second.empty())
-			m_senders.erase(it);
-	}
+    if (!t_senders.empty()) {
+        t_senders.pop_back();
+    }
 }
 
 EvtHandler * EvtHandler::getSender()
 {
-	RecurMutexLocker lLocker(m_mutex);
-
-	CIT_SenderMap it = m_senders.find(ThreadManager::getThreadId());
-
-	O3D_ASSERT(it != m_senders.end());
+    for (auto it = t_senders.rbegin(); it != t_senders.rend(); ++it) {
+        if (it->receiver == this) {
+            return it->sender;
+        }
+    }
 
-	if (it != m_senders.end())
-		return it->second.back();
-	else
-        return nullptr;
+	O3D_ASSERT(0);
+    return nullptr;
 }
 
 EvtConnection::EvtConnection():
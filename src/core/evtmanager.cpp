@@ -21,17 +21,133 @@ using namespace o3d;
 
 EvtManager * EvtManager::m_pInstance = nullptr;
 
+EvtManager::EvtQueue::EvtQueue() :
+    thread(nullptr),
+    registered(False),
+    producers(0),
+    posted(nullptr),
+    head(nullptr),
+    tail(nullptr)
+{
+}
+
+void EvtManager::EvtQueue::drain()
+{
+    EvtFunctionAsyncBase *stack = posted.exchange(nullptr);
+    if (!stack) {
+        return;
+    }
+
+    // the stack is in the reverse order of posting
+    EvtFunctionAsyncBase *first = nullptr;
+    EvtFunctionAsyncBase *last = stack;
+
+    while (stack) {
+        EvtFunctionAsyncBase *next = stack->m_next;
+        stack->m_next = first;
+        first = stack;
+        stack = next;
+    }
+
+    if (tail) {
+        tail->m_next = first;
+    } else {
+        head = first;
+    }
+
+    tail = last;
+}
+
+EvtFunctionAsyncBase* EvtManager::EvtQueue::takeAll()
+{
+    EvtFunctionAsyncBase *list = head;
+    head = tail = nullptr;
+
+    return list;
+}
+
+EvtFunctionAsyncBase* EvtManager::EvtQueue::take(EvtHandler *receiver)
+{
+    EvtFunctionAsyncBase *first = nullptr;
+    EvtFunctionAsyncBase *last = nullptr;
+
+    EvtFunctionAsyncBase *prev = nullptr;
+    EvtFunctionAsyncBase *it = head;
+
+    while (it) {
+        EvtFunctionAsyncBase *next = it->m_next;
+
+        if (it->getReceiver() == receiver) {
+            // unlink
+            if (prev) {
+                prev->m_next = next;
+            } else {
+                head = next;
+            }
+
+            if (tail == it) {
+                tail = prev;
+            }
+
+            // and append to the result
+            it->m_next = nullptr;
+            if (last) {
+                last->m_next = it;
+            } else {
+                first = it;
+            }
+            last = it;
+        } else {
+            prev = it;
+        }
+
+        it = next;
+    }
+
+    return first;
+}
+
+Bool EvtManager::EvtQueue::hasEvents(EvtHandler *receiver) const
+{
+    if (!receiver) {
+        return (head != nullptr) || (posted.load() != nullptr);
+    }
+
+    for (EvtFunctionAsyncBase *it = head; it != nullptr; it = it->m_next) {
+        if (it->getReceiver() == receiver) {
+            return True;
+        }
+    }
+
+    return False;
+}
+
 EvtManager::EvtManager():
-	m_poolMap(),
+    m_numQueues(0),
     m_mutex(),
     m_mainMessage(False),
     m_isAutoWakeUp(True),
     m_wakeUpCallback(nullptr)
 {
+    for (UInt32 i = 0; i < MAX_THREADS; ++i) {
+        m_queues[i] = nullptr;
+    }
 }
 
 EvtManager::~EvtManager()
 {
+    const UInt32 numQueues = m_numQueues.load();
+
+    for (UInt32 i = 0; i < numQueues; ++i) {
+        EvtQueue *queue = m_queues[i];
+
+        queue->drain();
+        deleteList(queue->takeAll());
+
+        deletePtr(queue);
+    }
+
+    deletePtr(m_wakeUpCallback);
 }
 
 EvtManager * EvtManager::instance()
@@ -57,28 +173,39 @@ void EvtManager::postEvent(EvtFunctionAsyncBase * _pFunction)
 
 	// On détermine dans quel thread il faut placer l'événement
 	Thread * lThread = _pFunction->getThread();
-    Bool hasEvents = False;
-    {
-        FastMutexLocker lLocker(m_mutex);
-
-        IT_PoolMap it = m_poolMap.find(lThread);
+    EvtQueue *queue = findQueue(lThread);
 
-        if (it != m_poolMap.end()) {
-            hasEvents = True;
-            it->second.push_back(_pFunction);
+    if (queue) {
+        ++queue->producers;
 
-            // Event for the main thread
-            if ((lThread == nullptr) && m_isAutoWakeUp && !m_mainMessage) {
-                Application::pushEvent(Application::EVENT_EVT_MANAGER, 0, 0);
-                m_mainMessage = True;
-            }
-        } else {
-            deletePtr(_pFunction);
-            O3D_ERROR(E_InvalidOperation("Thread not registered in the EvtManager"));
+        // the queue can be unregistered or reused by another thread meanwhile,
+        // and unregistration waits for the producers before cleaning the queue
+        if (!queue->registered.load() || (queue->thread.load() != lThread)) {
+            --queue->producers;
+            queue = nullptr;
         }
     }
 
-    if (hasEvents && m_wakeUpCallback) {
+    if (!queue) {
+        deletePtr(_pFunction);
+        O3D_ERROR(E_InvalidOperation("Thread not registered in the EvtManager"));
+        return;
+    }
+
+    // lock-free push
+    EvtFunctionAsyncBase *top = queue->posted.load(std::memory_order_relaxed);
+    do {
+        _pFunction->m_next = top;
+    } while (!queue->posted.compare_exchange_weak(top, _pFunction));
+
+    --queue->producers;
+
+    // Event for the main thread
+    if ((lThread == nullptr) && m_isAutoWakeUp.load() && !m_mainMessage.exchange(True)) {
+        Application::pushEvent(Application::EVENT_EVT_MANAGER, 0, 0);
+    }
+
+    if (m_wakeUpCallback) {
         m_wakeUpCallback->call(nullptr);
     }
 }
@@ -87,103 +214,109 @@ void EvtManager::registerThread(Thread * _pThread)
 {
     FastMutexLocker lLocker(m_mutex);
 
-	IT_PoolMap it = m_poolMap.find(_pThread);
-
-    if (it == m_poolMap.end()) {
-		m_poolMap[_pThread] = T_EventList();
-    } else {
+    if (findQueue(_pThread) != nullptr) {
 		O3D_ERROR(E_InvalidOperation("Attempt to register twice the same thread in the EvtManager"));
     }
+
+    const UInt32 numQueues = m_numQueues.load();
+
+    // reuse a free queue
+    for (UInt32 i = 0; i < numQueues; ++i) {
+        EvtQueue *queue = m_queues[i];
+
+        if (!queue->registered.load()) {
+            queue->thread = _pThread;
+            queue->registered = True;
+
+            return;
+        }
+    }
+
+    if (numQueues >= MAX_THREADS) {
+        O3D_ERROR(E_InvalidOperation("Too many threads registered in the EvtManager"));
+    }
+
+    EvtQueue *queue = new EvtQueue;
+    queue->thread = _pThread;
+    queue->registered = True;
+
+    // published after it is initialized
+    m_queues[numQueues] = queue;
+    m_numQueues = numQueues + 1;
 }
 
 void EvtManager::unRegisterThread(Thread * _pThread)
 {
     FastMutexLocker lLocker(m_mutex);
 
-	IT_PoolMap it = m_poolMap.find(_pThread);
-    if (it != m_poolMap.end()) {
-		T_EventList & lList = it->second;
-        for (IT_EventList itList = lList.begin() ; itList != lList.end() ; itList++) {
-			deletePtr(*itList);
-        }
-
-		m_poolMap.erase(it);
-    } else {
+    EvtQueue *queue = findQueue(_pThread);
+    if (!queue) {
 		O3D_ERROR(E_InvalidOperation("This thread can't be unregistered"));
     }
+
+    queue->registered = False;
+
+    // wait for the producers that can still push into this queue
+    while (queue->producers.load() > 0) {
+        System::waitMs(0);
+    }
+
+    FastMutexLocker lQueueLocker(queue->mutex);
+
+    queue->drain();
+    deleteList(queue->takeAll());
 }
 
 Bool EvtManager::isThreadRegistered(Thread * _pThread) const
 {
-    FastMutexLocker lLocker(m_mutex);
-
-	CIT_PoolMap it = m_poolMap.find(_pThread);
-    if (it != m_poolMap.end()) {
-		return True;
-    } else {
-		return False;
-    }
+    return findQueue(_pThread) != nullptr;
 }
 
 UInt32 EvtManager::processEvent()
 {
 	const UInt32 lCurrentThreadId = ThreadManager::getThreadId();
 
-	T_EventList lList;
+    EvtQueue *queue = getQueue(lCurrentThreadId);
+    EvtFunctionAsyncBase *list = nullptr;
 
 	{
-        FastMutexLocker lLocker(m_mutex);
-
-		IT_PoolMap itMap = getPoolMap(lCurrentThreadId);
+        FastMutexLocker lLocker(queue->mutex);
 
-		lList = itMap->second;
-		itMap->second.clear();
+        // reset main message state if necessary, before draining to not miss
+        // the wake-up of an event posted meanwhile
+        resetMainMessage(queue);
 
-		// reset main message state if necessary
-        if ((lCurrentThreadId == ThreadManager::getMainThreadId()) && m_isAutoWakeUp && m_mainMessage) {
-            m_mainMessage = False;
-		}
+        queue->drain();
+        list = queue->takeAll();
 	}
 
-    for (IT_EventList itList = lList.begin() ; itList != lList.end() ; itList++) {
+#ifdef _DEBUG
+    for (EvtFunctionAsyncBase *it = list; it != nullptr; it = it->m_next) {
         O3D_ASSERT((ThreadManager::getMainThreadId() == lCurrentThreadId) ||
-                   (((*itList)->getThread() != nullptr) && ((*itList)->getThread()->getThreadID() == lCurrentThreadId)));
-
-		(*itList)->process();
-		deletePtr(*itList);
-	}
+                   ((it->getThread() != nullptr) && (it->getThread()->getThreadID() == lCurrentThreadId)));
+    }
+#endif
 
-	return UInt32(lList.size());
+    return processList(list);
 }
 
 UInt32 EvtManager::processEvent(Thread * _pThread)
 {
-	T_EventList lList;
+    EvtQueue *queue = getQueue(_pThread);
+    EvtFunctionAsyncBase *list = nullptr;
 
 	{
-        FastMutexLocker lLocker(m_mutex);
+        FastMutexLocker lLocker(queue->mutex);
 
-		IT_PoolMap itMap = m_poolMap.find(_pThread);
-
-        if (itMap == m_poolMap.end()) {
-			O3D_ERROR(E_InvalidOperation("The thread is not registered"));
-        }
-
-		lList = itMap->second;
-		itMap->second.clear();
-
-		// reset main message state if necessary
-        if ((_pThread == nullptr) && m_isAutoWakeUp && m_mainMessage) {
-            m_mainMessage = False;
-		}
-	}
+        // reset main message state if necessary, before draining to not miss
+        // the wake-up of an event posted meanwhile
+        resetMainMessage(queue);
 
-    for (IT_EventList itList = lList.begin() ; itList != lList.end() ; itList++) {
-		(*itList)->process();
-		deletePtr(*itList);
+        queue->drain();
+        list = queue->takeAll();
 	}
 
-	return UInt32(lList.size());
+    return processList(list);
 }
 
 UInt32 EvtManager::processEvent(EvtHandler * _pHandler)
@@ -192,128 +325,94 @@ UInt32 EvtManager::processEvent(EvtHandler * _pHandler)
 
 	const UInt32 lCurrentThreadId = ThreadManager::getThreadId();
 
-	T_EventList lList;
-	{
-        FastMutexLocker lLocker(m_mutex);
+    EvtQueue *queue = getQueue(lCurrentThreadId);
+    EvtFunctionAsyncBase *list = nullptr;
 
-		T_EventList & lListCpy = getPoolMap(lCurrentThreadId)->second;
-		IT_EventList it = lListCpy.begin();
+	{
+        FastMutexLocker lLocker(queue->mutex);
 
-        while (it != lListCpy.end()) {
-            if ((*it)->getReceiver() == _pHandler) {
-				lList.push_back(*it);
-				it = lListCpy.erase(it);
-            } else {
-				it++;
-            }
-		}
+        // reset main message state if necessary, before draining to not miss
+        // the wake-up of an event posted meanwhile
+        resetMainMessage(queue);
 
-		// reset main message state if necessary
-        if ((lCurrentThreadId == ThreadManager::getMainThreadId()) && m_isAutoWakeUp && m_mainMessage) {
-            m_mainMessage = False;
-		}
+        queue->drain();
+        list = queue->take(_pHandler);
 	}
 
-	for(IT_EventList itList = lList.begin() ; itList != lList.end() ; itList++)	{
-        O3D_ASSERT((ThreadManager::getMainThreadId() == lCurrentThreadId) || (((*itList)->getThread() != nullptr) && ((*itList)->getThread()->getThreadID() == lCurrentThreadId)));
-
-		(*itList)->process();
-		deletePtr(*itList);
-	}
+#ifdef _DEBUG
+    for (EvtFunctionAsyncBase *it = list; it != nullptr; it = it->m_next) {
+        O3D_ASSERT((ThreadManager::getMainThreadId() == lCurrentThreadId) ||
+                   ((it->getThread() != nullptr) && (it->getThread()->getThreadID() == lCurrentThreadId)));
+    }
+#endif
 
-	return UInt32(lList.size());
+    return processList(list);
 }
 
-
 UInt32 EvtManager::processEvent(EvtHandler * _pHandler, Thread * _pThread)
 {
     O3D_ASSERT(_pHandler != nullptr);
 
-	T_EventList lList;
-	{
-        FastMutexLocker lLocker(m_mutex);
-
-		IT_PoolMap itMap = m_poolMap.find(_pThread);
+    EvtQueue *queue = getQueue(_pThread);
+    EvtFunctionAsyncBase *list = nullptr;
 
-        if (itMap == m_poolMap.end()) {
-			O3D_ERROR(E_InvalidOperation("The thread is not registered"));
-        }
+	{
+        FastMutexLocker lLocker(queue->mutex);
 
-		T_EventList & lListCpy = itMap->second;
-		IT_EventList it = lListCpy.begin();
+        // reset main message state if necessary, before draining to not miss
+        // the wake-up of an event posted meanwhile
+        resetMainMessage(queue);
 
-        while (it != lListCpy.end()) {
-            if ((*it)->getReceiver() == _pHandler) {
-				lList.push_back(*it);
-				it = lListCpy.erase(it);
-            } else {
-				it++;
-            }
-		}
-
-		// reset main message state if necessary
-        if ((_pThread == nullptr) && m_isAutoWakeUp && m_mainMessage) {
-            m_mainMessage = False;
-		}
+        queue->drain();
+        list = queue->take(_pHandler);
 	}
 
-	for(IT_EventList itList = lList.begin() ; itList != lList.end() ; itList++)	{
-		(*itList)->process();
-		deletePtr(*itList);
-	}
-
-	return UInt32(lList.size());
+    return processList(list);
 }
 
 void EvtManager::deletePendingEvents()
 {
-    FastMutexLocker lLocker(m_mutex);
+    EvtQueue *queue = getQueue(ThreadManager::getThreadId());
 
-	T_EventList & lList = getPoolMap(ThreadManager::getThreadId())->second;
+    FastMutexLocker lLocker(queue->mutex);
 
-    for (IT_EventList it = lList.begin() ; it != lList.end() ; it++) {
-		deletePtr(*it);
-    }
-
-	lList.clear();
+    queue->drain();
+    deleteList(queue->takeAll());
 }
 
 void EvtManager::deletePendingEvents(EvtHandler* _pHandler)
 {
     O3D_ASSERT(_pHandler != nullptr);
 
-    FastMutexLocker lLocker(m_mutex);
+    const UInt32 numQueues = m_numQueues.load();
 
-	for (IT_PoolMap itMap = m_poolMap.begin() ; itMap != m_poolMap.end() ; itMap++)	{
-		T_EventList & lList = itMap->second;
+    for (UInt32 i = 0; i < numQueues; ++i) {
+        EvtQueue *queue = m_queues[i];
 
-		IT_EventList it = lList.begin();
+        if (queue->registered.load()) {
+            FastMutexLocker lLocker(queue->mutex);
 
-        while (it != lList.end()) {
-            if ((*it)->getReceiver() == _pHandler) {
-				deletePtr(*it);
-				it = lList.erase(it);
-            } else {
-				it++;
-            }
-		}
-	}
+            queue->drain();
+            deleteList(queue->take(_pHandler));
+        }
+    }
 }
 
 Bool EvtManager::isPendingEvent() const
 {
-    FastMutexLocker lLocker(m_mutex);
+    EvtQueue *queue = getQueue(ThreadManager::getThreadId());
 
-	return !(getPoolMap(ThreadManager::getThreadId())->second.empty());
+    FastMutexLocker lLocker(queue->mutex);
+    return queue->hasEvents(nullptr);
 }
 
 Bool EvtManager::isPendingEvent(Thread * _pThread) const
 {
-    if (isThreadRegistered(_pThread)) {
-        FastMutexLocker lLocker(m_mutex);
-        const UInt32 lThreadId = (_pThread == nullptr ? ThreadManager::getMainThreadId() : _pThread->getThreadID());
+    EvtQueue *queue = findQueue(_pThread);
 
-		return !(getPoolMap(lThreadId)->second.empty());
+    if (queue) {
+        FastMutexLocker lLocker(queue->mutex);
+        return queue->hasEvents(nullptr);
     } else {
 		return False;
     }
@@ -323,96 +422,133 @@ Bool EvtManager::isPendingEvent(EvtHandler * _pHandler) const
 {
     O3D_ASSERT(_pHandler != nullptr);
 
-    FastMutexLocker lLocker(m_mutex);
-
-	const T_EventList & lListCpy = getPoolMap(ThreadManager::getThreadId())->second;
+    EvtQueue *queue = getQueue(ThreadManager::getThreadId());
 
-    for (CIT_EventList it = lListCpy.begin() ; it != lListCpy.end() ; it++) {
-        if ((*it)->getReceiver() == _pHandler) {
-			return True;
-        }
-    }
+    FastMutexLocker lLocker(queue->mutex);
 
-	return False;
+    queue->drain();
+    return queue->hasEvents(_pHandler);
 }
 
 Bool EvtManager::isPendingEvent(EvtHandler * _pHandler, Thread * _pThread) const
 {
     O3D_ASSERT(_pHandler != nullptr);
 
-    if (isThreadRegistered(_pThread)) {
-        FastMutexLocker lLocker(m_mutex);
+    EvtQueue *queue = findQueue(_pThread);
 
-        const UInt32 lThreadId = (_pThread == nullptr ? ThreadManager::getMainThreadId() : _pThread->getThreadID());
-		const T_EventList & lListCpy = getPoolMap(lThreadId)->second;
+    if (queue) {
+        FastMutexLocker lLocker(queue->mutex);
 
-        for (CIT_EventList it = lListCpy.begin() ; it != lListCpy.end() ; it++) {
-            if ((*it)->getReceiver() == _pHandler) {
-				return True;
-            }
-        }
+        queue->drain();
+        return queue->hasEvents(_pHandler);
 	}
 
 	return False;
 }
 
-EvtManager::IT_PoolMap EvtManager::getPoolMap(UInt32 _threadId)
+EvtManager::EvtQueue* EvtManager::findQueue(Thread *thread) const
+{
+    const UInt32 numQueues = m_numQueues.load();
+
+    for (UInt32 i = 0; i < numQueues; ++i) {
+        EvtQueue *queue = m_queues[i];
+
+        if (queue->registered.load() && (queue->thread.load() == thread)) {
+            return queue;
+        }
+    }
+
+    return nullptr;
+}
+
+EvtManager::EvtQueue* EvtManager::getQueue(UInt32 _threadId) const
 {
     if (_threadId == ThreadManager::getMainThreadId()) {
-        IT_PoolMap itMap = m_poolMap.find((Thread*)nullptr);
+        EvtQueue *queue = findQueue(nullptr);
 
-        if (itMap == m_poolMap.end()) {
+        if (!queue) {
 			O3D_ERROR(E_InvalidOperation("The main thread is not registered in the EvtManager"));
         }
 
-		return itMap;
+		return queue;
     } else {
-		IT_PoolMap itMap = m_poolMap.begin();
+        const UInt32 numQueues = m_numQueues.load();
 
-        for (; itMap != m_poolMap.end() ; itMap++) {
-            if ((itMap->first != nullptr) && (itMap->first->getThreadID() == _threadId)) {
-				break;
+        for (UInt32 i = 0; i < numQueues; ++i) {
+            EvtQueue *queue = m_queues[i];
+            Thread *thread = queue->thread.load();
+
+            if (queue->registered.load() && (thread != nullptr) && (thread->getThreadID() == _threadId)) {
+                return queue;
 			}
 		}
 
-        if (itMap == m_poolMap.end()) {
-			O3D_ERROR(E_InvalidOperation(String("The thread <") << _threadId << "> is not registered in the EvtManager"));
-        } else {
-			return itMap;
-        }
+        O3D_ERROR(E_InvalidOperation(String("The thread <") << _threadId << "> is not registered in the EvtManager"));
 	}
 
-	return m_poolMap.end();
+    return nullptr;
 }
 
-EvtManager::CIT_PoolMap EvtManager::getPoolMap(UInt32 _threadId) const
+EvtManager::EvtQueue* EvtManager::getQueue(Thread *thread) const
 {
-	return const_cast<EvtManager*>(this)->getPoolMap(_threadId);
+    EvtQueue *queue = findQueue(thread);
+
+    if (!queue) {
+        O3D_ERROR(E_InvalidOperation("The thread is not registered"));
+    }
+
+    return queue;
+}
+
+UInt32 EvtManager::processList(EvtFunctionAsyncBase *list)
+{
+    UInt32 count = 0;
+
+    while (list) {
+        EvtFunctionAsyncBase *next = list->m_next;
+
+        list->process();
+        deletePtr(list);
+
+        list = next;
+        ++count;
+    }
+
+    return count;
+}
+
+void EvtManager::deleteList(EvtFunctionAsyncBase *list)
+{
+    while (list) {
+        EvtFunctionAsyncBase *next = list->m_next;
+        deletePtr(list);
+        list = next;
+    }
+}
+
+void EvtManager::resetMainMessage(EvtQueue *queue)
+{
+    if ((queue->thread.load() == nullptr) && m_isAutoWakeUp.load()) {
+        m_mainMessage = False;
+    }
 }
 
 // Enable PostMessage for the main thread
 void EvtManager::enableAutoWakeUp()
 {
-    FastMutexLocker lLocker(m_mutex);
     m_isAutoWakeUp = True;
 }
 
 // Disable PostMessage for the main thread
 void EvtManager::disableAutoWakeUp()
 {
-    FastMutexLocker lLocker(m_mutex);
     m_isAutoWakeUp = False;
 }
 
 // Get the state of PostMessage for the main thread
 Bool EvtManager::isAutoWakeUp() const
 {
-	Bool ret = False;
-	{
-        FastMutexLocker lLocker(m_mutex);
-        ret = m_isAutoWakeUp;
-	}
-    return ret;
+    return m_isAutoWakeUp.load();
 }
 
 void EvtManager::setWakeUpCallback(Callback *callback)
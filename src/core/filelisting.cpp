@@ -573,7 +573,9 @@ void FileListing::searchFirstFile()		// Version UNIX du file listing
 	rep = opendir(m_path.toUtf8().getData());
     if (rep) {
         while ((lecture = readdir(rep))) {
-			stat(lecture->d_name, &FileInfos);
+			String fileName;
+			fileName.fromUtf8(lecture->d_name);
+			stat((m_path + '/' + fileName).toUtf8().getData(), &FileInfos);
 
 			if (((lecture->d_type == DT_DIR) && (m_type == FILE_FILE)) ||
                 (!(lecture->d_type == DT_DIR) && (m_type == FILE_DIR))) {
@@ -10,6 +10,7 @@
 #include "o3d/core/precompiled.h"
 #include "o3d/core/filemanager.h"
 #include "o3d/core/zip.h"
+#include "o3d/core/chunkpack.h"
 #include "o3d/core/filelisting.h"
 #include "o3d/core/thread.h"
 #include "o3d/core/localfile.h"
@@ -21,6 +22,7 @@
 #include "o3d/core/debug.h"
 
 #include "o3d/core/fileinstream.h"
+#include "o3d/core/mmapinstream.h"
 #include "o3d/core/fileoutstream.h"
 
 #ifdef O3D_WINDOWS
@@ -64,6 +66,10 @@ void FileManager::destroy()
 
 // default contructor
 FileManager::FileManager() :
+    m_mmapThreshold(1024*1024),
+    m_readQueue(nullptr),
+    m_curChild(0),
+    m_curGeneration(0),
 	m_curFilePos(0)
 {
 	m_instance = (FileManager*)this; // Used to avoid recursive call when the ctor call himself...
@@ -84,6 +90,10 @@ FileManager::FileManager() :
 // destructor
 FileManager::~FileManager()
 {
+    // pending reads are canceled, and running ones use the assets
+    deletePtr(m_readQueue);
+    m_assetCache = nullptr;
+
     umountAllAssets();
 }
 
@@ -385,19 +395,29 @@ InStream *FileManager::openInStream(const String &filename)
     {
         FastMutexLocker locker(O3D_FileManagerMutex);
 
-        for (IT_AssetList it = m_assets.begin() ; it != m_assets.end(); ++it) {
-            Int32 index;
-            // search for the file
-            if ((index = (*it)->findFile(lfilename)) != -1) {
-                // If found, try to open it
-                return (*it)->openInStream(index);
-            }
+        Int32 index;
+        Asset *asset = findAssetFile(lfilename, index);
+        if (asset) {
+            // If found, try to open it
+            return asset->openInStream(index);
         }
     }
 
-    // Try with filesystem
+    // Try with filesystem, mapping the large files
     try {
-        lis = new FileInStream(lfilename);
+        UInt64 size = 0;
+        if (m_mmapThreshold > 0) {
+            LocalFile fileInfo(lfilename);
+            if (fileInfo.exists()) {
+                size = fileInfo.getFileSize();
+            }
+        }
+
+        if (m_mmapThreshold > 0 && size >= m_mmapThreshold) {
+            lis = new MmapInStream(lfilename);
+        } else {
+            lis = new FileInStream(lfilename);
+        }
     } catch(const E_FileNotFoundOrInvalidRights &) {
         deletePtr(lis);
         throw;
@@ -406,6 +426,56 @@ InStream *FileManager::openInStream(const String &filename)
     return lis;
 }
 
+SmartPtr<FileReadRequest> FileManager::readAsync(
+        const String &filename,
+        UInt64 offset,
+        UInt32 length,
+        Int32 priority,
+        const void *tag,
+        const FileReadRequest::T_Callback &callback)
+{
+    // resolved now, the working directory can change before the read
+    return getReadQueue()->submit(getFullFileName(filename), offset, length, priority, tag, callback);
+}
+
+UInt32 FileManager::cancelReads(const void *tag)
+{
+    FileReadQueue *queue = nullptr;
+    {
+        FastMutexLocker locker(O3D_FileManagerMutex);
+        queue = m_readQueue;
+    }
+
+    return queue ? queue->cancelAll(tag) : 0;
+}
+
+FileReadQueue *FileManager::getReadQueue()
+{
+    FastMutexLocker locker(O3D_FileManagerMutex);
+
+    if (!m_readQueue) {
+        m_readQueue = new FileReadQueue();
+    }
+
+    return m_readQueue;
+}
+
+void FileManager::setAssetCache(AssetCache *cache)
+{
+    // the previous cache is released out of the lock, saving its index
+    SmartPtr<AssetCache> previous(cache);
+    {
+        FastMutexLocker locker(O3D_FileManagerMutex);
+        std::swap(previous, m_assetCache);
+    }
+}
+
+SmartPtr<AssetCache> FileManager::getAssetCache() const
+{
+    FastMutexLocker locker(O3D_FileManagerMutex);
+    return m_assetCache;
+}
+
 FileOutStream *FileManager::openOutStream(const String &filename, FileOutStream::Mode mode)
 {
     // Always write on filesystem
@@ -422,44 +492,62 @@ FileOutStream *FileManager::openOutStream(const String &filename, FileOutStream:
     return los;
 }
 
-Bool FileManager::mountAsset(const String &protocol, const String &assetName)
+static Asset* createZip(InStream &is, const String &name, const String &path)
 {
-    if (protocol == "zip://") {
-        Zip *pNewZipFile;
-        String lPackName = getFullFileName(assetName);
+    return new Zip(is, name, path);
+}
 
-        O3D_FileManagerMutex.lock();
-        // Is archive already mounted
-        for (IT_AssetList it = m_assets.begin() ; it != m_assets.end(); ++it) {
-            if ((*it)->protocol() != "zip://") {
-                continue;
-            }
+static Asset* createChunkPack(InStream &is, const String &name, const String &path)
+{
+    return new ChunkPack(is, name, path);
+}
 
-            if ((*it)->fullPathName() == lPackName) {
-                O3D_FileManagerMutex.unlock();
-                return False;
-            }
-        }
-        O3D_FileManagerMutex.unlock();
+Bool FileManager::mountArchive(const String &protocol, const String &assetName, ArchiveFactory factory)
+{
+    Asset *pNewAsset;
+    String lPackName = getFullFileName(assetName);
 
-        // open the pack file
-        InStream *is = openInStream(lPackName);
+    O3D_FileManagerMutex.lock();
+    // Is archive already mounted
+    for (IT_AssetList it = m_assets.begin() ; it != m_assets.end(); ++it) {
+        if ((*it)->protocol() != protocol) {
+            continue;
+        }
 
-        try {
-            String fname, fpath;
-            getFileNameAndPath(lPackName, fname, fpath);
-            pNewZipFile = new Zip(*is, fname, fpath);
-        } catch(E_BaseException &) {
-            deletePtr(is);
-            throw;
+        if ((*it)->fullPathName() == lPackName) {
+            O3D_FileManagerMutex.unlock();
+            return False;
         }
+    }
+    O3D_FileManagerMutex.unlock();
 
-        // insert it
-        O3D_FileManagerMutex.lock();
-        m_assets.push_back(pNewZipFile);
-        O3D_FileManagerMutex.unlock();
+    // open the archive file
+    InStream *is = openInStream(lPackName);
 
-        return True;
+    try {
+        String fname, fpath;
+        getFileNameAndPath(lPackName, fname, fpath);
+        pNewAsset = factory(*is, fname, fpath);
+    } catch(E_BaseException &) {
+        deletePtr(is);
+        throw;
+    }
+
+    // insert it
+    O3D_FileManagerMutex.lock();
+    m_assets.push_back(pNewAsset);
+    m_index.addAsset(pNewAsset);
+    O3D_FileManagerMutex.unlock();
+
+    return True;
+}
+
+Bool FileManager::mountAsset(const String &protocol, const String &assetName)
+{
+    if (protocol == "zip://") {
+        return mountArchive(protocol, assetName, &createZip);
+    } else if (protocol == "pack://") {
+        return mountArchive(protocol, assetName, &createChunkPack);
     } else if (protocol == "android://") {
     #ifdef O3D_ANDROID
         AssetAndroid *asset;
@@ -478,7 +566,7 @@ Bool FileManager::mountAsset(const String &protocol, const String &assetName)
 
         asset = new AssetAndroid();
 
-        // insert it
+        // insert it, not indexable
         O3D_FileManagerMutex.lock();
         m_assets.push_back(asset);
         O3D_FileManagerMutex.unlock();
@@ -521,10 +609,15 @@ Bool FileManager::umountAsset(const String &assetName)
 	O3D_FileManagerMutex.lock();
     for (IT_AssetList it = m_assets.begin() ; it != m_assets.end(); ++it) {
         if ((*it)->fullPathName() == lAssetName) {
-            O3D_FileManagerMutex.unlock();
+            Asset *asset = *it;
 
-			deletePtr(*it);
+            // the precedence of the others assets can change
             m_assets.erase(it);
+            m_index.rebuild(m_assets);
+
+            O3D_FileManagerMutex.unlock();
+
+			deletePtr(asset);
 			return True;
 		}
 	}
@@ -546,6 +639,7 @@ Int32 FileManager::umountAllAssets()
 	}
 
     m_assets.clear();
+    m_index.clear();
 
 	return ret;
 }
@@ -553,11 +647,29 @@ Int32 FileManager::umountAllAssets()
 // initialize the file search
 void FileManager::searchFirstVirtualFile(const String &path)
 {
+    const String lpath = getFullFileName(path);
+
 	FastMutexLocker locker(O3D_FileManagerMutex);
 
+    // direct children from the index
+    const VirtualFileIndex::T_Children *children = m_index.children(lpath);
+    if (children) {
+        m_curChildren = *children;
+    } else {
+        m_curChildren.clear();
+    }
+
+    m_curChild = 0;
+    m_curGeneration = m_index.getGeneration();
+
+    // next the assets not indexed
     m_curFilePos = 0;
     m_curAssetIt = m_assets.begin();
 
+    while ((m_curAssetIt != m_assets.end()) && (*m_curAssetIt)->isIndexable()) {
+        ++m_curAssetIt;
+    }
+
     if (m_curAssetIt != m_assets.end()) {
         (*m_curAssetIt)->searchFirstFile(path);
     }
@@ -569,7 +681,24 @@ String FileManager::searchNextVirtualFile(const String &path, FileTypes *fileTyp
 	FastMutexLocker locker(O3D_FileManagerMutex);
 	String result;
 
-    // @todo improve because of android asset
+    // the index changed since the first search, its children are no longer valid
+    if (m_curGeneration != m_index.getGeneration()) {
+        m_curChildren.clear();
+        m_curChild = 0;
+    }
+
+    while (m_curChild < m_curChildren.size()) {
+        const Int32 entryIndex = m_curChildren[m_curChild++];
+
+        const VirtualFileIndex::Entry &entry = m_index.getEntry(entryIndex);
+
+        if (fileType) {
+            *fileType = entry.type;
+        }
+
+        return entry.name;
+    }
+
     while (m_curAssetIt != m_assets.end()) {
         if (m_curFilePos < (*m_curAssetIt)->getNumFiles()) {
             result = (*m_curAssetIt)->getFileName(m_curFilePos);
@@ -586,6 +715,10 @@ String FileManager::searchNextVirtualFile(const String &path, FileTypes *fileTyp
 			m_curFilePos = 0;
             ++m_curAssetIt;
 
+            while ((m_curAssetIt != m_assets.end()) && (*m_curAssetIt)->isIndexable()) {
+                ++m_curAssetIt;
+            }
+
             if (m_curAssetIt != m_assets.end()) {
                 (*m_curAssetIt)->searchFirstFile(path);
             }
@@ -599,17 +732,12 @@ Bool FileManager::isPath(const String &path) const
 {
     String lpath = getFullFileName(path);
 
-    // Lookup file on assets
+    // Lookup path on assets
     {
         FastMutexLocker locker(O3D_FileManagerMutex);
 
-        for (CIT_AssetList cit = m_assets.cbegin() ; cit != m_assets.cend(); ++cit) {
-            // @todo could optimize comparing the base of the path
-
-            // search for the path
-            if ((*cit)->isPath(lpath)) {
-                return True;
-            }
+        if (isAssetPath(lpath)) {
+            return True;
         }
     }
 
@@ -626,12 +754,9 @@ Bool FileManager::isFile(const String &fileName) const
     {
         FastMutexLocker locker(O3D_FileManagerMutex);
 
-        for (CIT_AssetList cit = m_assets.cbegin() ; cit != m_assets.cend(); ++cit) {
-            Int32 index;
-            // search for the file
-            if ((index = (*cit)->findFile(lfilename)) != -1) {
-                return True;
-            }
+        Int32 index;
+        if (findAssetFile(lfilename, index)) {
+            return True;
         }
     }
 
@@ -648,18 +773,16 @@ UInt64 FileManager::fileSize(const String &fileName) const
     {
         FastMutexLocker locker(O3D_FileManagerMutex);
 
-        for (CIT_AssetList cit = m_assets.cbegin() ; cit != m_assets.cend(); ++cit) {
-            Int32 index;
-            // search for the file
-            if ((index = (*cit)->findFile(lfilename)) != -1) {
-                return (*cit)->getFileSize(index);
-            }
+        Int32 index;
+        Asset *asset = findAssetFile(lfilename, index);
+        if (asset) {
+            return asset->getFileSize(index);
         }
     }
 
     // Look on filesystem
     LocalFile fileInfo(lfilename);
-    return fileInfo.exists();
+    return fileInfo.exists() ? fileInfo.getFileSize() : 0;
 }
 
 FileTypes FileManager::fileType(const String &fileName) const
@@ -670,12 +793,16 @@ FileTypes FileManager::fileType(const String &fileName) const
     {
         FastMutexLocker locker(O3D_FileManagerMutex);
 
-        for (CIT_AssetList cit = m_assets.cbegin() ; cit != m_assets.cend(); ++cit) {
-            Int32 index;
-            // search for the file
-            if ((index = (*cit)->findFile(lfilename)) != -1) {
-                return (*cit)->getFileType(index);
-            }
+        // implicit directories of the assets are indexed too
+        const VirtualFileIndex::Entry *entry = m_index.find(lfilename);
+        if (entry) {
+            return entry->type;
+        }
+
+        Int32 index;
+        Asset *asset = findAssetFile(lfilename, index);
+        if (asset) {
+            return asset->getFileType(index);
         }
     }
 
@@ -692,15 +819,9 @@ BaseFile* FileManager::file(const String &fileName) const
     {
         FastMutexLocker locker(O3D_FileManagerMutex);
 
-        // @todo optimize lookup throught asset using part of theirs path
-        // if the base path exists into a map... every where in this manager
-
-        for (CIT_AssetList cit = m_assets.cbegin() ; cit != m_assets.cend(); ++cit) {
-            Int32 index;
-            // search for the file
-            if ((index = (*cit)->findFile(lfilename)) != -1) {
-                return new VirtualFile(fileName);
-            }
+        Int32 index;
+        if (findAssetFile(lfilename, index)) {
+            return new VirtualFile(fileName);
         }
     }
 
@@ -723,13 +844,8 @@ BaseDir* FileManager::dir(const String &path) const
     {
         FastMutexLocker locker(O3D_FileManagerMutex);
 
-        for (CIT_AssetList cit = m_assets.cbegin() ; cit != m_assets.cend(); ++cit) {
-            // @todo could optimize comparing the base of the path
-
-            // search for the path
-            if ((*cit)->isPath(lpath)) {
-                return new VirtualDir(path);
-            }
+        if (isAssetPath(lpath)) {
+            return new VirtualDir(path);
         }
     }
 
@@ -744,6 +860,40 @@ BaseDir* FileManager::dir(const String &path) const
     return nullptr;
 }
 
+Asset* FileManager::findAssetFile(const String &filename, Int32 &index) const
+{
+    const VirtualFileIndex::Entry *entry = m_index.find(filename);
+    if (entry && (entry->index >= 0)) {
+        index = entry->index;
+        return entry->asset;
+    }
+
+    // the assets not indexed are searched in order
+    for (CIT_AssetList cit = m_assets.cbegin() ; cit != m_assets.cend(); ++cit) {
+        if (!(*cit)->isIndexable() && ((index = (*cit)->findFile(filename)) != -1)) {
+            return *cit;
+        }
+    }
+
+    return nullptr;
+}
+
+Bool FileManager::isAssetPath(const String &path) const
+{
+    const VirtualFileIndex::Entry *entry = m_index.find(path);
+    if (entry) {
+        return entry->type == FILE_DIR;
+    }
+
+    for (CIT_AssetList cit = m_assets.cbegin() ; cit != m_assets.cend(); ++cit) {
+        if (!(*cit)->isIndexable() && (*cit)->isPath(path)) {
+            return True;
+        }
+    }
+
+    return False;
+}
+
 // get a mounted archive file
 Asset *FileManager::getAsset(const String &assetName)
 {
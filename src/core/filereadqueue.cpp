@@ -0,0 +1,415 @@
+/**
+ * @file filereadqueue.cpp
+ * @brief Implementation of FileReadQueue.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/filereadqueue.h"
+
+#include "o3d/core/filemanager.h"
+#include "o3d/core/debug.h"
+
+#include <algorithm>
+
+using namespace o3d;
+
+// End of a range read until the end of the file
+static const UInt64 RANGE_OPEN = ~UInt64(0);
+
+// Largest read, the number of elements of a SmartArray is a 32 bits signed integer
+static const UInt64 READ_MAX = 0x7fffffff;
+
+static inline UInt64 rangeEnd(const FileReadRequest *request)
+{
+    return request->getLength() > 0 ? request->getOffset() + request->getLength() : RANGE_OPEN;
+}
+
+// Release the buffer of a coalesced read, shared by the requests
+static void releaseSharedBuffer(void *owner)
+{
+    delete static_cast<SmartArrayUInt8*>(owner);
+}
+
+//---------------------------------------------------------------------------------------
+// FileReadRequest
+//---------------------------------------------------------------------------------------
+
+FileReadRequest::FileReadRequest(
+        FileReadQueue *queue,
+        const String &filename,
+        UInt64 offset,
+        UInt32 length,
+        Int32 priority,
+        const void *tag,
+        const T_Callback &callback) :
+    m_queue(queue),
+    m_filename(filename),
+    m_offset(offset),
+    m_length(length),
+    m_priority(priority),
+    m_tag(tag),
+    m_callback(callback),
+    m_sequence(0),
+    m_state(STATE_PENDING)
+{
+}
+
+FileReadRequest::~FileReadRequest()
+{
+}
+
+Bool FileReadRequest::wait()
+{
+    FastMutexLocker locker(m_mutex);
+
+    while (!isFinished()) {
+        m_finished.wait(m_mutex);
+    }
+
+    return isDone();
+}
+
+Bool FileReadRequest::cancel()
+{
+    return m_queue->cancel(this);
+}
+
+void FileReadRequest::finish(State state)
+{
+    {
+        FastMutexLocker locker(m_mutex);
+
+        m_state = state;
+        m_finished.wakeAll();
+    }
+
+    if (m_callback) {
+        m_callback(this);
+
+        // release the captures
+        m_callback = nullptr;
+    }
+}
+
+//---------------------------------------------------------------------------------------
+// FileReadQueue
+//---------------------------------------------------------------------------------------
+
+FileReadQueue::FileReadQueue(UInt32 numThreads) :
+    m_nextSequence(0),
+    m_running(True),
+    m_numReads(0)
+{
+    numThreads = o3d::max<UInt32>(numThreads, 1);
+    m_threads.reserve(numThreads);
+
+    for (UInt32 i = 0; i < numThreads; ++i) {
+        IOThread *thread = new IOThread(this, i);
+        m_threads.push_back(thread);
+
+        thread->m_thread.start();
+        thread->m_thread.setName(String("o3d-io-") << i);
+    }
+}
+
+FileReadQueue::~FileReadQueue()
+{
+    std::vector<SmartPtr<FileReadRequest> > canceled;
+
+    // stop signal
+    {
+        FastMutexLocker locker(m_mutex);
+        m_running = False;
+
+        canceled.reserve(m_pending.size());
+        for (T_RequestMap::iterator it = m_pending.begin(); it != m_pending.end(); ++it) {
+            canceled.push_back(it->second);
+        }
+
+        m_pending.clear();
+        m_files.clear();
+
+        m_wakeUp.wakeAll();
+    }
+
+    for (SmartPtr<FileReadRequest> &request : canceled) {
+        request->finish(FileReadRequest::STATE_CANCELED);
+    }
+
+    // join and cleanup
+    for (IOThread *thread : m_threads) {
+        thread->m_thread.waitFinish();
+        deletePtr(thread);
+    }
+
+    m_threads.clear();
+}
+
+SmartPtr<FileReadRequest> FileReadQueue::submit(
+        const String &filename,
+        UInt64 offset,
+        UInt32 length,
+        Int32 priority,
+        const void *tag,
+        const FileReadRequest::T_Callback &callback)
+{
+    SmartPtr<FileReadRequest> request(new FileReadRequest(
+                                          this, filename, offset, length, priority, tag, callback));
+
+    FastMutexLocker locker(m_mutex);
+
+    if (!m_running) {
+        O3D_ERROR(E_InvalidOperation("The file read queue is stopped"));
+    }
+
+    request->m_sequence = m_nextSequence++;
+
+    Key key = { priority, request->m_sequence };
+    m_pending[key] = request;
+    m_files.insert(std::make_pair(filename, request.get()));
+
+    m_wakeUp.wakeOne();
+
+    return request;
+}
+
+SmartPtr<FileReadRequest> FileReadQueue::remove(FileReadRequest *request)
+{
+    std::pair<T_FileMap::iterator, T_FileMap::iterator> range = m_files.equal_range(request->m_filename);
+    for (T_FileMap::iterator it = range.first; it != range.second; ++it) {
+        if (it->second == request) {
+            m_files.erase(it);
+            break;
+        }
+    }
+
+    Key key = { request->m_priority, request->m_sequence };
+    T_RequestMap::iterator it = m_pending.find(key);
+    O3D_ASSERT(it != m_pending.end());
+
+    SmartPtr<FileReadRequest> result = it->second;
+    m_pending.erase(it);
+
+    return result;
+}
+
+Bool FileReadQueue::cancel(FileReadRequest *request)
+{
+    SmartPtr<FileReadRequest> canceled;
+
+    {
+        FastMutexLocker locker(m_mutex);
+
+        if (request->getState() != FileReadRequest::STATE_PENDING) {
+            return False;
+        }
+
+        canceled = remove(request);
+        canceled->m_state = FileReadRequest::STATE_CANCELED;
+    }
+
+    canceled->finish(FileReadRequest::STATE_CANCELED);
+    return True;
+}
+
+UInt32 FileReadQueue::cancelAll(const void *tag)
+{
+    std::vector<SmartPtr<FileReadRequest> > canceled;
+
+    {
+        FastMutexLocker locker(m_mutex);
+
+        T_RequestMap::iterator it = m_pending.begin();
+        while (it != m_pending.end()) {
+            FileReadRequest *request = it->second.get();
+            ++it;
+
+            if (request->m_tag == tag) {
+                canceled.push_back(remove(request));
+                request->m_state = FileReadRequest::STATE_CANCELED;
+            }
+        }
+    }
+
+    for (SmartPtr<FileReadRequest> &request : canceled) {
+        request->finish(FileReadRequest::STATE_CANCELED);
+    }
+
+    return (UInt32)canceled.size();
+}
+
+UInt32 FileReadQueue::getNumPending() const
+{
+    FastMutexLocker locker(m_mutex);
+    return (UInt32)m_pending.size();
+}
+
+Bool FileReadQueue::take(std::vector<SmartPtr<FileReadRequest> > &group)
+{
+    FastMutexLocker locker(m_mutex);
+
+    while (m_running && m_pending.empty()) {
+        m_wakeUp.wait(m_mutex);
+    }
+
+    if (!m_running) {
+        return False;
+    }
+
+    // highest priority first
+    FileReadRequest *first = m_pending.begin()->second.get();
+    group.push_back(remove(first));
+
+    UInt64 begin = first->m_offset;
+    UInt64 end = rangeEnd(first);
+
+    // others pending requests of the same file, by offset
+    std::vector<FileReadRequest*> candidates;
+
+    std::pair<T_FileMap::iterator, T_FileMap::iterator> range = m_files.equal_range(first->m_filename);
+    for (T_FileMap::iterator it = range.first; it != range.second; ++it) {
+        candidates.push_back(it->second);
+    }
+
+    std::sort(candidates.begin(), candidates.end(), [] (FileReadRequest *a, FileReadRequest *b) {
+        return a->getOffset() < b->getOffset();
+    });
+
+    // grow the range while some candidates are close enough, a merge can make
+    // a previous candidate close enough
+    Bool merged = True;
+    while (merged) {
+        merged = False;
+
+        for (FileReadRequest *&candidate : candidates) {
+            if (!candidate) {
+                continue;
+            }
+
+            const UInt64 candidateBegin = candidate->m_offset;
+            const UInt64 candidateEnd = rangeEnd(candidate);
+
+            const Bool close = ((candidateBegin <= end) || (candidateBegin - end <= COALESCE_GAP)) &&
+                               ((candidateEnd >= begin) || (begin - candidateEnd <= COALESCE_GAP));
+            if (!close) {
+                continue;
+            }
+
+            const UInt64 newBegin = o3d::min(begin, candidateBegin);
+            const UInt64 newEnd = o3d::max(end, candidateEnd);
+
+            if ((newEnd != RANGE_OPEN) && (newEnd - newBegin > COALESCE_MAX)) {
+                continue;
+            }
+
+            begin = newBegin;
+            end = newEnd;
+
+            group.push_back(remove(candidate));
+            candidate = nullptr;
+
+            merged = True;
+        }
+    }
+
+    for (SmartPtr<FileReadRequest> &request : group) {
+        request->m_state = FileReadRequest::STATE_READING;
+    }
+
+    return True;
+}
+
+void FileReadQueue::process(std::vector<SmartPtr<FileReadRequest> > &group)
+{
+    UInt64 begin = RANGE_OPEN;
+    UInt64 end = 0;
+
+    for (SmartPtr<FileReadRequest> &request : group) {
+        begin = o3d::min(begin, request->m_offset);
+        end = o3d::max(end, rangeEnd(request.get()));
+    }
+
+    SmartArrayUInt8 buffer;
+    UInt64 fileSize = 0;
+    UInt32 read = 0;
+    Bool opened = False;
+
+    InStream *is = nullptr;
+
+    try {
+        is = FileManager::instance()->openInStream(group[0]->m_filename);
+        if (is) {
+            opened = True;
+            // the 32 bits available size of the stream is wrong past 2GB
+            fileSize = FileManager::instance()->fileSize(group[0]->m_filename);
+
+            // the requests past the largest read fail as a short read
+            const UInt64 readEnd = o3d::min(o3d::min(end, fileSize), begin + READ_MAX);
+
+            if (begin < readEnd) {
+                const UInt32 length = (UInt32)(readEnd - begin);
+                buffer = SmartArrayUInt8(length);
+
+                is->reset(begin);
+                read = is->reader(buffer.getData(), 1, length);
+            }
+        }
+    } catch (E_BaseException &) {
+        opened = False;
+    }
+
+    deletePtr(is);
+    ++m_numReads;
+
+    for (SmartPtr<FileReadRequest> &request : group) {
+        // a short read fails the requests it does not cover up to the end of the file
+        if (!opened || (request->m_offset > fileSize) ||
+            (o3d::min(rangeEnd(request.get()), fileSize) > begin + read)) {
+            request->finish(FileReadRequest::STATE_FAILED);
+            continue;
+        }
+
+        const UInt64 requestEnd = o3d::min(rangeEnd(request.get()), begin + read);
+
+        if (requestEnd > request->m_offset) {
+            const UInt32 start = (UInt32)(request->m_offset - begin);
+            const UInt32 size = (UInt32)(requestEnd - request->m_offset);
+
+            if ((start == 0) && ((Int32)size == buffer.getNumElt())) {
+                request->m_data = buffer;
+            } else {
+                // share the buffer of the coalesced read
+                request->m_data = SmartArrayUInt8(
+                                      buffer.getData() + start,
+                                      (Int32)size,
+                                      releaseSharedBuffer,
+                                      new SmartArrayUInt8(buffer));
+            }
+        }
+
+        request->finish(FileReadRequest::STATE_DONE);
+    }
+}
+
+FileReadQueue::IOThread::IOThread(FileReadQueue *queue, UInt32 index) :
+    m_thread(this),
+    m_queue(queue),
+    m_index(index)
+{
+}
+
+Int32 FileReadQueue::IOThread::run(void *)
+{
+    std::vector<SmartPtr<FileReadRequest> > group;
+
+    while (m_queue->take(group)) {
+        m_queue->process(group);
+        group.clear();
+    }
+
+    return 0;
+}
@@ -0,0 +1,157 @@
+/**
+ * @file framearena.cpp
+ * @brief Implementation of FrameArena.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/framearena.h"
+
+#include "o3d/core/debug.h"
+
+using namespace o3d;
+
+// Alignment of the buffers, and maximal alignment of an allocation
+static const size_t O3D_FrameArenaAlign = FrameArena::DEFAULT_ALIGN * 4;
+
+FrameArena::FrameArena(size_t initialSize) :
+    m_current(0),
+    m_frameId(0),
+    m_frameUsed(0),
+    m_highWaterMark(0),
+    m_numHeapAllocs(0)
+{
+    initBuffer(m_single, initialSize);
+    initBuffer(m_double[0], initialSize);
+    initBuffer(m_double[1], initialSize);
+}
+
+FrameArena::~FrameArena()
+{
+    releaseBuffer(m_single);
+    releaseBuffer(m_double[0]);
+    releaseBuffer(m_double[1]);
+}
+
+void* FrameArena::allocate(size_t size, size_t align, Lifetime lifetime)
+{
+    O3D_ASSERT((align & (align - 1)) == 0);
+    O3D_ASSERT(align <= O3D_FrameArenaAlign);
+
+    void *ptr = nullptr;
+
+    if (lifetime == FRAME_DOUBLE) {
+        ptr = allocateFrom(m_double[m_current], size, align);
+    } else {
+        ptr = allocateFrom(m_single, size, align);
+    }
+
+    m_frameUsed += size;
+    if (m_frameUsed > m_highWaterMark) {
+        m_highWaterMark = m_frameUsed;
+    }
+
+    return ptr;
+}
+
+void FrameArena::endFrame()
+{
+    resetBuffer(m_single);
+
+    // the buffer of the previous frame is kept, and the older one is reused
+    m_current ^= 1;
+    resetBuffer(m_double[m_current]);
+
+    m_frameUsed = 0;
+    ++m_frameId;
+}
+
+size_t FrameArena::getCapacity() const
+{
+    return m_single.size + m_single.overflowSize +
+            m_double[0].size + m_double[0].overflowSize +
+            m_double[1].size + m_double[1].overflowSize;
+}
+
+void FrameArena::initBuffer(Buffer &buffer, size_t size)
+{
+    buffer.size = o3d::max<size_t>(size, O3D_FrameArenaAlign);
+    buffer.data = (UInt8*)O3D_ALIGNED_MALLOC(buffer.size, O3D_FrameArenaAlign);
+    buffer.offset = 0;
+    buffer.overflowSize = 0;
+    buffer.overflowOffset = 0;
+    buffer.overflowLast = 0;
+
+    if (!buffer.data) {
+        O3D_ERROR(E_InvalidAllocation("Frame arena buffer"));
+    }
+
+    ++m_numHeapAllocs;
+}
+
+void FrameArena::releaseBuffer(Buffer &buffer)
+{
+    for (UInt8 *overflow : buffer.overflows) {
+        O3D_ALIGNED_FREE(overflow);
+    }
+
+    buffer.overflows.clear();
+
+    if (buffer.data) {
+        O3D_ALIGNED_FREE(buffer.data);
+        buffer.data = nullptr;
+    }
+}
+
+void FrameArena::resetBuffer(Buffer &buffer)
+{
+    if (buffer.overflowSize > 0) {
+        // grow the buffer to contain the whole frame the next times
+        const size_t size = buffer.size + buffer.overflowSize;
+
+        releaseBuffer(buffer);
+        initBuffer(buffer, size);
+    }
+
+    buffer.offset = 0;
+}
+
+void* FrameArena::allocateFrom(Buffer &buffer, size_t size, size_t align)
+{
+    size_t offset = (buffer.offset + align - 1) & ~(align - 1);
+
+    if (offset + size <= buffer.size) {
+        buffer.offset = offset + size;
+        return buffer.data + offset;
+    }
+
+    // into the current extra block
+    if (!buffer.overflows.empty()) {
+        offset = (buffer.overflowOffset + align - 1) & ~(align - 1);
+
+        if (offset + size <= buffer.overflowLast) {
+            buffer.overflowOffset = offset + size;
+            return buffer.overflows.back() + offset;
+        }
+    }
+
+    // a new extra block, freed at the next reset
+    const size_t blockSize = o3d::max<size_t>(size, buffer.size / 2);
+    UInt8 *block = (UInt8*)O3D_ALIGNED_MALLOC(blockSize, O3D_FrameArenaAlign);
+
+    if (!block) {
+        O3D_ERROR(E_InvalidAllocation("Frame arena extra block"));
+    }
+
+    ++m_numHeapAllocs;
+
+    buffer.overflows.push_back(block);
+    buffer.overflowSize += blockSize;
+    buffer.overflowLast = blockSize;
+    buffer.overflowOffset = size;
+
+    return block;
+}
@@ -0,0 +1,288 @@
+/**
+ * @file jobgraph.cpp
+ * @brief Implementation of JobGraph.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/jobgraph.h"
+
+#include "o3d/core/debug.h"
+
+using namespace o3d;
+
+//---------------------------------------------------------------------------------------
+// Job
+//---------------------------------------------------------------------------------------
+
+Job::Job(JobGraph *graph, T_JobFunction func) :
+    m_graph(graph),
+    m_func(func),
+    m_numDeps(1),
+    m_canceled(False),
+    m_done(False),
+    m_failed(False),
+    m_submitted(False)
+{
+}
+
+Job::~Job()
+{
+}
+
+void Job::dependsOn(Job *job)
+{
+    O3D_ASSERT(job != nullptr);
+    O3D_ASSERT(job != this);
+
+    if (!job || (job == this)) {
+        return;
+    }
+
+    if (m_submitted) {
+        O3D_ERROR(E_InvalidOperation("Cannot add a dependency to an already submitted job"));
+    }
+
+    if (job->m_graph != m_graph) {
+        O3D_ERROR(E_InvalidParameter("Dependency must be a job of the same graph"));
+    }
+
+    FastMutexLocker locker(job->m_mutex);
+
+    if (!job->m_done) {
+        job->m_successors.push_back(this);
+        ++m_numDeps;
+    } else if (job->m_failed || job->isCanceled()) {
+        m_canceled = True;
+    }
+}
+
+Job* Job::then(T_JobFunction func)
+{
+    return m_graph->add(func, {this});
+}
+
+Bool Job::isDone() const
+{
+    FastMutexLocker locker(const_cast<FastMutex&>(m_mutex));
+    return m_done;
+}
+
+void Job::release()
+{
+    if (--m_numDeps == 0) {
+        m_graph->m_pool->push(this);
+    }
+}
+
+Int32 Job::run(void *)
+{
+    Bool failed = False;
+
+    if (!m_canceled.load()) {
+        try {
+            m_func();
+        } catch (E_BaseException &e) {
+            O3D_WARNING(String("Job failed: ") + e.getMsg());
+            failed = True;
+        } catch (std::exception &e) {
+            O3D_WARNING(String("Job failed: ") + e.what());
+            failed = True;
+        }
+    }
+
+    if (failed) {
+        m_graph->m_failed = True;
+    }
+
+    std::vector<Job*> successors;
+    {
+        FastMutexLocker locker(m_mutex);
+        m_done = True;
+        m_failed = failed;
+        successors.swap(m_successors);
+    }
+
+    // cancel the continuations of a failed or canceled job, but release them anyway
+    const Bool cancel = failed || m_canceled.load();
+
+    for (Job *job : successors) {
+        if (cancel) {
+            job->m_canceled = True;
+        }
+        job->release();
+    }
+
+    // the graph can be destroyed after that
+    m_graph->jobDone();
+
+    return 0;
+}
+
+//---------------------------------------------------------------------------------------
+// JobGraph
+//---------------------------------------------------------------------------------------
+
+JobGraph::JobGraph(WorkerPool *pool) :
+    m_pool(pool),
+    m_started(False),
+    m_failed(False),
+    m_numRemaining(0)
+{
+    if (!m_pool) {
+        m_pool = WorkerPool::instance();
+    }
+}
+
+JobGraph::~JobGraph()
+{
+    if (m_started.load()) {
+        wait();
+    }
+
+    for (Job *job : m_jobs) {
+        deletePtr(job);
+    }
+
+    m_jobs.clear();
+}
+
+Job* JobGraph::add(T_JobFunction func, std::initializer_list<Job*> dependencies)
+{
+    Job *job = new Job(this, func);
+
+    {
+        FastMutexLocker locker(m_doneMutex);
+        ++m_numRemaining;
+    }
+
+    for (Job *dependency : dependencies) {
+        job->dependsOn(dependency);
+    }
+
+    Bool started = False;
+    {
+        FastMutexLocker locker(m_mutex);
+        m_jobs.push_back(job);
+        started = m_started.load();
+    }
+
+    // started graph, submit now
+    if (started) {
+        job->m_submitted = True;
+        job->release();
+    }
+
+    return job;
+}
+
+void JobGraph::start()
+{
+    std::vector<Job*> jobs;
+    {
+        FastMutexLocker locker(m_mutex);
+
+        if (m_started.load()) {
+            return;
+        }
+
+        jobs = m_jobs;
+        m_started = True;
+    }
+
+    // first mark all of them, because a released job can be run immediately
+    for (Job *job : jobs) {
+        job->m_submitted = True;
+    }
+
+    for (Job *job : jobs) {
+        job->release();
+    }
+}
+
+void JobGraph::wait()
+{
+    if (!m_started.load()) {
+        O3D_ERROR(E_InvalidOperation("Waiting for a non started job graph"));
+    }
+
+    // help the workers
+    while (!isDone()) {
+        if (!m_pool->runPending()) {
+            FastMutexLocker locker(m_doneMutex);
+            if (m_numRemaining.load() > 0) {
+                // short timeout to look for new pending jobs
+                m_doneCond.wait(m_doneMutex, 1);
+            }
+        }
+    }
+
+    // the last job can still hold the mutex
+    FastMutexLocker locker(m_doneMutex);
+    while (m_numRemaining.load() > 0) {
+        m_doneCond.wait(m_doneMutex);
+    }
+}
+
+UInt32 JobGraph::getNumJobs() const
+{
+    FastMutexLocker locker(m_mutex);
+    return (UInt32)m_jobs.size();
+}
+
+void JobGraph::jobDone()
+{
+    FastMutexLocker locker(m_doneMutex);
+
+    if (--m_numRemaining == 0) {
+        m_doneCond.wakeAll();
+    }
+}
+
+void JobGraph::parallelFor(
+        UInt32 begin,
+        UInt32 end,
+        UInt32 grain,
+        const T_RangeFunction &func,
+        WorkerPool *pool)
+{
+    if (end <= begin) {
+        return;
+    }
+
+    if (!pool) {
+        pool = WorkerPool::instance();
+    }
+
+    const UInt32 count = end - begin;
+
+    if (grain == 0) {
+        // few jobs per worker (plus the calling thread) to balance the load
+        grain = o3d::max<UInt32>(count / ((pool->getNumWorkers() + 1) * 4), 1);
+    }
+
+    // not enough to be split
+    if (count <= grain) {
+        func(begin, end);
+        return;
+    }
+
+    JobGraph graph(pool);
+
+    // the sub-range size is bounded by the remaining count, first + grain can wrap
+    for (UInt32 first = begin; first < end;) {
+        const UInt32 last = first + o3d::min<UInt32>(grain, end - first);
+        graph.add([&func, first, last] () { func(first, last); });
+        first = last;
+    }
+
+    graph.start();
+    graph.wait();
+
+    if (graph.isFailed()) {
+        O3D_ERROR(E_InvalidResult("At least one range of a parallelFor failed"));
+    }
+}
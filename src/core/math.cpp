@@ -11,7 +11,7 @@
 #include "o3d/core/math.h"
 
 #include "o3d/core/matrix4.h"
-#include "o3d/core/processor.h"
+#include "o3d/core/cpudispatch.h"
 
 #include <math.h>
 
@@ -26,9 +26,9 @@ Float (*Math::sqrt)(Float) = Math::_Std::sqrt;
 
 void Math::init()
 {
-	Processor processor;
+	const Processor &processor = CpuDispatch::getProcessor();
 
-    if (processor.hasSSE()) {
+    if (CpuDispatch::getLevel() >= SIMD_SSE2) {
         sqrt = _SSE::sqrt;
     } else if (processor.has3DNow()) {
         sqrt = _3DNow::sqrt;
@@ -16,6 +16,8 @@
 #include "o3d/core/logger.h"
 #include "o3d/core/memory.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <memory.h>
 #include <stdlib.h>
@@ -94,7 +96,11 @@ const Char* MemoryManager::sfxType2String(AudioTarget stype)
 
 // Constructor
 MemoryManager::MemoryManager() :
-    m_logger(nullptr)
+    m_logger(nullptr),
+    m_threadAllocCurrent(0),
+    m_threadAllocTotal(0),
+    m_threadAllocNews(0),
+    m_threadAllocDeletes(0)
 {
 	// is file open ?
 #ifdef O3D_ANDROID
@@ -128,6 +134,16 @@ MemoryManager::~MemoryManager()
         m_logger->log(Logger::INFO, String("A total of ") << m_memory[MEM_SFX].m_memorytotalbytes << " bytes has been allocated in audio memory");
     }
 
+    mergeThreadAllocStats();
+
+    if (m_threadAllocTotal > 0) {
+        m_logger->log(Logger::INFO, String("A total of ") << (UInt64)m_threadAllocTotal << " bytes has been allocated by the thread cached allocator");
+    }
+
+    if (m_threadAllocCurrent > 0) {
+        m_logger->log(Logger::INFO, String("Thread cached allocator : ") << (UInt64)m_threadAllocCurrent << " bytes still allocated");
+    }
+
     if (!m_CBlocks.empty() || !m_GBlocks.empty()) {
 		// Leaks !!
         m_logger->log(Logger::WARNING, "Memory leaks detected :");
@@ -825,6 +841,372 @@ void MemoryManager::FastMemoryPool::reportLeaks(Logger *logger)
                 .arg((Int32)TotalSize));
 }
 
+//---------------------------------------------------------------------------------------
+// Thread cached allocator Operations
+//---------------------------------------------------------------------------------------
+
+namespace {
+
+//! Size classes, 16 bytes steps up to 128, then two classes per power of two.
+static const UInt32 O3D_ThreadAllocClasses[] = {
+    16, 32, 48, 64, 80, 96, 112, 128,
+    192, 256, 384, 512, 768, 1024, 1536, 2048, 3072, 4096 };
+
+static const UInt32 O3D_ThreadAllocNumClasses = sizeof(O3D_ThreadAllocClasses) / sizeof(UInt32);
+
+//! Bytes kept per size class by each thread before returning a batch.
+static const UInt32 O3D_ThreadAllocCacheSize = 8192;
+
+//! Size of the slabs allocated by the central pool.
+static const UInt32 O3D_ThreadAllocSlabSize = 65536;
+
+struct FreeBlock
+{
+    FreeBlock *next;
+};
+
+struct ThreadCache;
+
+//! Central pool, shared by the threads caches. It lives until the end of the process
+//! because static objects can release blocks after the destruction of the MemoryManager.
+struct CentralPool
+{
+    struct SizeClass
+    {
+        FastMutex mutex;
+        FreeBlock *head;
+        UInt32 size;
+        UInt32 batch;   //!< Number of blocks exchanged with a thread cache.
+    };
+
+    SizeClass classes[O3D_ThreadAllocNumClasses];
+    UInt8 classIndex[MemoryManager::THREAD_ALLOC_MAX_SIZE / 16 + 1];  //!< By 16 bytes steps.
+
+    FastMutex mutex;                    //!< Protect the slabs and the caches list.
+    std::vector<void*> slabs;
+    std::vector<ThreadCache*> caches;
+
+    // statistics of the terminated threads
+    Int64 retiredCurrent;
+    Int64 retiredTotal;
+    UInt64 retiredNews;
+    UInt64 retiredDeletes;
+
+    CentralPool() :
+        retiredCurrent(0),
+        retiredTotal(0),
+        retiredNews(0),
+        retiredDeletes(0)
+    {
+        UInt32 c = 0;
+        for (UInt32 i = 0; i < sizeof(classIndex); ++i) {
+            while (O3D_ThreadAllocClasses[c] < i * 16) {
+                ++c;
+            }
+            classIndex[i] = (UInt8)c;
+        }
+
+        for (UInt32 i = 0; i < O3D_ThreadAllocNumClasses; ++i) {
+            classes[i].head = nullptr;
+            classes[i].size = O3D_ThreadAllocClasses[i];
+            classes[i].batch = o3d::clamp<UInt32>(O3D_ThreadAllocCacheSize / classes[i].size, 2, 64);
+        }
+    }
+
+    static CentralPool& instance()
+    {
+        // never deleted, see above
+        static CentralPool *pool = new CentralPool;
+        return *pool;
+    }
+
+    inline UInt32 getClass(size_t size) const
+    {
+        return classIndex[(size + 15) >> 4];
+    }
+
+    //! Get a chain of count blocks.
+    FreeBlock* acquire(UInt32 c, UInt32 count)
+    {
+        SizeClass &sizeClass = classes[c];
+        FastMutexLocker locker(sizeClass.mutex);
+
+        FreeBlock *first = nullptr;
+
+        while (count > 0) {
+            if (!sizeClass.head) {
+                grow(sizeClass);
+            }
+
+            FreeBlock *block = sizeClass.head;
+            sizeClass.head = block->next;
+
+            block->next = first;
+            first = block;
+
+            --count;
+        }
+
+        return first;
+    }
+
+    //! Give back a chain of blocks.
+    void release(UInt32 c, FreeBlock *first, FreeBlock *last)
+    {
+        SizeClass &sizeClass = classes[c];
+        FastMutexLocker locker(sizeClass.mutex);
+
+        last->next = sizeClass.head;
+        sizeClass.head = first;
+    }
+
+    //! Allocate a new slab and split it into blocks (class mutex must be locked).
+    void grow(SizeClass &sizeClass)
+    {
+        const UInt32 slabSize = o3d::max<UInt32>(O3D_ThreadAllocSlabSize, sizeClass.size * sizeClass.batch);
+        UInt8 *slab = (UInt8*)O3D_B_ALIGNED_MALLOC(slabSize, 16);
+
+        if (!slab) {
+            O3D_ERROR(E_InvalidAllocation("Thread cached allocator out of memory"));
+        }
+
+        {
+            FastMutexLocker locker(mutex);
+            slabs.push_back(slab);
+        }
+
+        const UInt32 numBlocks = slabSize / sizeClass.size;
+        for (UInt32 i = numBlocks; i > 0; --i) {
+            FreeBlock *block = (FreeBlock*)(slab + (i-1) * sizeClass.size);
+            block->next = sizeClass.head;
+            sizeClass.head = block;
+        }
+    }
+};
+
+//! Per thread cache and statistics.
+struct ThreadCache
+{
+    FreeBlock *heads[O3D_ThreadAllocNumClasses];
+    UInt32 counts[O3D_ThreadAllocNumClasses];
+
+    // only written by the owner thread, read by the merge
+    std::atomic<Int64> current;
+    std::atomic<Int64> total;
+    std::atomic<UInt64> news;
+    std::atomic<UInt64> deletes;
+
+    ThreadCache() :
+        current(0),
+        total(0),
+        news(0),
+        deletes(0)
+    {
+        for (UInt32 i = 0; i < O3D_ThreadAllocNumClasses; ++i) {
+            heads[i] = nullptr;
+            counts[i] = 0;
+        }
+
+        CentralPool &pool = CentralPool::instance();
+        FastMutexLocker locker(pool.mutex);
+        pool.caches.push_back(this);
+    }
+
+    ~ThreadCache()
+    {
+        CentralPool &pool = CentralPool::instance();
+
+        for (UInt32 i = 0; i < O3D_ThreadAllocNumClasses; ++i) {
+            if (heads[i]) {
+                FreeBlock *last = heads[i];
+                while (last->next) {
+                    last = last->next;
+                }
+
+                pool.release(i, heads[i], last);
+
+                heads[i] = nullptr;
+                counts[i] = 0;
+            }
+        }
+
+        FastMutexLocker locker(pool.mutex);
+
+        pool.retiredCurrent += current.load();
+        pool.retiredTotal += total.load();
+        pool.retiredNews += news.load();
+        pool.retiredDeletes += deletes.load();
+
+        pool.caches.erase(std::find(pool.caches.begin(), pool.caches.end(), this));
+    }
+
+    // single writer, no need of an atomic read-modify-write
+    inline void add(std::atomic<Int64> &counter, Int64 value)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    inline void inc(std::atomic<UInt64> &counter)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    }
+};
+
+// The cache is owned by a thread local object, and the raw pointer stay valid (null)
+// after its destruction, for the releases done during the static destruction.
+static thread_local ThreadCache *t_threadCache = nullptr;
+static thread_local Bool t_threadCacheReleased = False;
+
+struct ThreadCacheOwner
+{
+    ThreadCache cache;
+
+    ThreadCacheOwner()
+    {
+        t_threadCache = &cache;
+    }
+
+    ~ThreadCacheOwner()
+    {
+        t_threadCache = nullptr;
+        t_threadCacheReleased = True;
+    }
+};
+
+static inline ThreadCache* getThreadCache()
+{
+    if (!t_threadCache && !t_threadCacheReleased) {
+        static thread_local ThreadCacheOwner owner;
+    }
+
+    return t_threadCache;
+}
+
+} // anonymous namespace
+
+void* MemoryManager::threadAlloc(size_t size)
+{
+    if (size > THREAD_ALLOC_MAX_SIZE) {
+        return O3D_B_ALIGNED_MALLOC(size, 16);
+    }
+
+    CentralPool &pool = CentralPool::instance();
+    const UInt32 c = pool.getClass(size);
+
+    ThreadCache *cache = getThreadCache();
+    if (!cache) {
+        // thread terminating
+        return pool.acquire(c, 1);
+    }
+
+    if (!cache->heads[c]) {
+        const UInt32 batch = pool.classes[c].batch;
+
+        cache->heads[c] = pool.acquire(c, batch);
+        cache->counts[c] = batch;
+    }
+
+    FreeBlock *block = cache->heads[c];
+    cache->heads[c] = block->next;
+    --cache->counts[c];
+
+    cache->add(cache->current, pool.classes[c].size);
+    cache->add(cache->total, pool.classes[c].size);
+    cache->inc(cache->news);
+
+    return block;
+}
+
+void MemoryManager::threadFree(void *ptr, size_t size)
+{
+    if (!ptr) {
+        return;
+    }
+
+    if (size > THREAD_ALLOC_MAX_SIZE) {
+        O3D_B_ALIGNED_FREE(ptr);
+        return;
+    }
+
+    CentralPool &pool = CentralPool::instance();
+    const UInt32 c = pool.getClass(size);
+
+    FreeBlock *block = (FreeBlock*)ptr;
+
+    ThreadCache *cache = getThreadCache();
+    if (!cache) {
+        // thread terminating
+        pool.release(c, block, block);
+        return;
+    }
+
+    block->next = cache->heads[c];
+    cache->heads[c] = block;
+    ++cache->counts[c];
+
+    cache->add(cache->current, -(Int64)pool.classes[c].size);
+    cache->inc(cache->deletes);
+
+    // too many blocks, give back a batch to the central pool
+    const UInt32 batch = pool.classes[c].batch;
+
+    if (cache->counts[c] > 2 * batch) {
+        FreeBlock *first = cache->heads[c];
+        FreeBlock *last = first;
+
+        for (UInt32 i = 1; i < batch; ++i) {
+            last = last->next;
+        }
+
+        cache->heads[c] = last->next;
+        cache->counts[c] -= batch;
+
+        pool.release(c, first, last);
+    }
+}
+
+void MemoryManager::mergeThreadAllocStats() const
+{
+    CentralPool &pool = CentralPool::instance();
+
+    Int64 current, total;
+    UInt64 news, deletes;
+
+    {
+        FastMutexLocker locker(pool.mutex);
+
+        current = pool.retiredCurrent;
+        total = pool.retiredTotal;
+        news = pool.retiredNews;
+        deletes = pool.retiredDeletes;
+
+        for (const ThreadCache *cache : pool.caches) {
+            current += cache->current.load(std::memory_order_relaxed);
+            total += cache->total.load(std::memory_order_relaxed);
+            news += cache->news.load(std::memory_order_relaxed);
+            deletes += cache->deletes.load(std::memory_order_relaxed);
+        }
+    }
+
+    // apply the changes since the last merge
+    MemoryModule &module = m_memory[MEM_FAST];
+
+    module.m_currentbytes += (UInt32)(current - m_threadAllocCurrent);
+    module.m_memorytotalbytes += (UInt32)(total - m_threadAllocTotal);
+    module.m_nbrNew += (UInt32)(news - m_threadAllocNews);
+    module.m_nbrDelete += (UInt32)(deletes - m_threadAllocDeletes);
+
+    // the peak is only known at the merges
+    if (module.m_currentbytes > module.m_maxpeak) {
+        module.m_maxpeak = module.m_currentbytes;
+    }
+
+    m_threadAllocCurrent = current;
+    m_threadAllocTotal = total;
+    m_threadAllocNews = news;
+    m_threadAllocDeletes = deletes;
+}
+
 
 //---------------------------------------------------------------------------------------
 // Graphic Memory Operations
@@ -1148,6 +1530,10 @@ Bool MemoryManager::isLogging(MemoryType type)
 // get the memory evolution
 MemoryManager::MemoryState MemoryManager::getMemoryState(MemoryType type)
 {
+    if (type == MEM_FAST) {
+        mergeThreadAllocStats();
+    }
+
 	O3D_MemoryManagerTime[type].update();
 
 	// do we need to recompute the memory state ?
@@ -1210,6 +1596,10 @@ UInt32 MemoryManager::getMemoryStateHystereris(MemoryType type)const
 // get current memory occupation
 UInt32 MemoryManager::getCurrentMemorySize(MemoryType type)const
 {
+    if (type == MEM_FAST) {
+        mergeThreadAllocStats();
+    }
+
 	UInt32 ret = m_memory[type].m_currentbytes;
 	O3D_MemoryManagerMutex.unlock();
 	return ret;
@@ -1218,6 +1608,10 @@ UInt32 MemoryManager::getCurrentMemorySize(MemoryType type)const
 // get total memory allocation
 UInt32 MemoryManager::getTotalMemorySize(MemoryType type)const
 {
+    if (type == MEM_FAST) {
+        mergeThreadAllocStats();
+    }
+
 	UInt32 ret = m_memory[type].m_memorytotalbytes;
 	O3D_MemoryManagerMutex.unlock();
 	return ret;
@@ -1226,6 +1620,10 @@ UInt32 MemoryManager::getTotalMemorySize(MemoryType type)const
 // get maximum memory allocation peak
 UInt32 MemoryManager::getMemoryPeakSize(MemoryType type)const
 {
+    if (type == MEM_FAST) {
+        mergeThreadAllocStats();
+    }
+
 	UInt32 ret = m_memory[type].m_maxpeak;
 	O3D_MemoryManagerMutex.unlock();
 	return ret;
@@ -1234,6 +1632,10 @@ UInt32 MemoryManager::getMemoryPeakSize(MemoryType type)const
 // reset memory states
 void MemoryManager::resetCounters(MemoryType type)
 {
+    if (type == MEM_FAST) {
+        mergeThreadAllocStats();
+    }
+
 	m_memory[type].m_memState = INCREASE;
 	m_memory[type].m_currentbytes = 0;
 	m_memory[type].m_memorytotalbytes = 0;
@@ -1249,6 +1651,10 @@ void MemoryManager::resetCounters(MemoryType type)
 // get number of new/delete operations per second
 Bool MemoryManager::updateOpPerSec(MemoryType type,Float &news, Float &deletes)
 {
+    if (type == MEM_FAST) {
+        mergeThreadAllocStats();
+    }
+
 	O3D_MemoryManagerTimeCounter[type].update();
 
     if (O3D_MemoryManagerTimeCounter[type].check()) {
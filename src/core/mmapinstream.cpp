@@ -0,0 +1,429 @@
+/**
+ * @file mmapinstream.cpp
+ * @brief Implementation of MmapInStream.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/mmapinstream.h"
+
+#include "o3d/core/basefile.h"
+#include "o3d/core/templatearray.h"
+#include "o3d/core/debug.h"
+
+#ifdef O3D_WINDOWS
+    #include "o3d/core/architecture.h"
+#else
+    #include <sys/types.h>
+    #include <sys/stat.h>
+    #include <sys/mman.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace o3d;
+
+MmapInStream::MmapInStream(const String &filename) :
+    m_region(nullptr),
+    m_data(nullptr),
+    m_pos(nullptr),
+    m_size(0),
+    m_borrowing(False)
+{
+    String name(filename);
+    name.replace('\\', '/');
+
+    map(name);
+}
+
+MmapInStream::MmapInStream(const BaseFile &file) :
+    m_region(nullptr),
+    m_data(nullptr),
+    m_pos(nullptr),
+    m_size(0),
+    m_borrowing(False)
+{
+    map(file.getFullFileName());
+}
+
+MmapInStream::~MmapInStream()
+{
+    close();
+}
+
+void MmapInStream::map(const String &filename)
+{
+    UInt8 *data = nullptr;
+    UInt64 size = 0;
+
+#ifdef O3D_WINDOWS
+    HANDLE file = CreateFileW(
+                filename.getData(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                nullptr);
+
+    if (file == INVALID_HANDLE_VALUE) {
+        O3D_ERROR(E_FileNotFoundOrInvalidRights("", filename));
+    }
+
+    LARGE_INTEGER length;
+    if (!GetFileSizeEx(file, &length)) {
+        CloseHandle(file);
+        O3D_ERROR(E_FileNotFoundOrInvalidRights("", filename));
+    }
+
+    size = (UInt64)length.QuadPart;
+
+    if (size > 0) {
+        // copy on write, the view remains valid once the handles are closed
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        if (mapping) {
+            data = (UInt8*)MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+            CloseHandle(mapping);
+        }
+
+        if (!data) {
+            CloseHandle(file);
+            O3D_ERROR(E_FileNotFoundOrInvalidRights("Unable to map the file", filename));
+        }
+    }
+
+    CloseHandle(file);
+#else
+    int fd = ::open(filename.toUtf8().getData(), O_RDONLY);
+    if (fd < 0) {
+        O3D_ERROR(E_FileNotFoundOrInvalidRights("", filename));
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        O3D_ERROR(E_FileNotFoundOrInvalidRights("", filename));
+    }
+
+    size = (UInt64)st.st_size;
+
+    if (size > (UInt64)(size_t)-1) {
+        ::close(fd);
+        O3D_ERROR(E_FileNotFoundOrInvalidRights("File too large to be mapped", filename));
+    }
+
+    if (size > 0) {
+        // copy on write, the mapping remains valid once the descriptor is closed
+        void *ptr = ::mmap(nullptr, (size_t)size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (ptr == MAP_FAILED) {
+            ::close(fd);
+            O3D_ERROR(E_FileNotFoundOrInvalidRights("Unable to map the file", filename));
+        }
+
+        ::madvise(ptr, (size_t)size, MADV_SEQUENTIAL);
+        data = (UInt8*)ptr;
+    }
+
+    ::close(fd);
+#endif
+
+    m_region = new Region;
+    m_region->counter.reset(1);
+    m_region->data = data;
+    m_region->size = size;
+
+    m_data = m_pos = data;
+    m_size = size;
+}
+
+void MmapInStream::releaseRegion(void *region)
+{
+    Region *lregion = (Region*)region;
+
+    if (lregion->counter.decrement() == 0) {
+        if (lregion->data) {
+        #ifdef O3D_WINDOWS
+            UnmapViewOfFile(lregion->data);
+        #else
+            ::munmap(lregion->data, (size_t)lregion->size);
+        #endif
+        }
+
+        deletePtr(lregion);
+    }
+}
+
+Bool MmapInStream::isMemory() const
+{
+    return True;
+}
+
+UInt32 MmapInStream::reader(void *buf, UInt32 size, UInt32 count)
+{
+    UInt64 len = UInt64(size) * count;
+
+    if (len > UInt64(m_data + m_size - m_pos)) {
+        len = UInt64(m_data + m_size - m_pos);
+    }
+
+    memcpy(buf, m_pos, (size_t)len);
+
+    m_pos += len;
+
+    return (UInt32)len;
+}
+
+const UInt8* MmapInStream::getDirectPointer(UInt32 size)
+{
+    if (UInt64(size) > UInt64(m_data + m_size - m_pos)) {
+        return nullptr;
+    }
+
+    const UInt8 *ptr = m_pos;
+    m_pos += size;
+
+    return ptr;
+}
+
+const UInt8* MmapInStream::getMappedData(UInt64 &size) const
+{
+    size = m_size;
+    return m_data;
+}
+
+void MmapInStream::setBorrowing(Bool borrowing)
+{
+    m_borrowing = borrowing;
+}
+
+Bool MmapInStream::isBorrowing() const
+{
+    return m_borrowing;
+}
+
+const UInt8* MmapInStream::borrowDirectPointer(
+        UInt32 size,
+        UInt32 alignment,
+        void (*&releaser)(void*),
+        void *&owner)
+{
+    if (!m_borrowing || !m_region || size == 0) {
+        return nullptr;
+    }
+
+    if (UInt64(size) > UInt64(m_data + m_size - m_pos)) {
+        return nullptr;
+    }
+
+    if (alignment > 1 && ((size_t)m_pos & (alignment - 1))) {
+        return nullptr;
+    }
+
+    m_region->counter.increment();
+
+    releaser = &MmapInStream::releaseRegion;
+    owner = m_region;
+
+    const UInt8 *ptr = m_pos;
+    m_pos += size;
+
+    return ptr;
+}
+
+void MmapInStream::close()
+{
+    if (m_region) {
+        releaseRegion(m_region);
+        m_region = nullptr;
+    }
+
+    m_data = m_pos = nullptr;
+    m_size = 0;
+}
+
+void MmapInStream::reset(UInt64 n)
+{
+    if (n > m_size) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    m_pos = m_data + n;
+}
+
+void MmapInStream::seek(Int64 n)
+{
+    if (n > Int64(m_data + m_size - m_pos)) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    if (-n > Int64(m_pos - m_data)) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    m_pos += n;
+}
+
+void MmapInStream::end(Int64 n)
+{
+    if (n > 0) {
+        O3D_ERROR(E_IndexOutOfRange("value must be negative"));
+    }
+
+    if (UInt64(-n) > m_size) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    m_pos = m_data + m_size + n;
+}
+
+Int32 MmapInStream::getAvailable() const
+{
+    return (Int32)(m_data + m_size - m_pos);
+}
+
+Int32 MmapInStream::getPosition() const
+{
+    return (Int32)(m_pos - m_data);
+}
+
+Bool MmapInStream::isEnd() const
+{
+    return m_pos >= m_data + m_size;
+}
+
+UInt8 MmapInStream::peek()
+{
+    if (m_pos >= m_data + m_size) {
+        return (UInt8)EOF;
+    } else {
+        return *m_pos;
+    }
+}
+
+void MmapInStream::ignore(Int32 limit, UInt8 delim)
+{
+    const UInt8* plimit = m_pos + o3d::min<UInt64>(limit > 0 ? limit : 0, m_data + m_size - m_pos);
+
+    while ((m_pos < plimit) && (*m_pos != delim)) {
+        ++m_pos;
+    }
+}
+
+Int32 MmapInStream::readLine(String &str, CharacterEncoding encoding)
+{
+    const UInt8* plimit = m_data + m_size;
+
+    ArrayChar read;
+
+    Int32 c;
+    while ((m_pos < plimit) && ((c = *m_pos) != '\n')) {
+        if (c != '\r') {
+            read.push((Char)c);
+        }
+
+        ++m_pos;
+    }
+
+    if (m_pos < plimit && *m_pos == '\n') {
+        ++m_pos;
+    }
+
+    if ((read.getSize() == 0) && (m_pos == plimit)) {
+        // empty string
+        str.destroy();
+        return EOF;
+    }
+
+    read.push(0);
+
+    // set using the specified encoding
+    if (encoding == ENCODING_UTF8) {
+        str.fromUtf8(read.getData());
+    } else if (encoding == ENCODING_ANSI) {
+        str.set(read.getData(),0);
+    } else {
+        O3D_ERROR(E_InvalidParameter("Unsupported character encoding"));
+    }
+
+    return str.length();
+}
+
+Int32 MmapInStream::readLine(String &str, Int32 limit, UInt8 delim, CharacterEncoding encoding)
+{
+    const UInt8* plimit = m_pos + o3d::min<UInt64>(limit > 0 ? limit : 0, m_data + m_size - m_pos);
+
+    ArrayChar read;
+
+    Int32 c;
+    while ((m_pos < plimit) && ((c = *m_pos) != '\n') && (c != delim)) {
+        if (c != '\r') {
+            read.push((Char)c);
+        }
+
+        ++m_pos;
+    }
+
+    if (m_pos < plimit && *m_pos == '\n') {
+        ++m_pos;
+    }
+
+    if ((read.getSize() == 0) && (m_pos == plimit)) {
+        // empty string
+        str.destroy();
+        return EOF;
+    }
+
+    read.push(0);
+
+    // set using the specified encoding
+    if (encoding == ENCODING_UTF8) {
+        str.fromUtf8(read.getData());
+    } else if (encoding == ENCODING_ANSI) {
+        str.set(read.getData(),0);
+    } else {
+        O3D_ERROR(E_InvalidParameter("Unsupported character encoding"));
+    }
+
+    return str.length();
+}
+
+Int32 MmapInStream::readWord(String &str, CharacterEncoding encoding)
+{
+    const UInt8* limit = m_data + m_size;
+
+    ArrayChar read;
+
+    Int32 c;
+    while ((m_pos < limit) && ((c = *m_pos) != ' ') && (c != '\n') && (c != '\r')) {
+        read.push((Char)c);
+        ++m_pos;
+    }
+
+    if (m_pos < limit && *m_pos == '\r') {
+        ++m_pos;
+    }
+
+    if (m_pos < limit && *m_pos == '\n') {
+        ++m_pos;
+    }
+
+    if ((read.getSize() == 0) && (m_pos == limit)) {
+        return EOF;
+    }
+
+    read.push(0);
+
+    // set using the specified encoding
+    if (encoding == ENCODING_UTF8) {
+        str.fromUtf8(read.getData());
+    } else if (encoding == ENCODING_ANSI) {
+        str.set(read.getData(),0);
+    } else {
+        O3D_ERROR(E_InvalidParameter("Unsupported character encoding"));
+    }
+
+    return str.length();
+}
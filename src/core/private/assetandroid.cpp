@@ -253,6 +253,11 @@ void AssetAndroid::findAllFiles()
     AAssetDir_close(assetDir);
 }
 
+Bool AssetAndroid::isIndexable() const
+{
+    return False;
+}
+
 void AssetAndroid::searchFirstFile(const String &path)
 {
     String lPath(path);
@@ -13,7 +13,7 @@
 #include "o3d/core/architecture.h"
 #include "o3d/core/debug.h"
 
-#if defined(_MSC_VER) && defined(O3D_WIN64)
+#if defined(_MSC_VER)
 #include <intrin.h>
 #endif
 
@@ -32,6 +32,16 @@ Processor::Processor() :
 	m_has_sse(False),
 	m_has_sse2(False),
 	m_has_sse3(False),
+	m_has_ssse3(False),
+	m_has_sse4_1(False),
+	m_has_sse4_2(False),
+	m_has_avx(False),
+	m_has_avx2(False),
+	m_has_fma(False),
+	m_has_f16c(False),
+	m_has_avx512f(False),
+	m_has_avx512bw(False),
+	m_has_avx512vl(False),
 	m_is_htt(False),
 	m_stepping(0),
 	m_model(0),
@@ -96,6 +106,14 @@ void Processor::reportLog()
                 (m_has_sse3?"SSE3 ":"NO SSE3 ") << (m_has_ssse3?"SSSE3 ":"NO SSSE3 ") <<
                 (m_has_sse4_1?"SSE4.1 ":"NO SSE4.1 ") << (m_has_sse4_2?"SSE4.2":"NO SSE4.2"));
 
+    O3D_MESSAGE(String("- AVX: ") <<
+                (m_has_avx?"AVX ":"NO AVX ") << (m_has_avx2?"AVX2 ":"NO AVX2 ") <<
+                (m_has_fma?"FMA ":"NO FMA ") << (m_has_f16c?"F16C":"NO F16C"));
+
+    O3D_MESSAGE(String("- AVX-512: ") <<
+                (m_has_avx512f?"F ":"NO F ") << (m_has_avx512bw?"BW ":"NO BW ") <<
+                (m_has_avx512vl?"VL":"NO VL"));
+
     O3D_MESSAGE(String("- HTT: ") << (m_is_htt?"YES":"NO"));
 
     O3D_MESSAGE(String("- NumCPU: ") << m_num_cpu);
@@ -147,6 +165,22 @@ void Processor::reportLog()
             *c = info[2];
             *d = info[3];
         }
+
+        void cpuidex(UInt32 func, UInt32 subfunc, UInt32* a, UInt32* b, UInt32* c, UInt32* d)
+        {
+            Int32 info[4];
+            __cpuidex(info, (Int32)func, (Int32)subfunc);
+
+            *a = info[0];
+            *b = info[1];
+            *c = info[2];
+            *d = info[3];
+        }
+
+        UInt64 xgetbv0()
+        {
+            return _xgetbv(0);
+        }
     #elif defined(O3D_ARM) || defined(O3D_ARM64)
         void cpuid(UInt32 func, UInt32* a, UInt32* b, UInt32* c, UInt32* d)
         {
@@ -168,6 +202,20 @@ void Processor::reportLog()
         "cpuid              \n"
             :"=a" (*a), "=b" (*b), "=c" (*c), "=d" (*d) : "a" (func));
     }
+
+    void cpuidex(UInt32 func, UInt32 subfunc, UInt32* a, UInt32* b, UInt32* c, UInt32* d)
+    {
+          __asm__  (
+        "cpuid              \n"
+            :"=a" (*a), "=b" (*b), "=c" (*c), "=d" (*d) : "a" (func), "c" (subfunc));
+    }
+
+    UInt64 xgetbv0()
+    {
+        UInt32 a, d;
+        __asm__ ("xgetbv" : "=a" (a), "=d" (d) : "c" (0));
+        return ((UInt64)d << 32) | a;
+    }
   #elif defined(O3D_IX32)
     void cpuid(UInt32 func, UInt32* a, UInt32* b, UInt32* c, UInt32* d)
     {
@@ -178,6 +226,23 @@ void Processor::reportLog()
         "popl %%ebx        \n"
             :"=a" (*a), "=S" (*b), "=c" (*c), "=d" (*d) : "a" (func));
     }
+
+    void cpuidex(UInt32 func, UInt32 subfunc, UInt32* a, UInt32* b, UInt32* c, UInt32* d)
+    {
+          __asm__  (
+        "pushl %%ebx        \n"
+        "cpuid              \n"
+        "movl %%ebx, %%esi  \n"
+        "popl %%ebx        \n"
+            :"=a" (*a), "=S" (*b), "=c" (*c), "=d" (*d) : "a" (func), "c" (subfunc));
+    }
+
+    UInt64 xgetbv0()
+    {
+        UInt32 a, d;
+        __asm__ ("xgetbv" : "=a" (a), "=d" (d) : "c" (0));
+        return ((UInt64)d << 32) | a;
+    }
   #elif defined(O3D_ARM64)
         void cpuid(UInt32 func, UInt32* a, UInt32* b, UInt32* c, UInt32* d)
         {
@@ -200,6 +265,7 @@ void Processor::doCPUID()
 	UInt32 cpu_feat_edx = 0;
 	UInt32 cpu_feat_ecx = 0;
 	UInt32 cpu_feat_ext_edx = 0;
+	UInt32 cpu_feat7_ebx = 0;
 
 	UInt32 reax, rebx, recx, redx;
 
@@ -386,6 +452,12 @@ void Processor::doCPUID()
 	#endif*/
   #endif
 
+	// structured extended features
+	cpuid(0x0, &reax, &rebx, &recx, &redx);
+    if (reax >= 0x7) {
+		cpuidex(0x7, 0x0, &reax, &cpu_feat7_ebx, &recx, &redx);
+    }
+
 	// now process data we got from cpu
 	m_cpu_name = String(cpu_name_string);
 	m_cpu_vendor = String(cpu_vendor_id_string);
@@ -407,6 +479,22 @@ void Processor::doCPUID()
 	m_has_sse4_1 = (cpu_feat_ecx >> 19) & 0x1;
 	m_has_sse4_2 = (cpu_feat_ecx >> 20) & 0x1;
 
+	// AVX needs the OS to save the YMM registers (OSXSAVE and XCR0 SSE|AVX states)
+	UInt64 xcr0 = 0;
+    if (((cpu_feat_ecx >> 27) & 0x1) && ((cpu_feat_ecx >> 28) & 0x1)) {
+		xcr0 = xgetbv0();
+		m_has_avx = (xcr0 & 0x6) == 0x6;
+    }
+
+	m_has_avx2 = m_has_avx && ((cpu_feat7_ebx >> 5) & 0x1);
+	m_has_fma = m_has_avx && ((cpu_feat_ecx >> 12) & 0x1);
+	m_has_f16c = m_has_avx && ((cpu_feat_ecx >> 29) & 0x1);
+
+	// AVX-512 needs in addition the opmask and ZMM states
+	m_has_avx512f = m_has_avx && ((xcr0 & 0xe0) == 0xe0) && ((cpu_feat7_ebx >> 16) & 0x1);
+	m_has_avx512bw = m_has_avx512f && ((cpu_feat7_ebx >> 30) & 0x1);
+	m_has_avx512vl = m_has_avx512f && ((cpu_feat7_ebx >> 31) & 0x1);
+
 	m_has_mmx_ext = (cpu_feat_ext_edx >> 22) & 0x1;
 	m_has_3dnow = (cpu_feat_ext_edx >> 31) & 0x1;
 	m_has_3dnow_ext = (cpu_feat_ext_edx >> 30) & 0x1;
@@ -13,11 +13,28 @@
 
 using namespace o3d;
 
-ScheduledThreadPool::ScheduledThreadPool(UInt32 numThread, ThreadFactory *threadFactory) :
+ScheduledThreadPool::ScheduledThreadPool(
+        UInt32 numThread,
+        ThreadFactory *threadFactory,
+        UInt32 tickResolution) :
     m_daemon(False),
     m_running(False),
-    m_terminate(False)
+    m_terminate(False),
+    m_startTime(System::getTime(TIME_MICROSECOND)),
+    m_tickResolution(o3d::max<UInt32>(tickResolution, 1)),
+    m_currentTick(0),
+    m_numPending(0),
+    m_numDue(0),
+    m_nextId(1)
 {
+    for (Int32 l = 0; l < WHEEL_LEVELS; ++l) {
+        for (Int32 i = 0; i < WHEEL_SIZE; ++i) {
+            m_wheel[l][i].head = m_wheel[l][i].tail = nullptr;
+        }
+    }
+
+    m_dueTasks.head = m_dueTasks.tail = nullptr;
+
     AutoPtr<DefaultThreadFactory> tf;
 
     if (threadFactory == nullptr)
@@ -55,7 +72,9 @@ ScheduledThreadPool::~ScheduledThreadPool()
     m_running = False;
 
     // wake up
-    m_waitingTask.postSignal();
+    for (size_t i = 0; i < m_threads.size(); ++i) {
+        m_waitingTask.postSignal();
+    }
 
     // join...
     while (!m_threads.empty())
@@ -69,56 +88,72 @@ ScheduledThreadPool::~ScheduledThreadPool()
         m_threads.pop_front();
         locker.relock();
     }
+
+    // tasks remaining from a run during the terminate
+    for (std::pair<const UInt64, ScheduledRunnable*> &task : m_tasks) {
+        deletePtr(task.second);
+    }
+
+    m_tasks.clear();
 }
 
-void ScheduledThreadPool::schedule(Runnable *runnable,
+UInt64 ScheduledThreadPool::schedule(Runnable *runnable,
         Int32 initialDelay,
         Int32 delay,
         TimeUnit unit)
 {
-    RecurMutexLocker locker(m_mutex);
-
     ScheduledRunnable *newTask = new ScheduledRunnable;
 
     newTask->setTimestamp(System::getTime(TIME_MICROSECOND) + Time::toMicros<Int64>(initialDelay, unit));
     newTask->setRunnable(runnable);
     newTask->setDelay(Time::toMicros<Int64>(delay, unit));
 
-    if (m_pendingTasks.empty())
-    {
-        m_pendingTasks.push_back(newTask);
+    RecurMutexLocker locker(m_mutex);
 
-        locker.unlock();
+    newTask->m_id = m_nextId++;
+    m_tasks[newTask->m_id] = newTask;
 
-        // send a signal to consumers
-        m_waitingTask.postSignal();
+    newTask->m_expires = timestampToTick(newTask->m_timestamp);
+    insert(newTask);
 
-        return;
-    }
+    const UInt64 id = newTask->m_id;
+    const Bool due = newTask->m_list == &m_dueTasks;
 
-    for (IT_ScheduledRunnableList it = m_pendingTasks.begin(); it != m_pendingTasks.end(); ++it)
-    {
-        ScheduledRunnable *task = *it;
-        if (task->getTimestamp() > newTask->getTimestamp())
-        {
-            // insert before a task with a later timestamp
-            m_pendingTasks.insert(it, newTask);
+    locker.unlock();
+
+    // send a signal to consumers
+    if (due) {
+        m_waitingTask.postSignal();
+    }
 
-            locker.unlock();
+    return id;
+}
 
-            // send a signal to consumers
-            m_waitingTask.postSignal();
+Bool ScheduledThreadPool::cancel(UInt64 id)
+{
+    RecurMutexLocker locker(m_mutex);
 
-            return;
-        }
+    IT_TaskMap it = m_tasks.find(id);
+    if (it == m_tasks.end()) {
+        return False;
     }
 
-    m_pendingTasks.push_back(newTask);
+    ScheduledRunnable *task = it->second;
+    task->cancel();
 
-    locker.unlock();
+    // pending or due, else it is running and will be released after
+    if (task->m_list) {
+        unlink(task);
+        releaseTask(task);
+    }
 
-    // send a signal to consumers
-    m_waitingTask.postSignal();
+    return True;
+}
+
+UInt32 ScheduledThreadPool::getNumTasks() const
+{
+    RecurMutexLocker locker(m_mutex);
+    return (UInt32)m_tasks.size();
 }
 
 void ScheduledThreadPool::setDaemon(Bool daemon)
@@ -143,18 +178,16 @@ void ScheduledThreadPool::kill()
         thread->kill();
     }
 
-    for (ScheduledRunnable *scheduled : m_pendingTasks)
-    {
-        deletePtr(scheduled);
-    }
+    RecurMutexLocker locker(m_mutex);
 
-    for (ScheduledRunnable *scheduled : m_pickedTasks)
-    {
-        deletePtr(scheduled);
+    clearTasks();
+
+    // the running ones will never be released
+    for (std::pair<const UInt64, ScheduledRunnable*> &task : m_tasks) {
+        deletePtr(task.second);
     }
 
-    m_pendingTasks.clear();
-    m_pickedTasks.clear();
+    m_tasks.clear();
 }
 
 void ScheduledThreadPool::terminate()
@@ -166,39 +199,8 @@ void ScheduledThreadPool::terminate()
     // terminate signal
     m_terminate = True;
 
-    for (ScheduledRunnable *scheduled : m_pendingTasks)
-    {
-        m_mutex.unlock();
-        scheduled->cancel();
-        m_mutex.lock();
-    }
-
-    for (ScheduledRunnable *scheduled : m_pickedTasks)
-    {
-        m_mutex.unlock();
-        scheduled->cancel();
-        m_mutex.lock();
-    }
-/*  if a task is running, it can finish until the destructor or kill
-    while (!m_pendingTasks.empty() || !m_pickedTasks.empty())
-    {
-        m_mutex.unlock();
-        System::waitMs(10);
-        m_mutex.lock();
-    }*/
-
-    for (ScheduledRunnable *scheduled : m_pendingTasks)
-    {
-        deletePtr(scheduled);
-    }
-
-    for (ScheduledRunnable *scheduled : m_pickedTasks)
-    {
-        deletePtr(scheduled);
-    }
-
-    m_pendingTasks.clear();
-    m_pickedTasks.clear();
+    // if a task is running, it can finish until the destructor or kill
+    clearTasks();
 
     m_terminate = False;
 }
@@ -206,92 +208,117 @@ void ScheduledThreadPool::terminate()
 ScheduledRunnable *ScheduledThreadPool::getNextTask()
 {
     RecurMutexLocker locker(m_mutex);
-    if (m_pickedTasks.empty())
+
+    ScheduledRunnable *task = m_dueTasks.head;
+    if (task == nullptr)
         return nullptr;
 
-    ScheduledRunnable *task = m_pickedTasks.front();
-    m_pickedTasks.pop_front();
+    unlink(task);
 
     return task;
 }
 
+UInt32 ScheduledThreadPool::getNextTasks(std::vector<ScheduledRunnable*> &tasks, UInt32 maxTasks)
+{
+    RecurMutexLocker locker(m_mutex);
+
+    if (m_numDue == 0) {
+        return 0;
+    }
+
+    // a fair share of the due tasks, so that the others workers take the rest
+    const UInt32 numThreads = o3d::max<UInt32>((UInt32)m_threads.size(), 1);
+    const UInt32 count = o3d::min<UInt32>(maxTasks, o3d::max<UInt32>(m_numDue / numThreads, 1));
+
+    for (UInt32 i = 0; i < count; ++i) {
+        ScheduledRunnable *task = m_dueTasks.head;
+
+        unlink(task);
+        tasks.push_back(task);
+    }
+
+    return count;
+}
+
 void ScheduledThreadPool::waitForNewTask()
 {
-    m_waitingTask.waitSignal(100);
+    UInt32 timeout = 100;
+
+    {
+        RecurMutexLocker locker(m_mutex);
+
+        // wait for the next tick only if there are pending tasks
+        if (m_numPending > 0) {
+            timeout = o3d::clamp<UInt32>(m_tickResolution / 1000, 1, 100);
+        }
+    }
+
+    m_waitingTask.waitSignal(timeout);
 }
 
 void ScheduledThreadPool::poll()
 {
     RecurMutexLocker locker(m_mutex);
 
-    // no task to perform
-    if (m_pendingTasks.empty())
-        return;
-
-    ScheduledRunnable *task = m_pendingTasks.front();
-    Int64 time = System::getTime(TIME_MICROSECOND);
+    const Int64 time = System::getTime(TIME_MICROSECOND);
+    const UInt64 tick = time > m_startTime ? (UInt64)(time - m_startTime) / m_tickResolution : 0;
 
-    while (task->getTimestamp() <= time)
-    {
-        m_pendingTasks.pop_front();
-        m_pickedTasks.push_back(task);
-
-        if (!m_pendingTasks.empty())
-            task = m_pendingTasks.front();
-        else
-            break;
+    if (tick >= m_currentTick) {
+        advance(tick);
     }
 
-    if (m_pickedTasks.empty())
+    if (m_numDue == 0)
         return;
 
+    const UInt32 numSignals = o3d::min<UInt32>(m_numDue, (UInt32)m_threads.size());
+
     locker.unlock();
 
     // send a signal to consumers
-    m_waitingTask.postSignal();
+    for (UInt32 i = 0; i < numSignals; ++i) {
+        m_waitingTask.postSignal();
+    }
 }
 
 void ScheduledThreadPool::put(ScheduledRunnable *putTask)
 {
-    Int64 timestamp = System::getTime(TIME_MICROSECOND) + putTask->getDelay();
-    putTask->setTimestamp(timestamp);
+    std::vector<ScheduledRunnable*> tasks(1, putTask);
+    put(tasks);
+}
+
+void ScheduledThreadPool::put(std::vector<ScheduledRunnable*> &tasks)
+{
+    const Int64 time = System::getTime(TIME_MICROSECOND);
+    Bool due = False;
 
     {
         RecurMutexLocker locker(m_mutex);
 
-        if (!m_running) {
-            return;
-        }
-
-        if (putTask->isCanceled()) {
-            return;
-        }
-
-        if (m_pendingTasks.empty()) {
-            m_pendingTasks.push_back(putTask);
-
-            // send a signal to consumers
-            m_waitingTask.postSignal();
+        for (ScheduledRunnable *task : tasks) {
+            if (task->m_id == 0) {
+                // a task not created by schedule
+                task->m_id = m_nextId++;
+                m_tasks[task->m_id] = task;
+            }
 
-            return;
-        }
+            if (!m_running || m_terminate || task->isCanceled()) {
+                releaseTask(task);
+                continue;
+            }
 
-        for (IT_ScheduledRunnableList it = m_pendingTasks.begin(); it != m_pendingTasks.end(); ++it) {
-            ScheduledRunnable *task = *it;
-            if (task->getTimestamp() > putTask->getTimestamp()) {
-                // insert before a task with a later timestamp
-                m_pendingTasks.insert(it, putTask);
+            task->m_timestamp = time + task->m_delay;
+            task->m_expires = timestampToTick(task->m_timestamp);
 
-                // send a signal to consumers
-                m_waitingTask.postSignal();
+            insert(task);
 
-                return;
+            if (task->m_list == &m_dueTasks) {
+                due = True;
             }
         }
+    }
 
-        m_pendingTasks.push_back(putTask);
-
-        // send a signal to consumers
+    // send a signal to consumers
+    if (due) {
         m_waitingTask.postSignal();
     }
 }
@@ -308,13 +335,182 @@ Bool ScheduledThreadPool::isTerminate() const
     return m_terminate;
 }
 
+UInt64 ScheduledThreadPool::timestampToTick(Int64 timestamp) const
+{
+    if (timestamp <= m_startTime) {
+        return 0;
+    }
+
+    // rounded up, a task is never run before its timestamp
+    return ((UInt64)(timestamp - m_startTime) + m_tickResolution - 1) / m_tickResolution;
+}
+
+void ScheduledThreadPool::insert(ScheduledRunnable *task)
+{
+    // already due
+    if (task->m_expires < m_currentTick) {
+        pushBack(m_dueTasks, task);
+        ++m_numDue;
+        return;
+    }
+
+    const UInt64 delta = task->m_expires - m_currentTick;
+
+    // the farthest tasks are placed at the end of the wheel, and cascaded again later
+    const UInt64 maxDelta = (UInt64(1) << (WHEEL_BITS * WHEEL_LEVELS)) - 1;
+    const UInt64 expires = delta > maxDelta ? m_currentTick + maxDelta : task->m_expires;
+
+    Int32 level = 0;
+    while ((level < WHEEL_LEVELS - 1) && (delta >= (UInt64(1) << (WHEEL_BITS * (level + 1))))) {
+        ++level;
+    }
+
+    pushBack(m_wheel[level][(expires >> (WHEEL_BITS * level)) & WHEEL_MASK], task);
+    ++m_numPending;
+}
+
+void ScheduledThreadPool::advance(UInt64 tick)
+{
+    // nothing to expire, simply move the wheel
+    if (m_numPending == 0) {
+        m_currentTick = tick + 1;
+        return;
+    }
+
+    while (m_currentTick <= tick) {
+        const UInt32 index = (UInt32)(m_currentTick & WHEEL_MASK);
+
+        // at each turn of a level, cascade the slot of the upper level
+        if (index == 0) {
+            for (Int32 level = 1; level < WHEEL_LEVELS; ++level) {
+                const UInt32 upper = (UInt32)((m_currentTick >> (WHEEL_BITS * level)) & WHEEL_MASK);
+
+                TaskList &list = m_wheel[level][upper];
+                ScheduledRunnable *task = list.head;
+
+                list.head = list.tail = nullptr;
+
+                while (task) {
+                    ScheduledRunnable *next = task->m_next;
+
+                    --m_numPending;
+                    insert(task);
+
+                    task = next;
+                }
+
+                if (upper != 0) {
+                    break;
+                }
+            }
+        }
+
+        // move the expired slot to the due list
+        TaskList &slot = m_wheel[0][index];
+        ScheduledRunnable *task = slot.head;
+
+        while (task) {
+            ScheduledRunnable *next = task->m_next;
+
+            --m_numPending;
+            pushBack(m_dueTasks, task);
+            ++m_numDue;
+
+            task = next;
+        }
+
+        slot.head = slot.tail = nullptr;
+
+        ++m_currentTick;
+
+        if (m_numPending == 0) {
+            m_currentTick = tick + 1;
+            break;
+        }
+    }
+}
+
+void ScheduledThreadPool::clearTasks()
+{
+    std::vector<ScheduledRunnable*> tasks;
+    tasks.reserve(m_tasks.size());
+
+    for (std::pair<const UInt64, ScheduledRunnable*> &task : m_tasks) {
+        tasks.push_back(task.second);
+    }
+
+    for (ScheduledRunnable *task : tasks) {
+        task->cancel();
+
+        // the running ones are released by the worker once done
+        if (task->m_list) {
+            unlink(task);
+            releaseTask(task);
+        }
+    }
+}
+
+void ScheduledThreadPool::releaseTask(ScheduledRunnable *task)
+{
+    m_tasks.erase(task->m_id);
+    deletePtr(task);
+}
+
+void ScheduledThreadPool::pushBack(TaskList &list, ScheduledRunnable *task)
+{
+    task->m_list = &list;
+    task->m_next = nullptr;
+    task->m_prev = list.tail;
+
+    if (list.tail) {
+        list.tail->m_next = task;
+    } else {
+        list.head = task;
+    }
+
+    list.tail = task;
+}
+
+void ScheduledThreadPool::unlink(ScheduledRunnable *task)
+{
+    TaskList *list = static_cast<TaskList*>(task->m_list);
+    if (!list) {
+        return;
+    }
+
+    if (list == &m_dueTasks) {
+        --m_numDue;
+    } else {
+        --m_numPending;
+    }
+
+    if (task->m_prev) {
+        task->m_prev->m_next = task->m_next;
+    } else {
+        list->head = task->m_next;
+    }
+
+    if (task->m_next) {
+        task->m_next->m_prev = task->m_prev;
+    } else {
+        list->tail = task->m_prev;
+    }
+
+    task->m_prev = task->m_next = nullptr;
+    task->m_list = nullptr;
+}
+
 ScheduledRunnable::ScheduledRunnable() :
     m_delay(0),
-    m_running(False),
     m_cancel(False),
     m_done(False),
     m_runnable(nullptr),
-    m_timestamp(0)
+    m_timestamp(0),
+    m_id(0),
+    m_prev(nullptr),
+    m_next(nullptr),
+    m_list(nullptr),
+    m_expires(0)
 {
 }
 
@@ -325,49 +521,46 @@ ScheduledRunnable::~ScheduledRunnable()
 
 void ScheduledRunnable::setTimestamp(Int64 timestamp)
 {
-    FastMutexLocker locker(m_mutex);
     m_timestamp = timestamp;
 }
 
 void ScheduledRunnable::setRunnable(Runnable *runnable)
 {
-    FastMutexLocker locker(m_mutex);
     m_runnable = runnable;
 }
 
 void ScheduledRunnable::setDelay(Int64 delay)
 {
-    FastMutexLocker locker(m_mutex);
     m_delay = delay;
 }
 
 Int64 ScheduledRunnable::getTimestamp() const
 {
-    FastMutexLocker locker(m_mutex);
     return m_timestamp;
 }
 
+UInt64 ScheduledRunnable::getId() const
+{
+    return m_id;
+}
+
 void ScheduledRunnable::cancel()
 {
-    FastMutexLocker locker(m_mutex);
     m_cancel = True;
 }
 
 Bool ScheduledRunnable::isCanceled() const
 {
-    FastMutexLocker locker(m_mutex);
-    return m_cancel;
+    return m_cancel.load();
 }
 
 Bool ScheduledRunnable::isDone() const
 {
-    FastMutexLocker locker(m_mutex);
-    return m_done;
+    return m_done.load();
 }
 
 Int64 ScheduledRunnable::getDelay() const
 {
-    FastMutexLocker locker(m_mutex);
     return m_delay;
 }
 
@@ -375,65 +568,46 @@ Int32 ScheduledRunnable::run(void *p)
 {
     m_done = False;
 
-    if (m_cancel)
+    if (m_cancel.load())
         return 0;
 
-    m_running = True;
-
     Int32 res = m_runnable->run(p);
 
     if (res < 0)
         m_cancel = True;
 
     m_done = True;
-    m_running = False;
 
     return res;
 }
 
 ScheduledThreadPool::Scheduler::Scheduler(ScheduledThreadPool *pool) :
-    m_pool(pool),
-    m_task(nullptr)
+    m_pool(pool)
 {
 }
 
 Int32 ScheduledThreadPool::Scheduler::run(void *p)
 {
-    Bool run = False;
-    Bool terminate = False;
-
-    m_mutex.lock();
-    run = m_pool->isRunning();
-
-    while (run) {
-        m_mutex.unlock();
+    // maximal number of tasks taken at once
+    const UInt32 maxTasks = 64;
 
+    while (m_pool->isRunning()) {
         m_pool->poll();
-        m_task = m_pool->getNextTask();
 
         // running
-        if (m_task) {
-            // run
-            Int32 r = m_task->run(p);
-
-            // if not canceled do it again
-            if ((r >= 0) && !m_task->isCanceled() && !terminate) {
-                m_pool->put(m_task);
-            } else {
-                deletePtr(m_task);
+        if (m_pool->getNextTasks(m_tasks, maxTasks) > 0) {
+            for (ScheduledRunnable *task : m_tasks) {
+                task->run(p);
             }
 
-            m_task = nullptr;
+            // do it again if not canceled, else delete it
+            m_pool->put(m_tasks);
+            m_tasks.clear();
         } else {
-            // wait for a task during 100 ms
+            // wait for a task during a tick, or 100 ms if none
             m_pool->waitForNewTask();
         }
-
-        m_mutex.lock();
-        run = m_pool->isRunning();
-        terminate = m_pool->isTerminate();
     }
-    m_mutex.unlock();
 
     return 0;
 }
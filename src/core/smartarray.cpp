@@ -15,12 +15,39 @@
 
 using namespace o3d;
 
+//! Refer the data of a memory mapped stream instead of a copy, when it is enabled.
+template <class T>
+static Bool borrowFromStream(InStream &is, SmartArray<T> &array, Int32 size)
+{
+#ifdef O3D_BIG_ENDIAN
+    // the data must be swapped
+    if (sizeof(T) > 1) {
+        return False;
+    }
+#endif
+
+    if (!is.isBorrowing() || size <= 0 || UInt64(size) * sizeof(T) > 0xffffffff) {
+        return False;
+    }
+
+    void (*releaser)(void*) = nullptr;
+    void *owner = nullptr;
+
+    const UInt8 *data = is.borrowDirectPointer(UInt32(size * sizeof(T)), alignof(T), releaser, owner);
+    if (!data) {
+        return False;
+    }
+
+    array = SmartArray<T>((T*)data, size, releaser, owner);
+    return True;
+}
+
 template<> Bool SmartArray<Char>::writeToFile(OutStream &os) const
 {
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -33,9 +60,9 @@ template<> Bool SmartArray<Char>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
 		allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -46,7 +73,7 @@ template<> Bool SmartArray<UInt8>::writeToFile(OutStream &os) const
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -59,9 +86,9 @@ template<> Bool SmartArray<UInt8>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
 		allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -72,7 +99,7 @@ template<> Bool SmartArray<Int16>::writeToFile(OutStream &os) const
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -85,9 +112,9 @@ template<> Bool SmartArray<Int16>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
 		allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -98,7 +125,7 @@ template<> Bool SmartArray<UInt16>::writeToFile(OutStream &os) const
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -111,9 +138,9 @@ template<> Bool SmartArray<UInt16>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
 		allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -124,7 +151,7 @@ template<> Bool SmartArray<Int32>::writeToFile(OutStream &os) const
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -137,9 +164,9 @@ template<> Bool SmartArray<Int32>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
 		allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -150,7 +177,7 @@ template<> Bool SmartArray<UInt32>::writeToFile(OutStream &os) const
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -163,9 +190,9 @@ template<> Bool SmartArray<UInt32>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
 		allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -176,7 +203,7 @@ template<> Bool SmartArray<Int64>::writeToFile(OutStream &os) const
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -189,9 +216,9 @@ template<> Bool SmartArray<Int64>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
         allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -202,7 +229,7 @@ template<> Bool SmartArray<UInt64>::writeToFile(OutStream &os) const
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -215,9 +242,9 @@ template<> Bool SmartArray<UInt64>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
         allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -228,7 +255,7 @@ template<> Bool SmartArray<Float>::writeToFile(OutStream &os) const
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -241,9 +268,9 @@ template<> Bool SmartArray<Float>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
 		allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -254,7 +281,7 @@ template<> Bool SmartArray<Double>::writeToFile(OutStream &os) const
     os << m_size;
 
     if (m_size && m_data) {
-        os.write(m_data, m_size);
+        os.writeArray(m_data, (UInt32)m_size);
     }
 
     return True;
@@ -267,9 +294,9 @@ template<> Bool SmartArray<Double>::readFromFile(InStream &is)
     Int32 size;
     is >> size;
 
-    if (size > 0) {
+    if (size > 0 && !borrowFromStream(is, *this, size)) {
 		allocate(size);
-        is.read(m_data, size);
+        is.readArray(m_data, (UInt32)size);
     }
 
     return True;
@@ -0,0 +1,523 @@
+/**
+ * @file sparsematrix.cpp
+ * @brief Implementation of SparseMatrix.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/sparsematrix.h"
+
+#include "o3d/core/matrixnxp.h"
+#include "o3d/core/cpudispatch.h"
+#include "o3d/core/debug.h"
+
+#include <algorithm>
+#include <math.h>
+
+#ifdef O3D_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+using namespace o3d;
+
+namespace {
+
+//! Number of rows of a slice.
+const UInt32 SLICE = 8;
+
+//! Storage given to the product kernels.
+struct Storage
+{
+    UInt32 rows;
+
+    const UInt32 *rowOffsets;
+    const UInt32 *columns;
+    const Float *values;
+
+    const UInt32 *sliceOffsets;
+    const UInt32 *sliceColumns;
+    const Float *sliceValues;
+};
+
+typedef void (*MultiplyFunc)(const Storage &m, const Float *x, Float *y);
+
+//! Scalar, directly on the rows.
+void multiplyScalar(const Storage &m, const Float *x, Float *y)
+{
+    for (UInt32 i = 0; i < m.rows; ++i) {
+        Float sum = 0.f;
+
+        for (UInt32 k = m.rowOffsets[i]; k < m.rowOffsets[i+1]; ++k) {
+            sum += m.values[k] * x[m.columns[k]];
+        }
+
+        y[i] = sum;
+    }
+}
+
+//! Store the 8 results of a slice, the last one can be partial.
+inline void storeSlice(const Float *sums, Float *y, UInt32 first, UInt32 rows)
+{
+    const UInt32 count = std::min(SLICE, rows - first);
+    for (UInt32 l = 0; l < count; ++l) {
+        y[first + l] = sums[l];
+    }
+}
+
+#ifdef O3D_SIMD_X86
+
+//! 8 rows at once, the x values being loaded one by one.
+O3D_SIMD_TARGET_SSE2
+void multiplySSE2(const Storage &m, const Float *x, Float *y)
+{
+    const UInt32 numSlices = (m.rows + SLICE - 1) / SLICE;
+
+    for (UInt32 s = 0; s < numSlices; ++s) {
+        const UInt32 *c = m.sliceColumns + m.sliceOffsets[s];
+        const UInt32 *end = m.sliceColumns + m.sliceOffsets[s+1];
+        const Float *v = m.sliceValues + m.sliceOffsets[s];
+
+        __m128 lo = _mm_setzero_ps();
+        __m128 hi = _mm_setzero_ps();
+
+        for (; c < end; c += SLICE, v += SLICE) {
+            const __m128 xlo = _mm_setr_ps(x[c[0]], x[c[1]], x[c[2]], x[c[3]]);
+            const __m128 xhi = _mm_setr_ps(x[c[4]], x[c[5]], x[c[6]], x[c[7]]);
+
+            lo = _mm_add_ps(lo, _mm_mul_ps(_mm_loadu_ps(v), xlo));
+            hi = _mm_add_ps(hi, _mm_mul_ps(_mm_loadu_ps(v + 4), xhi));
+        }
+
+        if ((s + 1) * SLICE <= m.rows) {
+            _mm_storeu_ps(y + s*SLICE, lo);
+            _mm_storeu_ps(y + s*SLICE + 4, hi);
+        } else {
+            Float sums[SLICE];
+            _mm_storeu_ps(sums, lo);
+            _mm_storeu_ps(sums + 4, hi);
+            storeSlice(sums, y, s*SLICE, m.rows);
+        }
+    }
+}
+
+//! 8 rows at once, the x values being gathered. Also used with AVX-512, the products
+//! being bound by the gathers, not the width.
+O3D_SIMD_TARGET_AVX2
+void multiplyAVX2(const Storage &m, const Float *x, Float *y)
+{
+    const UInt32 numSlices = (m.rows + SLICE - 1) / SLICE;
+
+    for (UInt32 s = 0; s < numSlices; ++s) {
+        const UInt32 *c = m.sliceColumns + m.sliceOffsets[s];
+        const UInt32 *end = m.sliceColumns + m.sliceOffsets[s+1];
+        const Float *v = m.sliceValues + m.sliceOffsets[s];
+
+        __m256 sum = _mm256_setzero_ps();
+
+        for (; c < end; c += SLICE, v += SLICE) {
+            const __m256 xs = _mm256_i32gather_ps(x, _mm256_loadu_si256((const __m256i*)c), 4);
+            sum = _mm256_fmadd_ps(_mm256_loadu_ps(v), xs, sum);
+        }
+
+        if ((s + 1) * SLICE <= m.rows) {
+            _mm256_storeu_ps(y + s*SLICE, sum);
+        } else {
+            Float sums[SLICE];
+            _mm256_storeu_ps(sums, sum);
+            storeSlice(sums, y, s*SLICE, m.rows);
+        }
+    }
+}
+
+#endif // O3D_SIMD_X86
+
+//! Dot product accumulated in double, the solvers compare small residuals.
+inline Double dot(const Float *a, const Float *b, UInt32 n)
+{
+    Double sum = 0.0;
+    for (UInt32 i = 0; i < n; ++i) {
+        sum += Double(a[i]) * Double(b[i]);
+    }
+
+    return sum;
+}
+
+} // anonymous namespace
+
+SparseMatrix::SparseMatrix() :
+    m_rows(0),
+    m_cols(0)
+{
+    m_rowOffsets.push_back(0);
+    m_sliceOffsets.push_back(0);
+}
+
+SparseMatrix::SparseMatrix(UInt32 rows, UInt32 cols, const std::vector<Entry> &entries) :
+    m_rows(0),
+    m_cols(0)
+{
+    build(rows, cols, entries);
+}
+
+SparseMatrix::SparseMatrix(const MatrixNxP &mat, Float threshold) :
+    m_rows(mat.getNbrRows()),
+    m_cols(mat.getNbrCols())
+{
+    m_rowOffsets.reserve(m_rows + 1);
+    m_rowOffsets.push_back(0);
+
+    for (UInt32 i = 0; i < m_rows; ++i) {
+        for (UInt32 j = 0; j < m_cols; ++j) {
+            const Float value = mat.getData(i, j);
+            if (value != 0.f && o3d::abs(value) > threshold) {
+                m_columns.push_back(j);
+                m_values.push_back(value);
+            }
+        }
+
+        m_rowOffsets.push_back((UInt32)m_values.size());
+    }
+
+    buildSlices();
+}
+
+void SparseMatrix::build(UInt32 rows, UInt32 cols, const std::vector<Entry> &entries)
+{
+    // count the entries of each row, then place them
+    std::vector<UInt32> offsets(rows + 1, 0);
+
+    for (const Entry &e : entries) {
+        if (e.row >= rows || e.col >= cols) {
+            O3D_ERROR(E_InvalidParameter("Sparse matrix entry out of range"));
+        }
+
+        ++offsets[e.row + 1];
+    }
+
+    for (UInt32 i = 0; i < rows; ++i) {
+        offsets[i+1] += offsets[i];
+    }
+
+    std::vector<std::pair<UInt32, Float>> placed(entries.size());
+    std::vector<UInt32> cursor(offsets.begin(), offsets.end() - 1);
+
+    for (const Entry &e : entries) {
+        placed[cursor[e.row]++] = std::make_pair(e.col, e.value);
+    }
+
+    // sort each row by column and sum the duplicates
+    m_rows = rows;
+    m_cols = cols;
+
+    m_rowOffsets.assign(1, 0);
+    m_rowOffsets.reserve(rows + 1);
+    m_columns.clear();
+    m_columns.reserve(entries.size());
+    m_values.clear();
+    m_values.reserve(entries.size());
+
+    for (UInt32 i = 0; i < rows; ++i) {
+        std::sort(placed.begin() + offsets[i], placed.begin() + offsets[i+1],
+                  [] (const std::pair<UInt32, Float> &a, const std::pair<UInt32, Float> &b) {
+                      return a.first < b.first; });
+
+        const UInt32 first = (UInt32)m_columns.size();
+
+        for (UInt32 k = offsets[i]; k < offsets[i+1]; ++k) {
+            if (m_columns.size() > first && m_columns.back() == placed[k].first) {
+                m_values.back() += placed[k].second;
+            } else {
+                m_columns.push_back(placed[k].first);
+                m_values.push_back(placed[k].second);
+            }
+        }
+
+        m_rowOffsets.push_back((UInt32)m_columns.size());
+    }
+
+    buildSlices();
+}
+
+void SparseMatrix::buildSlices()
+{
+    m_diagonal.assign(m_rows, ~0U);
+
+    for (UInt32 i = 0; i < m_rows && i < m_cols; ++i) {
+        const UInt32 *begin = m_columns.data() + m_rowOffsets[i];
+        const UInt32 *end = m_columns.data() + m_rowOffsets[i+1];
+        const UInt32 *it = std::lower_bound(begin, end, i);
+
+        if (it != end && *it == i) {
+            m_diagonal[i] = UInt32(it - m_columns.data());
+        }
+    }
+
+    // each slice is stored step by step, a step holding the k-th entry of its 8 rows.
+    // the shorter rows are padded with a null value on their last column, already
+    // being read, such as the padding does not touch more memory.
+    const UInt32 numSlices = (m_rows + SLICE - 1) / SLICE;
+
+    m_sliceOffsets.assign(1, 0);
+    m_sliceOffsets.reserve(numSlices + 1);
+    m_sliceColumns.clear();
+    m_sliceValues.clear();
+
+    for (UInt32 s = 0; s < numSlices; ++s) {
+        const UInt32 first = s * SLICE;
+        const UInt32 last = std::min(first + SLICE, m_rows);
+
+        UInt32 length = 0;
+        for (UInt32 i = first; i < last; ++i) {
+            length = std::max(length, m_rowOffsets[i+1] - m_rowOffsets[i]);
+        }
+
+        for (UInt32 k = 0; k < length; ++k) {
+            for (UInt32 l = 0; l < SLICE; ++l) {
+                const UInt32 i = first + l;
+
+                if (i < last && m_rowOffsets[i] + k < m_rowOffsets[i+1]) {
+                    m_sliceColumns.push_back(m_columns[m_rowOffsets[i] + k]);
+                    m_sliceValues.push_back(m_values[m_rowOffsets[i] + k]);
+                } else {
+                    const Bool empty = i >= last || m_rowOffsets[i] == m_rowOffsets[i+1];
+                    m_sliceColumns.push_back(empty ? 0 : m_columns[m_rowOffsets[i+1] - 1]);
+                    m_sliceValues.push_back(0.f);
+                }
+            }
+        }
+
+        m_sliceOffsets.push_back((UInt32)m_sliceColumns.size());
+    }
+}
+
+Float SparseMatrix::getData(UInt32 i, UInt32 j) const
+{
+    if (i >= m_rows || j >= m_cols) {
+        return 0.f;
+    }
+
+    const UInt32 *begin = m_columns.data() + m_rowOffsets[i];
+    const UInt32 *end = m_columns.data() + m_rowOffsets[i+1];
+    const UInt32 *it = std::lower_bound(begin, end, j);
+
+    if (it != end && *it == j) {
+        return m_values[it - m_columns.data()];
+    }
+
+    return 0.f;
+}
+
+void SparseMatrix::multiply(const Float *x, Float *y) const
+{
+    static const MultiplyFunc func = SimdKernel<MultiplyFunc>(multiplyScalar)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, multiplySSE2)
+            .add(SIMD_AVX2, multiplyAVX2)
+#endif
+            .get();
+
+    const Storage storage = {
+        m_rows,
+        m_rowOffsets.data(), m_columns.data(), m_values.data(),
+        m_sliceOffsets.data(), m_sliceColumns.data(), m_sliceValues.data() };
+
+    func(storage, x, y);
+}
+
+VectorND SparseMatrix::operator* (const VectorND &vec) const
+{
+    if (vec.getDim() != m_cols) {
+        O3D_ERROR(E_InvalidParameter("Vector dimension must be the number of columns"));
+    }
+
+    VectorND result(m_rows);
+    if (m_rows > 0) {
+        multiply(vec.getData(), result.getData());
+    }
+
+    return result;
+}
+
+void SparseMatrix::gaussSeidelStep(VectorND &x, const VectorND &b) const
+{
+    if (m_rows != m_cols || x.getDim() != m_rows || b.getDim() != m_rows) {
+        O3D_ERROR(E_InvalidParameter("Gauss-Seidel needs a square matrix and vectors of its size"));
+    }
+
+    Float *xs = x.getData();
+    const Float *bs = b.getData();
+
+    for (UInt32 i = 0; i < m_rows; ++i) {
+        const UInt32 d = m_diagonal[i];
+        if (d == ~0U || o3d::abs(m_values[d]) <= o3d::Limits<Float>::epsilon()) {
+            continue;
+        }
+
+        Float sum = bs[i];
+        for (UInt32 k = m_rowOffsets[i]; k < m_rowOffsets[i+1]; ++k) {
+            if (k != d) {
+                sum -= m_values[k] * xs[m_columns[k]];
+            }
+        }
+
+        xs[i] = sum / m_values[d];
+    }
+}
+
+UInt32 SparseMatrix::solveConjugateGradient(
+        const VectorND &b,
+        VectorND &x,
+        UInt32 maxIterations,
+        Float tolerance,
+        Float *residual) const
+{
+    const UInt32 n = m_rows;
+
+    if (m_rows != m_cols || x.getDim() != n || b.getDim() != n) {
+        O3D_ERROR(E_InvalidParameter("Conjugate gradient needs a square matrix and vectors of its size"));
+    }
+
+    if (n == 0) {
+        if (residual) {
+            *residual = 0.f;
+        }
+        return 0;
+    }
+
+    const Double bNorm = sqrt(dot(b.getData(), b.getData(), n));
+    if (bNorm == 0.0) {
+        x.zero();
+        if (residual) {
+            *residual = 0.f;
+        }
+        return 0;
+    }
+
+    // inverse of the diagonal, 1 where it is missing or null
+    std::vector<Float> invDiag(n, 1.f);
+    for (UInt32 i = 0; i < n; ++i) {
+        if (m_diagonal[i] != ~0U && m_values[m_diagonal[i]] != 0.f) {
+            invDiag[i] = 1.f / m_values[m_diagonal[i]];
+        }
+    }
+
+    std::vector<Float> r(n), z(n), p(n), q(n);
+    Float *xs = x.getData();
+    const Float *bs = b.getData();
+
+    // r = b - M*x, z = D^-1 * r, p = z
+    multiply(xs, r.data());
+    for (UInt32 i = 0; i < n; ++i) {
+        r[i] = bs[i] - r[i];
+        z[i] = invDiag[i] * r[i];
+        p[i] = z[i];
+    }
+
+    const Double target = Double(tolerance) * bNorm;
+    Double rz = dot(r.data(), z.data(), n);
+    Double rNorm = sqrt(dot(r.data(), r.data(), n));
+
+    UInt32 iter = 0;
+    while (iter < maxIterations && rNorm > target) {
+        multiply(p.data(), q.data());
+
+        const Double pq = dot(p.data(), q.data(), n);
+        if (pq <= 0.0) {
+            // not positive definite, or converged to the float precision
+            break;
+        }
+
+        // update and the next dot products in the same pass
+        const Float alpha = Float(rz / pq);
+        Double rzNext = 0.0, rr = 0.0;
+
+        for (UInt32 i = 0; i < n; ++i) {
+            xs[i] += alpha * p[i];
+            r[i] -= alpha * q[i];
+            z[i] = invDiag[i] * r[i];
+
+            rzNext += Double(r[i]) * Double(z[i]);
+            rr += Double(r[i]) * Double(r[i]);
+        }
+
+        const Float beta = Float(rzNext / rz);
+        rz = rzNext;
+
+        for (UInt32 i = 0; i < n; ++i) {
+            p[i] = z[i] + beta * p[i];
+        }
+
+        rNorm = sqrt(rr);
+        ++iter;
+    }
+
+    if (residual) {
+        *residual = Float(rNorm / bNorm);
+    }
+
+    return iter;
+}
+
+UInt32 SparseMatrix::solveProjectedGaussSeidel(
+        const VectorND &b,
+        VectorND &x,
+        const VectorND &lo,
+        const VectorND &hi,
+        UInt32 maxIterations,
+        Float tolerance,
+        Float relaxation) const
+{
+    const UInt32 n = m_rows;
+
+    if (m_rows != m_cols || x.getDim() != n || b.getDim() != n || lo.getDim() != n || hi.getDim() != n) {
+        O3D_ERROR(E_InvalidParameter("Projected Gauss-Seidel needs a square matrix and vectors of its size"));
+    }
+
+    Float *xs = x.getData();
+    const Float *bs = b.getData();
+    const Float *los = lo.getData();
+    const Float *his = hi.getData();
+
+    // start inside the bounds
+    for (UInt32 i = 0; i < n; ++i) {
+        xs[i] = o3d::clamp(xs[i], los[i], his[i]);
+    }
+
+    UInt32 iter = 0;
+    while (iter < maxIterations) {
+        Float maxDelta = 0.f;
+        Float maxValue = 1.f;
+
+        for (UInt32 i = 0; i < n; ++i) {
+            const UInt32 d = m_diagonal[i];
+            if (d == ~0U || m_values[d] <= 0.f) {
+                continue;
+            }
+
+            Float sum = bs[i];
+            for (UInt32 k = m_rowOffsets[i]; k < m_rowOffsets[i+1]; ++k) {
+                sum -= m_values[k] * xs[m_columns[k]];
+            }
+
+            // sum is b - M*x including the diagonal term, so the step is sum / Mii
+            const Float prev = xs[i];
+            const Float next = o3d::clamp(prev + relaxation * sum / m_values[d], los[i], his[i]);
+
+            xs[i] = next;
+
+            maxDelta = o3d::max(maxDelta, o3d::abs(next - prev));
+            maxValue = o3d::max(maxValue, o3d::abs(next));
+        }
+
+        ++iter;
+
+        if (maxDelta <= tolerance * maxValue) {
+            break;
+        }
+    }
+
+    return iter;
+}
@@ -9,6 +9,7 @@
 
 #include "o3d/core/precompiled.h"
 #include "o3d/core/task.h"
+#include "o3d/core/workerpool.h"
 
 using namespace o3d;
 
@@ -20,7 +21,9 @@ Task::Task() :
 	m_priority(Thread::PRIORITY_NORMAL),
 	m_cpuAffinity(-1),
 	m_thread(this),
-	m_executed(False)
+	m_executed(False),
+	m_pooled(False),
+	m_running(False)
 {
 }
 
@@ -30,13 +33,31 @@ Task::~Task()
     if (m_thread.isThread()) {
 		m_thread.waitFinish();
     }
+
+    // or if queued or running into the worker pool
+    if (m_pooled) {
+        waitFinish();
+    }
 }
 
 // Start the task.
 void Task::start(Bool asynchronous)
 {
     if (asynchronous) {
-        if (!m_thread.isThread()) {
+        // no specific thread settings, so use the persistent workers
+        if ((m_priority == Thread::PRIORITY_NORMAL) && (m_cpuAffinity == -1)) {
+            {
+                FastMutexLocker locker(m_runMutex);
+                if (m_running) {
+                    return;
+                }
+
+                m_running = True;
+            }
+
+            m_pooled = True;
+            WorkerPool::instance()->push(this);
+        } else if (!m_thread.isThread()) {
 			m_thread.start();
 
 			// thread priority
@@ -60,7 +81,14 @@ void Task::start(Bool asynchronous)
 // Force to kill the task
 void Task::kill()
 {
-    if (m_thread.isThread()) {
+    if (m_pooled) {
+        // a pooled task cannot be killed, only canceled before it starts
+        if (WorkerPool::instance()->cancel(this)) {
+            releasePooled();
+        } else {
+            waitFinish();
+        }
+    } else if (m_thread.isThread()) {
 		m_thread.kill();
     }
 }
@@ -68,7 +96,14 @@ void Task::kill()
 // Is the task is currently running.
 void Task::waitFinish()
 {
-	m_thread.waitFinish();
+    if (m_pooled) {
+        FastMutexLocker locker(m_runMutex);
+        while (m_running) {
+            m_runCond.wait(m_runMutex);
+        }
+    } else {
+        m_thread.waitFinish();
+    }
 }
 
 Int32 Task::run(void *param)
@@ -81,9 +116,21 @@ Int32 Task::run(void *param)
 	else
 		onTaskFailed(this);
 
+    // the task can be deleted as soon as it is released
+    if (m_pooled) {
+        releasePooled();
+    }
+
 	return 0;
 }
 
+void Task::releasePooled()
+{
+    FastMutexLocker locker(m_runMutex);
+    m_running = False;
+    m_runCond.wakeAll();
+}
+
 // Finalize the task.
 void Task::synchronize()
 {
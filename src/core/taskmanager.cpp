@@ -9,6 +9,7 @@
 
 #include "o3d/core/precompiled.h"
 #include "o3d/core/taskmanager.h"
+#include "o3d/core/workerpool.h"
 #include "o3d/core/debug.h"
 
 #include <algorithm>
@@ -39,6 +40,10 @@ void TaskManager::destroy()
 TaskManager::TaskManager() :
 	m_maxTask(5)
 {
+	// tasks are processed by the persistent workers, keep them busy while some
+	// others finished tasks are waiting for their finalize
+	m_maxTask = o3d::max<UInt32>(m_maxTask, WorkerPool::instance()->getNumWorkers() * 2);
+
 	m_instance = (TaskManager*)this; // Used to avoid recursive call when the ctor call himself...
 
 	// connect himself to the delete task signal
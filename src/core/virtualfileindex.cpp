@@ -0,0 +1,140 @@
+/**
+ * @file virtualfileindex.cpp
+ * @brief Implementation of VirtualFileIndex.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/virtualfileindex.h"
+
+using namespace o3d;
+
+VirtualFileIndex::VirtualFileIndex() :
+    m_generation(0)
+{
+}
+
+VirtualFileIndex::~VirtualFileIndex()
+{
+}
+
+String VirtualFileIndex::foldPath(const String &path)
+{
+    String key(path);
+    key.trimRight('/', True);
+    key.lower();
+
+    return key;
+}
+
+void VirtualFileIndex::addAsset(Asset *asset)
+{
+    if (!asset || !asset->isIndexable()) {
+        return;
+    }
+
+    ++m_generation;
+
+    const String rootKey = foldPath(asset->location());
+    const Int32 numFiles = asset->getNumFiles();
+
+    m_entries.reserve(m_entries.size() + numFiles);
+    m_entryMap.reserve(m_entryMap.size() + numFiles);
+
+    for (Int32 i = 0; i < numFiles; ++i) {
+        add(asset->getFileName(i), asset, i, asset->getFileType(i), rootKey);
+    }
+}
+
+void VirtualFileIndex::rebuild(const T_AssetList &assets)
+{
+    clear();
+
+    for (CIT_AssetList cit = assets.cbegin(); cit != assets.cend(); ++cit) {
+        addAsset(*cit);
+    }
+}
+
+void VirtualFileIndex::clear()
+{
+    m_entries.clear();
+    m_entryMap.clear();
+    m_childrenMap.clear();
+
+    ++m_generation;
+}
+
+const VirtualFileIndex::Entry* VirtualFileIndex::find(const String &path) const
+{
+    T_EntryMap::const_iterator cit = m_entryMap.find(foldPath(path));
+    if (cit != m_entryMap.end()) {
+        return &m_entries[cit->second];
+    }
+
+    return nullptr;
+}
+
+const VirtualFileIndex::T_Children* VirtualFileIndex::children(const String &path) const
+{
+    T_ChildrenMap::const_iterator cit = m_childrenMap.find(foldPath(path));
+    if (cit != m_childrenMap.end()) {
+        return &cit->second;
+    }
+
+    return nullptr;
+}
+
+void VirtualFileIndex::add(
+        const String &name,
+        Asset *asset,
+        Int32 index,
+        FileTypes type,
+        const String &rootKey)
+{
+    String entryName(name);
+    entryName.trimRight('/', True);
+
+    String key(entryName);
+    key.lower();
+
+    if (key.isEmpty() || (key == rootKey)) {
+        return;
+    }
+
+    T_EntryMap::iterator it = m_entryMap.find(key);
+    if (it != m_entryMap.end()) {
+        Entry &entry = m_entries[it->second];
+
+        // an explicit directory listed after one of its children
+        if ((entry.index == -1) && (entry.asset == asset) && (type == FILE_DIR)) {
+            entry.index = index;
+        }
+
+        return;
+    }
+
+    const Int32 entryIndex = (Int32)m_entries.size();
+
+    Entry entry;
+    entry.name = entryName;
+    entry.asset = asset;
+    entry.index = index;
+    entry.type = type;
+
+    m_entries.push_back(entry);
+    m_entryMap[key] = entryIndex;
+
+    // reference it from its parent, the folding keeps the positions
+    const Int32 pos = key.reverseFind('/');
+    if (pos > 0) {
+        const String parentKey = key.sub(0, pos);
+        m_childrenMap[parentKey].push_back(entryIndex);
+
+        if ((parentKey != rootKey) && (m_entryMap.find(parentKey) == m_entryMap.end())) {
+            add(entryName.sub(0, pos), asset, -1, FILE_DIR, rootKey);
+        }
+    }
+}
@@ -0,0 +1,275 @@
+/**
+ * @file workerpool.cpp
+ * @brief Implementation of WorkerPool.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/workerpool.h"
+
+#include "o3d/core/cpudispatch.h"
+#include "o3d/core/debug.h"
+
+#include <algorithm>
+
+using namespace o3d;
+
+std::atomic<WorkerPool*> WorkerPool::m_instance(nullptr);
+
+// Protect the creation and the deletion of the singleton
+static FastMutex O3D_WorkerPoolMutex;
+
+// Pool and worker index of the calling thread (null/-1 for non worker threads)
+static thread_local WorkerPool* t_workerPool = nullptr;
+static thread_local Int32 t_workerIndex = -1;
+
+WorkerPool* WorkerPool::instance()
+{
+    WorkerPool *pool = m_instance.load(std::memory_order_acquire);
+    if (!pool) {
+        // many threads can ask for the first time
+        FastMutexLocker locker(O3D_WorkerPoolMutex);
+
+        pool = m_instance.load(std::memory_order_relaxed);
+        if (!pool) {
+            pool = new WorkerPool();
+            m_instance.store(pool, std::memory_order_release);
+        }
+    }
+
+    return pool;
+}
+
+void WorkerPool::destroy()
+{
+    WorkerPool *pool = nullptr;
+    {
+        FastMutexLocker locker(O3D_WorkerPoolMutex);
+        pool = m_instance.exchange(nullptr);
+    }
+
+    deletePtr(pool);
+}
+
+WorkerPool::WorkerPool(UInt32 numWorkers) :
+    m_numPending(0),
+    m_numSleeping(0),
+    m_nextWorker(0),
+    m_running(True)
+{
+    if (numWorkers == 0) {
+        // keep a core for the main thread
+        numWorkers = (UInt32)o3d::max<Int32>(CpuDispatch::getProcessor().getNumCPU() - 1, 1);
+    }
+
+    m_workers.reserve(numWorkers);
+
+    for (UInt32 i = 0; i < numWorkers; ++i) {
+        m_workers.push_back(new Worker(this, i));
+    }
+
+    // start only once every queue exists because workers steal from each others
+    for (Worker *worker : m_workers) {
+        worker->m_thread.start();
+        worker->m_thread.setName(String("o3d-worker-") << worker->m_index);
+    }
+}
+
+WorkerPool::~WorkerPool()
+{
+    // stop signal
+    {
+        FastMutexLocker locker(m_sleepMutex);
+        m_running = False;
+        m_wakeUp.wakeAll();
+    }
+
+    // join and cleanup
+    for (Worker *worker : m_workers) {
+        worker->m_thread.waitFinish();
+    }
+
+    for (Worker *worker : m_workers) {
+        if (!worker->m_queue.empty()) {
+            O3D_WARNING(String("WorkerPool: ") << (UInt32)worker->m_queue.size() <<
+                        " pending runnables dropped on worker " << worker->m_index);
+        }
+
+        deletePtr(worker);
+    }
+
+    m_workers.clear();
+}
+
+Int32 WorkerPool::getCurrentWorker() const
+{
+    return t_workerPool == this ? t_workerIndex : -1;
+}
+
+void WorkerPool::push(Runnable *runnable)
+{
+    O3D_ASSERT(runnable != nullptr);
+    if (!runnable) {
+        return;
+    }
+
+    Worker *worker = nullptr;
+
+    if (t_workerPool == this) {
+        // nested work stay on the same worker, and can be stolen by the others
+        worker = m_workers[t_workerIndex];
+    } else {
+        worker = m_workers[m_nextWorker++ % m_workers.size()];
+    }
+
+    {
+        FastMutexLocker locker(worker->m_mutex);
+        worker->m_queue.push_back(runnable);
+    }
+
+    ++m_numPending;
+
+    // m_numPending must be incremented before reading m_numSleeping, and a worker does the
+    // inverse, so at least one of both see the change of the other
+    if (m_numSleeping.load() > 0) {
+        FastMutexLocker locker(m_sleepMutex);
+        m_wakeUp.wakeOne();
+    }
+}
+
+Bool WorkerPool::cancel(Runnable *runnable)
+{
+    for (Worker *worker : m_workers) {
+        FastMutexLocker locker(worker->m_mutex);
+
+        auto it = std::find(worker->m_queue.begin(), worker->m_queue.end(), runnable);
+        if (it != worker->m_queue.end()) {
+            worker->m_queue.erase(it);
+            --m_numPending;
+
+            return True;
+        }
+    }
+
+    return False;
+}
+
+Bool WorkerPool::runPending()
+{
+    Runnable *runnable = nullptr;
+
+    if (t_workerPool == this) {
+        runnable = pop(t_workerIndex);
+    } else {
+        runnable = steal(-1);
+    }
+
+    if (runnable) {
+        runnable->run(nullptr);
+        return True;
+    }
+
+    return False;
+}
+
+Runnable* WorkerPool::pop(UInt32 index)
+{
+    Worker *worker = m_workers[index];
+
+    {
+        FastMutexLocker locker(worker->m_mutex);
+
+        if (!worker->m_queue.empty()) {
+            Runnable *runnable = worker->m_queue.back();
+            worker->m_queue.pop_back();
+            --m_numPending;
+
+            return runnable;
+        }
+    }
+
+    return steal(index);
+}
+
+Runnable* WorkerPool::steal(Int32 except)
+{
+    const UInt32 numWorkers = (UInt32)m_workers.size();
+
+    // start from the next one to spread the stealing over the victims
+    const UInt32 start = except >= 0 ? (UInt32)except + 1 : 0;
+
+    for (UInt32 i = 0; i < numWorkers; ++i) {
+        const UInt32 victim = (start + i) % numWorkers;
+        if ((Int32)victim == except) {
+            continue;
+        }
+
+        Worker *worker = m_workers[victim];
+
+        // don't wait on a busy queue, try the next one
+        if (!worker->m_mutex.tryLock()) {
+            continue;
+        }
+
+        if (!worker->m_queue.empty()) {
+            Runnable *runnable = worker->m_queue.front();
+            worker->m_queue.pop_front();
+            --m_numPending;
+
+            worker->m_mutex.unlock();
+            return runnable;
+        }
+
+        worker->m_mutex.unlock();
+    }
+
+    return nullptr;
+}
+
+void WorkerPool::waitForWork()
+{
+    FastMutexLocker locker(m_sleepMutex);
+
+    ++m_numSleeping;
+
+    while (m_running.load() && (m_numPending.load() <= 0)) {
+        m_wakeUp.wait(m_sleepMutex);
+    }
+
+    --m_numSleeping;
+}
+
+WorkerPool::Worker::Worker(WorkerPool *pool, UInt32 index) :
+    m_thread(this),
+    m_pool(pool),
+    m_index(index)
+{
+}
+
+WorkerPool::Worker::~Worker()
+{
+}
+
+Int32 WorkerPool::Worker::run(void *)
+{
+    t_workerPool = m_pool;
+    t_workerIndex = (Int32)m_index;
+
+    while (m_pool->m_running.load()) {
+        Runnable *runnable = m_pool->pop(m_index);
+
+        if (runnable) {
+            runnable->run(nullptr);
+        } else {
+            m_pool->waitForWork();
+        }
+    }
+
+    t_workerPool = nullptr;
+    t_workerIndex = -1;
+
+    return 0;
+}
@@ -0,0 +1,1035 @@
+/**
+ * @file xxhash3.cpp
+ * @brief XXH3 64 and 128 bits non cryptographic hash calculation.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Implementation of the XXH3 algorithm of Yann Collet (xxHash 0.8, BSD-2),
+ * with the same results for the default secret and a seed.
+ */
+
+#include "o3d/core/precompiled.h"
+
+#include "o3d/core/xxhash3.h"
+#include "o3d/core/stringutils.h"
+#include "o3d/core/instream.h"
+#include "o3d/core/cpudispatch.h"
+
+#ifdef O3D_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER) && defined(O3D_IX64)
+    #include <intrin.h>
+#endif
+
+using namespace o3d;
+
+static const UInt32 PRIME32_1 = 0x9E3779B1U;
+static const UInt32 PRIME32_2 = 0x85EBCA77U;
+static const UInt32 PRIME32_3 = 0xC2B2AE3DU;
+
+static const UInt64 PRIME64_1 = 0x9E3779B185EBCA87ULL;
+static const UInt64 PRIME64_2 = 0xC2B2AE3D27D4EB4FULL;
+static const UInt64 PRIME64_3 = 0x165667B19E3779F9ULL;
+static const UInt64 PRIME64_4 = 0x85EBCA77C2B2AE63ULL;
+static const UInt64 PRIME64_5 = 0x27D4EB2F165667C5ULL;
+
+static const UInt64 PRIME_MX1 = 0x165667919E3779F9ULL;
+static const UInt64 PRIME_MX2 = 0x9FB21C651E98DF25ULL;
+
+static const size_t STRIPE_LEN = 64;
+static const size_t SECRET_CONSUME_RATE = 8;
+static const size_t ACC_NB = 8;
+static const size_t SECRET_SIZE = 192;
+static const size_t SECRET_SIZE_MIN = 136;
+static const size_t SECRET_LIMIT = SECRET_SIZE - STRIPE_LEN;
+static const size_t SECRET_LASTACC_START = 7;
+static const size_t SECRET_MERGEACCS_START = 11;
+static const size_t STRIPES_PER_BLOCK = SECRET_LIMIT / SECRET_CONSUME_RATE;
+static const size_t BLOCK_LEN = STRIPE_LEN * STRIPES_PER_BLOCK;
+
+static const size_t MIDSIZE_MAX = 240;
+static const size_t MIDSIZE_STARTOFFSET = 3;
+static const size_t MIDSIZE_LASTOFFSET = 17;
+
+static const size_t BUFFER_SIZE = 256;
+static const size_t BUFFER_STRIPES = BUFFER_SIZE / STRIPE_LEN;
+
+// default secret
+static const UInt8 kSecret[SECRET_SIZE] = {
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+//---------------------------------------------------------------------------------------
+// Helpers
+//---------------------------------------------------------------------------------------
+
+namespace {
+
+struct U128
+{
+    UInt64 low;
+    UInt64 high;
+};
+
+inline UInt32 swap32(UInt32 x)
+{
+    return ((x << 24) & 0xff000000) | ((x << 8) & 0x00ff0000) |
+           ((x >> 8) & 0x0000ff00) | ((x >> 24) & 0x000000ff);
+}
+
+inline UInt64 swap64(UInt64 x)
+{
+    return ((UInt64)swap32((UInt32)x) << 32) | (UInt64)swap32((UInt32)(x >> 32));
+}
+
+inline UInt32 readLE32(const UInt8 *p)
+{
+    UInt32 v;
+    memcpy(&v, p, sizeof(UInt32));
+#ifdef O3D_BIG_ENDIAN
+    v = swap32(v);
+#endif
+    return v;
+}
+
+inline UInt64 readLE64(const UInt8 *p)
+{
+    UInt64 v;
+    memcpy(&v, p, sizeof(UInt64));
+#ifdef O3D_BIG_ENDIAN
+    v = swap64(v);
+#endif
+    return v;
+}
+
+inline void writeLE64(UInt8 *p, UInt64 v)
+{
+#ifdef O3D_BIG_ENDIAN
+    v = swap64(v);
+#endif
+    memcpy(p, &v, sizeof(UInt64));
+}
+
+inline UInt32 rotl32(UInt32 x, int r) { return (x << r) | (x >> (32 - r)); }
+inline UInt64 rotl64(UInt64 x, int r) { return (x << r) | (x >> (64 - r)); }
+
+inline UInt64 mult32to64(UInt64 a, UInt64 b)
+{
+    return (UInt64)(UInt32)a * (UInt64)(UInt32)b;
+}
+
+inline U128 mult64to128(UInt64 a, UInt64 b)
+{
+    U128 r;
+#if defined(__SIZEOF_INT128__)
+    const unsigned __int128 product = (unsigned __int128)a * (unsigned __int128)b;
+    r.low = (UInt64)product;
+    r.high = (UInt64)(product >> 64);
+#elif defined(_MSC_VER) && defined(O3D_IX64)
+    r.low = _umul128(a, b, &r.high);
+#else
+    const UInt64 lo_lo = mult32to64(a & 0xFFFFFFFF, b & 0xFFFFFFFF);
+    const UInt64 hi_lo = mult32to64(a >> 32, b & 0xFFFFFFFF);
+    const UInt64 lo_hi = mult32to64(a & 0xFFFFFFFF, b >> 32);
+    const UInt64 hi_hi = mult32to64(a >> 32, b >> 32);
+
+    const UInt64 cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    r.high = (hi_lo >> 32) + (cross >> 32) + hi_hi;
+    r.low = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+    return r;
+}
+
+inline UInt64 mul128Fold64(UInt64 a, UInt64 b)
+{
+    const U128 r = mult64to128(a, b);
+    return r.low ^ r.high;
+}
+
+inline UInt64 xorShift64(UInt64 v, int shift)
+{
+    return v ^ (v >> shift);
+}
+
+inline UInt64 xxh64Avalanche(UInt64 h)
+{
+    h ^= h >> 33;
+    h *= PRIME64_2;
+    h ^= h >> 29;
+    h *= PRIME64_3;
+    h ^= h >> 32;
+    return h;
+}
+
+inline UInt64 avalanche(UInt64 h)
+{
+    h = xorShift64(h, 37);
+    h *= PRIME_MX1;
+    return xorShift64(h, 32);
+}
+
+inline UInt64 rrmxmx(UInt64 h, UInt64 len)
+{
+    h ^= rotl64(h, 49) ^ rotl64(h, 24);
+    h *= PRIME_MX2;
+    h ^= (h >> 35) + len;
+    h *= PRIME_MX2;
+    return xorShift64(h, 28);
+}
+
+inline UInt64 mix16B(const UInt8 *input, const UInt8 *secret, UInt64 seed)
+{
+    return mul128Fold64(
+                readLE64(input) ^ (readLE64(secret) + seed),
+                readLE64(input + 8) ^ (readLE64(secret + 8) - seed));
+}
+
+inline U128 mix32B(U128 acc, const UInt8 *input1, const UInt8 *input2, const UInt8 *secret, UInt64 seed)
+{
+    acc.low += mix16B(input1, secret, seed);
+    acc.low ^= readLE64(input2) + readLE64(input2 + 8);
+    acc.high += mix16B(input2, secret + 16, seed);
+    acc.high ^= readLE64(input1) + readLE64(input1 + 8);
+    return acc;
+}
+
+//! Derive the secret of a seed for the long inputs.
+void initCustomSecret(UInt8 *secret, UInt64 seed)
+{
+    for (size_t i = 0; i < SECRET_SIZE / 16; ++i) {
+        writeLE64(secret + 16*i, readLE64(kSecret + 16*i) + seed);
+        writeLE64(secret + 16*i + 8, readLE64(kSecret + 16*i + 8) - seed);
+    }
+}
+
+//---------------------------------------------------------------------------------------
+// Short inputs, 64 bits
+//---------------------------------------------------------------------------------------
+
+UInt64 len1To3_64(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    const UInt32 combined = ((UInt32)input[0] << 16) | ((UInt32)input[len >> 1] << 24) |
+                            (UInt32)input[len - 1] | ((UInt32)len << 8);
+    const UInt64 bitflip = (readLE32(secret) ^ readLE32(secret + 4)) + seed;
+    return xxh64Avalanche((UInt64)combined ^ bitflip);
+}
+
+UInt64 len4To8_64(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    seed ^= (UInt64)swap32((UInt32)seed) << 32;
+
+    const UInt32 input1 = readLE32(input);
+    const UInt32 input2 = readLE32(input + len - 4);
+    const UInt64 bitflip = (readLE64(secret + 8) ^ readLE64(secret + 16)) - seed;
+    const UInt64 input64 = input2 + ((UInt64)input1 << 32);
+
+    return rrmxmx(input64 ^ bitflip, len);
+}
+
+UInt64 len9To16_64(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    const UInt64 bitflip1 = (readLE64(secret + 24) ^ readLE64(secret + 32)) + seed;
+    const UInt64 bitflip2 = (readLE64(secret + 40) ^ readLE64(secret + 48)) - seed;
+    const UInt64 inputLo = readLE64(input) ^ bitflip1;
+    const UInt64 inputHi = readLE64(input + len - 8) ^ bitflip2;
+
+    return avalanche(len + swap64(inputLo) + inputHi + mul128Fold64(inputLo, inputHi));
+}
+
+UInt64 len0To16_64(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    if (len > 8) {
+        return len9To16_64(input, len, secret, seed);
+    } else if (len >= 4) {
+        return len4To8_64(input, len, secret, seed);
+    } else if (len > 0) {
+        return len1To3_64(input, len, secret, seed);
+    }
+
+    return xxh64Avalanche(seed ^ (readLE64(secret + 56) ^ readLE64(secret + 64)));
+}
+
+UInt64 len17To128_64(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    UInt64 acc = len * PRIME64_1;
+
+    if (len > 32) {
+        if (len > 64) {
+            if (len > 96) {
+                acc += mix16B(input + 48, secret + 96, seed);
+                acc += mix16B(input + len - 64, secret + 112, seed);
+            }
+            acc += mix16B(input + 32, secret + 64, seed);
+            acc += mix16B(input + len - 48, secret + 80, seed);
+        }
+        acc += mix16B(input + 16, secret + 32, seed);
+        acc += mix16B(input + len - 32, secret + 48, seed);
+    }
+    acc += mix16B(input, secret, seed);
+    acc += mix16B(input + len - 16, secret + 16, seed);
+
+    return avalanche(acc);
+}
+
+UInt64 len129To240_64(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    const size_t nbRounds = len / 16;
+    UInt64 acc = len * PRIME64_1;
+
+    for (size_t i = 0; i < 8; ++i) {
+        acc += mix16B(input + 16*i, secret + 16*i, seed);
+    }
+
+    UInt64 accEnd = mix16B(input + len - 16, secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET, seed);
+    acc = avalanche(acc);
+
+    for (size_t i = 8; i < nbRounds; ++i) {
+        accEnd += mix16B(input + 16*i, secret + 16*(i-8) + MIDSIZE_STARTOFFSET, seed);
+    }
+
+    return avalanche(acc + accEnd);
+}
+
+//---------------------------------------------------------------------------------------
+// Short inputs, 128 bits
+//---------------------------------------------------------------------------------------
+
+U128 len1To3_128(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    const UInt32 combinedl = ((UInt32)input[0] << 16) | ((UInt32)input[len >> 1] << 24) |
+                             (UInt32)input[len - 1] | ((UInt32)len << 8);
+    const UInt32 combinedh = rotl32(swap32(combinedl), 13);
+    const UInt64 bitflipl = (readLE32(secret) ^ readLE32(secret + 4)) + seed;
+    const UInt64 bitfliph = (readLE32(secret + 8) ^ readLE32(secret + 12)) - seed;
+
+    U128 h;
+    h.low = xxh64Avalanche((UInt64)combinedl ^ bitflipl);
+    h.high = xxh64Avalanche((UInt64)combinedh ^ bitfliph);
+    return h;
+}
+
+U128 len4To8_128(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    seed ^= (UInt64)swap32((UInt32)seed) << 32;
+
+    const UInt32 inputLo = readLE32(input);
+    const UInt32 inputHi = readLE32(input + len - 4);
+    const UInt64 input64 = inputLo + ((UInt64)inputHi << 32);
+    const UInt64 bitflip = (readLE64(secret + 16) ^ readLE64(secret + 24)) + seed;
+
+    U128 m = mult64to128(input64 ^ bitflip, PRIME64_1 + (len << 2));
+
+    m.high += m.low << 1;
+    m.low ^= m.high >> 3;
+
+    m.low = xorShift64(m.low, 35);
+    m.low *= PRIME_MX2;
+    m.low = xorShift64(m.low, 28);
+    m.high = avalanche(m.high);
+    return m;
+}
+
+U128 len9To16_128(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    const UInt64 bitflipl = (readLE64(secret + 32) ^ readLE64(secret + 40)) - seed;
+    const UInt64 bitfliph = (readLE64(secret + 48) ^ readLE64(secret + 56)) + seed;
+    const UInt64 inputLo = readLE64(input);
+    UInt64 inputHi = readLE64(input + len - 8);
+
+    U128 m = mult64to128(inputLo ^ inputHi ^ bitflipl, PRIME64_1);
+    m.low += (UInt64)(len - 1) << 54;
+    inputHi ^= bitfliph;
+    m.high += inputHi + mult32to64((UInt32)inputHi, PRIME32_2 - 1);
+    m.low ^= swap64(m.high);
+
+    // 128x64 multiply
+    U128 h = mult64to128(m.low, PRIME64_2);
+    h.high += m.high * PRIME64_2;
+
+    h.low = avalanche(h.low);
+    h.high = avalanche(h.high);
+    return h;
+}
+
+U128 len0To16_128(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    if (len > 8) {
+        return len9To16_128(input, len, secret, seed);
+    } else if (len >= 4) {
+        return len4To8_128(input, len, secret, seed);
+    } else if (len > 0) {
+        return len1To3_128(input, len, secret, seed);
+    }
+
+    U128 h;
+    h.low = xxh64Avalanche(seed ^ readLE64(secret + 64) ^ readLE64(secret + 72));
+    h.high = xxh64Avalanche(seed ^ readLE64(secret + 80) ^ readLE64(secret + 88));
+    return h;
+}
+
+inline U128 finalize128(U128 acc, size_t len, UInt64 seed)
+{
+    U128 h;
+    h.low = avalanche(acc.low + acc.high);
+    h.high = 0 - avalanche((acc.low * PRIME64_1) + (acc.high * PRIME64_4) + ((len - seed) * PRIME64_2));
+    return h;
+}
+
+U128 len17To128_128(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    U128 acc;
+    acc.low = len * PRIME64_1;
+    acc.high = 0;
+
+    if (len > 32) {
+        if (len > 64) {
+            if (len > 96) {
+                acc = mix32B(acc, input + 48, input + len - 64, secret + 96, seed);
+            }
+            acc = mix32B(acc, input + 32, input + len - 48, secret + 64, seed);
+        }
+        acc = mix32B(acc, input + 16, input + len - 32, secret + 32, seed);
+    }
+    acc = mix32B(acc, input, input + len - 16, secret, seed);
+
+    return finalize128(acc, len, seed);
+}
+
+U128 len129To240_128(const UInt8 *input, size_t len, const UInt8 *secret, UInt64 seed)
+{
+    U128 acc;
+    acc.low = len * PRIME64_1;
+    acc.high = 0;
+
+    for (size_t i = 32; i < 160; i += 32) {
+        acc = mix32B(acc, input + i - 32, input + i - 16, secret + i - 32, seed);
+    }
+
+    acc.low = avalanche(acc.low);
+    acc.high = avalanche(acc.high);
+
+    for (size_t i = 160; i <= len; i += 32) {
+        acc = mix32B(acc, input + i - 32, input + i - 16, secret + MIDSIZE_STARTOFFSET + i - 160, seed);
+    }
+
+    acc = mix32B(acc, input + len - 16, input + len - 32,
+                 secret + SECRET_SIZE_MIN - MIDSIZE_LASTOFFSET - 16, 0 - seed);
+
+    return finalize128(acc, len, seed);
+}
+
+//---------------------------------------------------------------------------------------
+// Stripes accumulation
+//---------------------------------------------------------------------------------------
+
+typedef void (*AccumulateFunc)(UInt64 *acc, const UInt8 *input, const UInt8 *secret, size_t nbStripes);
+typedef void (*ScrambleFunc)(UInt64 *acc, const UInt8 *secret);
+
+void accumulateScalar(UInt64 *acc, const UInt8 *input, const UInt8 *secret, size_t nbStripes)
+{
+    for (size_t n = 0; n < nbStripes; ++n) {
+        const UInt8 *in = input + n * STRIPE_LEN;
+        const UInt8 *sec = secret + n * SECRET_CONSUME_RATE;
+
+        for (size_t i = 0; i < ACC_NB; ++i) {
+            const UInt64 dataVal = readLE64(in + 8*i);
+            const UInt64 dataKey = dataVal ^ readLE64(sec + 8*i);
+
+            acc[i ^ 1] += dataVal;
+            acc[i] += mult32to64(dataKey & 0xFFFFFFFF, dataKey >> 32);
+        }
+    }
+}
+
+void scrambleScalar(UInt64 *acc, const UInt8 *secret)
+{
+    for (size_t i = 0; i < ACC_NB; ++i) {
+        UInt64 a = xorShift64(acc[i], 47);
+        a ^= readLE64(secret + 8*i);
+        acc[i] = a * PRIME32_1;
+    }
+}
+
+#ifdef O3D_SIMD_X86
+
+O3D_SIMD_TARGET_SSE2
+void accumulateSSE2(UInt64 *acc, const UInt8 *input, const UInt8 *secret, size_t nbStripes)
+{
+    __m128i xacc[4];
+    for (int i = 0; i < 4; ++i) {
+        xacc[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(acc) + i);
+    }
+
+    for (size_t n = 0; n < nbStripes; ++n) {
+        const __m128i *in = reinterpret_cast<const __m128i*>(input + n * STRIPE_LEN);
+        const __m128i *sec = reinterpret_cast<const __m128i*>(secret + n * SECRET_CONSUME_RATE);
+
+        for (int i = 0; i < 4; ++i) {
+            const __m128i dataVec = _mm_loadu_si128(in + i);
+            const __m128i dataKey = _mm_xor_si128(dataVec, _mm_loadu_si128(sec + i));
+            // 32x32 products of the low and high halves of each lane
+            const __m128i dataKeyLo = _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m128i product = _mm_mul_epu32(dataKey, dataKeyLo);
+            // the data are added to the swapped lanes
+            const __m128i dataSwap = _mm_shuffle_epi32(dataVec, _MM_SHUFFLE(1, 0, 3, 2));
+
+            xacc[i] = _mm_add_epi64(product, _mm_add_epi64(xacc[i], dataSwap));
+        }
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(acc) + i, xacc[i]);
+    }
+}
+
+O3D_SIMD_TARGET_SSE2
+void scrambleSSE2(UInt64 *acc, const UInt8 *secret)
+{
+    const __m128i prime32 = _mm_set1_epi32((int)PRIME32_1);
+
+    for (int i = 0; i < 4; ++i) {
+        __m128i *a = reinterpret_cast<__m128i*>(acc) + i;
+        const __m128i accVec = _mm_loadu_si128(a);
+        const __m128i dataVec = _mm_xor_si128(accVec, _mm_srli_epi64(accVec, 47));
+        const __m128i dataKey = _mm_xor_si128(
+                    dataVec, _mm_loadu_si128(reinterpret_cast<const __m128i*>(secret) + i));
+
+        // 64x32 product by the low and high halves
+        const __m128i dataKeyHi = _mm_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+        const __m128i prodLo = _mm_mul_epu32(dataKey, prime32);
+        const __m128i prodHi = _mm_mul_epu32(dataKeyHi, prime32);
+
+        _mm_storeu_si128(a, _mm_add_epi64(prodLo, _mm_slli_epi64(prodHi, 32)));
+    }
+}
+
+O3D_SIMD_TARGET_AVX2
+void accumulateAVX2(UInt64 *acc, const UInt8 *input, const UInt8 *secret, size_t nbStripes)
+{
+    __m256i xacc[2];
+    for (int i = 0; i < 2; ++i) {
+        xacc[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(acc) + i);
+    }
+
+    for (size_t n = 0; n < nbStripes; ++n) {
+        const __m256i *in = reinterpret_cast<const __m256i*>(input + n * STRIPE_LEN);
+        const __m256i *sec = reinterpret_cast<const __m256i*>(secret + n * SECRET_CONSUME_RATE);
+
+        for (int i = 0; i < 2; ++i) {
+            const __m256i dataVec = _mm256_loadu_si256(in + i);
+            const __m256i dataKey = _mm256_xor_si256(dataVec, _mm256_loadu_si256(sec + i));
+            const __m256i dataKeyLo = _mm256_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+            const __m256i product = _mm256_mul_epu32(dataKey, dataKeyLo);
+            const __m256i dataSwap = _mm256_shuffle_epi32(dataVec, _MM_SHUFFLE(1, 0, 3, 2));
+
+            xacc[i] = _mm256_add_epi64(product, _mm256_add_epi64(xacc[i], dataSwap));
+        }
+    }
+
+    for (int i = 0; i < 2; ++i) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc) + i, xacc[i]);
+    }
+}
+
+O3D_SIMD_TARGET_AVX2
+void scrambleAVX2(UInt64 *acc, const UInt8 *secret)
+{
+    const __m256i prime32 = _mm256_set1_epi32((int)PRIME32_1);
+
+    for (int i = 0; i < 2; ++i) {
+        __m256i *a = reinterpret_cast<__m256i*>(acc) + i;
+        const __m256i accVec = _mm256_loadu_si256(a);
+        const __m256i dataVec = _mm256_xor_si256(accVec, _mm256_srli_epi64(accVec, 47));
+        const __m256i dataKey = _mm256_xor_si256(
+                    dataVec, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(secret) + i));
+
+        const __m256i dataKeyHi = _mm256_shuffle_epi32(dataKey, _MM_SHUFFLE(0, 3, 0, 1));
+        const __m256i prodLo = _mm256_mul_epu32(dataKey, prime32);
+        const __m256i prodHi = _mm256_mul_epu32(dataKeyHi, prime32);
+
+        _mm256_storeu_si256(a, _mm256_add_epi64(prodLo, _mm256_slli_epi64(prodHi, 32)));
+    }
+}
+
+#endif // O3D_SIMD_X86
+
+struct Dispatch
+{
+    AccumulateFunc accumulate;
+    ScrambleFunc scramble;
+};
+
+Dispatch selectDispatch()
+{
+    Dispatch dispatch = { accumulateScalar, scrambleScalar };
+
+#ifdef O3D_SIMD_X86
+    const SimdLevel level = CpuDispatch::getLevel();
+
+    if (level >= SIMD_AVX2) {
+        dispatch.accumulate = accumulateAVX2;
+        dispatch.scramble = scrambleAVX2;
+    } else if (level >= SIMD_SSE2) {
+        dispatch.accumulate = accumulateSSE2;
+        dispatch.scramble = scrambleSSE2;
+    }
+#endif
+
+    return dispatch;
+}
+
+inline const Dispatch& dispatch()
+{
+    static const Dispatch instance = selectDispatch();
+    return instance;
+}
+
+//---------------------------------------------------------------------------------------
+// Long inputs
+//---------------------------------------------------------------------------------------
+
+inline void initAcc(UInt64 *acc)
+{
+    acc[0] = PRIME32_3;
+    acc[1] = PRIME64_1;
+    acc[2] = PRIME64_2;
+    acc[3] = PRIME64_3;
+    acc[4] = PRIME64_4;
+    acc[5] = PRIME32_2;
+    acc[6] = PRIME64_5;
+    acc[7] = PRIME32_1;
+}
+
+void hashLongAcc(UInt64 *acc, const UInt8 *input, size_t len, const UInt8 *secret)
+{
+    const Dispatch &d = dispatch();
+    const size_t nbBlocks = (len - 1) / BLOCK_LEN;
+
+    initAcc(acc);
+
+    for (size_t n = 0; n < nbBlocks; ++n) {
+        d.accumulate(acc, input + n * BLOCK_LEN, secret, STRIPES_PER_BLOCK);
+        d.scramble(acc, secret + SECRET_LIMIT);
+    }
+
+    // last partial block
+    const size_t nbStripes = ((len - 1) - BLOCK_LEN * nbBlocks) / STRIPE_LEN;
+    d.accumulate(acc, input + nbBlocks * BLOCK_LEN, secret, nbStripes);
+
+    // last stripe
+    d.accumulate(acc, input + len - STRIPE_LEN, secret + SECRET_LIMIT - SECRET_LASTACC_START, 1);
+}
+
+UInt64 mergeAccs(const UInt64 *acc, const UInt8 *secret, UInt64 start)
+{
+    UInt64 result = start;
+
+    for (size_t i = 0; i < 4; ++i) {
+        result += mul128Fold64(acc[2*i] ^ readLE64(secret + 16*i),
+                               acc[2*i+1] ^ readLE64(secret + 16*i + 8));
+    }
+
+    return avalanche(result);
+}
+
+inline UInt64 mergeAccs64(const UInt64 *acc, const UInt8 *secret, UInt64 len)
+{
+    return mergeAccs(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1);
+}
+
+inline U128 mergeAccs128(const UInt64 *acc, const UInt8 *secret, UInt64 len)
+{
+    U128 h;
+    h.low = mergeAccs(acc, secret + SECRET_MERGEACCS_START, len * PRIME64_1);
+    h.high = mergeAccs(acc, secret + SECRET_SIZE - sizeof(UInt64) * ACC_NB - SECRET_MERGEACCS_START,
+                       ~(len * PRIME64_2));
+    return h;
+}
+
+//---------------------------------------------------------------------------------------
+// One shot
+//---------------------------------------------------------------------------------------
+
+UInt64 hashShort64(const UInt8 *input, size_t len, UInt64 seed)
+{
+    if (len <= 16) {
+        return len0To16_64(input, len, kSecret, seed);
+    } else if (len <= 128) {
+        return len17To128_64(input, len, kSecret, seed);
+    } else {
+        return len129To240_64(input, len, kSecret, seed);
+    }
+}
+
+U128 hashShort128(const UInt8 *input, size_t len, UInt64 seed)
+{
+    if (len <= 16) {
+        return len0To16_128(input, len, kSecret, seed);
+    } else if (len <= 128) {
+        return len17To128_128(input, len, kSecret, seed);
+    } else {
+        return len129To240_128(input, len, kSecret, seed);
+    }
+}
+
+//! Compute the 64 and 128 bits hashes, with a single accumulation for the long inputs.
+void hashBoth(const UInt8 *input, size_t len, UInt64 seed, UInt64 &h64, U128 &h128)
+{
+    if (len <= MIDSIZE_MAX) {
+        h64 = hashShort64(input, len, seed);
+        h128 = hashShort128(input, len, seed);
+        return;
+    }
+
+    UInt8 customSecret[SECRET_SIZE];
+    const UInt8 *secret = kSecret;
+
+    if (seed != 0) {
+        initCustomSecret(customSecret, seed);
+        secret = customSecret;
+    }
+
+    UInt64 acc[ACC_NB];
+    hashLongAcc(acc, input, len, secret);
+
+    h64 = mergeAccs64(acc, secret, len);
+    h128 = mergeAccs128(acc, secret, len);
+}
+
+//---------------------------------------------------------------------------------------
+// Streaming
+//---------------------------------------------------------------------------------------
+
+struct XXH3State
+{
+    UInt64 acc[ACC_NB];
+    UInt8 customSecret[SECRET_SIZE];
+    UInt8 buffer[BUFFER_SIZE];
+    size_t bufferedSize;
+    size_t nbStripesSoFar;
+    UInt64 totalLen;
+    UInt64 seed;
+
+    inline const UInt8* secret() const { return seed != 0 ? customSecret : kSecret; }
+};
+
+void stateReset(XXH3State *state, UInt64 seed)
+{
+    initAcc(state->acc);
+
+    state->bufferedSize = 0;
+    state->nbStripesSoFar = 0;
+    state->totalLen = 0;
+    state->seed = seed;
+
+    if (seed != 0) {
+        initCustomSecret(state->customSecret, seed);
+    }
+}
+
+const UInt8* consumeStripes(
+        UInt64 *acc,
+        size_t &nbStripesSoFar,
+        const UInt8 *input,
+        size_t nbStripes,
+        const UInt8 *secret)
+{
+    const Dispatch &d = dispatch();
+    const UInt8 *initialSecret = secret + nbStripesSoFar * SECRET_CONSUME_RATE;
+
+    if (nbStripes >= STRIPES_PER_BLOCK - nbStripesSoFar) {
+        size_t nbStripesThisIter = STRIPES_PER_BLOCK - nbStripesSoFar;
+
+        do {
+            d.accumulate(acc, input, initialSecret, nbStripesThisIter);
+            d.scramble(acc, secret + SECRET_LIMIT);
+
+            input += nbStripesThisIter * STRIPE_LEN;
+            nbStripes -= nbStripesThisIter;
+            nbStripesThisIter = STRIPES_PER_BLOCK;
+            initialSecret = secret;
+        } while (nbStripes >= STRIPES_PER_BLOCK);
+
+        nbStripesSoFar = 0;
+    }
+
+    if (nbStripes > 0) {
+        d.accumulate(acc, input, initialSecret, nbStripes);
+        input += nbStripes * STRIPE_LEN;
+        nbStripesSoFar += nbStripes;
+    }
+
+    return input;
+}
+
+void stateUpdate(XXH3State *state, const UInt8 *input, size_t len)
+{
+    const UInt8 *end = input + len;
+    const UInt8 *secret = state->secret();
+
+    state->totalLen += len;
+
+    if (len <= BUFFER_SIZE - state->bufferedSize) {
+        memcpy(state->buffer + state->bufferedSize, input, len);
+        state->bufferedSize += len;
+        return;
+    }
+
+    // complete and consume the buffer, it always keeps the last stripe
+    if (state->bufferedSize) {
+        const size_t loadSize = BUFFER_SIZE - state->bufferedSize;
+        memcpy(state->buffer + state->bufferedSize, input, loadSize);
+        input += loadSize;
+
+        consumeStripes(state->acc, state->nbStripesSoFar, state->buffer, BUFFER_STRIPES, secret);
+        state->bufferedSize = 0;
+    }
+
+    // directly from the input
+    if ((size_t)(end - input) > BUFFER_SIZE) {
+        const size_t nbStripes = (size_t)(end - 1 - input) / STRIPE_LEN;
+        input = consumeStripes(state->acc, state->nbStripesSoFar, input, nbStripes, secret);
+
+        // the previous stripe, for the last stripe of the digest
+        memcpy(state->buffer + BUFFER_SIZE - STRIPE_LEN, input - STRIPE_LEN, STRIPE_LEN);
+    }
+
+    memcpy(state->buffer, input, (size_t)(end - input));
+    state->bufferedSize = (size_t)(end - input);
+}
+
+void stateDigestLong(const XXH3State *state, UInt64 *acc)
+{
+    const UInt8 *secret = state->secret();
+    UInt8 lastStripe[STRIPE_LEN];
+    const UInt8 *lastStripePtr;
+
+    memcpy(acc, state->acc, sizeof(state->acc));
+
+    if (state->bufferedSize >= STRIPE_LEN) {
+        const size_t nbStripes = (state->bufferedSize - 1) / STRIPE_LEN;
+        size_t nbStripesSoFar = state->nbStripesSoFar;
+
+        consumeStripes(acc, nbStripesSoFar, state->buffer, nbStripes, secret);
+        lastStripePtr = state->buffer + state->bufferedSize - STRIPE_LEN;
+    } else {
+        const size_t catchupSize = STRIPE_LEN - state->bufferedSize;
+        memcpy(lastStripe, state->buffer + BUFFER_SIZE - catchupSize, catchupSize);
+        memcpy(lastStripe + catchupSize, state->buffer, state->bufferedSize);
+        lastStripePtr = lastStripe;
+    }
+
+    dispatch().accumulate(acc, lastStripePtr, secret + SECRET_LIMIT - SECRET_LASTACC_START, 1);
+}
+
+} // anonymous namespace
+
+//---------------------------------------------------------------------------------------
+// XXH3Hash
+//---------------------------------------------------------------------------------------
+
+XXH3Hash::XXH3Hash(UInt64 seed) :
+    m_hash64(0),
+    m_rawDigest(16),
+    m_privateData(new XXH3State)
+{
+    m_hash128[0] = m_hash128[1] = 0;
+    stateReset(reinterpret_cast<XXH3State*>(m_privateData), seed);
+}
+
+XXH3Hash::XXH3Hash(const UInt8 *data, UInt32 len, UInt64 seed) :
+    m_rawDigest(16),
+    m_privateData(nullptr)
+{
+    UInt64 h64;
+    U128 h128;
+
+    hashBoth(data, data ? len : 0, seed, h64, h128);
+    setResult(h64, h128.low, h128.high);
+}
+
+XXH3Hash::XXH3Hash(const SmartArrayUInt8 &array, UInt64 seed) :
+    m_rawDigest(16),
+    m_privateData(nullptr)
+{
+    UInt64 h64;
+    U128 h128;
+
+    hashBoth(array.getData(), array.isValid() ? array.getSizeInBytes() : 0, seed, h64, h128);
+    setResult(h64, h128.low, h128.high);
+}
+
+XXH3Hash::XXH3Hash(InStream &is, UInt64 seed) :
+    m_hash64(0),
+    m_rawDigest(16),
+    m_privateData(new XXH3State)
+{
+    m_hash128[0] = m_hash128[1] = 0;
+    stateReset(reinterpret_cast<XXH3State*>(m_privateData), seed);
+
+    update(is);
+    finalize();
+}
+
+XXH3Hash::~XXH3Hash()
+{
+    if (m_privateData != nullptr) {
+        delete reinterpret_cast<XXH3State*>(m_privateData);
+    }
+}
+
+void XXH3Hash::update(const UInt8 *data, UInt32 len)
+{
+    if (m_privateData && data && len) {
+        stateUpdate(reinterpret_cast<XXH3State*>(m_privateData), data, len);
+    }
+}
+
+void XXH3Hash::update(const SmartArrayUInt8 &array)
+{
+    if (m_privateData && array.isValid()) {
+        stateUpdate(reinterpret_cast<XXH3State*>(m_privateData), array.getData(), array.getSizeInBytes());
+    }
+}
+
+void XXH3Hash::update(InStream &is)
+{
+    if (!m_privateData) {
+        return;
+    }
+
+    XXH3State *state = reinterpret_cast<XXH3State*>(m_privateData);
+
+    // directly from the memory streams
+    if (is.isMemory() && is.getAvailable() > 0) {
+        const Int32 size = is.getAvailable();
+        const UInt8 *data = reinterpret_cast<const UInt8*>(is.getDirectPointer(size));
+
+        if (data) {
+            stateUpdate(state, data, size);
+            return;
+        }
+    }
+
+    // stream, with larger reads than the other hashes for its throughput
+    const Int32 BUF_SIZE = 65536;
+
+    UInt8 *buf = new UInt8[BUF_SIZE];
+    Int32 size;
+
+    while (is.getAvailable() > 0) {
+        size = o3d::min(is.getAvailable(), BUF_SIZE);
+
+        is.read(buf, size);
+        stateUpdate(state, buf, size);
+    }
+
+    deleteArray(buf);
+}
+
+void XXH3Hash::finalize()
+{
+    if (!m_privateData) {
+        return;
+    }
+
+    XXH3State *state = reinterpret_cast<XXH3State*>(m_privateData);
+
+    if (state->totalLen > MIDSIZE_MAX) {
+        UInt64 acc[ACC_NB];
+        stateDigestLong(state, acc);
+
+        const U128 h128 = mergeAccs128(acc, state->secret(), state->totalLen);
+        setResult(mergeAccs64(acc, state->secret(), state->totalLen), h128.low, h128.high);
+    } else {
+        // the whole input is into the buffer
+        UInt64 h64;
+        U128 h128;
+
+        hashBoth(state->buffer, (size_t)state->totalLen, state->seed, h64, h128);
+        setResult(h64, h128.low, h128.high);
+    }
+
+    deletePtr(state);
+    m_privateData = nullptr;
+}
+
+String XXH3Hash::getHex() const
+{
+    return StringUtils::toHex(m_rawDigest, False);
+}
+
+UInt64 XXH3Hash::hash64(const void *data, size_t len, UInt64 seed)
+{
+    const UInt8 *input = reinterpret_cast<const UInt8*>(data);
+
+    if (len <= MIDSIZE_MAX) {
+        return hashShort64(input, len, seed);
+    }
+
+    UInt8 customSecret[SECRET_SIZE];
+    const UInt8 *secret = kSecret;
+
+    if (seed != 0) {
+        initCustomSecret(customSecret, seed);
+        secret = customSecret;
+    }
+
+    UInt64 acc[ACC_NB];
+    hashLongAcc(acc, input, len, secret);
+
+    return mergeAccs64(acc, secret, len);
+}
+
+void XXH3Hash::hash128(const void *data, size_t len, UInt64 &low, UInt64 &high, UInt64 seed)
+{
+    const UInt8 *input = reinterpret_cast<const UInt8*>(data);
+    U128 h;
+
+    if (len <= MIDSIZE_MAX) {
+        h = hashShort128(input, len, seed);
+    } else {
+        UInt8 customSecret[SECRET_SIZE];
+        const UInt8 *secret = kSecret;
+
+        if (seed != 0) {
+            initCustomSecret(customSecret, seed);
+            secret = customSecret;
+        }
+
+        UInt64 acc[ACC_NB];
+        hashLongAcc(acc, input, len, secret);
+
+        h = mergeAccs128(acc, secret, len);
+    }
+
+    low = h.low;
+    high = h.high;
+}
+
+void XXH3Hash::setResult(UInt64 hash64, UInt64 low, UInt64 high)
+{
+    m_hash64 = hash64;
+    m_hash128[0] = low;
+    m_hash128[1] = high;
+
+    // canonical form, high part first, big-endian
+    UInt8 *raw = m_rawDigest.getData();
+    for (Int32 i = 0; i < 8; ++i) {
+        raw[i] = (UInt8)(high >> (56 - 8*i));
+        raw[8 + i] = (UInt8)(low >> (56 - 8*i));
+    }
+}
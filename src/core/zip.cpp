@@ -10,16 +10,9 @@
 #include "o3d/core/precompiled.h"
 #include "o3d/core/zip.h"
 #include "o3d/core/filemanager.h"
-#include "o3d/core/datainstream.h"
 
 #include "o3d/core/debug.h"
 
-#ifdef _MSC_VER
-	#include <zlib/zlib.h>
-#else
-	#include <zlib.h>
-#endif
-
 using namespace o3d;
 
 //! MAX_PATH isn't defined under UNIX
@@ -62,16 +55,14 @@ using namespace o3d;
     System::swapBytes8(&S.FilePos);
 
 Zip::Zip(InStream &is, const String &zipName, const String &zipPath) :
-    m_is(&is),
     m_zipPathName(zipPath),
     m_zipFileName(zipName)
 {
-    if (!m_is) {
-        O3D_ERROR(E_InvalidPrecondition("Stream must be valid"));
-    }
-
 	// read all headers
-	while(readHeader()) {}
+	while(readHeader(is)) {}
+
+    // the stream is owned once the archive is valid
+    m_source = new ArchiveSource(&is);
 }
 
 Zip::~Zip()
@@ -88,10 +79,11 @@ void Zip::destroy()
 	m_filelist.clear();
 	m_fileMap.clear();
 
-    deletePtr(m_is);
+    // deleted once the opened entries are closed
+    m_source = nullptr;
 }
 
-Bool Zip::readHeader()
+Bool Zip::readHeader(InStream &is)
 {
 	ZipToken *entry;
 	Char buffer[MAX_PATH];
@@ -99,7 +91,7 @@ Bool Zip::readHeader()
 	entry = new ZipToken;
 
 	// Lecture du header
-    if (m_is->reader(&entry->FileHeader, sizeof(ZipHeader), 1)) {
+    if (is.reader(&entry->FileHeader, sizeof(ZipHeader), 1)) {
 		#ifdef O3D_BIG_ENDIAN
 			// Convert
 			O3DZipHeaderToBIG(entry->FileHeader)
@@ -110,7 +102,7 @@ Bool Zip::readHeader()
 		}
 
 		// Lecture du nom
-        m_is->read(buffer, entry->FileHeader.FileNameLength);
+        is.read(buffer, entry->FileHeader.FileNameLength);
 		buffer[entry->FileHeader.FileNameLength] = '\0';
 
 		entry->FileName = buffer;
@@ -124,21 +116,21 @@ Bool Zip::readHeader()
         }
 
 		// On saute les extras fields
-        m_is->seek(entry->FileHeader.ExtraFieldLength);
+        is.seek(entry->FileHeader.ExtraFieldLength);
 
 		// On saute le Data descriptor si besoin est
         if (entry->FileHeader.BitFlag & O3D_ZIP_DATA_DESCRIPTOR) {
-            m_is->reader(&entry->FileHeader.DataDescriptor, sizeof(ZipDataDescriptor), 1);
+            is.reader(&entry->FileHeader.DataDescriptor, sizeof(ZipDataDescriptor), 1);
 			#ifdef O3D_BIG_ENDIAN
 			O3DZipDataDescriptorToBIG(entry->FileHeader.DataDescriptor)
 			#endif
 		}
 
 		// On a tout lu on recupere la position
-        entry->FilePos = m_is->getPosition();
+        entry->FilePos = is.getPosition();
 
 		// On saute les donnees
-        m_is->seek(entry->FileHeader.DataDescriptor.CompressedSize);
+        is.seek(entry->FileHeader.DataDescriptor.CompressedSize);
 
 		m_filelist.push_back(entry);
 
@@ -224,7 +216,6 @@ InStream *Zip::openInStream(const String &filename)
 
 InStream *Zip::openInStream(Int32 index)
 {
-    InStream *lfile;
     ZipToken *entry;
 
     if ((index < 0) || (index >= (Int32)m_filelist.size())) {
@@ -234,78 +225,31 @@ InStream *Zip::openInStream(Int32 index)
     entry = m_filelist[index];
 
     if (entry) {
-        // On decompresse le fichier et on le retourne
+        const ZipDataDescriptor &descriptor = entry->FileHeader.DataDescriptor;
+
         switch(entry->FileHeader.CompressionMethod) {
             case 0:
-            {
-                // Pas de compression on copie les donnees
-                m_is->reset((Int32)entry->FilePos);
-
-                // On creer un nouveau fichier memory
-                SmartArrayUInt8 data(entry->FileHeader.DataDescriptor.UnCompressedSize);
-
-                m_is->read(data.getData(), entry->FileHeader.DataDescriptor.UnCompressedSize);
-                lfile = new SharedDataInStream(data);
-            }
-                break;
+                // stored
+                return new ZipEntryInStream(
+                            m_source,
+                            entry->FilePos,
+                            descriptor.CompressedSize,
+                            descriptor.UnCompressedSize,
+                            False);
 
             case 8:
-            {
-                // Compression Deflated
-                m_is->reset((Int32)entry->FilePos);
-
-                UInt8 *CompressedData;	// Data compressees
-                UInt32 CompressedSize;
-                UInt32 UnCompressedSize;
-
-                // Taille des donnees
-                CompressedSize = entry->FileHeader.DataDescriptor.CompressedSize;
-                UnCompressedSize = entry->FileHeader.DataDescriptor.UnCompressedSize;
-
-                CompressedData = new UInt8[CompressedSize];
-                SmartArrayUInt8 data(UnCompressedSize);
-
-                // Lecture des donnees compresssees
-                m_is->read(CompressedData, CompressedSize);
-
-                // Decompression en utilisant Zlib
-                z_stream Stream;
-                UInt32 Erreur;
-
-                Stream.next_in = (Bytef*)CompressedData;
-                Stream.avail_in = (UInt32)CompressedSize;
-                Stream.next_out = (Bytef*)data.getData();
-                Stream.avail_out = (UInt32)UnCompressedSize;
-                Stream.zalloc = (alloc_func)nullptr;
-                Stream.zfree = (free_func)nullptr;
-                Stream.opaque = nullptr;
-
-                // Decompresse les donnees. wbits < 0 indique que l'on a pas de header dans les donnees en entree
-                Erreur = inflateInit2(&Stream,-MAX_WBITS);
-                if (Erreur == Z_OK) {
-                    Erreur = inflate(&Stream,Z_FINISH);
-                    inflateEnd(&Stream);
-                    if (Erreur == Z_STREAM_END) {
-                        Erreur = Z_OK;
-                    }
-
-                    Erreur = Z_OK;
-                    inflateEnd(&Stream);
-                }
-
-                deleteArray(CompressedData);
-
-                // fichier
-                lfile = new SharedDataInStream(data);
-            }
-                break;
+                // deflated
+                return new ZipEntryInStream(
+                            m_source,
+                            entry->FilePos,
+                            descriptor.CompressedSize,
+                            descriptor.UnCompressedSize,
+                            True);
 
             default:
                 // Compression non supporte
                 O3D_ERROR(E_InvalidFormat("Unsupported compression in " + fullPathName()));
         }
-
-        return lfile;
     } else {
         // Index en dehors de la plage de fichiers
         O3D_ERROR(E_IndexOutOfRange(""));
@@ -0,0 +1,427 @@
+/**
+ * @file zipentryinstream.cpp
+ * @brief Implementation of ZipEntryInStream.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/core/precompiled.h"
+#include "o3d/core/zipentryinstream.h"
+
+#include "o3d/core/templatearray.h"
+#include "o3d/core/debug.h"
+
+#ifdef _MSC_VER
+	#include <zlib/zlib.h>
+#else
+	#include <zlib.h>
+#endif
+
+using namespace o3d;
+
+ZipEntryInStream::ZipEntryInStream(
+        ArchiveSource *source,
+        UInt64 offset,
+        UInt32 compressedSize,
+        UInt32 size,
+        Bool deflated) :
+    m_source(source),
+    m_offset(offset),
+    m_compressedSize(compressedSize),
+    m_size(size),
+    m_zstream(nullptr),
+    m_input(nullptr),
+    m_inputPos(0),
+    m_window(nullptr),
+    m_windowPos(0),
+    m_windowSize(0),
+    m_pos(0),
+    m_streamPos(0)
+{
+    if (!source) {
+        O3D_ERROR(E_InvalidPrecondition("Source must be valid"));
+    }
+
+    if (deflated) {
+        m_zstream = new z_stream;
+        memset(m_zstream, 0, sizeof(z_stream));
+
+        // no zlib header into the zip entries
+        if (inflateInit2(m_zstream, -MAX_WBITS) != Z_OK) {
+            deletePtr(m_zstream);
+            O3D_ERROR(E_InvalidResult("Unable to initialize the inflate stream"));
+        }
+
+        if (!source->getData()) {
+            m_input = new UInt8[INPUT_SIZE];
+        }
+
+        restart();
+    }
+
+    m_window = new UInt8[WINDOW_SIZE];
+}
+
+ZipEntryInStream::~ZipEntryInStream()
+{
+    close();
+}
+
+Bool ZipEntryInStream::isMemory() const
+{
+    return False;
+}
+
+void ZipEntryInStream::close()
+{
+    if (m_zstream) {
+        inflateEnd(m_zstream);
+        deletePtr(m_zstream);
+    }
+
+    deleteArray(m_input);
+    deleteArray(m_window);
+
+    m_source = nullptr;
+
+    m_windowPos = m_windowSize = 0;
+    m_pos = m_streamPos = m_size = 0;
+}
+
+UInt32 ZipEntryInStream::produce(UInt8 *dest, UInt32 len)
+{
+    len = o3d::min(len, m_size - m_streamPos);
+    if (len == 0) {
+        return 0;
+    }
+
+    if (!m_zstream) {
+        // stored
+        const UInt32 read = m_source->readAt(m_offset + m_streamPos, dest, len);
+        m_streamPos += read;
+
+        return read;
+    }
+
+    m_zstream->next_out = (Bytef*)dest;
+    m_zstream->avail_out = len;
+
+    while (m_zstream->avail_out > 0) {
+        if ((m_zstream->avail_in == 0) && m_input && (m_inputPos < m_compressedSize)) {
+            const UInt32 read = m_source->readAt(
+                        m_offset + m_inputPos,
+                        m_input,
+                        o3d::min(INPUT_SIZE, m_compressedSize - m_inputPos));
+
+            if (read == 0) {
+                break;
+            }
+
+            m_zstream->next_in = (Bytef*)m_input;
+            m_zstream->avail_in = read;
+            m_inputPos += read;
+        }
+
+        const int ret = inflate(m_zstream, Z_NO_FLUSH);
+        if (ret == Z_STREAM_END) {
+            break;
+        } else if (ret == Z_BUF_ERROR) {
+            // truncated entry
+            break;
+        } else if (ret != Z_OK) {
+            O3D_ERROR(E_InvalidFormat("Corrupted zip entry"));
+        }
+    }
+
+    const UInt32 produced = len - m_zstream->avail_out;
+    m_streamPos += produced;
+
+    return produced;
+}
+
+UInt32 ZipEntryInStream::fillWindow()
+{
+    m_windowPos = 0;
+    m_windowSize = produce(m_window, WINDOW_SIZE);
+
+    return m_windowSize;
+}
+
+Int32 ZipEntryInStream::nextByte()
+{
+    if ((m_windowPos == m_windowSize) && (fillWindow() == 0)) {
+        return EOF;
+    }
+
+    ++m_pos;
+    return m_window[m_windowPos++];
+}
+
+void ZipEntryInStream::restart()
+{
+    if (m_zstream) {
+        inflateReset(m_zstream);
+
+        if (m_input) {
+            m_zstream->next_in = nullptr;
+            m_zstream->avail_in = 0;
+        } else {
+            // the whole entry is directly available
+            m_zstream->next_in = (Bytef*)(m_source->getData() + m_offset);
+            m_zstream->avail_in = (uInt)o3d::min<UInt64>(m_compressedSize, m_source->getSize() - m_offset);
+        }
+
+        m_inputPos = 0;
+    }
+
+    m_windowPos = m_windowSize = 0;
+    m_pos = m_streamPos = 0;
+}
+
+void ZipEntryInStream::seekTo(UInt32 pos)
+{
+    if (pos > m_size) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    // backward
+    if (pos < m_pos) {
+        if (m_pos - pos <= m_windowPos) {
+            m_windowPos -= m_pos - pos;
+            m_pos = pos;
+            return;
+        }
+
+        if (m_zstream) {
+            restart();
+        } else {
+            m_windowPos = m_windowSize = 0;
+            m_pos = m_streamPos = pos;
+            return;
+        }
+    }
+
+    // forward into the window
+    UInt32 skip = pos - m_pos;
+    if (skip <= m_windowSize - m_windowPos) {
+        m_windowPos += skip;
+        m_pos = pos;
+        return;
+    }
+
+    skip -= m_windowSize - m_windowPos;
+    m_windowPos = m_windowSize = 0;
+
+    if (!m_zstream) {
+        m_pos = m_streamPos = pos;
+        return;
+    }
+
+    // inflate and discard
+    while (skip > 0) {
+        if (fillWindow() == 0) {
+            break;
+        }
+
+        const UInt32 n = o3d::min(skip, m_windowSize);
+        m_windowPos = n;
+        skip -= n;
+    }
+
+    m_pos = pos - skip;
+}
+
+UInt32 ZipEntryInStream::reader(void *buf, UInt32 size, UInt32 count)
+{
+    UInt32 len = o3d::min(size * count, m_size - m_pos);
+    UInt8 *dest = (UInt8*)buf;
+    UInt32 total = 0;
+
+    while (total < len) {
+        // from the window
+        if (m_windowPos < m_windowSize) {
+            const UInt32 n = o3d::min(len - total, m_windowSize - m_windowPos);
+            memcpy(dest + total, m_window + m_windowPos, n);
+
+            m_windowPos += n;
+            total += n;
+
+            continue;
+        }
+
+        // large reads directly to the destination
+        if (len - total >= WINDOW_SIZE) {
+            const UInt32 n = produce(dest + total, len - total);
+            if (n == 0) {
+                break;
+            }
+
+            total += n;
+        } else if (fillWindow() == 0) {
+            break;
+        }
+    }
+
+    m_pos += total;
+
+    return total;
+}
+
+void ZipEntryInStream::reset(UInt64 n)
+{
+    if (n > m_size) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    seekTo((UInt32)n);
+}
+
+void ZipEntryInStream::seek(Int64 n)
+{
+    if ((Int64(m_pos) + n < 0) || (Int64(m_pos) + n > Int64(m_size))) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    seekTo((UInt32)(m_pos + n));
+}
+
+void ZipEntryInStream::end(Int64 n)
+{
+    if (n > 0) {
+        O3D_ERROR(E_IndexOutOfRange("value must be negative"));
+    }
+
+    if (Int64(m_size) + n < 0) {
+        O3D_ERROR(E_IndexOutOfRange(""));
+    }
+
+    seekTo((UInt32)(m_size + n));
+}
+
+Int32 ZipEntryInStream::getAvailable() const
+{
+    return (Int32)(m_size - m_pos);
+}
+
+Int32 ZipEntryInStream::getPosition() const
+{
+    return (Int32)m_pos;
+}
+
+Bool ZipEntryInStream::isEnd() const
+{
+    return m_pos >= m_size;
+}
+
+UInt8 ZipEntryInStream::peek()
+{
+    if ((m_windowPos == m_windowSize) && (fillWindow() == 0)) {
+        return (UInt8)EOF;
+    }
+
+    return m_window[m_windowPos];
+}
+
+void ZipEntryInStream::ignore(Int32 limit, UInt8 delim)
+{
+    Int32 counter = 0;
+
+    while ((counter < limit) && (peek() != delim) && !isEnd()) {
+        nextByte();
+        ++counter;
+    }
+}
+
+Int32 ZipEntryInStream::readLine(String &str, CharacterEncoding encoding)
+{
+    ArrayChar read;
+
+    Int32 c;
+    while (((c = nextByte()) != '\n') && (c != EOF)) {
+        if (c != '\r') {
+            read.push((Char)c);
+        }
+    }
+
+    if ((read.getSize() == 0) && (c == EOF)) {
+        // empty string
+        str.destroy();
+        return EOF;
+    }
+
+    read.push(0);
+
+    // set using the specified encoding
+    if (encoding == ENCODING_UTF8) {
+        str.fromUtf8(read.getData());
+    } else if (encoding == ENCODING_ANSI) {
+        str.set(read.getData(),0);
+    } else {
+        O3D_ERROR(E_InvalidParameter("Unsupported character encoding"));
+    }
+
+    return str.length();
+}
+
+Int32 ZipEntryInStream::readLine(String &str, Int32 limit, UInt8 delim, CharacterEncoding encoding)
+{
+    ArrayChar read;
+
+    Int32 c = EOF, counter = 0;
+
+    while ((counter < limit) && ((c = nextByte()) != '\n') && (c != EOF) && (c != delim)) {
+        if (c != '\r') {
+            read.push((Char)c);
+        }
+
+        ++counter;
+    }
+
+    if ((read.getSize() == 0) && (c == EOF)) {
+        // empty string
+        str.destroy();
+        return EOF;
+    }
+
+    read.push(0);
+
+    // set using the specified encoding
+    if (encoding == ENCODING_UTF8) {
+        str.fromUtf8(read.getData());
+    } else if (encoding == ENCODING_ANSI) {
+        str.set(read.getData(),0);
+    } else {
+        O3D_ERROR(E_InvalidParameter("Unsupported character encoding"));
+    }
+
+    return str.length();
+}
+
+Int32 ZipEntryInStream::readWord(String &str, CharacterEncoding encoding)
+{
+    ArrayChar read;
+
+    Int32 c;
+    while (((c = nextByte()) != ' ') && (c != EOF) && (c != '\n') && (c != '\r')) {
+        read.push((Char)c);
+    }
+
+    if ((read.getSize() == 0) && (c == EOF)) {
+        return EOF;
+    }
+
+    read.push(0);
+
+    // set using the specified encoding
+    if (encoding == ENCODING_UTF8) {
+        str.fromUtf8(read.getData());
+    } else if (encoding == ENCODING_ANSI) {
+        str.set(read.getData(),0);
+    } else {
+        O3D_ERROR(E_InvalidParameter("Unsupported character encoding"));
+    }
+
+    return str.length();
+}
@@ -16,11 +16,10 @@
 #include "o3d/engine/matrix.h"
 #include "o3d/engine/material/materialtechnique.h"
 #include "o3d/engine/scene/scene.h"
+#include "o3d/engine/utils/framemanager.h"
 #include "o3d/engine/context.h"
 #include "o3d/geom/aabbox.h"
 
-#include <list>
-
 using namespace o3d;
 
 O3D_IMPLEMENT_DYNAMIC_CLASS1(AlphaPipeline, ENGINE_ALPHA_PIPELINE, SceneEntity)
@@ -66,9 +65,9 @@ void AlphaPipeline::setInputListSize(UInt32 size)
 	{
 		UInt32 newsize;
 
-		// new size
-		if (size < m_inputSize + 100)
-			newsize = m_inputSize + 100;
+		// new size, geometric growth to limit the reallocations in steady state
+		if (size < m_inputSize + (m_inputSize >> 1) + 100)
+			newsize = m_inputSize + (m_inputSize >> 1) + 100;
 		else
 			newsize = size;
 
@@ -86,7 +85,7 @@ void AlphaPipeline::setInputListSize(UInt32 size)
         if (m_inputZ != nullptr)
 		{
 			memcpy(InputZTmp,m_inputZ,m_inputSize*sizeof(Float));
-			deleteArray(m_inputList);
+			deleteArray(m_inputZ);
 		}
 
 		m_inputList = InputListTmp;
@@ -100,8 +99,11 @@ void AlphaPipeline::sort()
 {
 	m_radixSort.sort(m_inputZ, m_numFaces);
 
-	// clear the draw list
-	m_processList.clear();
+	// new draw list for this frame, allocated into the frame arena
+	const size_t numSets = m_processList.size();
+
+	m_processList = T_DrawSetList(FrameAllocator<DrawSet>(&getScene()->getFrameManager()->getFrameArena()));
+	m_processList.reserve(o3d::max<size_t>(numSets, 64));
 
 	if (m_numFaces == 0)
 		return;
@@ -237,7 +239,7 @@ void AlphaPipeline::sort()
 // Process the draw list
 void AlphaPipeline::draw(const DrawInfo &drawInfo)
 {
-	for (std::list<DrawSet>::iterator it = m_processList.begin(); it != m_processList.end(); ++it)
+	for (T_DrawSetList::iterator it = m_processList.begin(); it != m_processList.end(); ++it)
 	{
 		DrawSet &drawSet = *it;
 
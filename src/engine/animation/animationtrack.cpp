@@ -13,6 +13,7 @@
 #include "o3d/engine/scene/sceneobject.h"
 
 #include "o3d/core/debug.h"
+#include "o3d/core/batchquaternion.h"
 
 #include "o3d/engine/matrix.h"
 #include "o3d/engine/context.h"
@@ -357,6 +358,57 @@ Bool AnimationTrack::readFromFile(InStream &is)
 	return True;
 }
 
+// Set the data of a keyframe from its serialized floats
+static inline void setKeyFrameData(Float &data, const Float *values)
+{
+    data = values[0];
+}
+
+static inline void setKeyFrameData(Vector3 &data, const Float *values)
+{
+    data.set(values);
+}
+
+static inline void setKeyFrameData(Quaternion &data, const Float *values)
+{
+    memcpy(data.getData(), values, 4*sizeof(Float));
+}
+
+// Read the keyframes of a track whose data are made of N floats, each keyframe being
+// serialized as its time followed by its data. All the keyframes are read at once.
+template <class K, UInt32 N>
+static void readKeyFrames(InStream &is, T_KeyFrameList &keyFrameList)
+{
+    UInt32 nKeys;
+    is >> nKeys;
+
+    if (nKeys == 0) {
+        return;
+    }
+
+    // the count is checked against the stream before any allocation, a corrupted
+    // file must neither overflow it nor lead to a huge scratch buffer
+    const UInt64 numValues = UInt64(nKeys) * (N+1);
+    if ((numValues > UInt64(o3d::Limits<Int32>::max()) / sizeof(Float)) ||
+        (Int64(numValues * sizeof(Float)) > is.getAvailable())) {
+        O3D_ERROR(E_InvalidFormat("Truncated animation track keyframes"));
+    }
+
+    std::vector<Float> scratch;
+    const Float *values = is.readArray<Float>((UInt32)numValues, scratch);
+
+    if (!values) {
+        O3D_ERROR(E_InvalidFormat("Truncated animation track keyframes"));
+    }
+
+    for (UInt32 i = 0; i < nKeys; ++i, values += N+1) {
+        K *keyFrame = new K(values[0]);
+        setKeyFrameData(keyFrame->Data, values + 1);
+
+        keyFrameList.push_back(keyFrame);
+    }
+}
+
 /*---------------------------------------------------------------------------------------
   class AnimationTrack_LinearFloat
 ---------------------------------------------------------------------------------------*/
@@ -394,16 +446,8 @@ Bool AnimationTrack_LinearFloat::readFromFile(InStream &is)
 {
     AnimationTrack::readFromFile(is);
 
-	UInt32 nKeys;
-    is >> nKeys;
+    readKeyFrames<KeyFrameLinear<Float>, 1>(is, m_keyFrameList);
 
-	// read all keys
-	for (UInt32 i = 0 ; i < nKeys ; ++i)
-	{
-		KeyFrameLinear<Float>* pKeyFrame = new KeyFrameLinear<Float>(0,0);
-        is >> *pKeyFrame;
-		m_keyFrameList.push_back(pKeyFrame);
-	}
 	return True;
 }
 
@@ -487,16 +531,8 @@ Bool AnimationTrack_LinearVector::readFromFile(InStream &is)
 {
     AnimationTrack::readFromFile(is);
 
-	UInt32 nKeys;
-    is >> nKeys;
+    readKeyFrames<KeyFrameLinear<Vector3>, 3>(is, m_keyFrameList);
 
-	// read all keys
-	for (UInt32 i = 0 ; i < nKeys ; ++i)
-	{
-		KeyFrameLinear<Vector3>* pKeyFrame = new KeyFrameLinear<Vector3>(0,Vector3());
-        is >> *pKeyFrame;
-		m_keyFrameList.push_back(pKeyFrame);
-	}
 	return True;
 }
 
@@ -525,8 +561,14 @@ const void* AnimationTrack_LinearQuaternion::compute(
 	if (fabs(tBefore - tAfter) > o3d::Limits<Float>::epsilon())
 		coef = (time - tBefore) / (tAfter - tBefore);
 
-	// compute the animation value with coef (m_Data is normalized)
-	pKeyBefore->Data.lerp(pKeyAfter->Data, coef, m_Data);
+	// compute the animation value with coef (m_Data is normalized), by the shortest path
+	BatchQuaternion::interpolate(
+			pKeyBefore->Data.getData(),
+			pKeyAfter->Data.getData(),
+			&coef,
+			m_Data.getData(),
+			1,
+			BatchQuaternion::NLERP);
 	m_Time = time;
 
 	// finally return the data
@@ -537,16 +579,8 @@ Bool AnimationTrack_LinearQuaternion::readFromFile(InStream &is)
 {
     AnimationTrack::readFromFile(is);
 
-	UInt32 nKeys;
-    is >> nKeys;
+    readKeyFrames<KeyFrameLinear<Quaternion>, 4>(is, m_keyFrameList);
 
-	// read all keys
-	for (UInt32 i = 0 ; i < nKeys ; ++i)
-	{
-		KeyFrameLinear<Quaternion>* pKeyFrame = new KeyFrameLinear<Quaternion>(0,Quaternion());
-        is >> *pKeyFrame;
-		m_keyFrameList.push_back(pKeyFrame);
-	}
 	return True;
 }
 
@@ -575,8 +609,14 @@ const void* AnimationTrack_SmoothQuaternion::compute(
 	if (fabs(tBefore - tAfter) > o3d::Limits<Float>::epsilon())
 		coef = (time - tBefore) / (tAfter - tBefore);
 
-	// compute the animation value with coef to sphere unit
-	pKeyBefore->Data.slerp(pKeyAfter->Data, coef, m_Data);
+	// compute the animation value with coef to sphere unit, by the shortest path
+	BatchQuaternion::interpolate(
+			pKeyBefore->Data.getData(),
+			pKeyAfter->Data.getData(),
+			&coef,
+			m_Data.getData(),
+			1,
+			BatchQuaternion::SLERP);
 	m_Time = time;
 
 	// finally return the data
@@ -587,16 +627,8 @@ Bool AnimationTrack_SmoothQuaternion::readFromFile(InStream &is)
 {
     AnimationTrack::readFromFile(is);
 
-	UInt32 nKeys;
-    is >> nKeys;
+    readKeyFrames<KeyFrameSmooth<Quaternion>, 4>(is, m_keyFrameList);
 
-	// read all keys
-	for (UInt32 i = 0 ; i < nKeys ; ++i)
-	{
-		KeyFrameSmooth<Quaternion>* pKeyFrame = new KeyFrameSmooth<Quaternion>(0,Quaternion());
-        is >> *pKeyFrame;
-		m_keyFrameList.push_back(pKeyFrame);
-	}
 	return True;
 }
 
@@ -1154,16 +1186,7 @@ Bool AnimationTrack_ConstantFloat::readFromFile(InStream &is)
 {
     AnimationTrack::readFromFile(is);
 
-	UInt32 nKeys;
-    is >> nKeys;
-
-	// read all keys
-	for (UInt32 i = 0 ; i < nKeys ; ++i)
-	{
-		KeyFrameConstant<Float>* pKeyFrame = new KeyFrameConstant<Float>(0,0);
-        is >> *pKeyFrame;
-		m_keyFrameList.push_back(pKeyFrame);
-	}
+    readKeyFrames<KeyFrameConstant<Float>, 1>(is, m_keyFrameList);
 
 	return True;
 }
@@ -1196,16 +1219,7 @@ Bool AnimationTrack_ConstantVector::readFromFile(InStream &is)
 {
     AnimationTrack::readFromFile(is);
 
-	UInt32 nKeys;
-    is >> nKeys;
-
-	// read all keys
-	for (UInt32 i = 0 ; i < nKeys ; ++i)
-	{
-		KeyFrameConstant<Vector3>* pKeyFrame = new KeyFrameConstant<Vector3>(0,Vector3());
-        is >> *pKeyFrame;
-		m_keyFrameList.push_back(pKeyFrame);
-	}
+    readKeyFrames<KeyFrameConstant<Vector3>, 3>(is, m_keyFrameList);
 
 	return True;
 }
@@ -1238,16 +1252,7 @@ Bool AnimationTrack_ConstantQuaternion::readFromFile(InStream &is)
 {
     AnimationTrack::readFromFile(is);
 
-	UInt32 nKeys;
-    is >> nKeys;
-
-	// read all keys
-	for (UInt32 i = 0 ; i < nKeys ; ++i)
-	{
-		KeyFrameConstant<Quaternion>* pKeyFrame = new KeyFrameConstant<Quaternion>(0,Quaternion());
-        is >> *pKeyFrame;
-		m_keyFrameList.push_back(pKeyFrame);
-	}
+    readKeyFrames<KeyFrameConstant<Quaternion>, 4>(is, m_keyFrameList);
 
 	return True;
 }
@@ -591,8 +591,8 @@ void DeferredDrawer::draw(ViewPort */*viewPort*/)
 
     context.blending().setFunc(Blending::ONE__ONE);
 
-    const TemplateArray<Light*> lights = getScene()->getVisibilityManager()->getEffectiveLights();
-    for (Int32 i = 0; i < lights.getSize(); ++i) {
+    const VisibilityManager::T_LightList &lights = getScene()->getVisibilityManager()->getEffectiveLights();
+    for (size_t i = 0; i < lights.size(); ++i) {
         processLight(lights[i]);
     }
 
@@ -13,6 +13,8 @@
 #include "o3d/engine/scene/scene.h"
 #include "o3d/engine//scene/sceneobjectmanager.h"
 #include "o3d/core/classfactory.h"
+#include "o3d/core/datainstream.h"
+#include "o3d/core/dataoutstream.h"
 #include "o3d/engine/matrix.h"
 #include "o3d/engine/context.h"
 #include "o3d/engine/primitive/primitivemanager.h"
@@ -210,34 +212,119 @@ Bool HierarchyTree::readFromFile(InStream &is)
 	m_lastImportedObjects.clear();
 
 	// import each son recursivly
-	for (UInt32 i = 0; i < num; ++i)
-	{
-		// import class name
-		String className;
-        is >> className;
+    for (UInt32 i = 0; i < num; ++i) {
+        importObject(is);
+    }
+
+	return True;
+}
+
+Bool HierarchyTree::writeSnapshot(OutStream &os)
+{
+    os << ENGINE_HIERARCHY_TREE;
 
-		// clone a class instance
-        BaseObject* object = ClassFactory::getInstanceOfClassInfo(className)->createInstance(this);
+    // serialize the objects in memory to know the size of the block
+    ArrayUInt8 payloads;
+    DataOutStream payloadStream(payloads);
 
-		if (typeOf<SceneObject>(object))
-		{
-			m_root->addSonLast(dynamicCast<SceneObject*>(object));
+    UInt32 num = 0;
 
-			// and read the object
-            is >> *object;
+    const T_SonList &sonList = m_root->getSonList();
+    for (CIT_SonList cit = sonList.begin(); cit != sonList.end(); ++cit) {
+        SceneObject *object = (*cit);
 
-			// set imported object
-			getScene()->getSceneObjectManager()->setImportedSceneObject(
-					object->getSerializeId(),
-					reinterpret_cast<SceneObject*>(object));
+        if (getScene()->getCurSceneIO().isIO(*object)) {
+            if (!ClassFactory::writeToFile(payloadStream, *object)) {
+                return False;
+            }
 
-			m_lastImportedObjects.push_back(reinterpret_cast<SceneObject*>(object));
-		}
-		else
-            O3D_ERROR(E_InvalidFormat("Invalid object type, must be a scene object"));
-	}
+            ++num;
+        }
+    }
 
-	return True;
+    os << num;
+    os << (UInt32)payloads.getSize();
+    os.writeArray(payloads.getData(), (UInt32)payloads.getSize());
+
+    return True;
+}
+
+// The payloads refer to the data of the source stream or to a scratch array
+static void releasePayloads(void *)
+{
+}
+
+Bool HierarchyTree::readSnapshot(InStream &is)
+{
+    UInt32 tmp;
+    is >> tmp;
+
+    if (tmp != ENGINE_HIERARCHY_TREE) {
+        O3D_ERROR(E_InvalidFormat("Invalid hierarchy tree token"));
+    }
+
+    UInt32 num = 0;
+    is >> num;
+
+    UInt32 payloadsSize = 0;
+    is >> payloadsSize;
+
+    // every payload at once, without copy from a memory stream
+    std::vector<UInt8> payloadsScratch;
+    const UInt8 *payloads = is.readArray<UInt8>(payloadsSize, payloadsScratch);
+
+    if ((num > 0) && !payloads) {
+        O3D_ERROR(E_InvalidFormat("Truncated scene snapshot"));
+    }
+
+    m_numObject += num;
+    m_lastImportedObjects.clear();
+
+    if (num == 0) {
+        return True;
+    }
+
+    SharedDataInStream payloadStream(SmartArrayUInt8(
+                                         const_cast<UInt8*>(payloads),
+                                         (Int32)payloadsSize,
+                                         releasePayloads,
+                                         nullptr));
+
+    for (UInt32 i = 0; i < num; ++i) {
+        importObject(payloadStream);
+    }
+
+    if ((UInt32)payloadStream.getPosition() != payloadsSize) {
+        O3D_ERROR(E_InvalidFormat("Invalid scene snapshot objects size"));
+    }
+
+    return True;
+}
+
+void HierarchyTree::importObject(InStream &is)
+{
+    // import class name
+    String className;
+    is >> className;
+
+    // clone a class instance
+    BaseObject* object = ClassFactory::getInstanceOfClassInfo(className)->createInstance(this);
+
+    if (typeOf<SceneObject>(object)) {
+        m_root->addSonLast(dynamicCast<SceneObject*>(object));
+
+        // and read the object
+        is >> *object;
+
+        // set imported object
+        getScene()->getSceneObjectManager()->setImportedSceneObject(
+                object->getSerializeId(),
+                reinterpret_cast<SceneObject*>(object));
+
+        m_lastImportedObjects.push_back(reinterpret_cast<SceneObject*>(object));
+    } else {
+        O3D_ERROR(E_InvalidFormat("Invalid object type, must be a scene object"));
+    }
 }
 
 void HierarchyTree::preExportPass()
@@ -746,15 +746,20 @@ const Vector2ui PCLODTopZone::getZoneExtension() const
 	return Vector2ui((m_size[X]-1)/(baseSize[X] - 1), (m_size[Y]-1)/(baseSize[Y]-1));
 }
 
-/* Load the datas of the zone (must be initialized first) */
-void PCLODTopZone::load()
+/* Return the full path of the data file */
+String PCLODTopZone::getDataFullPathName() const
 {
-	O3D_ASSERT(init());
-	O3D_ASSERT(!dataLoaded());
-
 	String fullPath;
 	fullPath << m_pZoneManager->getDataFilePath() << String("/") << m_dataFileName;
 
+	return fullPath;
+}
+
+/* Load the datas of the zone (must be initialized first) */
+void PCLODTopZone::load()
+{
+	String fullPath = getDataFullPathName();
+
     AutoPtr<InStream> pdataIs(FileManager::instance()->openInStream(fullPath));
 
     if (pdataIs.get() == nullptr)
@@ -763,7 +768,14 @@ void PCLODTopZone::load()
 		return;
 	}
 
-    InStream &dataIs = *pdataIs;
+	load(*pdataIs);
+}
+
+/* Load the datas of the zone from the content of its data file */
+void PCLODTopZone::load(InStream & dataIs)
+{
+	O3D_ASSERT(init());
+	O3D_ASSERT(!dataLoaded());
 
 	/* Heightmap */
     Float * _buffer = nullptr;
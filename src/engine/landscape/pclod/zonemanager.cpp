@@ -25,6 +25,7 @@
 
 #include "o3d/core/objects.h"
 #include "o3d/core/filemanager.h"
+#include "o3d/core/datainstream.h"
 
 //#include <memory>
 
@@ -135,35 +136,21 @@ void PCLODZoneManager::rtRemoveZone(UInt32 _zoneId)
 	PCLOD_MESSAGE(String("ZoneManager : Zone ") << pZone->getId() << " : Remove from the zoneTable");
 }
 
-/* Load a zone from its id.
- * - Do nothing if the zone is already loaded */
-void PCLODZoneManager::rtLoadZone(UInt32 _zoneId, PCLODZoneManage & _zoneManage)
+/* Create a zone from its header.
+ * - Do nothing if the zone is already created */
+PCLODTopZone * PCLODZoneManager::rtCreateZone(PCLODZoneInfo & _zoneInfo)
 {
-	// On regarde si la zone est deja chargée
-	IT_ZoneHeaderMap itZone = m_zoneTableMap.find(_zoneId);
-	O3D_ASSERT(itZone != m_zoneTableMap.end());
-
-	PCLODZoneInfo & zoneInfo = itZone->second;
-	SPCLODTopZone & zonePtr = zoneInfo.pZone;
-
-    O3D_ASSERT(zonePtr.get() == nullptr);
-
-	// Dans le cas ou la zone est deja chargée, on fait rien.
-/*	if (zonePtr && zonePtr->dataLoaded())
-	{
-		_zoneManage.setZone(zonePtr);
-		return;
-	}*/
+	SPCLODTopZone & zonePtr = _zoneInfo.pZone;
 
-	// Si la zone n'est pas créée, ce qui est probable, on créé l'objet et on charge
-	// a partir du disque dur
+	// Si la zone n'est pas créée, ce qui est probable, on créé l'objet a partir de
+	// son entete
 	if (!zonePtr)
 	{
         AutoPtr<InStream> pAutoIs(FileManager::instance()->openInStream(m_headerFilePath));
         InStream * pIs = pAutoIs.get();
         O3D_ASSERT(pIs != nullptr);
 
-        pIs->reset(zoneInfo.zoneFilePosition);
+        pIs->reset(_zoneInfo.zoneFilePosition);
         zonePtr = new PCLODTopZone(*pIs, this);
 
         zonePtr->onZoneHidden.connect(this, &PCLODZoneManager::rteOnZoneHide, getRefreshThread());
@@ -176,9 +163,56 @@ void PCLODZoneManager::rtLoadZone(UInt32 _zoneId, PCLODZoneManage & _zoneManage)
         zonePtr->onRendererUpdated.connect(this, &PCLODZoneManager::rteOnRendererUpdated, getMainThread());
 	}
 
+	return zonePtr.get();
+}
+
+/* Read the data of a zone asynchronously.
+ * - Do nothing if the data are already loaded or requested */
+void PCLODZoneManager::rtRequestZone(UInt32 _zoneId, Int32 _priority)
+{
+	IT_ZoneHeaderMap itZone = m_zoneTableMap.find(_zoneId);
+	O3D_ASSERT(itZone != m_zoneTableMap.end());
+
+	PCLODZoneInfo & zoneInfo = itZone->second;
+	PCLODTopZone * pZone = rtCreateZone(zoneInfo);
+
+	if (!pZone->dataLoaded() && !zoneInfo.dataRequest)
+	{
+		zoneInfo.dataRequest = FileManager::instance()->readAsync(
+			pZone->getDataFullPathName(), 0, 0, _priority);
+	}
+}
+
+/* Load a zone from its id.
+ * - Do nothing if the zone is already loaded
+ * - The data are taken from the asynchronous read if the zone was requested */
+void PCLODZoneManager::rtLoadZone(UInt32 _zoneId, PCLODZoneManage & _zoneManage)
+{
+	// On regarde si la zone est deja chargée
+	IT_ZoneHeaderMap itZone = m_zoneTableMap.find(_zoneId);
+	O3D_ASSERT(itZone != m_zoneTableMap.end());
+
+	PCLODZoneInfo & zoneInfo = itZone->second;
+	SPCLODTopZone & zonePtr = zoneInfo.pZone;
+
+	// La zone peut deja etre créée par rtRequestZone
+	rtCreateZone(zoneInfo);
+
 	// Si les données n'ont pas été chargée...
 	if (!zonePtr->dataLoaded())
-		zonePtr->load();
+	{
+		SmartPtr<FileReadRequest> request = zoneInfo.dataRequest;
+		zoneInfo.dataRequest = nullptr;
+
+		// from the asynchronous read, otherwise directly from the file
+		if (request && request->wait())
+		{
+			SharedDataInStream dataIs(request->getData());
+			zonePtr->load(dataIs);
+		}
+		else
+			zonePtr->load();
+	}
 
 	_zoneManage.setZone(zonePtr);
 }
@@ -210,24 +244,35 @@ void PCLODZoneManager::rtMoveCamera(const Vector2i & _direction)
 
 	// We must only defined some
 	// For the moment, a fast and easy way is implement, but it can be improved
-    for (Int32 j = 0 ; j < m_visibleZoneArray.height() ; ++j)
-        for (Int32 i = 0 ; i < m_visibleZoneArray.width() ; ++i)
+	std::vector<std::pair<UInt32, PCLODZoneManage*> > toLoad;
+
+	for (Int32 j = 0 ; j < m_visibleZoneArray.height() ; ++j)
+	{
+		for (Int32 i = 0 ; i < m_visibleZoneArray.width() ; ++i)
 		{
 			PCLODZoneManage & pZoneManage = m_visibleZoneArray(i,j);
 			Vector2i position(originArray[X] + i, originArray[Y] + j);
 
 			if (!pZoneManage.isValid() &&
-                (position[X] >= 0) && (position[X] < m_zoneTableArray.width()) &&
-                (position[Y] >= 0) && (position[Y] < m_zoneTableArray.height()))
+				(position[X] >= 0) && (position[X] < m_zoneTableArray.width()) &&
+				(position[Y] >= 0) && (position[Y] < m_zoneTableArray.height()))
 			{
 				UInt32 zoneId = m_zoneTableArray(position[X], position[Y]);
 
 				if (zoneId != 0) // If zoneId = 0, it means there is no zone in this area
 				{
-					rtLoadZone(zoneId, pZoneManage);
+					// The nearest zones of the camera are read first
+					rtRequestZone(zoneId, -(o3d::abs(i - halfSize[X]) + o3d::abs(j - halfSize[Y])));
+					toLoad.push_back(std::make_pair(zoneId, &pZoneManage));
 				}
 			}
 		}
+	}
+
+	// The zone files, one per zone, are read in parallel by the read queue, and every
+	// requested zone is loaded before returning, so no read is left pending
+	for (size_t k = 0 ; k < toLoad.size() ; ++k)
+		rtLoadZone(toLoad[k].first, *toLoad[k].second);
 }
 
 void PCLODZoneManager::rtBuildgetRenderer(PCLODZone & _zone)
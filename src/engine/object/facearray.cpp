@@ -405,7 +405,7 @@ Bool FaceArrayUInt16::writeToFile(OutStream &os)
 		UInt32 count = m_vbo.getCount();
 
         os << count;
-        os.write(data, count);
+        os.writeArray(data, count);
 
 		m_vbo.unlock();
     } else {
@@ -756,7 +756,7 @@ Bool FaceArrayUInt32::writeToFile(OutStream &os)
 		UInt32 count = m_vbo.getCount();
 
         os << count;
-        os.write(data, count);
+        os.writeArray(data, count);
 
 		m_vbo.unlock();
     } else {
@@ -19,8 +19,14 @@
 #include "o3d/engine/scene/scene.h"
 #include "o3d/core/math.h"
 #include "o3d/core/vector2.h"
+#include "o3d/core/batchmath.h"
 #include "o3d/geom/boundinggen.h"
 #include "o3d/core/file.h"
+#include "o3d/core/filemanager.h"
+#include "o3d/core/datainstream.h"
+#include "o3d/core/dataoutstream.h"
+
+#include <algorithm>
 
 using namespace o3d;
 
@@ -635,8 +641,6 @@ void GeometryData::computeBounding(BoundingMode mode)
     if (mode == BOUNDING_FAST) {
 		// build the bounding box by using the minimum and maximum of the
 		// vertices present in the vertex array.
-		Vector3 curVertex;
-
 		Vector3 minCoords(
 				Limits<Float>::max(),
 				Limits<Float>::max(),
@@ -647,14 +651,7 @@ void GeometryData::computeBounding(BoundingMode mode)
 				Limits<Float>::min(),
 				Limits<Float>::min());
 
-		UInt32 numIndices = numVertices * 3;
-
-        for (UInt32 vert = 0; vert < numIndices; vert += 3) {
-			curVertex.set(vertices + vert);
-
-			minCoords.minOf(minCoords, curVertex);
-			maxCoords.maxOf(maxCoords, curVertex);
-		}
+		BatchMath::bounds(ConstBatchVectors::aos(vertices), numVertices, minCoords, maxCoords);
 
 		// get the bounding box
 		m_AABBoxExt.setMinMax(minCoords, maxCoords);
@@ -667,29 +664,22 @@ void GeometryData::computeBounding(BoundingMode mode)
     } else {
         // precise bounding box computation
 		BoundingGen bounding;
-		UInt32 numIndices = numVertices * 3;
+		const ConstBatchVectors batch = ConstBatchVectors::aos(vertices);
 
 		// first pass bounding volume computation
-		for (UInt32 vert = 0 ; vert < numIndices ; vert += 3)
-			bounding.firstPass(vertices[vert], vertices[vert+1], vertices[vert+2]);
-
+		bounding.firstPass(batch, numVertices);
 		bounding.flushFirstPass(numVertices);
 
 		// second pass bounding volume computation
-		for (UInt32 vert = 0 ; vert < numIndices ; vert += 3)
-			bounding.secondPass(vertices[vert], vertices[vert+1], vertices[vert+2]);
-
+		bounding.secondPass(batch, numVertices);
 		bounding.flushSecondPass(numVertices);
 
 		// third pass bounding volume computation
-		for (UInt32 vert = 0 ; vert < numIndices ; vert += 3)
-			bounding.thirdPass(vertices[vert], vertices[vert+1], vertices[vert+2]);
-
+		bounding.thirdPass(batch, numVertices);
 		bounding.flushThirdPass();
 
 		// fourth pass bounding volume computation
-		for (UInt32 vert = 0 ; vert < numIndices ; vert += 3)
-			bounding.fourthPass(vertices[vert], vertices[vert+1], vertices[vert+2]);
+		bounding.fourthPass(batch, numVertices);
 
 		// get the bounding sphere
 		bounding.getBoundingSphere(m_BSphere);
@@ -869,6 +859,9 @@ Bool GeometryData::readFromFile(InStream &is)
     is >> boolean;
 	m_flags.setBit(INTERLEAVE_ELEMENTS, boolean);
 
+    // the arrays refer directly to the data of a memory mapped file
+    InStreamBorrowing borrowing(is);
+
 	// read elements
 	UInt32 numElements;
     is >> numElements;
@@ -1232,6 +1225,90 @@ static void computeTangentVector(
 	tTangent.normalize();
 }
 
+// Hash the format and the indices of some face arrays into a converted resources key
+static void hashFaceArrays(AssetCache::Key &key, const std::vector<FaceArray*> &faceArrays)
+{
+	for (FaceArray *faceArray : faceArrays) {
+		key.addValue((UInt32)faceArray->getFormat())
+		   .addValue(faceArray->getTypeSize())
+		   .addValue(faceArray->getNumElements());
+
+		const UInt8 *indices = faceArray->lockArray(0, 0, BufferObject::MAP_READ);
+		if (indices) {
+			key.addData(indices, faceArray->getNumElements()*faceArray->getTypeSize());
+			faceArray->unlockArray();
+		}
+	}
+}
+
+template<class T>
+static void writeCollapseMap(OutStream &os, TemplateArray<T> &map, TemplateArray<T> &permutation)
+{
+	os << (UInt32)map.getSize() << (UInt32)permutation.getSize();
+
+	os.writeArray(map.getData(), map.getSize());
+	os.writeArray(permutation.getData(), permutation.getSize());
+}
+
+template<class T>
+static Bool readCollapseMap(InStream &is, TemplateArray<T> &map, TemplateArray<T> &permutation)
+{
+	UInt32 mapSize, permutationSize;
+	is >> mapSize >> permutationSize;
+
+	if (((UInt64)mapSize + permutationSize) * sizeof(T) > (UInt64)is.getAvailable()) {
+		return False;
+	}
+
+	map.setSize(mapSize);
+	permutation.setSize(permutationSize);
+
+	return (is.readArray(map.getData(), mapSize) == mapSize) &&
+		   (is.readArray(permutation.getData(), permutationSize) == permutationSize);
+}
+
+// Write the collapse maps of some triangles face arrays
+static void writeCollapseMaps(OutStream &os, const std::vector<FaceArray*> &faceArrays)
+{
+	for (FaceArray *faceArray : faceArrays) {
+		if (faceArray->getTypeSize() == sizeof(UInt32)) {
+			FaceArrayUInt32 *faceArray32 = reinterpret_cast<FaceArrayUInt32*>(faceArray);
+			writeCollapseMap(os, faceArray32->getCollapseMap(), faceArray32->getPermutation());
+		} else if (faceArray->getTypeSize() == sizeof(UInt16)) {
+			FaceArrayUInt16 *faceArray16 = reinterpret_cast<FaceArrayUInt16*>(faceArray);
+			writeCollapseMap(os, faceArray16->getCollapseMap(), faceArray16->getPermutation());
+		}
+	}
+}
+
+// Read the collapse maps of some triangles face arrays, written by writeCollapseMaps
+static Bool readCollapseMaps(const SmartArrayUInt8 &data, const std::vector<FaceArray*> &faceArrays)
+{
+	SharedDataInStream is(data);
+
+	try {
+		for (FaceArray *faceArray : faceArrays) {
+			Bool valid = True;
+
+			if (faceArray->getTypeSize() == sizeof(UInt32)) {
+				FaceArrayUInt32 *faceArray32 = reinterpret_cast<FaceArrayUInt32*>(faceArray);
+				valid = readCollapseMap(is, faceArray32->getCollapseMap(), faceArray32->getPermutation());
+			} else if (faceArray->getTypeSize() == sizeof(UInt16)) {
+				FaceArrayUInt16 *faceArray16 = reinterpret_cast<FaceArrayUInt16*>(faceArray);
+				valid = readCollapseMap(is, faceArray16->getCollapseMap(), faceArray16->getPermutation());
+			}
+
+			if (!valid) {
+				return False;
+			}
+		}
+	} catch (E_BaseException &) {
+		return False;
+	}
+
+	return is.getAvailable() == 0;
+}
+
 // Compute tangents and bi-tangents
 void GeometryData::computeTangentSpace()
 {
@@ -1365,20 +1442,33 @@ void GeometryData::computeProgressive()
 
 	UInt32 numVertices = getNumVertices();
 
-	// for each face array
-    for (IT_FaceArrays it = m_faceArrays.begin(); it != m_faceArrays.end(); ++it) {
-		FaceArray *faceArray = it->second;
+	// Process progressive mesh only on TRIANGLES mesh
+	std::vector<FaceArray*> faceArrays;
+	getSortedTriangleArrays(faceArrays);
 
-		// No faces to process...
-        if (faceArray->getNumElements() == 0) {
-			continue;
-        }
+	// converted resources cache, keyed by the vertices and faces
+	SmartPtr<AssetCache> cache = FileManager::instance()->getAssetCache();
+	String cacheKey;
 
-		// Process progressive mesh only on TRIANGLES mesh
-        if (faceArray->getFormat() != P_TRIANGLES) {
-			continue;
-        }
+	if (cache.isValid()) {
+		AssetCache::Key key("GeometryData::computeProgressive", 1);
+		key.addValue(numVertices)
+		   .addData(vertices, numVertices*m_elements[V_VERTICES_ARRAY]->getElementSize()*sizeof(Float));
+
+		hashFaceArrays(key, faceArrays);
+		cacheKey = key.getHex();
 
+		SmartArrayUInt8 data;
+		if (cache->fetch(cacheKey, data) && readCollapseMaps(data, faceArrays)) {
+			m_elements[V_VERTICES_ARRAY]->unlockArray();
+
+			m_flags.setBit(UPDATE_PROGRESSIVE_MESH, False);
+			return;
+		}
+	}
+
+	// for each face array
+	for (FaceArray *faceArray : faceArrays) {
 		ProgressiveMesh progMesh;
 
         UInt8 *triangles = faceArray->lockArray(0, 0, VertexBuffer::MAP_READ);
@@ -1417,7 +1507,42 @@ void GeometryData::computeProgressive()
 
 	m_elements[V_VERTICES_ARRAY]->unlockArray();
 
+	if (cache.isValid()) {
+		ArrayUInt8 data;
+		DataOutStream os(data);
+
+		writeCollapseMaps(os, faceArrays);
+		cache->store(cacheKey, data);
+	}
+
 	m_flags.setBit(UPDATE_PROGRESSIVE_MESH, False);
 	//m_flags.setBit(UPDATE_VERTEX_BUFFER, True);
 	//m_flags.setBit(UPDATE_INDEX_BUFFER, True);
 }
+
+void GeometryData::getSortedTriangleArrays(std::vector<FaceArray*> &faceArrays) const
+{
+	std::vector<UInt32> ids;
+	ids.reserve(m_faceArrays.size());
+
+	for (CIT_FaceArrays cit = m_faceArrays.begin(); cit != m_faceArrays.end(); ++cit) {
+		if (cit->second->getNumElements() == 0) {
+			continue;
+		}
+
+		if (cit->second->getFormat() != P_TRIANGLES) {
+			continue;
+		}
+
+		ids.push_back(cit->first);
+	}
+
+	std::sort(ids.begin(), ids.end());
+
+	faceArrays.clear();
+	faceArrays.reserve(ids.size());
+
+	for (UInt32 id : ids) {
+		faceArrays.push_back(m_faceArrays.find(id)->second);
+	}
+}
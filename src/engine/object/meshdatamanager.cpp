@@ -12,6 +12,7 @@
 
 #include "o3d/core/debug.h"
 #include "o3d/core/filemanager.h"
+#include "o3d/core/jobgraph.h"
 #include "o3d/core/virtualfilelisting.h"
 #include "o3d/engine/glextensionmanager.h"
 #include "o3d/engine/scene/scene.h"
@@ -263,6 +264,90 @@ MeshData* MeshDataManager::readMeshData(InStream &is)
 	return meshData;
 }
 
+void MeshDataManager::writeMeshDataList(OutStream &os, const std::vector<MeshData*> &list)
+{
+    os << (UInt32)list.size();
+
+    for (MeshData *meshData : list) {
+        os << *meshData;
+    }
+}
+
+UInt32 MeshDataManager::readMeshDataList(InStream &is)
+{
+    UInt32 num;
+    is >> num;
+
+    std::vector<MeshData*> loading;
+    loading.reserve(num);
+
+    for (UInt32 i = 0; i < num; ++i) {
+        MeshData *meshData = new MeshData(this);
+        is >> *meshData;
+
+        // already existing or listed twice
+        Bool found = findMeshData(0, meshData->getResourceName()) != nullptr;
+        for (size_t j = 0; !found && j < loading.size(); ++j) {
+            found = loading[j]->getResourceName() == meshData->getResourceName();
+        }
+
+        if (found) {
+            deletePtr(meshData);
+            continue;
+        }
+
+        meshData->setFileName(getFullFileName(meshData->getResourceName()));
+        loading.push_back(meshData);
+    }
+
+    // decode the geometries in parallel, as MeshDataTask::execute does
+    std::vector<GeometryData*> geometries(loading.size(), nullptr);
+
+    JobGraph::parallelFor(0, (UInt32)loading.size(), 1, [&] (UInt32 first, UInt32 last) {
+        for (UInt32 i = first; i < last; ++i) {
+            InStream *stream = nullptr;
+            GeometryData *geometry = new GeometryData(loading[i]);
+
+            try {
+                stream = FileManager::instance()->openInStream(loading[i]->getFileName());
+                if (stream && geometry->readFromFile(*stream)) {
+                    geometries[i] = geometry;
+                    geometry = nullptr;
+                }
+            } catch (E_BaseException &) {
+            }
+
+            deletePtr(stream);
+            deletePtr(geometry);
+        }
+    });
+
+    for (size_t i = 0; i < loading.size(); ++i) {
+        if (!geometries[i]) {
+            String filename = loading[i]->getFileName();
+
+            for (size_t j = 0; j < loading.size(); ++j) {
+                deletePtr(geometries[j]);
+                deletePtr(loading[j]);
+            }
+
+            O3D_ERROR(E_InvalidFormat("Invalid mesh data file \"" + filename + "\""));
+        }
+    }
+
+    // create the geometries and add the mesh data in order
+    for (size_t i = 0; i < loading.size(); ++i) {
+        O3D_MESSAGE("Import mesh data file \"" + loading[i]->getResourceName() + "\"");
+
+        loading[i]->setGeometry(geometries[i]);
+        loading[i]->createGeometry();
+
+        addMeshData(loading[i]);
+    }
+
+    return (UInt32)loading.size();
+}
+
 // count the total number of vertices of the manager
 UInt32 MeshDataManager::countTotalNumVerts()
 {
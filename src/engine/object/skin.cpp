@@ -22,6 +22,12 @@
 #include "o3d/engine/object/cloth.h"
 #include "o3d/engine/object/camera.h"
 
+#include "o3d/core/cpudispatch.h"
+
+#ifdef O3D_SIMD_X86
+    #include <immintrin.h>
+#endif
+
 using namespace o3d;
 
 //
@@ -960,6 +966,332 @@ void Rigging::prepareDrawing()
     }
 }
 
+namespace {
+
+//! Vertices range of a CPU skinning, by up to 4 weighted bones per vertex.
+struct SkinningRange
+{
+    const Float *matrices;      //!< Column major 4x4 matrix of each bone.
+
+    const Float *srcVertices;
+    const Float *srcNormals;    //!< Null if no normals.
+    const Float *srcSkinning;   //!< Bones indices, -1 before the fourth for less bones.
+    const Float *srcWeighting;
+
+    Float *dstVertices;
+    Float *dstNormals;
+
+    UInt32 vertexSrcStride;
+    UInt32 normalSrcStride;
+    UInt32 skinningSrcStride;
+    UInt32 weightingSrcStride;
+    UInt32 vertexDstStride;
+    UInt32 normalDstStride;
+
+    UInt32 numVertices;
+};
+
+typedef void (*SkinningFunc)(const SkinningRange &range);
+
+//! Number of bones of a vertex, the weights of the null or negative ones are cleared.
+inline UInt32 vertexBones(const Float *skinning, const Float *weighting, Int32 *bones, Float *weights)
+{
+    UInt32 boneCount = 0;
+
+    while (boneCount < 4) {
+        if ((bones[boneCount] = (Int32)skinning[boneCount]) != -1) {
+            weights[boneCount] = weighting[boneCount] > 0.f ? weighting[boneCount] : 0.f;
+            ++boneCount;
+        } else {
+            break;
+        }
+    }
+
+    return boneCount;
+}
+
+void skinningScalar(const SkinningRange &r)
+{
+    const Float *srcVertices = r.srcVertices;
+    const Float *srcNormals = r.srcNormals;
+    const Float *srcSkinning = r.srcSkinning;
+    const Float *srcWeighting = r.srcWeighting;
+    Float *dstVertices = r.dstVertices;
+    Float *dstNormals = r.dstNormals;
+
+    Int32 bones[4];
+    Float weights[4];
+    Float m[16];
+
+    for (UInt32 v = 0; v < r.numVertices; ++v) {
+        const UInt32 boneCount = vertexBones(srcSkinning, srcWeighting, bones, weights);
+
+        // compute the new vertex and normals only if one or more bone affect it
+        if (boneCount != 0) {
+            memset(m, 0, sizeof(m));
+
+            for (UInt32 b = 0; b < boneCount; ++b) {
+                const Float *bone = r.matrices + (bones[b] << 4);
+                for (Int32 i = 0; i < 16; ++i) {
+                    m[i] += bone[i] * weights[b];
+                }
+            }
+
+            const Float x = srcVertices[0], y = srcVertices[1], z = srcVertices[2];
+            dstVertices[0] = m[0]*x + m[4]*y + m[8]*z + m[12];
+            dstVertices[1] = m[1]*x + m[5]*y + m[9]*z + m[13];
+            dstVertices[2] = m[2]*x + m[6]*y + m[10]*z + m[14];
+
+            if (srcNormals) {
+                const Float nx = srcNormals[0], ny = srcNormals[1], nz = srcNormals[2];
+                dstNormals[0] = m[0]*nx + m[4]*ny + m[8]*nz;
+                dstNormals[1] = m[1]*nx + m[5]*ny + m[9]*nz;
+                dstNormals[2] = m[2]*nx + m[6]*ny + m[10]*nz;
+            }
+        } else {
+            // otherwise simply copy
+            memcpy(dstVertices, srcVertices, 3*sizeof(Float));
+
+            if (srcNormals) {
+                memcpy(dstNormals, srcNormals, 3*sizeof(Float));
+            }
+        }
+
+        srcVertices += r.vertexSrcStride;
+        dstVertices += r.vertexDstStride;
+
+        if (srcNormals) {
+            srcNormals += r.normalSrcStride;
+            dstNormals += r.normalDstStride;
+        }
+
+        srcSkinning += r.skinningSrcStride;
+        srcWeighting += r.weightingSrcStride;
+    }
+}
+
+#ifdef O3D_SIMD_X86
+
+O3D_SIMD_TARGET_SSE2
+inline void storeVector3(Float *dst, __m128 v)
+{
+    _mm_storel_pi(reinterpret_cast<__m64*>(dst), v);
+    _mm_store_ss(dst + 2, _mm_movehl_ps(v, v));
+}
+
+//! A column per register.
+O3D_SIMD_TARGET_SSE2
+void skinningSSE2(const SkinningRange &r)
+{
+    const Float *srcVertices = r.srcVertices;
+    const Float *srcNormals = r.srcNormals;
+    const Float *srcSkinning = r.srcSkinning;
+    const Float *srcWeighting = r.srcWeighting;
+    Float *dstVertices = r.dstVertices;
+    Float *dstNormals = r.dstNormals;
+
+    Int32 bones[4];
+    Float weights[4];
+
+    for (UInt32 v = 0; v < r.numVertices; ++v) {
+        const UInt32 boneCount = vertexBones(srcSkinning, srcWeighting, bones, weights);
+
+        if (boneCount != 0) {
+            __m128 c0 = _mm_setzero_ps(), c1 = _mm_setzero_ps(), c2 = _mm_setzero_ps(), c3 = _mm_setzero_ps();
+
+            for (UInt32 b = 0; b < boneCount; ++b) {
+                const Float *bone = r.matrices + (bones[b] << 4);
+                const __m128 w = _mm_set1_ps(weights[b]);
+
+                c0 = _mm_add_ps(c0, _mm_mul_ps(_mm_loadu_ps(bone), w));
+                c1 = _mm_add_ps(c1, _mm_mul_ps(_mm_loadu_ps(bone + 4), w));
+                c2 = _mm_add_ps(c2, _mm_mul_ps(_mm_loadu_ps(bone + 8), w));
+                c3 = _mm_add_ps(c3, _mm_mul_ps(_mm_loadu_ps(bone + 12), w));
+            }
+
+            const __m128 pos = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(srcVertices[0])),
+                                   _mm_mul_ps(c1, _mm_set1_ps(srcVertices[1]))),
+                        _mm_add_ps(_mm_mul_ps(c2, _mm_set1_ps(srcVertices[2])), c3));
+
+            storeVector3(dstVertices, pos);
+
+            if (srcNormals) {
+                const __m128 normal = _mm_add_ps(
+                            _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(srcNormals[0])),
+                                       _mm_mul_ps(c1, _mm_set1_ps(srcNormals[1]))),
+                            _mm_mul_ps(c2, _mm_set1_ps(srcNormals[2])));
+
+                storeVector3(dstNormals, normal);
+            }
+        } else {
+            memcpy(dstVertices, srcVertices, 3*sizeof(Float));
+
+            if (srcNormals) {
+                memcpy(dstNormals, srcNormals, 3*sizeof(Float));
+            }
+        }
+
+        srcVertices += r.vertexSrcStride;
+        dstVertices += r.vertexDstStride;
+
+        if (srcNormals) {
+            srcNormals += r.normalSrcStride;
+            dstNormals += r.normalDstStride;
+        }
+
+        srcSkinning += r.skinningSrcStride;
+        srcWeighting += r.weightingSrcStride;
+    }
+}
+
+//! Two columns per register, FMA blending.
+O3D_SIMD_TARGET_AVX2
+void skinningAVX2(const SkinningRange &r)
+{
+    const Float *srcVertices = r.srcVertices;
+    const Float *srcNormals = r.srcNormals;
+    const Float *srcSkinning = r.srcSkinning;
+    const Float *srcWeighting = r.srcWeighting;
+    Float *dstVertices = r.dstVertices;
+    Float *dstNormals = r.dstNormals;
+
+    Int32 bones[4];
+    Float weights[4];
+
+    for (UInt32 v = 0; v < r.numVertices; ++v) {
+        const UInt32 boneCount = vertexBones(srcSkinning, srcWeighting, bones, weights);
+
+        if (boneCount != 0) {
+            __m256 c01 = _mm256_setzero_ps(), c23 = _mm256_setzero_ps();
+
+            for (UInt32 b = 0; b < boneCount; ++b) {
+                const Float *bone = r.matrices + (bones[b] << 4);
+                const __m256 w = _mm256_set1_ps(weights[b]);
+
+                c01 = _mm256_fmadd_ps(_mm256_loadu_ps(bone), w, c01);
+                c23 = _mm256_fmadd_ps(_mm256_loadu_ps(bone + 8), w, c23);
+            }
+
+            // (c0*x + c2*z, c1*y + c3), next sum of the halves
+            const Float x = srcVertices[0], y = srcVertices[1], z = srcVertices[2];
+            __m256 pos = _mm256_fmadd_ps(
+                        c23, _mm256_setr_ps(z, z, z, z, 1.f, 1.f, 1.f, 1.f),
+                        _mm256_mul_ps(c01, _mm256_setr_ps(x, x, x, x, y, y, y, y)));
+
+            storeVector3(dstVertices, _mm_add_ps(_mm256_castps256_ps128(pos), _mm256_extractf128_ps(pos, 1)));
+
+            if (srcNormals) {
+                const Float nx = srcNormals[0], ny = srcNormals[1], nz = srcNormals[2];
+                __m256 normal = _mm256_fmadd_ps(
+                            c23, _mm256_setr_ps(nz, nz, nz, nz, 0.f, 0.f, 0.f, 0.f),
+                            _mm256_mul_ps(c01, _mm256_setr_ps(nx, nx, nx, nx, ny, ny, ny, ny)));
+
+                storeVector3(dstNormals, _mm_add_ps(_mm256_castps256_ps128(normal), _mm256_extractf128_ps(normal, 1)));
+            }
+        } else {
+            memcpy(dstVertices, srcVertices, 3*sizeof(Float));
+
+            if (srcNormals) {
+                memcpy(dstNormals, srcNormals, 3*sizeof(Float));
+            }
+        }
+
+        srcVertices += r.vertexSrcStride;
+        dstVertices += r.vertexDstStride;
+
+        if (srcNormals) {
+            srcNormals += r.normalSrcStride;
+            dstNormals += r.normalDstStride;
+        }
+
+        srcSkinning += r.skinningSrcStride;
+        srcWeighting += r.weightingSrcStride;
+    }
+}
+
+//! The whole matrix per register.
+O3D_SIMD_TARGET_AVX512
+inline __m128 sumColumns(__m512 v)
+{
+    return _mm_add_ps(_mm_add_ps(_mm512_castps512_ps128(v), _mm512_extractf32x4_ps(v, 1)),
+                      _mm_add_ps(_mm512_extractf32x4_ps(v, 2), _mm512_extractf32x4_ps(v, 3)));
+}
+
+O3D_SIMD_TARGET_AVX512
+void skinningAVX512(const SkinningRange &r)
+{
+    const Float *srcVertices = r.srcVertices;
+    const Float *srcNormals = r.srcNormals;
+    const Float *srcSkinning = r.srcSkinning;
+    const Float *srcWeighting = r.srcWeighting;
+    Float *dstVertices = r.dstVertices;
+    Float *dstNormals = r.dstNormals;
+
+    Int32 bones[4];
+    Float weights[4];
+
+    for (UInt32 v = 0; v < r.numVertices; ++v) {
+        const UInt32 boneCount = vertexBones(srcSkinning, srcWeighting, bones, weights);
+
+        if (boneCount != 0) {
+            __m512 m = _mm512_setzero_ps();
+
+            for (UInt32 b = 0; b < boneCount; ++b) {
+                m = _mm512_fmadd_ps(_mm512_loadu_ps(r.matrices + (bones[b] << 4)), _mm512_set1_ps(weights[b]), m);
+            }
+
+            const Float x = srcVertices[0], y = srcVertices[1], z = srcVertices[2];
+            const __m512 pos = _mm512_mul_ps(m, _mm512_setr_ps(
+                                                 x, x, x, x, y, y, y, y, z, z, z, z, 1.f, 1.f, 1.f, 1.f));
+
+            storeVector3(dstVertices, sumColumns(pos));
+
+            if (srcNormals) {
+                const Float nx = srcNormals[0], ny = srcNormals[1], nz = srcNormals[2];
+                const __m512 normal = _mm512_mul_ps(m, _mm512_setr_ps(
+                                                        nx, nx, nx, nx, ny, ny, ny, ny, nz, nz, nz, nz, 0.f, 0.f, 0.f, 0.f));
+
+                storeVector3(dstNormals, sumColumns(normal));
+            }
+        } else {
+            memcpy(dstVertices, srcVertices, 3*sizeof(Float));
+
+            if (srcNormals) {
+                memcpy(dstNormals, srcNormals, 3*sizeof(Float));
+            }
+        }
+
+        srcVertices += r.vertexSrcStride;
+        dstVertices += r.vertexDstStride;
+
+        if (srcNormals) {
+            srcNormals += r.normalSrcStride;
+            dstNormals += r.normalDstStride;
+        }
+
+        srcSkinning += r.skinningSrcStride;
+        srcWeighting += r.weightingSrcStride;
+    }
+}
+
+#endif // O3D_SIMD_X86
+
+void skinning(const SkinningRange &range)
+{
+    static const SkinningFunc func = SimdKernel<SkinningFunc>(skinningScalar)
+        #ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, skinningSSE2)
+            .add(SIMD_AVX2, skinningAVX2)
+            .add(SIMD_AVX512, skinningAVX512)
+        #endif
+            .get();
+
+    func(range);
+}
+
+} // anonymous namespace
+
 // Skinning PrepareDrawing
 void Skinning::prepareDrawing()
 {
@@ -988,12 +1320,6 @@ void Skinning::prepareDrawing()
             UInt32 skinningSrcStride = m_meshData->getGeometry()->getElement(V_SKINNING_ARRAY)->getAdvance();
             UInt32 weightingSrcStride = m_meshData->getGeometry()->getElement(V_WEIGHTING_ARRAY)->getAdvance();
 
-            Matrix4 matrix;
-            Vector3 position;
-            UInt32 boneCount;
-            Int32  boneId;
-            Float  scale;
-
             UInt32 vertexDstStride = m_vertexBlend->getVertices().getElementSize();
             UInt32 vertexSrcStride = m_meshData->getGeometry()->getVertices()->getAdvance();
 
@@ -1024,67 +1350,37 @@ void Skinning::prepareDrawing()
             srcSkinning += firstIndice * skinningSrcStride;
             srcWeighting += firstIndice * weightingSrcStride;
 
+            SkinningRange range;
+            range.matrices = m_skinMatrices.getData();
+            range.srcVertices = srcVertices;
+            range.srcNormals = nullptr;
+            range.srcSkinning = srcSkinning;
+            range.srcWeighting = srcWeighting;
+            range.dstVertices = dstVertices;
+            range.dstNormals = nullptr;
+            range.vertexSrcStride = vertexSrcStride;
+            range.normalSrcStride = 0;
+            range.skinningSrcStride = skinningSrcStride;
+            range.weightingSrcStride = weightingSrcStride;
+            range.vertexDstStride = vertexDstStride;
+            range.normalDstStride = 0;
+            range.numVertices = lastIndice - firstIndice + 1;
+
             // process with normal
             if (m_meshData->getGeometry()->isNormals()) {
                 const Float *srcNormals = m_meshData->getGeometry()->getNormals()->lockArray(0, 0);
                 Float *dstNormals = m_vertexBlend->getNormals().getData().getData();
 
-                Vector3 normal;
-
                 UInt32 normalDstStride = m_vertexBlend->getNormals().getElementSize();
                 UInt32 normalSrcStride =  m_meshData->getGeometry()->getNormals()->getAdvance();
 
-                dstNormals += firstIndice * normalDstStride;
-                srcNormals += firstIndice * normalSrcStride;
+                range.srcNormals = srcNormals + firstIndice * normalSrcStride;
+                range.dstNormals = dstNormals + firstIndice * normalDstStride;
+                range.normalSrcStride = normalSrcStride;
+                range.normalDstStride = normalDstStride;
 
                 // skinning process
-                for (UInt32 curVertex = firstIndice; curVertex <= lastIndice; ++curVertex) {
-                    matrix.zero();
-
-                    boneCount = 0;
-
-                    // compute the matrix (matrix blending)
-                    while (boneCount < 4) {
-                        if ((boneId = (Int32)srcSkinning[boneCount]) != -1) {
-                            scale = srcWeighting[boneCount];
-                            if (scale > 0.f) {
-                                matrix += m_skinMatrices[boneId] * scale;
-                            }
-
-                            ++boneCount;
-                        } else {
-                            break;
-                        }
-                    }
-
-                    // compute the new vertex and normals only if one or more bone affect it
-                    if (boneCount != 0) {
-                        // vertex
-                        position.set(srcVertices);
-
-                        position = matrix * position;
-                        memcpy(dstVertices, position.getData(), 3*sizeof(Float));
-
-                        // normal
-                        normal.set(srcNormals);
-
-                        normal = matrix.rotate(normal);
-                        memcpy(dstNormals, normal.getData(), 3*sizeof(Float));
-                    } else {
-                        // otherwise simply copy
-                        memcpy(dstVertices, srcVertices, 3*sizeof(Float));
-                        memcpy(dstNormals, srcNormals, 3*sizeof(Float));
-                    }
-
-                    dstVertices += vertexDstStride;
-                    dstNormals += normalDstStride;
-
-                    srcVertices += vertexSrcStride;
-                    srcNormals  += normalSrcStride;
-
-                    srcSkinning += skinningSrcStride;
-                    srcWeighting += weightingSrcStride;
-                }
+                skinning(range);
 
                 m_meshData->getGeometry()->getNormals()->unlockArray();
 
@@ -1095,45 +1391,7 @@ void Skinning::prepareDrawing()
                         lastIndice - firstIndice + 1);
             } else {
                 // process only vertices
-                // skinning process
-                for (UInt32 curVertex = firstIndice; curVertex <= lastIndice; ++curVertex) {
-                    matrix.zero();
-
-                    boneCount = 0;
-
-                    // compute the matrix (matrix blending)
-                    while (boneCount < 4) {
-                        if ((boneId = (Int32)srcSkinning[boneCount]) != -1) {
-                            scale = srcWeighting[boneCount];
-                            if (scale > 0.f) {
-                                matrix += m_skinMatrices[boneId] * scale;
-                            }
-
-                            ++boneCount;
-                        } else {
-                            break;
-                        }
-                    }
-
-                    // compute the new vertex and normals only if one or more bone affect it
-                    if (boneCount != 0) {
-                        // vertex
-                        position.set(srcVertices);
-
-                        position = matrix * position;
-                        memcpy(dstVertices, position.getData(), 3*sizeof(Float));
-                    } else {
-                        // otherwise simply copy
-                        memcpy(dstVertices, srcVertices, 3*sizeof(Float));
-                    }
-
-                    dstVertices += vertexDstStride;
-                    srcVertices += vertexSrcStride;
-
-                    srcSkinning += skinningSrcStride;
-                    srcWeighting += weightingSrcStride;
-                }
-
+                skinning(range);
             }
 
             // update vertices data
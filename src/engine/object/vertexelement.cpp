@@ -382,7 +382,7 @@ Bool VertexElement::writeToFile(OutStream &os)
 		UInt32 count = m_numElt * m_eltSize;
 
         os << count;
-        os.write(data, count);
+        os.writeArray(data, count);
 
 		unlockArray();
     } else {
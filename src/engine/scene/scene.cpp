@@ -77,6 +77,8 @@
 #include "o3d/engine/visibility/visibilitymanager.h"
 #include "o3d/engine/primitive/primitivemanager.h"
 
+#include <set>
+
 using namespace o3d;
 
 AudioManager::~AudioManager()
@@ -451,7 +453,9 @@ Bool Scene::importScene(InStream &is, SceneIO *whatImported)
 	SceneIO sceneio;
 
     is >> str;     // file id
-	if (str != "Scene")
+    const Bool snapshot = (str == "SceneSnapshot");
+
+	if (str != "Scene" && !snapshot)
         O3D_ERROR(E_InvalidFormat("Invalid scene token"));
 
 	// version
@@ -510,7 +514,14 @@ Bool Scene::importScene(InStream &is, SceneIO *whatImported)
 
 	// scene hierarchy
     if (sceneio.get(SceneIO::NODES)) {
-        if (!getHierarchyTree()->readFromFile(is)) {
+        if (snapshot) {
+            // the mesh data are decoded in parallel before to link the objects
+            getMeshDataManager()->readMeshDataList(is);
+
+            if (!getHierarchyTree()->readSnapshot(is)) {
+                return False;
+            }
+        } else if (!getHierarchyTree()->readFromFile(is)) {
 			return False;
         }
     }
@@ -543,7 +554,47 @@ Bool Scene::importScene(InStream &is, SceneIO *whatImported)
 	return True;
 }
 
+// Collect the mesh data of the exported meshes of a node, recursively
+static void collectMeshData(
+        const SceneIO &sceneio,
+        const Node *node,
+        std::set<MeshData*> &found,
+        std::vector<MeshData*> &list)
+{
+    const T_SonList &sonList = node->getSonList();
+    for (CIT_SonList cit = sonList.begin(); cit != sonList.end(); ++cit) {
+        SceneObject *object = (*cit);
+
+        if (!sceneio.isIO(*object)) {
+            continue;
+        }
+
+        Mesh *mesh = dynamicCast<Mesh*>(object);
+        if (mesh) {
+            MeshData *meshData = mesh->getMeshData();
+            if (meshData && found.insert(meshData).second) {
+                list.push_back(meshData);
+            }
+        }
+
+        Node *son = dynamicCast<Node*>(object);
+        if (son) {
+            collectMeshData(sceneio, son, found, list);
+        }
+    }
+}
+
 Bool Scene::exportScene(const String &sceneFilename, const SceneIO &whatExport)
+{
+    return exportScene(sceneFilename, whatExport, False);
+}
+
+Bool Scene::exportSceneSnapshot(const String &sceneFilename, const SceneIO &whatExport)
+{
+    return exportScene(sceneFilename, whatExport, True);
+}
+
+Bool Scene::exportScene(const String &sceneFilename, const SceneIO &whatExport, Bool snapshot)
 {
 	SceneIO sceneio = whatExport;
 
@@ -581,7 +632,7 @@ Bool Scene::exportScene(const String &sceneFilename, const SceneIO &whatExport)
     FileOutStream *os = FileManager::instance()->openOutStream(absSceneFilename, FileOutStream::CREATE);
     FileOutStream& ros = *os;
 
-	String fileTag("Scene");
+	String fileTag(snapshot ? "SceneSnapshot" : "Scene");
 
     ros << fileTag
         << UInt32(O3D_VERSION);
@@ -627,7 +678,18 @@ Bool Scene::exportScene(const String &sceneFilename, const SceneIO &whatExport)
 
 	// write scene hierarchy
     if (sceneio.get(SceneIO::NODES)) {
-        if (!getHierarchyTree()->writeToFile(ros)) {
+        if (snapshot) {
+            // the used mesh data first, to decode them before to link the objects
+            std::set<MeshData*> found;
+            std::vector<MeshData*> meshDataList;
+
+            collectMeshData(getCurSceneIO(), getHierarchyTree()->getRootNode(), found, meshDataList);
+            getMeshDataManager()->writeMeshDataList(ros, meshDataList);
+
+            if (!getHierarchyTree()->writeSnapshot(ros)) {
+                return False;
+            }
+        } else if (!getHierarchyTree()->writeToFile(ros)) {
 			return False;
         }
     }
@@ -894,6 +956,9 @@ void Scene::display()
 	
 	// draw all scene viewports
 	m_viewPortManager->display();
+
+    // release the transient data of the frame
+    m_frameManager->endFrame();
 }
 
 void Scene::reshape(UInt32 width, UInt32 height)
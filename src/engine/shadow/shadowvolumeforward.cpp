@@ -163,8 +163,8 @@ void ShadowVolumeForward::draw(ViewPort */*viewPort*/)
     //
 
     // process each effective light with the world
-    const TemplateArray<Light*> lights = getScene()->getVisibilityManager()->getEffectiveLights();
-    for (Int32 i = 0; i < lights.getSize(); ++i) {
+    const VisibilityManager::T_LightList &lights = getScene()->getVisibilityManager()->getEffectiveLights();
+    for (size_t i = 0; i < lights.size(); ++i) {
         processLight(lights[i]);
     }
 
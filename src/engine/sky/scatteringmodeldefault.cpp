@@ -11,6 +11,7 @@
 #include "o3d/engine/sky/scatteringmodeldefault.h"
 
 #include "o3d/core/smartarray.h"
+#include "o3d/core/batchmath.h"
 #include "o3d/engine/primitive/dome.h"
 #include "o3d/image/imagetype.h"
 
@@ -66,6 +67,13 @@ ScatteringModelBase::TaskResult ScatteringModelDefault::entry(TaskData & _datas)
 
 	memset((void*)_datas.colorArray.getData(), 0, 3*_datas.pDome->getNumVertices() * sizeof(Float));
 
+	// Direction normalisee de chaque vertex, commune a tous les objets
+	std::vector<Float> lVertexDirections(3*_datas.pDome->getNumVertices());
+
+	BatchMath::normalize(	ConstBatchVectors::aos(_datas.pDome->getVertices()),
+							BatchVectors::aos(lVertexDirections.data()),
+							_datas.pDome->getNumVertices());
+
 	for (IT_ObjectArray itObject = _datas.objectArray.begin() ; itObject != _datas.objectArray.end() ; itObject++)
 	{
 		memset((void*)_datas.workingArray.getData(), 0, 3*_datas.pDome->getNumVertices() * sizeof(Float));
@@ -120,6 +128,7 @@ ScatteringModelBase::TaskResult ScatteringModelDefault::entry(TaskData & _datas)
 			const UInt32 lVertexCount = _datas.pDome->getSliceCount(lCurrentStack);
 			const Float * const lpVertexStart = _datas.pDome->getVerticesAtStack(lCurrentStack);
 			Float * const lpColorStart = _datas.workingArray.getData() + (lpVertexStart - _datas.pDome->getVertices());
+			const Float * const lpDirectionStart = lVertexDirections.data() + (lpVertexStart - _datas.pDome->getVertices());
 			const UInt32 lVertexStepStart = (lVertexCount >= lColorThreshold1 ? 4 : (lVertexCount >= lColorThreshold2 ? 2 : 1));
 			UInt32 lVertexStep = lVertexStepStart;
 
@@ -140,8 +149,7 @@ ScatteringModelBase::TaskResult ScatteringModelDefault::entry(TaskData & _datas)
 				const Float lIRayDecFactorM = 1.0f/_datas.rayDensityDecFactor;
 				const Float lIMieDecFactorM = 1.0f/_datas.mieDensityDecFactor;
 
-				Vector3 lVertexDirection(lpVertexStart[0], lpVertexStart[1], lpVertexStart[2]);
-				lVertexDirection.normalize();
+				const Vector3 lVertexDirection(lpDirectionStart);
 
 				Float lStep = lStepStart;
 				Float lDistance = 0.0f;
@@ -211,9 +219,10 @@ ScatteringModelBase::TaskResult ScatteringModelDefault::entry(TaskData & _datas)
 			while (lVertexStep > 0)
 			{
 				const Float * lpVertex = lpVertexStart;
+				const Float * lpDirection = lpDirectionStart;
 				Float * lpColor = lpColorStart;
 
-				for (Int32 i = 0 ; i < Int32(lVertexCount) ; i += lVertexStep , lpVertex += 3*lVertexStep, lpColor += 3*lVertexStep)
+				for (Int32 i = 0 ; i < Int32(lVertexCount) ; i += lVertexStep , lpVertex += 3*lVertexStep, lpDirection += 3*lVertexStep, lpColor += 3*lVertexStep)
 				{
 					switch(lVertexStep)
 					{
@@ -258,8 +267,7 @@ ScatteringModelBase::TaskResult ScatteringModelDefault::entry(TaskData & _datas)
 					}
 
 					Vector3 lRayOpticalLength, lMieOpticalLength;
-					Vector3 lVertexDirection(lpVertex[0], lpVertex[1], lpVertex[2]);
-					lVertexDirection.normalize();
+					const Vector3 lVertexDirection(lpDirection);
 
 					const Float lCosAlpha = lVertexDirection * lDirection;
 					const Float lRayPhaseFunction = 3.0f/(16.0f*o3d::PI) * (_datas.rayleighPhaseFunctionCoef1 + _datas.rayleighPhaseFunctionCoef2 * lCosAlpha*lCosAlpha);
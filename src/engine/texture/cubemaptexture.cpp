@@ -11,6 +11,8 @@
 #include "o3d/engine/texture/cubemaptexture.h"
 
 #include "o3d/core/filemanager.h"
+#include "o3d/core/datainstream.h"
+#include "o3d/core/taskmanager.h"
 
 #include "o3d/engine/glextdefines.h"
 #include "o3d/engine/glextensionmanager.h"
@@ -371,7 +373,8 @@ CubeMapTextureTask::CubeMapTextureTask(
 		const String &filename,
 		Bool mipmaps) :
 			m_texture(texture),
-			m_mipmaps(mipmaps)
+			m_mipmaps(mipmaps),
+			m_numReading(0)
 {
 	if (!texture)
 		O3D_ERROR(E_InvalidParameter("The texture must be valid"));
@@ -387,7 +390,10 @@ CubeMapTextureTask::CubeMapTextureTask(
 		const String &yn,
 		const String &zp,
 		const String &zn,
-		Bool mipmaps)
+		Bool mipmaps) :
+			m_texture(texture),
+			m_mipmaps(mipmaps),
+			m_numReading(0)
 {
 	if (!texture)
 		O3D_ERROR(E_InvalidParameter("The texture must be valid"));
@@ -400,13 +406,58 @@ CubeMapTextureTask::CubeMapTextureTask(
 	m_filenames[5] = FileManager::instance()->getFullFileName(zn);
 }
 
+void CubeMapTextureTask::submit(Int32 priority)
+{
+	Int32 numFiles = 0;
+	for (Int32 i = 0; i < 6; ++i)
+	{
+		if (m_filenames[i].isValid())
+			++numFiles;
+	}
+
+	// one more until every read is submitted
+	m_numReading = numFiles + 1;
+
+	for (Int32 i = 0; i < 6; ++i)
+	{
+		if (m_filenames[i].isValid())
+		{
+			FileManager::instance()->readAsync(
+						m_filenames[i],
+						0, 0,
+						priority,
+						m_texture,
+						[this, i] (FileReadRequest *request) {
+				m_requests[i] = request;
+
+				// the last finished read starts the task
+				if (--m_numReading == 0)
+					TaskManager::instance()->addTask(this);
+			});
+		}
+	}
+
+	if (--m_numReading == 0)
+		TaskManager::instance()->addTask(this);
+}
+
 Bool CubeMapTextureTask::execute()
 {
 	for (Int32 i = 0; i < 6; ++i)
 	{
 		if (m_filenames[i].isValid())
 		{
-			if (!m_pictures[i].load(m_filenames[i]))
+			// from the asynchronous read, failed or canceled if not done
+			if (m_requests[i])
+			{
+				if (!m_requests[i]->isDone() || !m_requests[i]->getData().getNumElt())
+					return False;
+
+				SharedDataInStream is(m_requests[i]->getData());
+				if (!m_pictures[i].load(is))
+					return False;
+			}
+			else if (!m_pictures[i].load(m_filenames[i]))
 				return False;
 		}
 	}
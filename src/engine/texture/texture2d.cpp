@@ -11,6 +11,8 @@
 #include "o3d/engine/texture/texture2d.h"
 
 #include "o3d/core/filemanager.h"
+#include "o3d/core/datainstream.h"
+#include "o3d/core/taskmanager.h"
 
 #include "o3d/engine/glextdefines.h"
 #include "o3d/engine/glextensionmanager.h"
@@ -495,8 +497,31 @@ Texture2DTask::Texture2DTask(
 	m_filename = FileManager::instance()->getFullFileName(filename);
 }
 
+void Texture2DTask::submit(Int32 priority)
+{
+	FileManager::instance()->readAsync(
+				m_filename,
+				0, 0,
+				priority,
+				m_texture,
+				[this] (FileReadRequest *request) {
+		m_request = request;
+		TaskManager::instance()->addTask(this);
+	});
+}
+
 Bool Texture2DTask::execute()
 {
+	// from the asynchronous read, failed or canceled if not done
+	if (m_request)
+	{
+		if (!m_request->isDone() || !m_request->getData().getNumElt())
+			return False;
+
+		SharedDataInStream is(m_request->getData());
+		return m_picture.load(is);
+	}
+
 	O3D_ASSERT(m_filename.isValid());
 	if (m_filename.isValid())
 	{
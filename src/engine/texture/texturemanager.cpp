@@ -235,6 +235,10 @@ void TextureManager::deleteTexture(Texture *texture)
     if (texture->getManager() != this) {
 		O3D_ERROR(E_InvalidParameter("Texture manager is not this"));
     } else {
+        // a texture still waiting for its files is not loaded, so it is not kept
+        // into the garbage, and its loading task fails
+        Bool canceled = FileManager::instance()->cancelReads(texture) > 0;
+
         FastMutexLocker locker(m_mutex);
 
         // remove the textures objects from the manager.
@@ -254,14 +258,22 @@ void TextureManager::deleteTexture(Texture *texture)
             // and adding it for a deferred deletion
             if (it2 != it->second.end()) {
                 it->second.erase(it2);
-                m_garbageManager.add(GarbageKey(texture), texture);
+
+                if (!canceled) {
+                    m_garbageManager.add(GarbageKey(texture), texture);
+                }
 
                 texture->setManager(nullptr);
 
                 m_IDManager.releaseID(texture->getId());
                 texture->setId(-1);
 
-                O3D_MESSAGE("Delete (to GC) texture: " + texture->getResourceName());
+                if (canceled) {
+                    O3D_MESSAGE("Delete (canceled loading) texture: " + texture->getResourceName());
+                    deletePtr(texture);
+                } else {
+                    O3D_MESSAGE("Delete (to GC) texture: " + texture->getResourceName());
+                }
             }
 
             // erase the list if empty
@@ -306,7 +318,7 @@ Texture2D* TextureManager::addTexture2D(
                 getFullFileName(filename),
 				mipMaps);
 
-		TaskManager::instance()->addTask(task);
+		task->submit();
     } else {
         // synchronous loading
         Image image(getFullFileName(filename));
@@ -430,7 +442,7 @@ CubeMapTexture* TextureManager::addCubeMapTexture(
                 filenames[5],
 				mipMaps);
 
-		TaskManager::instance()->addTask(task);
+		task->submit();
     } else {
         // synchronous loading
         if (filenames[CubeMapTexture::RIGHT_SIDE].isValid()) {
@@ -479,7 +491,7 @@ CubeMapTexture* TextureManager::addCubeMapTexture(
                 getFullFileName(filename),
 				mipMaps);
 
-		TaskManager::instance()->addTask(task);
+		task->submit();
     } else {
         // synchronous loading
         Image image(getFullFileName(filename));
@@ -599,7 +611,7 @@ Texture2D* TextureManager::readTexture2D(InStream &is)
                 getFullFileName(texture2D->getResourceName()),
 				texture2D->isMipMaps());
 
-		TaskManager::instance()->addTask(task);
+		task->submit();
     } else {
         // synchronous loading
         Image image(getFullFileName(texture2D->getResourceName()));
@@ -706,14 +718,14 @@ CubeMapTexture* TextureManager::readTextureCubeMap(InStream &is)
                     filenames[CubeMapTexture::BACK_SIDE],
 					cubeMapTexture->isMipMaps());
 
-			TaskManager::instance()->addTask(task);
+			task->submit();
         } else {
 			CubeMapTextureTask *task = new CubeMapTextureTask(
 					cubeMapTexture,
                     filenames[CubeMapTexture::SINGLE],
 					cubeMapTexture->isMipMaps());
 
-			TaskManager::instance()->addTask(task);
+			task->submit();
 		}
     } else {
         // synchronous loading
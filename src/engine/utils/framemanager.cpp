@@ -93,6 +93,10 @@ void FrameManager::logInfo() const
                      m_framesList[i].numPoints,
                      m_framesList[i].numVertices));
     }
+
+    O3D_MESSAGE(String("Frame arena high-water mark {0} bytes, capacity {1} bytes")
+                .arg((UInt64)m_frameArena.getHighWaterMark())
+                .arg((UInt64)m_frameArena.getCapacity()));
 }
 
 // Compute the duration of the frame in seconds.
@@ -16,6 +16,7 @@
 #include "o3d/engine/visibility/visibilitybasic.h"
 #include "o3d/engine/object/camera.h"
 #include "o3d/engine/scene/scene.h"
+#include "o3d/engine/utils/framemanager.h"
 
 using namespace o3d;
 
@@ -28,8 +29,7 @@ VisibilityManager::VisibilityManager(BaseObject *parent) :
     m_globalController(nullptr),
     m_maxDistance(10000.0f),
 	m_useMaxDistance(True),
-	m_useMaxZFar(True),
-	m_drawList(4096, 4096)
+	m_useMaxZFar(True)
 {
 	setGlobal(m_global, 8, 128.f);
 }
@@ -93,9 +93,17 @@ void VisibilityManager::removeObject(SceneObject *object)
 // Process the visibility determination.
 void VisibilityManager::processVisibility()
 {
-    // clear the draw list and effective light list
-	m_drawList.forceSize(0);
-    m_effectiveLightList.forceSize(0);
+    // new draw list and effective light list for this frame, sized as the previous ones
+    FrameArena &arena = getScene()->getFrameManager()->getFrameArena();
+
+    const size_t numObjects = m_drawList.size();
+    const size_t numLights = m_effectiveLightList.size();
+
+    m_drawList = T_DrawList(FrameAllocator<SceneObject*>(&arena));
+    m_drawList.reserve(o3d::max<size_t>(numObjects, 256));
+
+    m_effectiveLightList = T_LightList(FrameAllocator<Light*>(&arena));
+    m_effectiveLightList.reserve(o3d::max<size_t>(numLights, 16));
 
 	VisibilityInfos info = {
 			getScene()->getActiveCamera()->getAbsoluteMatrix().getTranslation(),
@@ -117,8 +125,8 @@ void VisibilityManager::draw(const DrawInfo &drawInfo)
 	SceneObject * sceneObject;
 
     // according to the draw list check if each objet lies with the frustum and draw it
-	Int32 numObject = m_drawList.getSize();
-    for (Int32 i = 0; i < numObject; ++i) {
+	size_t numObject = m_drawList.size();
+    for (size_t i = 0; i < numObject; ++i) {
 		sceneObject = m_drawList[i];
 
         if (sceneObject->checkFrustum(*getScene()->getFrustum()) != Geometry::CLIP_OUTSIDE) {
@@ -129,11 +137,6 @@ void VisibilityManager::draw(const DrawInfo &drawInfo)
     }
 }
 
-const TemplateArray<Light *> VisibilityManager::getEffectiveLights() const
-{
-    return m_effectiveLightList;
-}
-
 void VisibilityManager::setMaxDistance(Float max)
 {
     m_maxDistance = max;
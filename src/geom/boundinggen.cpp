@@ -10,6 +10,8 @@
 #include "o3d/core/precompiled.h"
 #include "o3d/geom/boundinggen.h"
 
+#include "o3d/core/batchmath.h"
+
 #include "o3d/geom/bsphere.h"
 #include "o3d/geom/aabbox.h"
 #include "o3d/geom/obbox.h"
@@ -24,6 +26,23 @@ BoundingGen::BoundingGen() :
 {
 }
 
+// Number of vertices projected at once by the third pass
+static const UInt32 BATCH_SIZE = 256;
+
+// first pass for an array of vertices
+void BoundingGen::firstPass(const ConstBatchVectors &vertices, UInt32 numVertices)
+{
+	if (numVertices == 0)
+		return;
+
+	Vector3 minV, maxV, sum;
+	BatchMath::bounds(vertices, numVertices, minV, maxV, &sum);
+
+	m_average += sum;
+	m_minV.minOf(m_minV, minV);
+	m_maxV.maxOf(m_maxV, maxV);
+}
+
 // all vertices have been checked so we finish the computation
 void BoundingGen::flushFirstPass(UInt32 vertices)
 {
@@ -37,6 +56,34 @@ void BoundingGen::flushFirstPass(UInt32 vertices)
 	m_covariance.zero();
 }
 
+// second pass for an array of vertices
+void BoundingGen::secondPass(const ConstBatchVectors &vertices, UInt32 numVertices)
+{
+	const Float mx = m_average.x(), my = m_average.y(), mz = m_average.z();
+	Float xx = 0.f, yy = 0.f, zz = 0.f, xy = 0.f, xz = 0.f, yz = 0.f;
+
+	for (UInt32 i = 0, s = 0; i < numVertices; ++i, s += vertices.stride)
+	{
+		const Float dx = vertices.x[s] - mx;
+		const Float dy = vertices.y[s] - my;
+		const Float dz = vertices.z[s] - mz;
+
+		xx += dx * dx;
+		yy += dy * dy;
+		zz += dz * dz;
+		xy += dx * dy;
+		xz += dx * dz;
+		yz += dy * dz;
+	}
+
+	m_covariance(0,0) = m_covariance(0,0) + xx;
+	m_covariance(1,1) = m_covariance(1,1) + yy;
+	m_covariance(2,2) = m_covariance(2,2) + zz;
+	m_covariance(0,1) = m_covariance(0,1) + xy;
+	m_covariance(0,2) = m_covariance(0,2) + xz;
+	m_covariance(1,2) = m_covariance(1,2) + yz;
+}
+
 void BoundingGen::flushSecondPass(UInt32 vertices)
 {
 	Float invNumVertices = 1.f / vertices;
@@ -74,6 +121,72 @@ void BoundingGen::flushSecondPass(UInt32 vertices)
 	m_maxDotR = m_maxDotS = m_maxDotT = o3d::Limits<Float>::min();
 }
 
+// third pass for an array of vertices
+void BoundingGen::thirdPass(const ConstBatchVectors &vertices, UInt32 numVertices)
+{
+	// project onto R, S and T by batches
+	const Matrix4 proj(
+			m_R.x(), m_R.y(), m_R.z(), 0.f,
+			m_S.x(), m_S.y(), m_S.z(), 0.f,
+			m_T.x(), m_T.y(), m_T.z(), 0.f,
+			0.f, 0.f, 0.f, 1.f);
+
+	Float dotR[BATCH_SIZE], dotS[BATCH_SIZE], dotT[BATCH_SIZE];
+	const UInt32 stride = vertices.stride;
+
+	for (UInt32 first = 0; first < numVertices; first += BATCH_SIZE)
+	{
+		const UInt32 count = o3d::min(BATCH_SIZE, numVertices - first);
+		const UInt32 offset = first * stride;
+
+		const ConstBatchVectors batch(
+				vertices.x + offset,
+				vertices.y + offset,
+				vertices.z + offset,
+				stride);
+
+		BatchMath::transformNormals(proj, batch, BatchVectors::soa(dotR, dotS, dotT), count);
+
+		Vector3 minDot, maxDot;
+		BatchMath::bounds(ConstBatchVectors::soa(dotR, dotS, dotT), count, minDot, maxDot);
+
+		// first vertex of minimal and maximal projection onto R
+		if (minDot.x() < m_minDotR)
+		{
+			UInt32 i = 0;
+			while ((i < count) && (dotR[i] != minDot.x()))
+				++i;
+
+			if (i < count)
+				m_minVertexR.set(batch.x[i*stride], batch.y[i*stride], batch.z[i*stride]);
+		}
+
+		if (maxDot.x() > m_maxDotR)
+		{
+			UInt32 i = 0;
+			while ((i < count) && (dotR[i] != maxDot.x()))
+				++i;
+
+			if (i < count)
+				m_maxVertexR.set(batch.x[i*stride], batch.y[i*stride], batch.z[i*stride]);
+		}
+
+		m_minDotR = o3d::min(minDot.x(), m_minDotR);
+		m_maxDotR = o3d::max(maxDot.x(), m_maxDotR);
+		m_minDotS = o3d::min(minDot.y(), m_minDotS);
+		m_maxDotS = o3d::max(maxDot.y(), m_maxDotS);
+		m_minDotT = o3d::min(minDot.z(), m_minDotT);
+		m_maxDotT = o3d::max(maxDot.z(), m_maxDotT);
+	}
+}
+
+// fourth pass for an array of vertices
+void BoundingGen::fourthPass(const ConstBatchVectors &vertices, UInt32 numVertices)
+{
+	for (UInt32 i = 0, s = 0; i < numVertices; ++i, s += vertices.stride)
+		fourthPass(vertices.x[s], vertices.y[s], vertices.z[s]);
+}
+
 // Compute some variables
 void BoundingGen::flushThirdPass()
 {
@@ -15,6 +15,11 @@
 #include "o3d/geom/bcone.h"
 #include "o3d/core/matrix4.h"
 #include "o3d/core/vector3.h"
+#include "o3d/core/cpudispatch.h"
+
+#ifdef O3D_SIMD_X86
+    #include <immintrin.h>
+#endif
 
 using namespace o3d;
 
@@ -603,3 +608,522 @@ Geometry::Clipping Frustum::boxInFrustumLight(const OBBoxExt &box) const
     // @todo
 	return Geometry::CLIP_INSIDE;
 }
+
+//---------------------------------------------------------------------------------------
+// Batch culling
+//---------------------------------------------------------------------------------------
+
+namespace {
+
+//! Planes by component, the unused entries never reject (null normal, infinite distance).
+struct PlaneTable
+{
+    O3D_ALIGN(64) Float nx[16];
+    O3D_ALIGN(64) Float ny[16];
+    O3D_ALIGN(64) Float nz[16];
+    O3D_ALIGN(64) Float d[16];
+    O3D_ALIGN(64) Float ax[16];  //!< |nx|, for the boxes
+    O3D_ALIGN(64) Float ay[16];
+    O3D_ALIGN(64) Float az[16];
+
+    UInt32 numPlanes;
+};
+
+struct CullArgs
+{
+    const Float *x, *y, *z;
+    const Float *r;              //!< Spheres radius.
+    const Float *hx, *hy, *hz;   //!< Boxes half sizes.
+    UInt32 n;
+};
+
+typedef UInt32 (*CullFunc)(const PlaneTable &t, const CullArgs &a, UInt32 *visible, UInt8 *hints);
+
+inline UInt32 bitCount(UInt32 v)
+{
+    v = v - ((v >> 1) & 0x55555555);
+    v = (v & 0x33333333) + ((v >> 2) & 0x33333333);
+    return (((v + (v >> 4)) & 0x0f0f0f0f) * 0x01010101) >> 24;
+}
+
+//---------------------------------------------------------------------------------------
+// Scalar, also used for the remaining objects of the SIMD versions
+//---------------------------------------------------------------------------------------
+
+template <Bool BOX>
+inline Bool outsidePlane(const PlaneTable &t, UInt32 p, const CullArgs &a, UInt32 i)
+{
+    const Float dist = t.nx[p]*a.x[i] + t.ny[p]*a.y[i] + t.nz[p]*a.z[i] + t.d[p];
+
+    // for a box, the distance of the farthest corner along the normal
+    const Float radius = BOX ? t.ax[p]*a.hx[i] + t.ay[p]*a.hy[i] + t.az[p]*a.hz[i] : a.r[i];
+
+    return dist + radius < 0.f;
+}
+
+template <Bool BOX>
+inline UInt32 visibleOne(const PlaneTable &t, const CullArgs &a, UInt32 i, UInt8 *hints)
+{
+    if (hints && outsidePlane<BOX>(t, hints[i] & 15, a, i)) {
+        return 0;
+    }
+
+    for (UInt32 p = 0; p < t.numPlanes; ++p) {
+        if (outsidePlane<BOX>(t, p, a, i)) {
+            if (hints) {
+                hints[i] = (UInt8)p;
+            }
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+template <Bool BOX>
+UInt32 cullScalar(const PlaneTable &t, const CullArgs &a, UInt32 *visible, UInt8 *hints)
+{
+    UInt32 count = 0;
+
+    for (UInt32 base = 0; base < a.n; base += 32) {
+        const UInt32 last = o3d::min(a.n, base + 32);
+        UInt32 bits = 0;
+
+        for (UInt32 i = base; i < last; ++i) {
+            bits |= visibleOne<BOX>(t, a, i, hints) << (i - base);
+        }
+
+        visible[base >> 5] = bits;
+        count += bitCount(bits);
+    }
+
+    return count;
+}
+
+#ifdef O3D_SIMD_X86
+
+//---------------------------------------------------------------------------------------
+// SSE2, 4 objects per iteration
+//---------------------------------------------------------------------------------------
+
+template <Bool BOX>
+O3D_SIMD_TARGET_SSE2
+inline __m128 outsideSSE2(
+        __m128 nx, __m128 ny, __m128 nz, __m128 d,
+        __m128 ax, __m128 ay, __m128 az,
+        __m128 x, __m128 y, __m128 z,
+        __m128 r, __m128 hx, __m128 hy, __m128 hz)
+{
+    const __m128 dist = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(nx, x), _mm_mul_ps(ny, y)), _mm_mul_ps(nz, z)), d);
+    const __m128 radius = BOX ?
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax, hx), _mm_mul_ps(ay, hy)), _mm_mul_ps(az, hz)) : r;
+
+    return _mm_cmplt_ps(_mm_add_ps(dist, radius), _mm_setzero_ps());
+}
+
+template <Bool BOX>
+O3D_SIMD_TARGET_SSE2
+UInt32 cullSSE2(const PlaneTable &t, const CullArgs &a, UInt32 *visible, UInt8 *hints)
+{
+    UInt32 count = 0;
+    const __m128 zero = _mm_setzero_ps();
+
+    for (UInt32 base = 0; base < a.n; base += 32) {
+        const UInt32 last = o3d::min(a.n, base + 32);
+        UInt32 bits = 0;
+
+        UInt32 i = base;
+        for (; i + 4 <= last; i += 4) {
+            const __m128 x = _mm_loadu_ps(a.x + i);
+            const __m128 y = _mm_loadu_ps(a.y + i);
+            const __m128 z = _mm_loadu_ps(a.z + i);
+
+            const __m128 r = BOX ? zero : _mm_loadu_ps(a.r + i);
+            const __m128 hx = BOX ? _mm_loadu_ps(a.hx + i) : zero;
+            const __m128 hy = BOX ? _mm_loadu_ps(a.hy + i) : zero;
+            const __m128 hz = BOX ? _mm_loadu_ps(a.hz + i) : zero;
+
+            __m128 out = zero;
+            __m128i h = _mm_setzero_si128();
+
+            if (hints) {
+                // the plane that rejected each object the last time
+                const UInt32 h0 = hints[i] & 15, h1 = hints[i+1] & 15, h2 = hints[i+2] & 15, h3 = hints[i+3] & 15;
+                h = _mm_setr_epi32((Int32)h0, (Int32)h1, (Int32)h2, (Int32)h3);
+
+                out = outsideSSE2<BOX>(
+                          _mm_setr_ps(t.nx[h0], t.nx[h1], t.nx[h2], t.nx[h3]),
+                          _mm_setr_ps(t.ny[h0], t.ny[h1], t.ny[h2], t.ny[h3]),
+                          _mm_setr_ps(t.nz[h0], t.nz[h1], t.nz[h2], t.nz[h3]),
+                          _mm_setr_ps(t.d[h0], t.d[h1], t.d[h2], t.d[h3]),
+                          _mm_setr_ps(t.ax[h0], t.ax[h1], t.ax[h2], t.ax[h3]),
+                          _mm_setr_ps(t.ay[h0], t.ay[h1], t.ay[h2], t.ay[h3]),
+                          _mm_setr_ps(t.az[h0], t.az[h1], t.az[h2], t.az[h3]),
+                          x, y, z, r, hx, hy, hz);
+            }
+
+            if (_mm_movemask_ps(out) != 0xf) {
+                for (UInt32 p = 0; p < t.numPlanes; ++p) {
+                    const __m128 outPlane = outsideSSE2<BOX>(
+                                                _mm_set1_ps(t.nx[p]), _mm_set1_ps(t.ny[p]), _mm_set1_ps(t.nz[p]), _mm_set1_ps(t.d[p]),
+                                                _mm_set1_ps(t.ax[p]), _mm_set1_ps(t.ay[p]), _mm_set1_ps(t.az[p]),
+                                                x, y, z, r, hx, hy, hz);
+
+                    // first rejecting plane of each object
+                    const __m128i newly = _mm_castps_si128(_mm_andnot_ps(out, outPlane));
+                    h = _mm_or_si128(_mm_andnot_si128(newly, h), _mm_and_si128(newly, _mm_set1_epi32((Int32)p)));
+
+                    out = _mm_or_ps(out, outPlane);
+                    if (_mm_movemask_ps(out) == 0xf) {
+                        break;
+                    }
+                }
+
+                if (hints) {
+                    const __m128i h16 = _mm_packs_epi32(h, h);
+                    const UInt32 h8 = (UInt32)_mm_cvtsi128_si32(_mm_packus_epi16(h16, h16));
+                    memcpy(hints + i, &h8, 4);
+                }
+            }
+
+            bits |= (UInt32)(~_mm_movemask_ps(out) & 0xf) << (i - base);
+        }
+
+        for (; i < last; ++i) {
+            bits |= visibleOne<BOX>(t, a, i, hints) << (i - base);
+        }
+
+        visible[base >> 5] = bits;
+        count += bitCount(bits);
+    }
+
+    return count;
+}
+
+//---------------------------------------------------------------------------------------
+// AVX2, 8 objects per iteration
+//---------------------------------------------------------------------------------------
+
+template <Bool BOX>
+O3D_SIMD_TARGET_AVX2
+inline __m256 outsideAVX2(
+        __m256 nx, __m256 ny, __m256 nz, __m256 d,
+        __m256 ax, __m256 ay, __m256 az,
+        __m256 x, __m256 y, __m256 z,
+        __m256 r, __m256 hx, __m256 hy, __m256 hz)
+{
+    const __m256 dist = _mm256_fmadd_ps(nz, z, _mm256_fmadd_ps(ny, y, _mm256_fmadd_ps(nx, x, d)));
+    const __m256 radius = BOX ?
+            _mm256_fmadd_ps(az, hz, _mm256_fmadd_ps(ay, hy, _mm256_mul_ps(ax, hx))) : r;
+
+    return _mm256_cmp_ps(_mm256_add_ps(dist, radius), _mm256_setzero_ps(), _CMP_LT_OQ);
+}
+
+template <Bool BOX>
+O3D_SIMD_TARGET_AVX2
+UInt32 cullAVX2(const PlaneTable &t, const CullArgs &a, UInt32 *visible, UInt8 *hints)
+{
+    UInt32 count = 0;
+    const __m256 zero = _mm256_setzero_ps();
+
+    // the hinted planes are selected by permutation of the 8 first entries
+    const __m256 tnx = _mm256_load_ps(t.nx), tny = _mm256_load_ps(t.ny), tnz = _mm256_load_ps(t.nz);
+    const __m256 td = _mm256_load_ps(t.d);
+    const __m256 tax = _mm256_load_ps(t.ax), tay = _mm256_load_ps(t.ay), taz = _mm256_load_ps(t.az);
+    const __m256i seven = _mm256_set1_epi32(7);
+
+    for (UInt32 base = 0; base < a.n; base += 32) {
+        const UInt32 last = o3d::min(a.n, base + 32);
+        UInt32 bits = 0;
+
+        UInt32 i = base;
+        for (; i + 8 <= last; i += 8) {
+            const __m256 x = _mm256_loadu_ps(a.x + i);
+            const __m256 y = _mm256_loadu_ps(a.y + i);
+            const __m256 z = _mm256_loadu_ps(a.z + i);
+
+            const __m256 r = BOX ? zero : _mm256_loadu_ps(a.r + i);
+            const __m256 hx = BOX ? _mm256_loadu_ps(a.hx + i) : zero;
+            const __m256 hy = BOX ? _mm256_loadu_ps(a.hy + i) : zero;
+            const __m256 hz = BOX ? _mm256_loadu_ps(a.hz + i) : zero;
+
+            __m256 out = zero;
+            __m256i h = _mm256_setzero_si256();
+
+            if (hints) {
+                h = _mm256_and_si256(_mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(hints + i))), seven);
+
+                out = outsideAVX2<BOX>(
+                          _mm256_permutevar8x32_ps(tnx, h), _mm256_permutevar8x32_ps(tny, h),
+                          _mm256_permutevar8x32_ps(tnz, h), _mm256_permutevar8x32_ps(td, h),
+                          _mm256_permutevar8x32_ps(tax, h), _mm256_permutevar8x32_ps(tay, h),
+                          _mm256_permutevar8x32_ps(taz, h),
+                          x, y, z, r, hx, hy, hz);
+            }
+
+            if (_mm256_movemask_ps(out) != 0xff) {
+                for (UInt32 p = 0; p < t.numPlanes; ++p) {
+                    const __m256 outPlane = outsideAVX2<BOX>(
+                                                _mm256_set1_ps(t.nx[p]), _mm256_set1_ps(t.ny[p]),
+                                                _mm256_set1_ps(t.nz[p]), _mm256_set1_ps(t.d[p]),
+                                                _mm256_set1_ps(t.ax[p]), _mm256_set1_ps(t.ay[p]),
+                                                _mm256_set1_ps(t.az[p]),
+                                                x, y, z, r, hx, hy, hz);
+
+                    // first rejecting plane of each object
+                    const __m256 newly = _mm256_andnot_ps(out, outPlane);
+                    h = _mm256_blendv_epi8(h, _mm256_set1_epi32((Int32)p), _mm256_castps_si256(newly));
+
+                    out = _mm256_or_ps(out, outPlane);
+                    if (_mm256_movemask_ps(out) == 0xff) {
+                        break;
+                    }
+                }
+
+                if (hints) {
+                    const __m128i h16 = _mm_packus_epi32(_mm256_castsi256_si128(h), _mm256_extracti128_si256(h, 1));
+                    _mm_storel_epi64((__m128i*)(hints + i), _mm_packus_epi16(h16, h16));
+                }
+            }
+
+            bits |= (UInt32)(~_mm256_movemask_ps(out) & 0xff) << (i - base);
+        }
+
+        for (; i < last; ++i) {
+            bits |= visibleOne<BOX>(t, a, i, hints) << (i - base);
+        }
+
+        visible[base >> 5] = bits;
+        count += bitCount(bits);
+    }
+
+    return count;
+}
+
+//---------------------------------------------------------------------------------------
+// AVX-512, 16 objects per iteration
+//---------------------------------------------------------------------------------------
+
+template <Bool BOX>
+O3D_SIMD_TARGET_AVX512
+inline __mmask16 outsideAVX512(
+        __m512 nx, __m512 ny, __m512 nz, __m512 d,
+        __m512 ax, __m512 ay, __m512 az,
+        __m512 x, __m512 y, __m512 z,
+        __m512 r, __m512 hx, __m512 hy, __m512 hz)
+{
+    const __m512 dist = _mm512_fmadd_ps(nz, z, _mm512_fmadd_ps(ny, y, _mm512_fmadd_ps(nx, x, d)));
+    const __m512 radius = BOX ?
+            _mm512_fmadd_ps(az, hz, _mm512_fmadd_ps(ay, hy, _mm512_mul_ps(ax, hx))) : r;
+
+    return _mm512_cmp_ps_mask(_mm512_add_ps(dist, radius), _mm512_setzero_ps(), _CMP_LT_OQ);
+}
+
+template <Bool BOX>
+O3D_SIMD_TARGET_AVX512
+UInt32 cullAVX512(const PlaneTable &t, const CullArgs &a, UInt32 *visible, UInt8 *hints)
+{
+    UInt32 count = 0;
+    const __m512 zero = _mm512_setzero_ps();
+
+    const __m512 tnx = _mm512_load_ps(t.nx), tny = _mm512_load_ps(t.ny), tnz = _mm512_load_ps(t.nz);
+    const __m512 td = _mm512_load_ps(t.d);
+    const __m512 tax = _mm512_load_ps(t.ax), tay = _mm512_load_ps(t.ay), taz = _mm512_load_ps(t.az);
+    const __m512i fifteen = _mm512_set1_epi32(15);
+
+    for (UInt32 base = 0; base < a.n; base += 32) {
+        const UInt32 last = o3d::min(a.n, base + 32);
+        UInt32 bits = 0;
+
+        UInt32 i = base;
+        for (; i + 16 <= last; i += 16) {
+            const __m512 x = _mm512_loadu_ps(a.x + i);
+            const __m512 y = _mm512_loadu_ps(a.y + i);
+            const __m512 z = _mm512_loadu_ps(a.z + i);
+
+            const __m512 r = BOX ? zero : _mm512_loadu_ps(a.r + i);
+            const __m512 hx = BOX ? _mm512_loadu_ps(a.hx + i) : zero;
+            const __m512 hy = BOX ? _mm512_loadu_ps(a.hy + i) : zero;
+            const __m512 hz = BOX ? _mm512_loadu_ps(a.hz + i) : zero;
+
+            __mmask16 out = 0;
+            __m512i h = _mm512_setzero_si512();
+
+            if (hints) {
+                h = _mm512_and_si512(_mm512_cvtepu8_epi32(_mm_loadu_si128((const __m128i*)(hints + i))), fifteen);
+
+                out = outsideAVX512<BOX>(
+                          _mm512_permutexvar_ps(h, tnx), _mm512_permutexvar_ps(h, tny),
+                          _mm512_permutexvar_ps(h, tnz), _mm512_permutexvar_ps(h, td),
+                          _mm512_permutexvar_ps(h, tax), _mm512_permutexvar_ps(h, tay),
+                          _mm512_permutexvar_ps(h, taz),
+                          x, y, z, r, hx, hy, hz);
+            }
+
+            if (out != 0xffff) {
+                for (UInt32 p = 0; p < t.numPlanes; ++p) {
+                    const __mmask16 outPlane = outsideAVX512<BOX>(
+                                                   _mm512_set1_ps(t.nx[p]), _mm512_set1_ps(t.ny[p]),
+                                                   _mm512_set1_ps(t.nz[p]), _mm512_set1_ps(t.d[p]),
+                                                   _mm512_set1_ps(t.ax[p]), _mm512_set1_ps(t.ay[p]),
+                                                   _mm512_set1_ps(t.az[p]),
+                                                   x, y, z, r, hx, hy, hz);
+
+                    // first rejecting plane of each object
+                    h = _mm512_mask_mov_epi32(h, outPlane & ~out, _mm512_set1_epi32((Int32)p));
+
+                    out |= outPlane;
+                    if (out == 0xffff) {
+                        break;
+                    }
+                }
+
+                if (hints) {
+                    _mm_storeu_si128((__m128i*)(hints + i), _mm512_cvtepi32_epi8(h));
+                }
+            }
+
+            bits |= (UInt32)(~out & 0xffff) << (i - base);
+        }
+
+        for (; i < last; ++i) {
+            bits |= visibleOne<BOX>(t, a, i, hints) << (i - base);
+        }
+
+        visible[base >> 5] = bits;
+        count += bitCount(bits);
+    }
+
+    return count;
+}
+
+#endif // O3D_SIMD_X86
+
+} // anonymous namespace
+
+UInt32 Frustum::cull(
+        UInt32 numPlanes,
+        const SphereArray *spheres,
+        const BoxArray *boxes,
+        UInt32 n,
+        UInt32 *visible,
+        UInt8 *hints) const
+{
+    static const CullFunc sphereFunc = SimdKernel<CullFunc>(cullScalar<False>)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, cullSSE2<False>)
+            .add(SIMD_AVX2, cullAVX2<False>)
+            .add(SIMD_AVX512, cullAVX512<False>)
+#endif
+            .get();
+
+    static const CullFunc boxFunc = SimdKernel<CullFunc>(cullScalar<True>)
+#ifdef O3D_SIMD_X86
+            .add(SIMD_SSE2, cullSSE2<True>)
+            .add(SIMD_AVX2, cullAVX2<True>)
+            .add(SIMD_AVX512, cullAVX512<True>)
+#endif
+            .get();
+
+    if (n == 0) {
+        return 0;
+    }
+
+    PlaneTable t;
+    t.numPlanes = numPlanes;
+
+    for (UInt32 p = 0; p < 16; ++p) {
+        if (p < numPlanes) {
+            const Vector3 &normal = m_planes[p].getNormal();
+
+            t.nx[p] = normal.x();
+            t.ny[p] = normal.y();
+            t.nz[p] = normal.z();
+            t.d[p] = m_planes[p] * Vector3();  // d, the equation at the origin
+        } else {
+            t.nx[p] = t.ny[p] = t.nz[p] = 0.f;
+            t.d[p] = Limits<Float>::max();
+        }
+
+        t.ax[p] = o3d::abs(t.nx[p]);
+        t.ay[p] = o3d::abs(t.ny[p]);
+        t.az[p] = o3d::abs(t.nz[p]);
+    }
+
+    CullArgs a;
+    a.n = n;
+
+    if (spheres) {
+        a.x = spheres->x;
+        a.y = spheres->y;
+        a.z = spheres->z;
+        a.r = spheres->radius;
+        a.hx = a.hy = a.hz = nullptr;
+
+        return sphereFunc(t, a, visible, hints);
+    } else {
+        a.x = boxes->x;
+        a.y = boxes->y;
+        a.z = boxes->z;
+        a.r = nullptr;
+        a.hx = boxes->halfX;
+        a.hy = boxes->halfY;
+        a.hz = boxes->halfZ;
+
+        return boxFunc(t, a, visible, hints);
+    }
+}
+
+UInt32 Frustum::spheresInFrustum(
+        const SphereArray &spheres,
+        UInt32 n,
+        UInt32 *visible,
+        UInt8 *hints) const
+{
+    return cull(6, &spheres, nullptr, n, visible, hints);
+}
+
+UInt32 Frustum::spheresInFrustumLight(
+        const SphereArray &spheres,
+        UInt32 n,
+        UInt32 *visible,
+        UInt8 *hints) const
+{
+    return cull(4, &spheres, nullptr, n, visible, hints);
+}
+
+UInt32 Frustum::boxesInFrustum(
+        const BoxArray &boxes,
+        UInt32 n,
+        UInt32 *visible,
+        UInt8 *hints) const
+{
+    return cull(6, nullptr, &boxes, n, visible, hints);
+}
+
+UInt32 Frustum::boxesInFrustumLight(
+        const BoxArray &boxes,
+        UInt32 n,
+        UInt32 *visible,
+        UInt8 *hints) const
+{
+    return cull(4, nullptr, &boxes, n, visible, hints);
+}
+
+UInt32 Frustum::compactVisible(const UInt32 *visible, UInt32 n, UInt32 *indices)
+{
+    UInt32 count = 0;
+
+    for (UInt32 base = 0; base < n; base += 32) {
+        UInt32 bits = visible[base >> 5];
+
+        // lowest set bit first
+        while (bits) {
+            const UInt32 low = bits & (0u - bits);
+            indices[count++] = base + bitCount(low - 1);
+            bits ^= low;
+        }
+    }
+
+    return count;
+}
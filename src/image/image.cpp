@@ -11,6 +11,7 @@
 #include "o3d/image/image.h"
 
 #include "o3d/image/imgformat.h"
+#include "o3d/image/pixelconvert.h"
 #include "o3d/core/filemanager.h"
 #include "o3d/core/resourcemanager.h"
 
@@ -1153,17 +1154,7 @@ Bool Image::convertRGBtoRGBA8()
 
 	if (m_pixelFormat == PF_RGB_8)
 	{
-		UInt8 *src = m_data->data;
-
-		for ( i = 0 ; i < m_size ; i += 4 )
-		{
-			data[i  ] = src[j];
-			data[i+1] = src[j+1];
-			data[i+2] = src[j+2];
-			data[i+3] = 255;
-
-			j += 3;
-		}
+		PixelConvert::rgbToRgba(m_data->data, data, m_width * m_height);
 	}
 	else if (m_pixelFormat == PF_RGB_F32)
 	{
@@ -1285,16 +1276,7 @@ Bool Image::convertRGBAtoRGB8()
 
 	if (m_pixelFormat == PF_RGBA_8)
 	{
-		UInt8 *src = m_data->data;
-
-		for ( i = 0 ; i < m_size ; i += 3 )
-		{
-			data[i  ] = src[j];
-			data[i+1] = src[j+1];
-			data[i+2] = src[j+2];
-
-			j += 4;
-		}
+		PixelConvert::rgbaToRgb(m_data->data, data, m_width * m_height);
 	}
 	else if (m_pixelFormat == PF_RGBA_F32)
 	{
@@ -1365,17 +1347,13 @@ Bool Image::swapRB()
 
 	UInt32 numComp = getNumComponents();
 
-	if ((m_pixelFormat == PF_RGB_8) || (m_pixelFormat == PF_RGBA_8))
+	if (m_pixelFormat == PF_RGB_8)
 	{
-		UInt8 *data = m_data->data;
-		UInt8 buf;
-
-		for (UInt32 i = 0 ; i < m_size ; i += numComp)
-		{
-			buf = data[i];
-			data[i] = data[i+2];
-			data[i+2] = buf;
-		}
+		PixelConvert::swapRBRgb(m_data->data, m_size / 3);
+	}
+	else if (m_pixelFormat == PF_RGBA_8)
+	{
+		PixelConvert::swapRBRgba(m_data->data, m_size / 4);
 	}
 	else if ((m_pixelFormat == PF_RGB_F32) || (m_pixelFormat == PF_RGBA_F32))
 	{
@@ -0,0 +1,295 @@
+/**
+ * @file pixelconvert.cpp
+ * @brief Implementation of PixelConvert.h
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details
+ */
+
+#include "o3d/image/precompiled.h"
+#include "o3d/image/pixelconvert.h"
+
+#include "o3d/core/cpudispatch.h"
+
+#ifdef O3D_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+using namespace o3d;
+
+typedef void (*ConvertFunc)(const UInt8 *src, UInt8 *dst, UInt32 numPixels);
+typedef void (*SwapFunc)(UInt8 *data, UInt32 numPixels);
+
+namespace {
+
+//---------------------------------------------------------------------------------------
+// Scalar
+//---------------------------------------------------------------------------------------
+
+void rgbToRgbaScalar(const UInt8 *src, UInt8 *dst, UInt32 numPixels)
+{
+    for (UInt32 i = 0; i < numPixels; ++i) {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+        dst[3] = 255;
+
+        src += 3;
+        dst += 4;
+    }
+}
+
+void rgbaToRgbScalar(const UInt8 *src, UInt8 *dst, UInt32 numPixels)
+{
+    for (UInt32 i = 0; i < numPixels; ++i) {
+        dst[0] = src[0];
+        dst[1] = src[1];
+        dst[2] = src[2];
+
+        src += 4;
+        dst += 3;
+    }
+}
+
+template <UInt32 N>
+void swapRBScalar(UInt8 *data, UInt32 numPixels)
+{
+    for (UInt32 i = 0; i < numPixels; ++i) {
+        const UInt8 r = data[0];
+        data[0] = data[2];
+        data[2] = r;
+
+        data += N;
+    }
+}
+
+#ifdef O3D_SIMD_X86
+
+//---------------------------------------------------------------------------------------
+// SSSE3, 16 pixels per iteration
+//---------------------------------------------------------------------------------------
+
+O3D_SIMD_TARGET_SSSE3
+void rgbToRgbaSSSE3(const UInt8 *src, UInt8 *dst, UInt32 numPixels)
+{
+    const __m128i expand = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m128i alpha = _mm_set1_epi32((Int32)0xff000000);
+
+    UInt32 i = 0;
+    for (; i + 16 <= numPixels; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 32));
+
+        // 4 pixels at the beginning of each register
+        const __m128i v0 = a;
+        const __m128i v1 = _mm_alignr_epi8(b, a, 12);
+        const __m128i v2 = _mm_alignr_epi8(c, b, 8);
+        const __m128i v3 = _mm_srli_si128(c, 4);
+
+        __m128i *out = reinterpret_cast<__m128i*>(dst);
+        _mm_storeu_si128(out, _mm_or_si128(_mm_shuffle_epi8(v0, expand), alpha));
+        _mm_storeu_si128(out + 1, _mm_or_si128(_mm_shuffle_epi8(v1, expand), alpha));
+        _mm_storeu_si128(out + 2, _mm_or_si128(_mm_shuffle_epi8(v2, expand), alpha));
+        _mm_storeu_si128(out + 3, _mm_or_si128(_mm_shuffle_epi8(v3, expand), alpha));
+
+        src += 48;
+        dst += 64;
+    }
+
+    rgbToRgbaScalar(src, dst, numPixels - i);
+}
+
+//! Pack four registers of 4 RGB pixels, at their beginning, into three registers.
+O3D_SIMD_TARGET_SSSE3
+inline void storeRgb16(UInt8 *dst, __m128i s0, __m128i s1, __m128i s2, __m128i s3)
+{
+    __m128i *out = reinterpret_cast<__m128i*>(dst);
+    _mm_storeu_si128(out, _mm_or_si128(s0, _mm_slli_si128(s1, 12)));
+    _mm_storeu_si128(out + 1, _mm_or_si128(_mm_srli_si128(s1, 4), _mm_slli_si128(s2, 8)));
+    _mm_storeu_si128(out + 2, _mm_or_si128(_mm_srli_si128(s2, 8), _mm_slli_si128(s3, 4)));
+}
+
+O3D_SIMD_TARGET_SSSE3
+void rgbaToRgbSSSE3(const UInt8 *src, UInt8 *dst, UInt32 numPixels)
+{
+    const __m128i pack = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+    UInt32 i = 0;
+    for (; i + 16 <= numPixels; i += 16) {
+        const __m128i *in = reinterpret_cast<const __m128i*>(src);
+
+        storeRgb16(dst,
+                   _mm_shuffle_epi8(_mm_loadu_si128(in), pack),
+                   _mm_shuffle_epi8(_mm_loadu_si128(in + 1), pack),
+                   _mm_shuffle_epi8(_mm_loadu_si128(in + 2), pack),
+                   _mm_shuffle_epi8(_mm_loadu_si128(in + 3), pack));
+
+        src += 64;
+        dst += 48;
+    }
+
+    rgbaToRgbScalar(src, dst, numPixels - i);
+}
+
+O3D_SIMD_TARGET_SSSE3
+void swapRBRgbSSSE3(UInt8 *data, UInt32 numPixels)
+{
+    const __m128i swap = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, -1, -1, -1, -1);
+
+    UInt32 i = 0;
+    for (; i + 16 <= numPixels; i += 16) {
+        const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data));
+        const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16));
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32));
+
+        storeRgb16(data,
+                   _mm_shuffle_epi8(a, swap),
+                   _mm_shuffle_epi8(_mm_alignr_epi8(b, a, 12), swap),
+                   _mm_shuffle_epi8(_mm_alignr_epi8(c, b, 8), swap),
+                   _mm_shuffle_epi8(_mm_srli_si128(c, 4), swap));
+
+        data += 48;
+    }
+
+    swapRBScalar<3>(data, numPixels - i);
+}
+
+O3D_SIMD_TARGET_SSSE3
+void swapRBRgbaSSSE3(UInt8 *data, UInt32 numPixels)
+{
+    const __m128i swap = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    UInt32 i = 0;
+    for (; i + 4 <= numPixels; i += 4) {
+        __m128i *p = reinterpret_cast<__m128i*>(data);
+        _mm_storeu_si128(p, _mm_shuffle_epi8(_mm_loadu_si128(p), swap));
+
+        data += 16;
+    }
+
+    swapRBScalar<4>(data, numPixels - i);
+}
+
+//---------------------------------------------------------------------------------------
+// AVX2, 8 pixels per iteration
+//---------------------------------------------------------------------------------------
+
+O3D_SIMD_TARGET_AVX2
+void rgbToRgbaAVX2(const UInt8 *src, UInt8 *dst, UInt32 numPixels)
+{
+    // 4 pixels at the beginning of each lane
+    const __m256i spread = _mm256_setr_epi32(0, 1, 2, 3, 3, 4, 5, 6);
+    const __m256i expand = _mm256_setr_epi8(
+                0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+                0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+    const __m256i alpha = _mm256_set1_epi32((Int32)0xff000000);
+
+    // the 32 bytes loads read 8 bytes after the 8 pixels
+    UInt32 i = 0;
+    for (; i + 11 <= numPixels; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        v = _mm256_permutevar8x32_epi32(v, spread);
+        v = _mm256_or_si256(_mm256_shuffle_epi8(v, expand), alpha);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), v);
+
+        src += 24;
+        dst += 32;
+    }
+
+    rgbToRgbaScalar(src, dst, numPixels - i);
+}
+
+O3D_SIMD_TARGET_AVX2
+void rgbaToRgbAVX2(const UInt8 *src, UInt8 *dst, UInt32 numPixels)
+{
+    const __m256i pack = _mm256_setr_epi8(
+                0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+                0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+    const __m256i gather = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 7, 7);
+
+    UInt32 i = 0;
+    for (; i + 8 <= numPixels; i += 8) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src));
+        v = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(v, pack), gather);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(v));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(dst + 16), _mm256_extracti128_si256(v, 1));
+
+        src += 32;
+        dst += 24;
+    }
+
+    rgbaToRgbScalar(src, dst, numPixels - i);
+}
+
+O3D_SIMD_TARGET_AVX2
+void swapRBRgbaAVX2(UInt8 *data, UInt32 numPixels)
+{
+    const __m256i swap = _mm256_setr_epi8(
+                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+                2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+    UInt32 i = 0;
+    for (; i + 8 <= numPixels; i += 8) {
+        __m256i *p = reinterpret_cast<__m256i*>(data);
+        _mm256_storeu_si256(p, _mm256_shuffle_epi8(_mm256_loadu_si256(p), swap));
+
+        data += 32;
+    }
+
+    swapRBScalar<4>(data, numPixels - i);
+}
+
+#endif // O3D_SIMD_X86
+
+} // anonymous namespace
+
+void PixelConvert::rgbToRgba(const UInt8 *src, UInt8 *dst, UInt32 numPixels)
+{
+    static const ConvertFunc func = SimdKernel<ConvertFunc>(rgbToRgbaScalar)
+        #ifdef O3D_SIMD_X86
+            .add(SIMD_SSSE3, rgbToRgbaSSSE3)
+            .add(SIMD_AVX2, rgbToRgbaAVX2)
+        #endif
+            .get();
+
+    func(src, dst, numPixels);
+}
+
+void PixelConvert::rgbaToRgb(const UInt8 *src, UInt8 *dst, UInt32 numPixels)
+{
+    static const ConvertFunc func = SimdKernel<ConvertFunc>(rgbaToRgbScalar)
+        #ifdef O3D_SIMD_X86
+            .add(SIMD_SSSE3, rgbaToRgbSSSE3)
+            .add(SIMD_AVX2, rgbaToRgbAVX2)
+        #endif
+            .get();
+
+    func(src, dst, numPixels);
+}
+
+void PixelConvert::swapRBRgb(UInt8 *data, UInt32 numPixels)
+{
+    static const SwapFunc func = SimdKernel<SwapFunc>(swapRBScalar<3>)
+        #ifdef O3D_SIMD_X86
+            .add(SIMD_SSSE3, swapRBRgbSSSE3)
+        #endif
+            .get();
+
+    func(data, numPixels);
+}
+
+void PixelConvert::swapRBRgba(UInt8 *data, UInt32 numPixels)
+{
+    static const SwapFunc func = SimdKernel<SwapFunc>(swapRBScalar<4>)
+        #ifdef O3D_SIMD_X86
+            .add(SIMD_SSSE3, swapRBRgbaSSSE3)
+            .add(SIMD_AVX2, swapRBRgbaAVX2)
+        #endif
+            .get();
+
+    func(data, numPixels);
+}
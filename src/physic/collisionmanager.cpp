@@ -20,6 +20,9 @@ CollisionManager::CollisionManager()
 
 CollisionManager::~CollisionManager()
 {
+    for (IT_CollisionList it = m_collisionList.begin() ; it != m_collisionList.end() ; ++it) {
+        m_collisionPool.destroy(*it);
+    }
 }
 
 // add a collision beetween two body
@@ -29,16 +32,7 @@ void CollisionManager::addCollision(
         Vector3 edgeA, Vector3 edgeB,
         Bool isVertexFace)
 {
-    Collision* pCollision = nullptr;
-
-    if (m_garbageCollector.empty()) {
-		// create a new collision
-		pCollision = new Collision;
-    } else {
-		// get it from the garbage collector
-        pCollision = m_garbageCollector.front();
-        m_garbageCollector.pop_front();
-	}
+    Collision* pCollision = m_collisionPool.create();
 
 	// init the collision
     pCollision->setBodyA(rigidBody1);
@@ -123,7 +117,7 @@ void CollisionManager::resolveCollisions()
 		pCollision->resolve();
 
 		// re-cycle the collision
-        m_garbageCollector.push_back(pCollision);
+        m_collisionPool.destroy(pCollision);
 	}
 
     m_collisionList.clear();
@@ -0,0 +1,119 @@
+/**
+ * @file o3dpack.cpp
+ * @brief Command line packer of ChunkPack files.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : o3dpack [-c chunk-size-kb] [-l level] output input...
+ * The content of an input directory is added recursively at the root of the pack, and
+ * an input file is added at the root of the pack.
+ */
+
+#include <o3d/core/chunkpack.h>
+#include <o3d/core/fileinstream.h>
+#include <o3d/core/fileoutstream.h>
+#include <o3d/core/filelisting.h>
+#include <o3d/core/localfile.h>
+#include <o3d/core/error.h>
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+
+using namespace o3d;
+
+static void usage()
+{
+    std::cerr << "Usage : o3dpack [-c chunk-size-kb] [-l level] output input..." << std::endl
+              << "  -c  Uncompressed size of the chunks in KB (default 64)" << std::endl
+              << "  -l  zlib compression level from 0 to 9 (default 6)" << std::endl;
+}
+
+static void addFile(ChunkPackWriter &writer, const String &filename, const String &name)
+{
+    FileInStream is(filename);
+    writer.addFile(name, is);
+
+    std::cout << "  " << name.toUtf8().getData() << std::endl;
+}
+
+static void addDirectory(ChunkPackWriter &writer, const String &path, const String &prefix)
+{
+    FileListing listing;
+    listing.setPath(path);
+    listing.setType(FILE_BOTH);
+    listing.searchFirstFile();
+
+    FLItem *item;
+    while ((item = listing.searchNextFile()) != nullptr) {
+        if ((item->FileName == ".") || (item->FileName == "..")) {
+            continue;
+        }
+
+        const String name = prefix.isEmpty() ? item->FileName : prefix + '/' + item->FileName;
+
+        if (item->FileType == FILE_DIR) {
+            writer.addDirectory(name);
+            addDirectory(writer, path + '/' + item->FileName, name);
+        } else {
+            addFile(writer, path + '/' + item->FileName, name);
+        }
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    UInt32 chunkSize = ChunkPack::DEFAULT_CHUNK_SIZE;
+    Int32 level = 6;
+    Int32 arg = 1;
+
+    for (; arg < argc && argv[arg][0] == '-'; ++arg) {
+        if (!strcmp(argv[arg], "-c") && arg + 1 < argc) {
+            chunkSize = (UInt32)atoi(argv[++arg]) * 1024;
+        } else if (!strcmp(argv[arg], "-l") && arg + 1 < argc) {
+            level = atoi(argv[++arg]);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (argc - arg < 2) {
+        usage();
+        return 1;
+    }
+
+    try {
+        ChunkPackWriter writer(new FileOutStream(argv[arg], FileOutStream::CREATE), chunkSize, level);
+
+        for (Int32 i = arg + 1; i < argc; ++i) {
+            String input;
+            input.fromUtf8(argv[i]);
+            input.replace('\\', '/');
+            input.trimRight('/', True);
+
+            LocalFile file(input);
+            if (file.getType() == FILE_DIR) {
+                addDirectory(writer, input, "");
+            } else {
+                addFile(writer, input, file.getFileName());
+            }
+        }
+
+        writer.finish();
+
+        const UInt64 size = writer.getUncompressedSize();
+        const UInt64 packed = writer.getCompressedSize();
+
+        std::cout << argv[arg] << " : " << size << " bytes packed into " << packed << " bytes";
+        if (size > 0) {
+            std::cout << " (" << (100 * packed / size) << "%)";
+        }
+        std::cout << std::endl;
+    } catch (E_BaseException &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
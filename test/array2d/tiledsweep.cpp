@@ -0,0 +1,277 @@
+/**
+ * @file tiledsweep.cpp
+ * @brief Benchmark of directional sweeps on row major and tiled 2D arrays.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : tiledsweep [size]
+ * Check TiledArray2D against TemplateArray2D (conversions, accessors and iterators),
+ * then compute the shadows of a random heightmap of size x size (4096 by default) for
+ * a light in several directions, like GenLightMap::buildShadowmapInfiniteLight, with
+ * both layouts, and report the time of each sweep and of the rows and columns walks.
+ */
+
+#include <o3d/core/templatearray2d.h>
+#include <o3d/core/tiledarray2d.h>
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <cmath>
+#include <cstdlib>
+
+using namespace o3d;
+
+static UInt32 errors = 0;
+
+//! Best of 3 runs, in milliseconds.
+template <class F>
+static Double measure(F f)
+{
+    Double best = 1e9;
+
+    for (Int32 round = 0; round < 3; ++round) {
+        auto start = std::chrono::steady_clock::now();
+        f();
+        best = o3d::min(best, std::chrono::duration<Double>(std::chrono::steady_clock::now() - start).count() * 1e3);
+    }
+
+    return best;
+}
+
+/**
+ * Shadows of a heightmap for a light coming from the direction angle (radians) in the
+ * plane with a slope of dz per unit of distance. Each ray walks the grid along the
+ * major axis of the direction, the minor coordinate in 16.16 fixed point, keeping the
+ * highest horizon seen so far.
+ */
+template <class A>
+static void sweep(const A &height, A &shadow, Double angle, Float dz)
+{
+    const Int32 w = height.width();
+    const Int32 h = height.height();
+
+    Double dx = std::cos(angle), dy = std::sin(angle);
+    const Bool horizontal = std::abs(dx) >= std::abs(dy);
+
+    // steps along the major axis, from the light
+    const Int32 major = horizontal ? w : h;
+    const Int32 minor = horizontal ? h : w;
+    const Bool reverse = horizontal ? dx < 0 : dy < 0;
+    const Double slope = horizontal ? dy / std::abs(dx) : dx / std::abs(dy);
+    const Float decay = dz * Float(std::sqrt(1.0 + slope * slope));
+
+    const Int32 step = Int32(slope * 65536.0);
+    const Int32 drift = Int32(std::ceil(std::abs(slope) * major));
+
+    // rays starting before the grid on the minor axis reach it along the way
+    for (Int32 r = -drift; r < minor + drift; ++r) {
+        Int32 fixed = (r << 16) + 32768;
+        Float horizon = -1e30f;
+
+        for (Int32 m = 0; m < major; ++m, fixed += step) {
+            const Int32 n = fixed >> 16;
+            if (n < 0 || n >= minor) {
+                continue;
+            }
+
+            const Int32 k = reverse ? major - 1 - m : m;
+            const Int32 i = horizontal ? k : n;
+            const Int32 j = horizontal ? n : k;
+
+            const Float v = height(i, j);
+            horizon -= decay;
+
+            if (v >= horizon) {
+                horizon = v;
+                shadow(i, j) = 1.f;
+            } else {
+                shadow(i, j) = 0.f;
+            }
+        }
+    }
+}
+
+static void checkTiled(Int32 w, Int32 h, std::mt19937 &rnd)
+{
+    Array2DInt32 array(w, h);
+    for (Int32 k = 0; k < w * h; ++k) {
+        array[k] = Int32(rnd());
+    }
+
+    const TiledArray2DInt32 tiled(array);
+
+    Array2DInt32 back;
+    tiled.toArray2D(back);
+
+    // unsigned sums, wrapping around
+    UInt32 rowSum = 0, tiledRowSum = 0, colSum = 0, tiledColSum = 0;
+
+    for (Int32 j = 0; j < h; ++j) {
+        for (Int32 i = 0; i < w; ++i) {
+            if (tiled(i, j) != array(i, j) || back(i, j) != array(i, j)) {
+                std::cerr << "tiled " << w << "x" << h << ": different element " << i << "," << j << std::endl;
+                ++errors;
+                return;
+            }
+
+            rowSum += UInt32(array(i, j)) * UInt32(i + 1);
+            colSum += UInt32(array(i, j)) * UInt32(j + 1);
+        }
+    }
+
+    // the iterators from the start and from the middle of the lines
+    for (Int32 j = 0; j < h; ++j) {
+        for (TiledArray2DInt32::ConstLineIt it = tiled.rowBegin(j); it != tiled.rowEnd(j); ++it) {
+            tiledRowSum += UInt32(*it) * UInt32(it.pos() + 1);
+        }
+    }
+
+    for (Int32 i = 0; i < w; ++i) {
+        for (TiledArray2DInt32::ConstLineIt it = tiled.columnBegin(i); it != tiled.columnEnd(i); ++it) {
+            tiledColSum += UInt32(*it) * UInt32(it.pos() + 1);
+        }
+    }
+
+    UInt32 partial = 0, tiledPartial = 0;
+    for (Int32 i = w / 3; i < w; ++i) {
+        partial += UInt32(array(i, h / 2));
+    }
+    for (TiledArray2DInt32::ConstLineIt it = tiled.rowBegin(h / 2, w / 3); it != tiled.rowEnd(h / 2); ++it) {
+        tiledPartial += UInt32(*it);
+    }
+
+    if (rowSum != tiledRowSum || colSum != tiledColSum || partial != tiledPartial) {
+        std::cerr << "tiled " << w << "x" << h << ": different iteration" << std::endl;
+        ++errors;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const Int32 size = argc > 1 ? atoi(argv[1]) : 4096;
+
+    std::mt19937 rnd(1234);
+
+    const Int32 sizes[][2] = { {1, 1}, {7, 9}, {8, 8}, {33, 17}, {64, 200} };
+    for (const Int32 *s : sizes) {
+        checkTiled(s[0], s[1], rnd);
+    }
+
+    // heightmap made of a few octaves of bumps
+    std::uniform_real_distribution<Float> unit(0.f, 1.f);
+    Array2DFloat height(size, size);
+
+    Float phase[8];
+    for (Int32 k = 0; k < 8; ++k) {
+        phase[k] = unit(rnd) * 6.28f;
+    }
+
+    for (Int32 j = 0; j < size; ++j) {
+        for (Int32 i = 0; i < size; ++i) {
+            Float v = 0.f;
+            for (Int32 k = 1; k <= 4; ++k) {
+                const Float f = 0.01f * Float(1 << k);
+                v += (std::sin(i * f + phase[k-1]) * std::cos(j * f * 0.7f + phase[k+3])) * 40.f / Float(1 << k);
+            }
+            height(i, j) = v + unit(rnd) * 0.5f;
+        }
+    }
+
+    Double convert = 0;
+    TiledArray2DFloat tiledHeight;
+    convert = measure([&] { tiledHeight.fromArray2D(height); });
+
+    std::cout << size << "x" << size << " floats, conversion to tiles " << std::fixed << std::setprecision(1)
+              << convert << " ms" << std::endl;
+
+    Array2DFloat shadow(size, size), back;
+    TiledArray2DFloat tiledShadow(size, size);
+
+    const Double angles[] = { 0.0, 30.0, 45.0, 80.0, 90.0, 135.0, 200.0, 270.0 };
+    for (Double degrees : angles) {
+        const Double angle = degrees * 3.14159265358979 / 180.0;
+
+        const Double rowMajor = measure([&] { sweep(height, shadow, angle, 0.3f); });
+        const Double tiled = measure([&] { sweep(tiledHeight, tiledShadow, angle, 0.3f); });
+
+        tiledShadow.toArray2D(back);
+        for (Int32 k = 0; k < size * size; ++k) {
+            if (back[k] != shadow[k]) {
+                std::cerr << "sweep " << degrees << ": different shadow at " << k << std::endl;
+                ++errors;
+                break;
+            }
+        }
+
+        std::cout << "  sweep " << std::setw(5) << std::setprecision(0) << degrees << " deg  row major "
+                  << std::setprecision(1) << std::setw(7) << rowMajor << " ms, tiled " << std::setw(7) << tiled
+                  << " ms, x" << std::setprecision(2) << rowMajor / tiled << std::endl;
+    }
+
+    // rows and columns walks
+    const TiledArray2DFloat &tiledSource = tiledHeight;
+    Float sum = 0.f, tiledSum = 0.f;
+
+    const Double rows = measure([&] {
+        sum = 0.f;
+        for (Int32 j = 0; j < size; ++j) {
+            const Float *p = height.getData() + j * size;
+            for (Int32 i = 0; i < size; ++i) {
+                sum += p[i];
+            }
+        }
+    });
+
+    const Double tiledRows = measure([&] {
+        tiledSum = 0.f;
+        for (Int32 j = 0; j < size; ++j) {
+            for (TiledArray2DFloat::ConstLineIt it = tiledSource.rowBegin(j); it != tiledSource.rowEnd(j); ++it) {
+                tiledSum += *it;
+            }
+        }
+    });
+
+    if (sum != tiledSum) {
+        std::cerr << "rows: different sum" << std::endl;
+        ++errors;
+    }
+
+    const Double columns = measure([&] {
+        sum = 0.f;
+        for (Int32 i = 0; i < size; ++i) {
+            const Float *p = height.getData() + i;
+            for (Int32 j = 0; j < size; ++j, p += size) {
+                sum += *p;
+            }
+        }
+    });
+
+    const Double tiledColumns = measure([&] {
+        tiledSum = 0.f;
+        for (Int32 i = 0; i < size; ++i) {
+            for (TiledArray2DFloat::ConstLineIt it = tiledSource.columnBegin(i); it != tiledSource.columnEnd(i); ++it) {
+                tiledSum += *it;
+            }
+        }
+    });
+
+    if (sum != tiledSum) {
+        std::cerr << "columns: different sum" << std::endl;
+        ++errors;
+    }
+
+    std::cout << "  rows          row major " << std::setprecision(1) << std::setw(7) << rows << " ms, tiled "
+              << std::setw(7) << tiledRows << " ms" << std::endl;
+    std::cout << "  columns       row major " << std::setw(7) << columns << " ms, tiled "
+              << std::setw(7) << tiledColumns << " ms" << std::endl;
+
+    if (errors) {
+        std::cerr << errors << " error(s)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "ok" << std::endl;
+    return 0;
+}
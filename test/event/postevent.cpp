@@ -0,0 +1,115 @@
+/**
+ * @file postevent.cpp
+ * @brief Micro-benchmark of EvtManager::postEvent with concurrent producers.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : postevent [num-producers] [events-per-producer]
+ * Each producer thread posts events to the main thread which drains them in batch,
+ * and the number of posts per second is reported.
+ */
+
+#include <o3d/core/evtfunction.h>
+#include <o3d/core/evtmanager.h>
+#include <o3d/core/thread.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace o3d;
+
+static std::atomic<UInt32> g_processed(0);
+
+//! Minimal event, only counting its processing.
+class CountEvent : public EvtFunctionAsyncBase
+{
+public:
+
+    CountEvent() : EvtFunctionAsyncBase() {}
+
+    virtual void process()
+    {
+        ++g_processed;
+    }
+};
+
+class Producer : public Runnable
+{
+public:
+
+    Producer(UInt32 numEvents) :
+        m_thread(this),
+        m_numEvents(numEvents)
+    {
+    }
+
+    virtual Int32 run(void *)
+    {
+        EvtManager *evtManager = EvtManager::instance();
+
+        for (UInt32 i = 0; i < m_numEvents; ++i) {
+            // null thread target the main thread
+            evtManager->postEvent(new CountEvent);
+        }
+
+        return 0;
+    }
+
+    Thread m_thread;
+    UInt32 m_numEvents;
+};
+
+int main(int argc, char *argv[])
+{
+    const UInt32 numProducers = argc > 1 ? (UInt32)atoi(argv[1]) : 4;
+    const UInt32 numEvents = argc > 2 ? (UInt32)atoi(argv[2]) : 250000;
+
+    ThreadManager::init();
+
+    EvtManager *evtManager = EvtManager::instance();
+    evtManager->disableAutoWakeUp();
+    evtManager->registerThread(nullptr);
+
+    std::vector<Producer*> producers;
+    for (UInt32 i = 0; i < numProducers; ++i) {
+        producers.push_back(new Producer(numEvents));
+    }
+
+    const UInt32 total = numProducers * numEvents;
+    UInt32 numBatches = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (Producer *producer : producers) {
+        producer->m_thread.start();
+    }
+
+    while (g_processed.load() < total) {
+        if (evtManager->processEvent() > 0) {
+            ++numBatches;
+        } else {
+            System::waitMs(0);
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    for (Producer *producer : producers) {
+        producer->m_thread.waitFinish();
+        delete producer;
+    }
+
+    const Double seconds = std::chrono::duration<Double>(end - start).count();
+
+    std::cout << numProducers << " producers, " << total << " events in " << seconds << "s : "
+              << UInt64(total / seconds) << " posts/s, "
+              << (numBatches > 0 ? total / numBatches : 0) << " events per batch" << std::endl;
+
+    evtManager->unRegisterThread(nullptr);
+    EvtManager::destroy();
+
+    return 0;
+}
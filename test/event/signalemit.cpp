@@ -0,0 +1,105 @@
+/**
+ * @file signalemit.cpp
+ * @brief Micro-benchmark of the synchronous Signal emission.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : signalemit [num-slots] [num-emits]
+ * Compare the emits per second of a signal with the previous emission path, which
+ * copied the callbacks array at each emit, and the current one.
+ */
+
+#include <o3d/core/evt.h>
+#include <o3d/core/thread.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace o3d;
+
+class Sender : public EvtHandler
+{
+public:
+
+    Sender() : EvtHandler() {}
+
+    //! Emission as done before, with a copy of the callbacks.
+    void emitCopy(Int32 value)
+    {
+        Signal<Int32>::T_FunctionArray callBacks;
+        onValue.mContainer.getCallBacks(callBacks);
+
+        for (Signal<Int32>::IT_FunctionArray it = callBacks.begin(); it != callBacks.end(); ++it) {
+            (*it)->call(value);
+        }
+    }
+
+public /*signals*/:
+
+    Signal<Int32> onValue{this};
+};
+
+class Receiver : public EvtHandler
+{
+public:
+
+    Receiver() : EvtHandler(), m_sum(0) {}
+
+    void valueChanged(Int32 value)
+    {
+        m_sum += value;
+    }
+
+    Int64 m_sum;
+};
+
+template <class FUNC>
+static Double measure(UInt32 numEmits, FUNC func)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    for (UInt32 i = 0; i < numEmits; ++i) {
+        func((Int32)i);
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    return numEmits / std::chrono::duration<Double>(end - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 numSlots = argc > 1 ? (UInt32)atoi(argv[1]) : 4;
+    const UInt32 numEmits = argc > 2 ? (UInt32)atoi(argv[2]) : 2000000;
+
+    ThreadManager::init();
+
+    Sender *sender = new Sender;
+    std::vector<Receiver*> receivers;
+
+    for (UInt32 i = 0; i < numSlots; ++i) {
+        Receiver *receiver = new Receiver;
+        sender->onValue.connect(receiver, &Receiver::valueChanged, EvtHandler::CONNECTION_SYNCH);
+        receivers.push_back(receiver);
+    }
+
+    const Double before = measure(numEmits, [sender] (Int32 value) { sender->emitCopy(value); });
+    const Double after = measure(numEmits, [sender] (Int32 value) { sender->onValue(value); });
+
+    std::cout << numSlots << " slots : " << UInt64(before) << " emits/s with a copy, "
+              << UInt64(after) << " emits/s with a snapshot (x" << after / before << ")" << std::endl;
+
+    for (Receiver *receiver : receivers) {
+        if (receiver->m_sum != 2 * (Int64(numEmits) * (numEmits - 1) / 2)) {
+            std::cerr << "Unexpected slot calls count" << std::endl;
+            return 1;
+        }
+
+        delete receiver;
+    }
+
+    delete sender;
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/**
+ * @file assetcache.cpp
+ * @brief Test of the AssetCache store, fetch, eviction, statistics and persistence.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : assetcache
+ * Fill a cache over its budget while keeping an entry used, check the evicted entries
+ * and the statistics, then reopen the cache and check its restored entries and uses.
+ */
+
+#include <o3d/core/filemanager.h>
+#include <o3d/core/assetcache.h>
+#include <o3d/core/localdir.h>
+
+#include <iostream>
+#include <vector>
+
+using namespace o3d;
+
+static const UInt32 NUM_ENTRIES = 10;
+static const UInt32 ENTRY_SIZE = 1000;
+
+// an entry file has a header of magic, version and size
+static const UInt64 ENTRY_FILE_SIZE = ENTRY_SIZE + 12;
+
+static UInt32 g_numErrors = 0;
+
+static void check(Bool cond, const char *what)
+{
+    if (!cond) {
+        std::cerr << "Failed : " << what << std::endl;
+        ++g_numErrors;
+    }
+}
+
+static String makeKey(UInt32 n, const UInt8 *data)
+{
+    AssetCache::Key key("assetcache test", 1);
+    key.addValue(n).addData(data, ENTRY_SIZE);
+
+    return key.getHex();
+}
+
+int main(int /*argc*/, char * /*argv*/[])
+{
+    // the cache directory is not the working directory
+    const String path = FileManager::instance()->getWorkingDirectory() + "/assetcache/entries";
+
+    std::vector<UInt8> content(ENTRY_SIZE);
+    for (UInt32 i = 0; i < ENTRY_SIZE; ++i) {
+        content[i] = (UInt8)(i * 7);
+    }
+
+    // keys
+    {
+        AssetCache::Key a("kind", 1), b("kind", 1), c("kind", 2), d("other", 1);
+        a.addValue(5);
+        b.addValue(5);
+        c.addValue(5);
+        d.addValue(5);
+
+        check(a.getHex() == b.getHex(), "same key for the same data");
+        check(a.getHex() != c.getHex(), "the version changes the key");
+        check(a.getHex() != d.getHex(), "the kind changes the key");
+    }
+
+    std::vector<String> keys;
+    for (UInt32 n = 0; n < NUM_ENTRIES; ++n) {
+        keys.push_back(makeKey(n, content.data()));
+    }
+
+    {
+        // room for 4 entries
+        AssetCache cache(path, ENTRY_FILE_SIZE * 4 + 100);
+        cache.clear();
+        cache.resetStats();
+
+        SmartArrayUInt8 data;
+        check(!cache.fetch(keys[0], data), "fetch of a missing entry");
+
+        // the first entry is used after each store, and is never evicted
+        for (UInt32 n = 0; n < NUM_ENTRIES; ++n) {
+            content[0] = (UInt8)n;
+            check(cache.store(keys[n], content.data(), ENTRY_SIZE), "store");
+            check(cache.fetch(keys[0], data), "fetch of the used entry");
+        }
+
+        check(data.getNumElt() == ENTRY_SIZE && data[0] == 0 && data[ENTRY_SIZE-1] == content[ENTRY_SIZE-1],
+              "fetched content");
+
+        check(cache.contains(keys[0]), "used entry kept");
+        check(!cache.contains(keys[1]), "least recently used entry evicted");
+        check(cache.contains(keys[NUM_ENTRIES-1]), "last stored entry kept");
+
+        AssetCache::Stats stats = cache.getStats();
+        check(stats.stores == NUM_ENTRIES, "stores count");
+        check(stats.hits == NUM_ENTRIES && stats.misses == 1, "hits and misses count");
+        check(stats.numEntries + stats.evictions == NUM_ENTRIES, "evictions count");
+        check(stats.size == stats.numEntries * ENTRY_FILE_SIZE, "size of the entries");
+        check(stats.size <= stats.budget, "size under the budget");
+        check(stats.bytesWritten == NUM_ENTRIES * ENTRY_SIZE, "written bytes");
+        check(stats.bytesRead == NUM_ENTRIES * ENTRY_SIZE, "read bytes");
+
+        // replacing an entry keeps a single one
+        check(cache.store(keys[NUM_ENTRIES-1], content.data(), ENTRY_SIZE), "replace");
+        check(cache.getStats().numEntries == stats.numEntries, "replaced entry counted once");
+    }
+
+    {
+        // entries and last uses restored from the directory and the index
+        AssetCache cache(path, ENTRY_FILE_SIZE * 4 + 100);
+        AssetCache::Stats stats = cache.getStats();
+
+        check(stats.numEntries >= 2, "entries restored");
+        check(stats.size == stats.numEntries * ENTRY_FILE_SIZE, "size of the restored entries");
+
+        // under three entries, evicted down to 7/8 of the budget, that keeps the two most
+        // recently used entries, the used one and the replaced one
+        cache.setBudget(ENTRY_FILE_SIZE * 3 - 1);
+
+        check(cache.contains(keys[0]), "restored last use of the used entry");
+        check(cache.contains(keys[NUM_ENTRIES-1]), "restored last use of the last entry");
+        check(cache.getStats().numEntries == 2, "evicted down to the new budget");
+
+        SmartArrayUInt8 data;
+        check(cache.fetch(keys[NUM_ENTRIES-1], data) && data[0] == NUM_ENTRIES-1, "restored content");
+
+        cache.remove(keys[0]);
+        check(!cache.contains(keys[0]), "removed entry");
+
+        cache.clear();
+        check(cache.getStats().numEntries == 0 && cache.getStats().size == 0, "cleared");
+    }
+
+    LocalDir dir(FileManager::instance()->getWorkingDirectory());
+    dir.removeFile("assetcache/entries/cache.idx");
+    dir.removeDir("assetcache/entries");
+    dir.removeDir("assetcache");
+
+    std::cout << g_numErrors << " errors" << std::endl;
+
+    return g_numErrors ? 1 : 0;
+}
@@ -0,0 +1,196 @@
+/**
+ * @file chunkpack.cpp
+ * @brief Round-trip test of the ChunkPack writer and reader.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : chunkpack
+ * Write a pack with a compressed file and a file of stored chunks, read them back with
+ * a file and a mapped stream, and check that truncated or corrupted packs are rejected.
+ */
+
+#include <o3d/core/filemanager.h>
+#include <o3d/core/chunkpack.h>
+#include <o3d/core/datainstream.h>
+#include <o3d/core/fileinstream.h>
+#include <o3d/core/fileoutstream.h>
+#include <o3d/core/mmapinstream.h>
+#include <o3d/core/localdir.h>
+
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include <cstring>
+
+using namespace o3d;
+
+static const UInt32 CHUNK_SIZE = 4096;
+
+static UInt32 g_numErrors = 0;
+
+static void check(Bool cond, const char *what)
+{
+    if (!cond) {
+        std::cerr << "Failed : " << what << std::endl;
+        ++g_numErrors;
+    }
+}
+
+static std::vector<UInt8> readBytes(const String &fileName)
+{
+    std::ifstream file(fileName.toUtf8().getData(), std::ios::binary);
+    return std::vector<UInt8>(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+static void writeBytes(const String &fileName, const std::vector<UInt8> &data)
+{
+    std::ofstream file(fileName.toUtf8().getData(), std::ios::binary | std::ios::trunc);
+    file.write((const char*)data.data(), data.size());
+}
+
+//! Open a pack, and return null if it is rejected as an invalid format.
+static ChunkPack* openPack(const String &path, const String &name, Bool mapped)
+{
+    const String fileName = path + '/' + name;
+    InStream *is = mapped ? (InStream*)new MmapInStream(fileName) : (InStream*)new FileInStream(fileName);
+
+    try {
+        return new ChunkPack(*is, name, path);
+    } catch (E_InvalidFormat &) {
+        // not owned by the pack
+        deletePtr(is);
+        return nullptr;
+    }
+}
+
+//! Read a whole file of a pack and compare it, then some reads after a seek.
+static void checkFile(ChunkPack *pack, const String &name, const std::vector<UInt8> &content, const char *what)
+{
+    const Int32 index = pack->findFile(name);
+    check(index >= 0, what);
+    if (index < 0) {
+        return;
+    }
+
+    check(pack->getFileSize(index) == content.size(), what);
+
+    InStream *is = pack->openInStream(index);
+
+    std::vector<UInt8> data(content.size());
+    check(is->reader(data.data(), 1, (UInt32)data.size()) == content.size(), what);
+    check(data == content, what);
+    check(is->isEnd(), what);
+
+    // across a chunk boundary
+    const UInt32 pos = CHUNK_SIZE + CHUNK_SIZE / 2 - 10;
+    UInt8 buf[20];
+    is->reset(pos);
+    check(is->reader(buf, 1, 20) == 20, what);
+    check(memcmp(buf, &content[pos], 20) == 0, what);
+
+    // reads stop at the end of the file
+    is->reset(content.size() - 5);
+    check(is->reader(buf, 1, 20) == 5, what);
+
+    deletePtr(is);
+}
+
+int main(int /*argc*/, char * /*argv*/[])
+{
+    FileManager *fm = FileManager::instance();
+    const String path = fm->getWorkingDirectory();
+
+    // text compresses, and the noise is stored because it does not shrink
+    std::vector<UInt8> text(CHUNK_SIZE * 3 + 1000);
+    for (size_t i = 0; i < text.size(); ++i) {
+        text[i] = (UInt8)"chunk pack round trip "[i % 22];
+    }
+
+    std::vector<UInt8> noise(CHUNK_SIZE * 2 + 100);
+    UInt32 seed = 12345;
+    for (size_t i = 0; i < noise.size(); ++i) {
+        seed = seed * 1664525 + 1013904223;
+        noise[i] = (UInt8)(seed >> 24);
+    }
+
+    {
+        ChunkPackWriter writer(new FileOutStream(path + "/chunkpack.opc"), CHUNK_SIZE);
+
+        UInt64 offset = writer.getCompressedSize();
+        SharedDataInStream textStream(SmartArrayUInt8(text.data(), (UInt32)text.size()));
+        writer.addFile("dir/text.txt", textStream);
+        check(writer.getCompressedSize() - offset < text.size(), "compressed chunks");
+
+        offset = writer.getCompressedSize();
+        SharedDataInStream noiseStream(SmartArrayUInt8(noise.data(), (UInt32)noise.size()));
+        writer.addFile("dir/sub/noise.bin", noiseStream);
+        check(writer.getCompressedSize() - offset == noise.size(), "stored chunks");
+
+        writer.finish();
+    }
+
+    for (Int32 mapped = 0; mapped < 2; ++mapped) {
+        ChunkPack *pack = openPack(path, "chunkpack.opc", mapped != 0);
+        check(pack != nullptr, "valid pack");
+        if (!pack) {
+            continue;
+        }
+
+        check(pack->getChunkSize() == CHUNK_SIZE, "chunk size");
+        check(pack->getNumFiles() == 4, "files and parents directories");
+
+        const Int32 dir = pack->findFile(path + "/dir/sub");
+        check(dir >= 0 && pack->getFileType(dir) == FILE_DIR, "parent directory");
+
+        checkFile(pack, path + "/dir/text.txt", text, "compressed file");
+        checkFile(pack, path + "/dir/sub/noise.bin", noise, "stored file");
+
+        deletePtr(pack);
+    }
+
+    const std::vector<UInt8> bytes = readBytes(path + "/chunkpack.opc");
+
+    // truncated at the middle of the index, the trailer is missing
+    std::vector<UInt8> truncated(bytes.begin(), bytes.end() - 20);
+    writeBytes(path + "/truncated.opc", truncated);
+
+    // truncated at the middle of the data, the index offset is out of the pack
+    std::vector<UInt8> shortData(bytes.begin(), bytes.begin() + 100);
+    shortData.insert(shortData.end(), bytes.end() - 12, bytes.end());
+    writeBytes(path + "/shortdata.opc", shortData);
+
+    // the trailer gives the offset of the index, starting with the number of entries
+    UInt64 indexOffset;
+    memcpy(&indexOffset, &bytes[bytes.size() - 12], sizeof(UInt64));
+
+    // a huge number of entries must not be allocated
+    std::vector<UInt8> manyEntries(bytes);
+    const UInt32 numEntries = 0x7fffffff;
+    memcpy(&manyEntries[(size_t)indexOffset], &numEntries, sizeof(UInt32));
+    writeBytes(path + "/manyentries.opc", manyEntries);
+
+    // chunks referenced out of the chunks table
+    std::vector<UInt8> badChunks(bytes);
+    const UInt32 numChunks = 1;
+    memcpy(&badChunks[bytes.size() - 12 - 4 - 7 * 12], &numChunks, sizeof(UInt32));
+    writeBytes(path + "/badchunks.opc", badChunks);
+
+    const char *invalids[] = { "truncated.opc", "shortdata.opc", "manyentries.opc", "badchunks.opc" };
+
+    for (const char *invalid : invalids) {
+        for (Int32 mapped = 0; mapped < 2; ++mapped) {
+            ChunkPack *pack = openPack(path, invalid, mapped != 0);
+            check(pack == nullptr, invalid);
+            deletePtr(pack);
+        }
+
+        LocalDir(path).removeFile(invalid);
+    }
+
+    LocalDir(path).removeFile("chunkpack.opc");
+
+    std::cout << g_numErrors << " errors" << std::endl;
+
+    return g_numErrors ? 1 : 0;
+}
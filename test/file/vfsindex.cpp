@@ -0,0 +1,191 @@
+/**
+ * @file vfsindex.cpp
+ * @brief Benchmark of the FileManager virtual file index.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : vfsindex [num-entries] [num-packs] [files-per-dir]
+ * Write some packs sharing the same directories, mount them, and report the mount time,
+ * the lookup rate of the FileManager against a walk on each asset, and the listing rate
+ * of the VirtualFileListing against a walk on every entry.
+ */
+
+#include <o3d/core/filemanager.h>
+#include <o3d/core/chunkpack.h>
+#include <o3d/core/datainstream.h>
+#include <o3d/core/fileoutstream.h>
+#include <o3d/core/localdir.h>
+#include <o3d/core/virtualfilelisting.h>
+
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace o3d;
+
+static Double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<Double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static String entryName(UInt32 n, UInt32 filesPerDir)
+{
+    String name("vfsbench/d");
+    name << (n / filesPerDir) << "/f" << n << ".dat";
+    return name;
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 numEntries = argc > 1 ? (UInt32)atoi(argv[1]) : 50000;
+    const UInt32 numPacks = argc > 2 ? (UInt32)atoi(argv[2]) : 8;
+    const UInt32 filesPerDir = argc > 3 ? (UInt32)atoi(argv[3]) : 100;
+    const UInt32 numDirs = (numEntries + filesPerDir - 1) / filesPerDir;
+
+    FileManager *fm = FileManager::instance();
+    const String base = fm->getWorkingDirectory();
+
+    // the files are spread over the packs, each directory is shared by every pack
+    std::vector<String> packs;
+    UInt8 content[16] = { 0 };
+
+    for (UInt32 p = 0; p < numPacks; ++p) {
+        String packName(base);
+        packName << "/vfsbench" << p << ".opc";
+        packs.push_back(packName);
+
+        ChunkPackWriter writer(new FileOutStream(packName));
+
+        for (UInt32 n = p; n < numEntries; n += numPacks) {
+            SharedDataInStream is(SmartArrayUInt8(content, sizeof(content)));
+            writer.addFile(entryName(n, filesPerDir), is);
+        }
+
+        writer.finish();
+    }
+
+    // mount, building the index
+    auto start = std::chrono::steady_clock::now();
+
+    for (const String &pack : packs) {
+        fm->mountAsset("pack://", pack);
+    }
+
+    const Double mountTime = seconds(start);
+
+    std::vector<Asset*> assets;
+    for (const String &pack : packs) {
+        assets.push_back(fm->getAsset(pack));
+    }
+
+    std::vector<String> names;
+    names.reserve(numEntries);
+
+    for (UInt32 n = 0; n < numEntries; ++n) {
+        names.push_back(base + '/' + entryName(n, filesPerDir));
+    }
+
+    // lookups, half of them with a different case
+    UInt32 errors = 0;
+    start = std::chrono::steady_clock::now();
+
+    for (UInt32 n = 0; n < numEntries; ++n) {
+        if (n & 1) {
+            String upper(names[n]);
+            upper.upper();
+
+            if (!fm->isFile(upper)) {
+                ++errors;
+            }
+        } else if (fm->fileSize(names[n]) != sizeof(content)) {
+            ++errors;
+        }
+    }
+
+    const Double lookupTime = seconds(start);
+
+    // previous lookup, a walk on each asset
+    start = std::chrono::steady_clock::now();
+
+    for (UInt32 n = 0; n < numEntries; ++n) {
+        Bool found = False;
+
+        for (size_t a = 0; a < assets.size() && !found; ++a) {
+            found = assets[a]->findFile(names[n]) >= 0;
+        }
+
+        if (!found) {
+            ++errors;
+        }
+    }
+
+    const Double walkLookupTime = seconds(start);
+
+    // listings
+    const UInt32 numListed = o3d::min<UInt32>(numDirs, 100);
+    UInt32 listed = 0;
+
+    start = std::chrono::steady_clock::now();
+
+    for (UInt32 d = 0; d < numListed; ++d) {
+        VirtualFileListing listing;
+        listing.setPath(base + "/vfsbench/d" + String::print("%u", d));
+        listing.setType(FILE_FILE);
+        listing.searchFirstFile();
+
+        while (listing.searchNextFile()) {
+            ++listed;
+        }
+    }
+
+    const Double listTime = seconds(start);
+
+    // previous listing, a walk on every entry of every asset
+    UInt32 walked = 0;
+    start = std::chrono::steady_clock::now();
+
+    for (UInt32 d = 0; d < numListed; ++d) {
+        const String dir = base + "/vfsbench/d" + String::print("%u", d) + '/';
+
+        for (Asset *asset : assets) {
+            for (Int32 i = 0; i < asset->getNumFiles(); ++i) {
+                const String name = asset->getFileName(i);
+                if ((name.sub(dir, 0) == 0) && (name.find('/', dir.length()) < 0)) {
+                    ++walked;
+                }
+            }
+        }
+    }
+
+    const Double walkListTime = seconds(start);
+
+    // unmount invalidates
+    for (const String &pack : packs) {
+        fm->umountAsset(pack);
+    }
+
+    if (fm->isFile(names[0]) || fm->isPath(base + "/vfsbench")) {
+        ++errors;
+    }
+
+    LocalDir dir(base);
+    for (UInt32 p = 0; p < numPacks; ++p) {
+        dir.removeFile(String("vfsbench") << p << ".opc");
+    }
+
+    std::cout << numEntries << " entries into " << numPacks << " packs, " << numDirs << " directories" << std::endl;
+    std::cout << "  mount  : " << UInt64(mountTime * 1000) << " ms" << std::endl;
+    std::cout << "  lookup : " << UInt64(numEntries / lookupTime) << " files/s (walk "
+              << UInt64(numEntries / walkLookupTime) << ")" << std::endl;
+    std::cout << "  list   : " << UInt64(numListed / listTime) << " directories/s (walk "
+              << UInt64(numListed / walkListTime) << ")" << std::endl;
+
+    if (errors || listed != walked) {
+        std::cerr << errors << " lookup errors, " << listed << " listed files, expected "
+                  << walked << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,142 @@
+/**
+ * @file throughput.cpp
+ * @brief Benchmark of the hash and checksum functions.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : throughput [size-in-MB] [num-rounds]
+ * Report the throughput in GB/s of XXH3 64 and 128 bits, of CRC32C and of the previous
+ * MD5 and SHA1, for a large buffer and through a memory stream, and check the results
+ * of some known vectors.
+ */
+
+#include <o3d/core/xxhash3.h>
+#include <o3d/core/crc32c.h>
+#include <o3d/core/md5.h>
+#include <o3d/core/sha1.h>
+#include <o3d/core/datainstream.h>
+
+#include <chrono>
+#include <functional>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+
+using namespace o3d;
+
+static Double gigaBytesPerSecond(
+        const std::function<void()> &func,
+        UInt32 rounds,
+        UInt64 size)
+{
+    // warm up, and the processor detection
+    func();
+
+    auto start = std::chrono::steady_clock::now();
+
+    for (UInt32 r = 0; r < rounds; ++r) {
+        func();
+    }
+
+    const Double seconds = std::chrono::duration<Double>(std::chrono::steady_clock::now() - start).count();
+    return (Double)size * rounds / seconds / (1024.0 * 1024.0 * 1024.0);
+}
+
+static void report(const Char *name, Double rate)
+{
+    std::cout << "  " << std::left << std::setw(20) << name << std::right << std::fixed
+              << std::setprecision(2) << std::setw(8) << rate << " GB/s" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 sizeMB = argc > 1 ? (UInt32)atoi(argv[1]) : 64;
+    const UInt32 rounds = argc > 2 ? (UInt32)atoi(argv[2]) : 8;
+    const UInt32 size = sizeMB * 1024 * 1024;
+
+    UInt32 errors = 0;
+
+    // known vectors
+    const UInt8 *check = reinterpret_cast<const UInt8*>("123456789");
+
+    if (CRC32CHash::compute(check, 9) != 0xE3069283) {
+        std::cerr << "invalid CRC32C" << std::endl;
+        ++errors;
+    }
+
+    if (XXH3Hash::hash64(nullptr, 0) != 0x2D06800538D394C2ULL) {
+        std::cerr << "invalid XXH3 64 of an empty input" << std::endl;
+        ++errors;
+    }
+
+    SmartArrayUInt8 data(size);
+    UInt64 state = 0x9E3779B97F4A7C15ULL;
+
+    for (UInt32 i = 0; i < size; ++i) {
+        state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        data[i] = (UInt8)(state >> 56);
+    }
+
+    // the streaming and one shot results must be the same
+    XXH3Hash oneShot(data);
+    XXH3Hash streaming;
+
+    for (UInt32 pos = 0, chunk = 1; pos < size; pos += chunk, chunk = chunk * 3 + 1) {
+        streaming.update(data.getData() + pos, o3d::min(chunk, size - pos));
+    }
+    streaming.finalize();
+
+    if (oneShot.getHex() != streaming.getHex() || oneShot.get64() != streaming.get64()) {
+        std::cerr << "XXH3 streaming mismatch" << std::endl;
+        ++errors;
+    }
+
+    CRC32CHash crcStream;
+    for (UInt32 pos = 0, chunk = 1; pos < size; pos += chunk, chunk = chunk * 5 + 3) {
+        crcStream.update(data.getData() + pos, o3d::min(chunk, size - pos));
+    }
+
+    if (crcStream.get() != CRC32CHash::compute(data.getData(), size)) {
+        std::cerr << "CRC32C streaming mismatch" << std::endl;
+        ++errors;
+    }
+
+    volatile UInt64 sink = 0;
+
+    std::cout << sizeMB << " MB x " << rounds << " rounds" << std::endl;
+
+    report("XXH3 64", gigaBytesPerSecond([&] () {
+        sink = sink + XXH3Hash::hash64(data.getData(), size);
+    }, rounds, size));
+
+    report("XXH3 128", gigaBytesPerSecond([&] () {
+        UInt64 low, high;
+        XXH3Hash::hash128(data.getData(), size, low, high);
+        sink = sink + low + high;
+    }, rounds, size));
+
+    report("XXH3 stream", gigaBytesPerSecond([&] () {
+        SharedDataInStream is(data);
+        XXH3Hash hash(is);
+        sink = sink + hash.get64();
+    }, rounds, size));
+
+    report(CRC32CHash::isHardware() ? "CRC32C (SSE4.2)" : "CRC32C (tables)", gigaBytesPerSecond([&] () {
+        sink = sink + CRC32CHash::compute(data.getData(), size);
+    }, rounds, size));
+
+    // the cryptographic hashes are much slower
+    const UInt32 slowRounds = o3d::max<UInt32>(rounds / 4, 1);
+
+    report("MD5", gigaBytesPerSecond([&] () {
+        MD5Hash hash(data);
+        sink = sink + hash.getRaw()[0];
+    }, slowRounds, size));
+
+    report("SHA1", gigaBytesPerSecond([&] () {
+        SHA1Hash hash(data);
+        sink = sink + hash.getRaw()[0];
+    }, slowRounds, size));
+
+    return errors ? 1 : 0;
+}
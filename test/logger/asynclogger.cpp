@@ -0,0 +1,192 @@
+/**
+ * @file asynclogger.cpp
+ * @brief Benchmark of the logging cost on the calling threads.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : asynclogger [num-records] [num-threads]
+ * Log from several threads with FileLogger and AsyncLogger with each overflow policy,
+ * report the mean and maximal time of a log() call, and check the number of lines
+ * written against the number of dropped records.
+ */
+
+#include <o3d/core/asynclogger.h>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+
+using namespace o3d;
+
+struct Timing
+{
+    Double mean;    //!< us
+    Double max;     //!< us
+};
+
+//! FileLogger is not thread safe, Debug serializes the calls.
+class SerializedLogger : public Logger
+{
+public:
+
+    SerializedLogger(Logger &logger) : m_logger(logger) {}
+
+    virtual void log(LogLevel level, const String &str)
+    {
+        FastMutexLocker locker(m_mutex);
+        m_logger.log(level, str);
+    }
+
+    virtual void setDateFormat(const String &format) { m_logger.setDateFormat(format); }
+    virtual const String& getDateFormat() const { return m_logger.getDateFormat(); }
+    virtual void clearLog() { m_logger.clearLog(); }
+    virtual void setLogLevel(LogLevel minLevel) { m_logger.setLogLevel(minLevel); }
+    virtual LogLevel getLogLevel() const { return m_logger.getLogLevel(); }
+
+private:
+
+    Logger &m_logger;
+    FastMutex m_mutex;
+};
+
+static Timing run(Logger &logger, UInt32 numRecords, UInt32 numThreads)
+{
+    std::vector<std::thread> threads;
+    std::vector<Double> means(numThreads, 0), maxs(numThreads, 0);
+
+    for (UInt32 t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] () {
+            Double total = 0;
+
+            for (UInt32 i = 0; i < numRecords; ++i) {
+                String msg("<MSG> thread ");
+                msg << t << " record " << i << " with some text to look like a usual message";
+
+                auto start = std::chrono::steady_clock::now();
+                logger.log(Logger::MESSAGE, msg);
+                const Double us = std::chrono::duration<Double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+                total += us;
+                maxs[t] = std::max(maxs[t], us);
+            }
+
+            means[t] = total / numRecords;
+        });
+    }
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    Timing timing = { 0, 0 };
+    for (UInt32 t = 0; t < numThreads; ++t) {
+        timing.mean += means[t] / numThreads;
+        timing.max = std::max(timing.max, maxs[t]);
+    }
+
+    return timing;
+}
+
+static UInt64 countLines(const char *filename)
+{
+    std::ifstream file(filename);
+    std::string line;
+    UInt64 count = 0;
+
+    while (std::getline(file, line)) {
+        ++count;
+    }
+
+    return count;
+}
+
+static void report(const Char *name, const Timing &timing, UInt64 dropped)
+{
+    std::cout << "  " << std::left << std::setw(16) << name << std::right << std::fixed
+              << std::setprecision(3) << "mean " << std::setw(8) << timing.mean << " us, max "
+              << std::setw(10) << timing.max << " us, dropped " << dropped << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 numRecords = argc > 1 ? (UInt32)atoi(argv[1]) : 100000;
+    const UInt32 numThreads = argc > 2 ? (UInt32)atoi(argv[2]) : 4;
+    const UInt64 total = (UInt64)numRecords * numThreads;
+
+    ThreadManager::init();
+
+    UInt32 errors = 0;
+
+    std::cout << numRecords << " records x " << numThreads << " threads" << std::endl;
+
+    {
+        remove("sync.log");
+        FileLogger logger("sync.log");
+        logger.setDateFormat("%Y-%m-%d %H:%M:%S");
+
+        SerializedLogger serialized(logger);
+
+        report("FileLogger", run(serialized, numRecords, numThreads), 0);
+    }
+
+    const AsyncLogger::OverflowPolicy policies[] = {
+        AsyncLogger::OVERFLOW_DROP,
+        AsyncLogger::OVERFLOW_BLOCK,
+        AsyncLogger::OVERFLOW_SAMPLE
+    };
+
+    const Char *names[] = { "Async drop", "Async block", "Async sample" };
+
+    for (Int32 p = 0; p < 3; ++p) {
+        remove("async.log");
+
+        AsyncLogger *logger = new AsyncLogger("async.log", 4096, policies[p]);
+        logger->setDateFormat("%Y-%m-%d %H:%M:%S");
+
+        const Timing timing = run(*logger, numRecords, numThreads);
+        const UInt64 dropped = logger->getNumDropped();
+
+        delete logger;
+
+        report(names[p], timing, dropped);
+
+        // plus a line for each report of dropped records
+        const UInt64 lines = countLines("async.log");
+        if (lines < total - dropped || lines > total - dropped + (dropped ? total : 0)) {
+            std::cerr << "unexpected number of lines " << lines << std::endl;
+            ++errors;
+        }
+
+        if (policies[p] == AsyncLogger::OVERFLOW_BLOCK && dropped != 0) {
+            std::cerr << "records dropped by the block policy" << std::endl;
+            ++errors;
+        }
+    }
+
+    // stopped, synchronous fallback
+    {
+        remove("async.log");
+
+        AsyncLogger logger("async.log");
+        logger.log(Logger::MESSAGE, "<MSG> before stop");
+        logger.stop();
+        logger.log(Logger::MESSAGE, "<MSG> after stop");
+
+        if (countLines("async.log") != 2) {
+            std::cerr << "missing lines after stop" << std::endl;
+            ++errors;
+        }
+    }
+
+    remove("sync.log");
+    remove("async.log");
+
+    return errors ? 1 : 0;
+}
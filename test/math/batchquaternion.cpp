@@ -0,0 +1,340 @@
+/**
+ * @file batchquaternion.cpp
+ * @brief Benchmark of the batch quaternion interpolations against the Quaternion loops.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : batchquaternion [num-quaternions] [max-simd-level]
+ * Compare the results of BatchQuaternion with Quaternion::slerp(), lerp() and
+ * toMatrix4(), measure the angular error of the corrected normalized linear
+ * interpolation, and report the throughput of each operation for as many bones.
+ * The SIMD level can be limited (0 scalar, 1 SSE2, 5 AVX2, 6 AVX-512).
+ */
+
+#include <o3d/core/batchquaternion.h>
+#include <o3d/core/quaternion.h>
+#include <o3d/core/cpudispatch.h>
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+using namespace o3d;
+
+static UInt32 errors = 0;
+
+//! Best of 10 rounds of at least 20ms, in millions of quaternions per second.
+template <class F>
+static Double measure(F f, UInt32 num)
+{
+    Double best = 0;
+
+    for (Int32 round = 0; round < 10; ++round) {
+        UInt32 runs = 0;
+        auto start = std::chrono::steady_clock::now();
+        Double elapsed = 0;
+
+        do {
+            f();
+            ++runs;
+            elapsed = std::chrono::duration<Double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < 0.02);
+
+        best = o3d::max(best, (Double)num * runs / elapsed / 1e6);
+    }
+
+    return best;
+}
+
+static void check(const Char *name, const Float *values, const Float *ref, UInt32 count, Float tolerance)
+{
+    Float maxError = 0;
+    for (UInt32 i = 0; i < count; ++i) {
+        maxError = o3d::max(maxError, o3d::abs(values[i] - ref[i]));
+    }
+
+    if (!(maxError <= tolerance)) {
+        std::cerr << name << ": max error " << maxError << std::endl;
+        ++errors;
+    }
+}
+
+//! Exact shortest path slerp in double.
+static void slerpRef(const Float *a, const Float *b, Float t, Double *r)
+{
+    Double cosom = 0;
+    for (Int32 c = 0; c < 4; ++c) {
+        cosom += (Double)a[c] * b[c];
+    }
+
+    const Double sign = cosom < 0 ? -1 : 1;
+    const Double omega = std::acos(o3d::min(1.0, cosom * sign));
+    Double u = 1 - t, v = t;
+
+    if (omega > 1e-6) {
+        u = std::sin((1 - t) * omega) / std::sin(omega);
+        v = std::sin(t * omega) / std::sin(omega);
+    }
+
+    for (Int32 c = 0; c < 4; ++c) {
+        r[c] = a[c] * u + b[c] * v * sign;
+    }
+}
+
+//! Rotation angle from r to q, robust for close quaternions.
+static Double angle(const Double *r, const Float *q)
+{
+    Double minus = 0, plus = 0;
+    for (Int32 c = 0; c < 4; ++c) {
+        minus += (r[c] - q[c]) * (r[c] - q[c]);
+        plus += (r[c] + q[c]) * (r[c] + q[c]);
+    }
+
+    return 4 * std::asin(o3d::min(1.0, std::sqrt(o3d::min(minus, plus)) / 2));
+}
+
+static void report(const Char *name, Double scalar, Double batch)
+{
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(9) << batch << " Mq/s  x"
+              << std::setprecision(2) << batch / scalar << std::endl;
+}
+
+static void reportScalar(const Char *name, Double scalar)
+{
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(9) << scalar << " Mq/s" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 n = argc > 1 ? (UInt32)atoi(argv[1]) : 20003;
+    if (argc > 2) {
+        CpuDispatch::setMaxLevel((SimdLevel)atoi(argv[2]));
+    }
+
+    std::cout << n << " quaternions, " << CpuDispatch::getLevelName(CpuDispatch::getLevel()) << std::endl;
+
+    std::mt19937 rnd(1234);
+    std::normal_distribution<Float> gauss(0.f, 1.f);
+    std::uniform_real_distribution<Float> unit(0.f, 1.f);
+    std::uniform_real_distribution<Float> pos(-10.f, 10.f);
+
+    // random unit quaternions, the 'to' ones rotated by up to about 2 radians
+    std::vector<Quaternion> qa(n), qb(n);
+    std::vector<Float> from(n*4), to(n*4), t(n);
+
+    for (UInt32 i = 0; i < n; ++i) {
+        qa[i].set(gauss(rnd), gauss(rnd), gauss(rnd), gauss(rnd));
+        qa[i].normalize();
+
+        qb[i].set(qa[i][0] + gauss(rnd) * 0.5f, qa[i][1] + gauss(rnd) * 0.5f, qa[i][2] + gauss(rnd) * 0.5f, qa[i][3] + gauss(rnd) * 0.5f);
+        qb[i].normalize();
+
+        // some on the other hemisphere
+        if (i % 5 == 0) {
+            qb[i] *= -1.f;
+        }
+
+        for (Int32 c = 0; c < 4; ++c) {
+            from[i*4+c] = qa[i][c];
+            to[i*4+c] = qb[i][c];
+        }
+
+        t[i] = unit(rnd);
+    }
+
+    std::vector<Float> out(n*8), ref(n*8), matrices(n*16), refMatrices(n*16);
+
+    //
+    // correctness
+    //
+
+    // nlerp, Quaternion::lerp does not take the shortest path
+    for (UInt32 i = 0; i < n; ++i) {
+        Quaternion b(qb[i]);
+        if (qa[i].dot(b) < 0.f) {
+            b *= -1.f;
+        }
+
+        const Quaternion r = qa[i].lerp(b, t[i]);
+        for (Int32 c = 0; c < 4; ++c) {
+            ref[i*4+c] = r[c];
+        }
+    }
+
+    BatchQuaternion::interpolate(from.data(), to.data(), t.data(), out.data(), n, BatchQuaternion::NLERP);
+    check("nlerp", out.data(), ref.data(), n*4, 1e-6f);
+
+    // slerp and corrected nlerp against the exact slerp
+    Double maxSlerp = 0, maxCorrected = 0, maxNlerp = 0;
+    std::vector<Float> slerp(n*4), corrected(n*4), nlerp(out.begin(), out.begin() + n*4);
+
+    BatchQuaternion::interpolate(from.data(), to.data(), t.data(), slerp.data(), n, BatchQuaternion::SLERP);
+    BatchQuaternion::interpolate(from.data(), to.data(), t.data(), corrected.data(), n, BatchQuaternion::NLERP_CORRECTED);
+
+    for (UInt32 i = 0; i < n; ++i) {
+        Double r[4];
+        slerpRef(&from[i*4], &to[i*4], t[i], r);
+
+        // rotation angle between the unit quaternions, from the distance to the closest sign
+        maxSlerp = o3d::max(maxSlerp, angle(r, &slerp[i*4]));
+        maxCorrected = o3d::max(maxCorrected, angle(r, &corrected[i*4]));
+        maxNlerp = o3d::max(maxNlerp, angle(r, &nlerp[i*4]));
+    }
+
+    std::cout << "  max angular error (rad) slerp " << std::scientific << std::setprecision(2) << maxSlerp
+              << ", corrected nlerp " << maxCorrected << ", nlerp " << maxNlerp << std::endl;
+
+    if (maxSlerp > 1e-4 || maxCorrected > 2e-3) {
+        std::cerr << "slerp: too large angular error" << std::endl;
+        ++errors;
+    }
+
+    // the result is normalized
+    for (UInt32 i = 0; i < n; ++i) {
+        const Float *q = &corrected[i*4];
+        if (o3d::abs(q[0]*q[0] + q[1]*q[1] + q[2]*q[2] + q[3]*q[3] - 1.f) > 1e-5f) {
+            std::cerr << "corrected nlerp: not normalized" << std::endl;
+            ++errors;
+            break;
+        }
+    }
+
+    // normalize, with a null quaternion
+    std::vector<Float> scaled(n*4);
+    for (UInt32 i = 0; i < n*4; ++i) {
+        scaled[i] = from[i] * (1.f + (i / 4 % 7));
+    }
+    if (n > 2) {
+        scaled[8] = scaled[9] = scaled[10] = scaled[11] = 0.f;
+    }
+
+    std::vector<Float> refNormalized(from);
+    if (n > 2) {
+        refNormalized[8] = refNormalized[9] = refNormalized[10] = 0.f;
+        refNormalized[11] = 1.f;
+    }
+
+    BatchQuaternion::normalize(scaled.data(), out.data(), n);
+    check("normalize", out.data(), refNormalized.data(), n*4, 1e-6f);
+
+    // matrices
+    for (UInt32 i = 0; i < n; ++i) {
+        const Matrix4 m = qa[i].toMatrix4();
+        memcpy(&refMatrices[i*16], m.getData(), 16 * sizeof(Float));
+    }
+
+    BatchQuaternion::toMatrix4(from.data(), matrices.data(), n);
+    check("toMatrix4", matrices.data(), refMatrices.data(), n*16, 1e-6f);
+
+    // dual quaternions from a rotation and a translation, dual = 0.5 * translation * real
+    std::vector<Float> dualFrom(n*8), dualTo(n*8), dualScaled(n*8);
+    std::vector<Vector3> translations(n);
+
+    for (UInt32 i = 0; i < n; ++i) {
+        translations[i].set(pos(rnd), pos(rnd), pos(rnd));
+
+        const Quaternion tq(translations[i].x(), translations[i].y(), translations[i].z(), 0.f);
+        const Quaternion da = (tq * qa[i]) * 0.5f;
+        const Quaternion db = (tq * qb[i]) * 0.5f;
+
+        for (Int32 c = 0; c < 4; ++c) {
+            dualFrom[i*8+c] = qa[i][c];
+            dualFrom[i*8+4+c] = da[c];
+            dualTo[i*8+c] = qb[i][c];
+            dualTo[i*8+4+c] = db[c];
+            dualScaled[i*8+c] = qa[i][c] * 3.f;
+            dualScaled[i*8+4+c] = da[c] * 3.f;
+        }
+
+        Matrix4 m = qa[i].toMatrix4();
+        m.setTranslation(translations[i]);
+        memcpy(&refMatrices[i*16], m.getData(), 16 * sizeof(Float));
+    }
+
+    BatchQuaternion::dualToMatrix4(dualFrom.data(), matrices.data(), n);
+    check("dualToMatrix4", matrices.data(), refMatrices.data(), n*16, 1e-4f);
+
+    BatchQuaternion::normalizeDual(dualScaled.data(), out.data(), n);
+    check("normalizeDual", out.data(), dualFrom.data(), n*8, 1e-5f);
+
+    // same translation at both ends, the interpolation keeps it
+    std::vector<Float> dualOut(n*8);
+    BatchQuaternion::interpolateDual(dualFrom.data(), dualTo.data(), t.data(), dualOut.data(), n);
+    BatchQuaternion::dualToMatrix4(dualOut.data(), matrices.data(), n);
+
+    Float maxTranslation = 0;
+    for (UInt32 i = 0; i < n; ++i) {
+        maxTranslation = o3d::max(maxTranslation, (Vector3(&matrices[i*16+12]) - translations[i]).normInf());
+    }
+
+    if (maxTranslation > 1e-4f) {
+        std::cerr << "interpolateDual: translation error " << maxTranslation << std::endl;
+        ++errors;
+    }
+
+    for (UInt32 i = 0; i < n; ++i) {
+        for (Int32 c = 0; c < 4; ++c) {
+            ref[i*4+c] = nlerp[i*4+c] * (nlerp[i*4] * dualOut[i*8] >= 0.f ? 1.f : -1.f);
+            out[i*4+c] = dualOut[i*8+c];
+        }
+    }
+    check("interpolateDual", out.data(), ref.data(), n*4, 1e-5f);
+
+    // in place
+    std::vector<Float> inplace(from);
+    BatchQuaternion::interpolate(inplace.data(), to.data(), t.data(), inplace.data(), n, BatchQuaternion::NLERP);
+    check("in place", inplace.data(), nlerp.data(), n*4, 0.f);
+
+    //
+    // throughput
+    //
+
+    std::vector<Quaternion> qr(n);
+    std::vector<Matrix4> mr(n);
+
+    const Double scalarSlerp = measure([&] () {
+        for (UInt32 i = 0; i < n; ++i) {
+            qa[i].slerp(qb[i], t[i], qr[i]);
+            qr[i].toMatrix4(mr[i]);
+        }
+    }, n);
+
+    const Double scalarLerp = measure([&] () {
+        for (UInt32 i = 0; i < n; ++i) {
+            qa[i].lerp(qb[i], t[i], qr[i]);
+            qr[i].toMatrix4(mr[i]);
+        }
+    }, n);
+
+    reportScalar("slerp + toMatrix4", scalarSlerp);
+
+    report("slerp + toMatrix4", scalarSlerp, measure([&] () {
+        BatchQuaternion::interpolate(from.data(), to.data(), t.data(), out.data(), n, BatchQuaternion::SLERP);
+        BatchQuaternion::toMatrix4(out.data(), matrices.data(), n);
+    }, n));
+
+    report("corrected + toMatrix4", scalarSlerp, measure([&] () {
+        BatchQuaternion::interpolate(from.data(), to.data(), t.data(), out.data(), n, BatchQuaternion::NLERP_CORRECTED);
+        BatchQuaternion::toMatrix4(out.data(), matrices.data(), n);
+    }, n));
+
+    reportScalar("lerp + toMatrix4", scalarLerp);
+
+    report("nlerp + toMatrix4", scalarLerp, measure([&] () {
+        BatchQuaternion::interpolate(from.data(), to.data(), t.data(), out.data(), n, BatchQuaternion::NLERP);
+        BatchQuaternion::toMatrix4(out.data(), matrices.data(), n);
+    }, n));
+
+    report("dual interpolate + matrix", scalarLerp, measure([&] () {
+        BatchQuaternion::interpolateDual(dualFrom.data(), dualTo.data(), t.data(), dualOut.data(), n);
+        BatchQuaternion::dualToMatrix4(dualOut.data(), matrices.data(), n);
+    }, n));
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,242 @@
+/**
+ * @file frustumcull.cpp
+ * @brief Benchmark of the batch frustum culling against the per object tests.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : frustumcull [num-objects] [max-simd-level]
+ * Compare the visibility masks of Frustum::spheresInFrustum() and boxesInFrustum()
+ * with sphereInFrustum() and boxInFrustum() for each object, with and without the
+ * plane hints, and report the throughput of each one. The SIMD level can be limited
+ * (0 scalar, 1 SSE2, 5 AVX2, 6 AVX-512) to compare the implementations.
+ */
+
+#include <o3d/geom/frustum.h>
+#include <o3d/geom/aabbox.h>
+#include <o3d/core/matrix4.h>
+#include <o3d/core/cpudispatch.h>
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <cstdlib>
+
+using namespace o3d;
+
+static UInt32 errors = 0;
+
+//! Best of 10 rounds of at least 20ms, in millions of objects per second.
+template <class F>
+static Double measure(F f, UInt32 numObjects)
+{
+    Double best = 0;
+
+    for (Int32 round = 0; round < 10; ++round) {
+        UInt32 runs = 0;
+        auto start = std::chrono::steady_clock::now();
+        Double elapsed = 0;
+
+        do {
+            f();
+            ++runs;
+            elapsed = std::chrono::duration<Double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < 0.02);
+
+        best = o3d::max(best, (Double)numObjects * runs / elapsed / 1e6);
+    }
+
+    return best;
+}
+
+//! The objects at less than a small margin of a plane may differ by the rounding.
+static void check(const Char *name, const std::vector<UInt32> &visible, const std::vector<Bool> &ref,
+                  const std::vector<Bool> &ambiguous, UInt32 count)
+{
+    UInt32 mismatches = 0, refCount = 0;
+    for (UInt32 i = 0; i < ref.size(); ++i) {
+        const Bool v = (visible[i >> 5] >> (i & 31)) & 1;
+        if (v != ref[i] && !ambiguous[i]) {
+            ++mismatches;
+        }
+        refCount += v;
+    }
+
+    if (mismatches || refCount != count) {
+        std::cerr << name << ": " << mismatches << " mismatches, count " << count << " for " << refCount << std::endl;
+        ++errors;
+    }
+}
+
+static void report(const Char *name, Double scalar, Double batch)
+{
+    std::cout << "  " << std::left << std::setw(28) << name << std::right << std::fixed
+              << std::setprecision(1) << std::setw(9) << batch << " Mobj/s  x"
+              << std::setprecision(2) << batch / scalar << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 n = argc > 1 ? (UInt32)atoi(argv[1]) : 50021;
+    if (argc > 2) {
+        CpuDispatch::setMaxLevel((SimdLevel)atoi(argv[2]));
+    }
+
+    std::cout << n << " objects, " << CpuDispatch::getLevelName(CpuDispatch::getLevel()) << std::endl;
+
+    std::mt19937 rnd(1234);
+    std::uniform_real_distribution<Float> pos(-200.f, 200.f);
+    std::uniform_real_distribution<Float> size(0.1f, 8.f);
+
+    Matrix4 projection;
+    projection.buildPerspective(1.33f, 60.f, 1.f, 300.f);
+
+    Matrix4 modelview;
+    modelview.rotateY(0.4f);
+    modelview.rotateX(-0.2f);
+    modelview.translate(Vector3(5.f, -3.f, 20.f));
+
+    Frustum frustum;
+    frustum.computeFrustum(projection, modelview);
+
+    std::vector<Float> x(n), y(n), z(n), r(n), hx(n), hy(n), hz(n);
+    for (UInt32 i = 0; i < n; ++i) {
+        x[i] = pos(rnd);
+        y[i] = pos(rnd) * 0.25f;
+        z[i] = pos(rnd);
+        r[i] = size(rnd);
+        hx[i] = size(rnd);
+        hy[i] = size(rnd);
+        hz[i] = size(rnd);
+    }
+
+    const Frustum::SphereArray spheres = { x.data(), y.data(), z.data(), r.data() };
+    const Frustum::BoxArray boxes = { x.data(), y.data(), z.data(), hx.data(), hy.data(), hz.data() };
+
+    std::vector<AABBox> aabbs(n);
+    for (UInt32 i = 0; i < n; ++i) {
+        aabbs[i] = AABBox(Vector3(x[i], y[i], z[i]), Vector3(hx[i], hy[i], hz[i]));
+    }
+
+    std::vector<Bool> refSpheres(n), refBoxes(n), refLight(n), ambiguous(n);
+    for (UInt32 i = 0; i < n; ++i) {
+        const Vector3 center(x[i], y[i], z[i]);
+
+        refSpheres[i] = frustum.sphereInFrustum(center, r[i]) != Geometry::CLIP_OUTSIDE;
+        refLight[i] = frustum.sphereInFrustumLight(center, r[i]) != Geometry::CLIP_OUTSIDE;
+        refBoxes[i] = frustum.boxInFrustum(aabbs[i]) != Geometry::CLIP_OUTSIDE;
+
+        // the sphere or box touches a plane, up to the rounding
+        ambiguous[i] = False;
+        for (Int32 p = 0; p < 6; ++p) {
+            const Plane &plane = frustum.getPlane((Frustum::Planes)p);
+            const Vector3 &normal = plane.getNormal();
+            const Float dist = plane * center;
+            const Float extent = o3d::abs(normal.x()) * hx[i] + o3d::abs(normal.y()) * hy[i] + o3d::abs(normal.z()) * hz[i];
+
+            if (o3d::abs(dist + r[i]) < 1e-3f || o3d::abs(dist + extent) < 1e-3f) {
+                ambiguous[i] = True;
+            }
+        }
+    }
+
+    //
+    // correctness
+    //
+
+    const UInt32 numWords = (n + 31) / 32;
+    std::vector<UInt32> visible(numWords + 1), indices(n);
+    std::vector<UInt8> hints(n, 0);
+
+    // a sentinel after the last word
+    visible[numWords] = 0xdeadbeef;
+
+    check("spheres", visible, refSpheres, ambiguous, frustum.spheresInFrustum(spheres, n, visible.data()));
+    check("spheres light", visible, refLight, ambiguous, frustum.spheresInFrustumLight(spheres, n, visible.data()));
+    check("boxes", visible, refBoxes, ambiguous, frustum.boxesInFrustum(boxes, n, visible.data()));
+
+    // the second frame starts with the plane that rejected each object
+    for (Int32 frame = 0; frame < 2; ++frame) {
+        check("spheres hints", visible, refSpheres, ambiguous, frustum.spheresInFrustum(spheres, n, visible.data(), hints.data()));
+    }
+
+    std::fill(hints.begin(), hints.end(), 0);
+    for (Int32 frame = 0; frame < 2; ++frame) {
+        check("boxes hints", visible, refBoxes, ambiguous, frustum.boxesInFrustum(boxes, n, visible.data(), hints.data()));
+    }
+
+    for (UInt8 h : hints) {
+        if (h > 5) {
+            std::cerr << "invalid hint " << (Int32)h << std::endl;
+            ++errors;
+            break;
+        }
+    }
+
+    if (visible[numWords] != 0xdeadbeef) {
+        std::cerr << "write after the last word" << std::endl;
+        ++errors;
+    }
+
+    const UInt32 count = Frustum::compactVisible(visible.data(), n, indices.data());
+    UInt32 expected = 0;
+    for (UInt32 i = 0; i < n && expected <= count; ++i) {
+        if ((visible[i >> 5] >> (i & 31)) & 1) {
+            if (expected == count || indices[expected] != i) {
+                break;
+            }
+            ++expected;
+        }
+    }
+
+    if (expected != count) {
+        std::cerr << "compactVisible: mismatch" << std::endl;
+        ++errors;
+    }
+
+    std::cout << "  visible spheres " << frustum.spheresInFrustum(spheres, n, visible.data())
+              << ", boxes " << frustum.boxesInFrustum(boxes, n, visible.data()) << std::endl;
+
+    //
+    // throughput
+    //
+
+    std::vector<Bool> result(n);
+
+    const Double scalarSpheres = measure([&] () {
+        for (UInt32 i = 0; i < n; ++i) {
+            result[i] = frustum.sphereInFrustum(Vector3(x[i], y[i], z[i]), r[i]) != Geometry::CLIP_OUTSIDE;
+        }
+    }, n);
+
+    const Double scalarBoxes = measure([&] () {
+        for (UInt32 i = 0; i < n; ++i) {
+            result[i] = frustum.boxInFrustum(aabbs[i]) != Geometry::CLIP_OUTSIDE;
+        }
+    }, n);
+
+    std::cout << "  " << std::left << std::setw(28) << "sphereInFrustum" << std::right << std::fixed
+              << std::setprecision(1) << std::setw(9) << scalarSpheres << " Mobj/s" << std::endl;
+
+    report("spheres", scalarSpheres, measure([&] () {
+        frustum.spheresInFrustum(spheres, n, visible.data());
+    }, n));
+
+    report("spheres hints", scalarSpheres, measure([&] () {
+        frustum.spheresInFrustum(spheres, n, visible.data(), hints.data());
+    }, n));
+
+    std::cout << "  " << std::left << std::setw(28) << "boxInFrustum" << std::right << std::fixed
+              << std::setprecision(1) << std::setw(9) << scalarBoxes << " Mobj/s" << std::endl;
+
+    report("boxes", scalarBoxes, measure([&] () {
+        frustum.boxesInFrustum(boxes, n, visible.data());
+    }, n));
+
+    report("boxes hints", scalarBoxes, measure([&] () {
+        frustum.boxesInFrustum(boxes, n, visible.data(), hints.data());
+    }, n));
+
+    return errors ? 1 : 0;
+}
@@ -0,0 +1,324 @@
+/**
+ * @file sparsesolver.cpp
+ * @brief Benchmark of the sparse matrix product and solvers.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : sparsesolver [entries-per-row] [max-simd-level]
+ * Build random symmetric and diagonally dominant systems of 1k, 10k and 100k unknowns,
+ * check SparseMatrix against a dense MatrixNxP and a plain loop, and report the
+ * throughput of the product, the conjugate gradient iterations and time, and the
+ * projected Gauss-Seidel on a boxed problem.
+ * The SIMD level can be limited (0 scalar, 1 SSE2, 5 AVX2, 6 AVX-512).
+ */
+
+#include <o3d/core/sparsematrix.h>
+#include <o3d/core/matrixnxp.h>
+#include <o3d/core/cpudispatch.h>
+
+#include <chrono>
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <cmath>
+#include <cstdlib>
+
+using namespace o3d;
+
+static UInt32 errors = 0;
+
+//! Best of 10 rounds of at least 20ms, in seconds per call.
+template <class F>
+static Double measure(F f)
+{
+    Double best = 1e9;
+
+    for (Int32 round = 0; round < 10; ++round) {
+        UInt32 runs = 0;
+        auto start = std::chrono::steady_clock::now();
+        Double elapsed = 0;
+
+        do {
+            f();
+            ++runs;
+            elapsed = std::chrono::duration<Double>(std::chrono::steady_clock::now() - start).count();
+        } while (elapsed < 0.02);
+
+        best = o3d::min(best, elapsed / runs);
+    }
+
+    return best;
+}
+
+static Double elapsedOnce(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<Double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//! Random symmetric matrix with about 2*k off diagonal entries per row, the diagonal
+//! being larger than the sum of the row, plus 1.
+static std::vector<SparseMatrix::Entry> randomSystem(UInt32 n, UInt32 k, std::mt19937 &rnd)
+{
+    std::uniform_real_distribution<Float> value(-1.f, 1.f);
+    std::vector<SparseMatrix::Entry> entries;
+    std::vector<Float> diagonal(n, 1.f);
+
+    for (UInt32 i = 0; i < n; ++i) {
+        for (UInt32 e = 0; e < k; ++e) {
+            // mostly near the diagonal, like a mesh, some far
+            const UInt32 j = (e & 1) ? rnd() % n : (i + 1 + rnd() % 64) % n;
+            if (j == i) {
+                continue;
+            }
+
+            const Float v = value(rnd);
+            entries.push_back({i, j, v});
+            entries.push_back({j, i, v});
+
+            diagonal[i] += o3d::abs(v);
+            diagonal[j] += o3d::abs(v);
+        }
+    }
+
+    for (UInt32 i = 0; i < n; ++i) {
+        entries.push_back({i, i, diagonal[i]});
+    }
+
+    return entries;
+}
+
+//! Plain CSR loop, the reference of the product.
+static void multiplyLoop(const SparseMatrix &m, const Float *x, Float *y)
+{
+    const UInt32 *offsets = m.getRowOffsets();
+    const UInt32 *columns = m.getColumns();
+    const Float *values = m.getValues();
+
+    for (UInt32 i = 0; i < m.getNbrRows(); ++i) {
+        Float sum = 0.f;
+        for (UInt32 k = offsets[i]; k < offsets[i+1]; ++k) {
+            sum += values[k] * x[columns[k]];
+        }
+        y[i] = sum;
+    }
+}
+
+static Float maxDifference(const Float *a, const Float *b, UInt32 n)
+{
+    Float result = 0.f;
+    for (UInt32 i = 0; i < n; ++i) {
+        result = o3d::max(result, o3d::abs(a[i] - b[i]) / o3d::max(1.f, o3d::abs(b[i])));
+    }
+
+    return result;
+}
+
+//! Small system against the dense matrix.
+static void checkDense(std::mt19937 &rnd)
+{
+    const UInt32 n = 37;
+    std::vector<SparseMatrix::Entry> entries = randomSystem(n, 3, rnd);
+
+    // a duplicate, summed
+    entries.push_back({5, 5, 1.f});
+
+    MatrixNxP dense(n, n);
+    dense.zero();
+    for (const SparseMatrix::Entry &e : entries) {
+        dense.getData()[e.row * n + e.col] += e.value;
+    }
+
+    const SparseMatrix fromEntries(n, n, entries);
+    const SparseMatrix fromDense(dense);
+
+    if (fromEntries.getNumNonZeros() != fromDense.getNumNonZeros()) {
+        std::cerr << "dense: " << fromEntries.getNumNonZeros() << " entries instead of "
+                  << fromDense.getNumNonZeros() << std::endl;
+        ++errors;
+    }
+
+    for (UInt32 i = 0; i < n; ++i) {
+        for (UInt32 j = 0; j < n; ++j) {
+            if (o3d::abs(fromEntries.getData(i, j) - dense.getData(i, j)) > 1e-6f) {
+                std::cerr << "dense: different entry " << i << "," << j << std::endl;
+                ++errors;
+                i = j = n;
+            }
+        }
+    }
+
+    VectorND x(n), b(n);
+    for (UInt32 i = 0; i < n; ++i) {
+        x.setData(i, Float(i % 7) - 3.f);
+    }
+
+    const VectorND y = fromEntries * x;
+    const VectorND yDense = dense * x;
+    if (maxDifference(y.getData(), yDense.getData(), n) > 1e-5f) {
+        std::cerr << "dense: different product" << std::endl;
+        ++errors;
+    }
+
+    // Gauss-Seidel step like the dense one
+    b = yDense;
+    VectorND xs(n), xd(n);
+    for (Int32 iter = 0; iter < 5; ++iter) {
+        fromEntries.gaussSeidelStep(xs, b);
+        dense.gaussSeidelStep(xd, b);
+    }
+
+    if (maxDifference(xs.getData(), xd.getData(), n) > 1e-5f) {
+        std::cerr << "dense: different Gauss-Seidel step" << std::endl;
+        ++errors;
+    }
+
+    // rectangular product
+    std::vector<SparseMatrix::Entry> rect = { {0, 4, 2.f}, {2, 0, -1.f}, {2, 4, 3.f}, {2, 0, 0.5f} };
+    const SparseMatrix r(3, 5, rect);
+    VectorND v(5);
+    v.setData(0, 1.f);
+    v.setData(4, 2.f);
+
+    const VectorND rv = r * v;
+    if (rv.getDim() != 3 || rv.getData(0) != 4.f || rv.getData(1) != 0.f || rv.getData(2) != 5.5f) {
+        std::cerr << "rectangular: wrong product" << std::endl;
+        ++errors;
+    }
+}
+
+static void run(UInt32 n, UInt32 k, std::mt19937 &rnd)
+{
+    const auto buildStart = std::chrono::steady_clock::now();
+    const SparseMatrix m(n, n, randomSystem(n, k, rnd));
+    const Double buildTime = elapsedOnce(buildStart);
+
+    const UInt32 nnz = m.getNumNonZeros();
+
+    std::cout << std::setw(7) << n << " unknowns, " << std::fixed << std::setprecision(1)
+              << Double(nnz) / n << " entries per row, built in " << buildTime * 1e3 << " ms" << std::endl;
+
+    std::uniform_real_distribution<Float> value(-1.f, 1.f);
+    std::vector<Float> x(n), y(n), ref(n);
+    for (UInt32 i = 0; i < n; ++i) {
+        x[i] = value(rnd);
+    }
+
+    //
+    // product
+    //
+
+    multiplyLoop(m, x.data(), ref.data());
+    m.multiply(x.data(), y.data());
+
+    const Float productError = maxDifference(y.data(), ref.data(), n);
+    if (productError > 1e-5f) {
+        std::cerr << "multiply: max error " << productError << std::endl;
+        ++errors;
+    }
+
+    const Double loop = measure([&] { multiplyLoop(m, x.data(), ref.data()); });
+    const Double product = measure([&] { m.multiply(x.data(), y.data()); });
+
+    std::cout << "  product   " << std::setprecision(1) << std::setw(9) << product * 1e6 << " us "
+              << std::setprecision(2) << std::setw(7) << 2.0 * nnz / product / 1e9 << " GFlops"
+              << ", loop " << std::setprecision(1) << std::setw(9) << loop * 1e6 << " us, x"
+              << std::setprecision(2) << loop / product << std::endl;
+
+    //
+    // conjugate gradient, with a known solution
+    //
+
+    VectorND solution(n), b(n), result(n);
+    for (UInt32 i = 0; i < n; ++i) {
+        solution.setData(i, value(rnd));
+    }
+
+    m.multiply(solution.getData(), b.getData());
+
+    Float residual = 0.f;
+    const auto cgStart = std::chrono::steady_clock::now();
+    const UInt32 cgIter = m.solveConjugateGradient(b, result, 500, 1e-6f, &residual);
+    const Double cgTime = elapsedOnce(cgStart);
+
+    const Float cgError = maxDifference(result.getData(), solution.getData(), n);
+
+    std::cout << "  pcg       " << std::setprecision(1) << std::setw(9) << cgTime * 1e3 << " ms, "
+              << cgIter << " iterations, residual " << std::scientific << std::setprecision(2) << residual
+              << ", error " << cgError << std::fixed << std::endl;
+
+    if (residual > 1e-6f || cgError > 1e-4f) {
+        std::cerr << "pcg: not converged" << std::endl;
+        ++errors;
+    }
+
+    //
+    // projected Gauss-Seidel, the solution being clamped in [-0.5, 0.5]
+    //
+
+    VectorND lo(n), hi(n), pgs(n);
+    lo.setValue(-0.5f);
+    hi.setValue(0.5f);
+
+    const auto pgsStart = std::chrono::steady_clock::now();
+    const UInt32 pgsIter = m.solveProjectedGaussSeidel(b, pgs, lo, hi, 200, 1e-6f);
+    const Double pgsTime = elapsedOnce(pgsStart);
+
+    // complementarity : w = M*x - b is 0 inside, >= 0 on lo and <= 0 on hi
+    std::vector<Float> w(n);
+    m.multiply(pgs.getData(), w.data());
+
+    Float violation = 0.f;
+    UInt32 clamped = 0;
+    for (UInt32 i = 0; i < n; ++i) {
+        const Float xi = pgs.getData(i);
+        const Float wi = (w[i] - b.getData(i)) / m.getData(i, i);
+
+        if (xi < -0.5f || xi > 0.5f) {
+            violation = o3d::max(violation, 1.f);
+        } else if (xi == -0.5f) {
+            violation = o3d::max(violation, -wi);
+            ++clamped;
+        } else if (xi == 0.5f) {
+            violation = o3d::max(violation, wi);
+            ++clamped;
+        } else {
+            violation = o3d::max(violation, o3d::abs(wi));
+        }
+    }
+
+    std::cout << "  pgs       " << std::setprecision(1) << std::setw(9) << pgsTime * 1e3 << " ms, "
+              << pgsIter << " iterations, " << clamped << " clamped, violation "
+              << std::scientific << std::setprecision(2) << violation << std::fixed << std::endl;
+
+    if (violation > 1e-4f) {
+        std::cerr << "pgs: complementarity not satisfied" << std::endl;
+        ++errors;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 k = argc > 1 ? (UInt32)atoi(argv[1]) : 4;
+    if (argc > 2) {
+        CpuDispatch::setMaxLevel((SimdLevel)atoi(argv[2]));
+    }
+
+    std::cout << CpuDispatch::getLevelName(CpuDispatch::getLevel()) << std::endl;
+
+    std::mt19937 rnd(1234);
+
+    checkDense(rnd);
+
+    for (UInt32 n : { 1000u, 10000u, 100000u }) {
+        run(n, k, rnd);
+    }
+
+    if (errors) {
+        std::cerr << errors << " error(s)" << std::endl;
+        return 1;
+    }
+
+    std::cout << "ok" << std::endl;
+    return 0;
+}
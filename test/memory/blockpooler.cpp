@@ -0,0 +1,204 @@
+/**
+ * @file blockpooler.cpp
+ * @brief Stress test and micro-benchmark of the concurrent block pooler.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : blockpooler [num-producers] [objects-per-producer]
+ * Producer threads create objects from a TypedPool and hand them to the main thread
+ * which checks and destroys them, the rate is compared to new/delete.
+ */
+
+#include <o3d/core/typedpool.h>
+#include <o3d/core/thread.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace o3d;
+
+struct Node
+{
+    Node(UInt32 producer, UInt32 value) : producer(producer), value(value), check(producer ^ value) {}
+    ~Node() { check = 0; }
+
+    UInt32 producer;
+    UInt32 value;
+    UInt32 check;
+    Float payload[5];
+};
+
+//! Single producer single consumer exchange of objects.
+class Channel
+{
+public:
+
+    Channel() : m_size(1024), m_slots(new Node*[1024]), m_write(0), m_read(0) {}
+    ~Channel() { delete [] m_slots; }
+
+    Bool push(Node *node)
+    {
+        const UInt32 write = m_write.load(std::memory_order_relaxed);
+        if (write - m_read.load(std::memory_order_acquire) == m_size) {
+            return False;
+        }
+
+        m_slots[write % m_size] = node;
+        m_write.store(write + 1, std::memory_order_release);
+        return True;
+    }
+
+    Node* pop()
+    {
+        const UInt32 read = m_read.load(std::memory_order_relaxed);
+        if (read == m_write.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+
+        Node *node = m_slots[read % m_size];
+        m_read.store(read + 1, std::memory_order_release);
+        return node;
+    }
+
+private:
+
+    const UInt32 m_size;
+    Node **m_slots;
+    std::atomic<UInt32> m_write;
+    std::atomic<UInt32> m_read;
+};
+
+template <class CREATE>
+class Producer : public Runnable
+{
+public:
+
+    Producer(UInt32 id, UInt32 numObjects, CREATE create) :
+        m_thread(this),
+        m_id(id),
+        m_numObjects(numObjects),
+        m_create(create)
+    {
+    }
+
+    virtual Int32 run(void *)
+    {
+        for (UInt32 i = 0; i < m_numObjects; ++i) {
+            Node *node = m_create(m_id, i);
+            while (!m_channel.push(node)) {
+                System::waitMs(0);
+            }
+        }
+
+        return 0;
+    }
+
+    Thread m_thread;
+    Channel m_channel;
+    UInt32 m_id;
+    UInt32 m_numObjects;
+    CREATE m_create;
+};
+
+template <class CREATE, class DESTROY>
+static Double measure(UInt32 numProducers, UInt32 numObjects, CREATE create, DESTROY destroy, Bool &valid)
+{
+    std::vector<Producer<CREATE>*> producers;
+    std::vector<UInt32> next(numProducers, 0);
+
+    for (UInt32 i = 0; i < numProducers; ++i) {
+        producers.push_back(new Producer<CREATE>(i, numObjects, create));
+    }
+
+    const UInt64 total = UInt64(numProducers) * numObjects;
+    UInt64 count = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for (Producer<CREATE> *producer : producers) {
+        producer->m_thread.start();
+    }
+
+    // the main thread frees what the others allocated, sometimes keeping few of them
+    std::vector<Node*> kept;
+
+    while (count < total) {
+        Bool any = False;
+
+        for (UInt32 i = 0; i < numProducers; ++i) {
+            Node *node;
+            while ((node = producers[i]->m_channel.pop()) != nullptr) {
+                if (node->producer != i || node->value != next[i]++ || node->check != (node->producer ^ node->value)) {
+                    valid = False;
+                }
+
+                if ((count & 7) == 0) {
+                    kept.push_back(node);
+                } else {
+                    destroy(node);
+                }
+
+                ++count;
+                any = True;
+            }
+        }
+
+        if (kept.size() >= 256) {
+            for (Node *node : kept) {
+                destroy(node);
+            }
+            kept.clear();
+        }
+
+        if (!any) {
+            System::waitMs(0);
+        }
+    }
+
+    for (Node *node : kept) {
+        destroy(node);
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+
+    for (Producer<CREATE> *producer : producers) {
+        producer->m_thread.waitFinish();
+        delete producer;
+    }
+
+    return total / std::chrono::duration<Double>(end - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 numProducers = argc > 1 ? (UInt32)atoi(argv[1]) : 4;
+    const UInt32 numObjects = argc > 2 ? (UInt32)atoi(argv[2]) : 1000000;
+
+    ThreadManager::init();
+
+    TypedPool<Node> pool;
+    Bool valid = True;
+
+    auto poolCreate = [&pool] (UInt32 producer, UInt32 value) { return pool.create(producer, value); };
+    auto poolDestroy = [&pool] (Node *node) { pool.destroy(node); };
+
+    auto heapCreate = [] (UInt32 producer, UInt32 value) { return new Node(producer, value); };
+    auto heapDestroy = [] (Node *node) { delete node; };
+
+    const Double heap = measure(numProducers, numObjects, heapCreate, heapDestroy, valid);
+    const Double pooled = measure(numProducers, numObjects, poolCreate, poolDestroy, valid);
+
+    std::cout << numProducers << " producers : " << UInt64(heap) << " objects/s with new/delete, "
+              << UInt64(pooled) << " objects/s with a typed pool (x" << pooled / heap << "), "
+              << pool.getCapacity() << " pooled objects capacity" << std::endl;
+
+    if (!valid) {
+        std::cerr << "Corrupted object" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
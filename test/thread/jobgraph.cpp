@@ -0,0 +1,209 @@
+/**
+ * @file jobgraph.cpp
+ * @brief Test of the JobGraph dependencies, continuations, cancellation and parallelFor.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : jobgraph [num-iterations] [num-workers]
+ * Run each case several times on a WorkerPool, and report the first failed check.
+ */
+
+#include <o3d/core/jobgraph.h>
+#include <o3d/core/error.h>
+
+#include <atomic>
+#include <iostream>
+#include <stdexcept>
+#include <vector>
+#include <cstdlib>
+
+using namespace o3d;
+
+static UInt32 g_numErrors = 0;
+static WorkerPool *g_pool = nullptr;
+
+static void check(Bool cond, const char *what)
+{
+    if (!cond) {
+        if (g_numErrors == 0) {
+            std::cerr << "Failed : " << what << std::endl;
+        }
+        ++g_numErrors;
+    }
+}
+
+//! Fan-out and fan-in, each job must see its dependencies done.
+static void testDependencies()
+{
+    std::atomic<Int32> step(0);
+    std::atomic<Int32> mips(0);
+    std::atomic<Bool> ordered(True);
+
+    JobGraph graph(g_pool);
+
+    Job *read = graph.add([&] () { step = 1; });
+    Job *decode = graph.add([&] () { if (step.load() != 1) { ordered = False; } step = 2; }, {read});
+    Job *mip1 = graph.add([&] () { if (step.load() != 2) { ordered = False; } ++mips; }, {decode});
+    Job *mip2 = graph.add([&] () { if (step.load() != 2) { ordered = False; } ++mips; }, {decode});
+    Job *upload = graph.add([&] () { if (mips.load() != 2) { ordered = False; } step = 3; }, {mip1, mip2});
+
+    graph.start();
+    graph.wait();
+
+    check(ordered.load(), "dependencies order");
+    check(step.load() == 3, "every job run");
+    check(upload->isDone() && !upload->isCanceled(), "last job done");
+    check(!graph.isFailed(), "no failure");
+    check(graph.getNumJobs() == 5, "number of jobs");
+}
+
+//! Continuations added before the start and from a running job.
+static void testContinuations()
+{
+    std::atomic<Int32> count(0);
+
+    JobGraph graph(g_pool);
+
+    Job *first = graph.add([&] () { ++count; });
+    first->then([&] () {
+        ++count;
+
+        // added from a running job of the started graph
+        graph.add([&] () { ++count; })->then([&] () { ++count; });
+    });
+
+    graph.start();
+    graph.wait();
+
+    check(count.load() == 4, "continuations run");
+    check(graph.getNumJobs() == 4, "number of continuations");
+
+    // then on a job already done
+    first->then([&] () { ++count; });
+    graph.wait();
+
+    check(count.load() == 5, "continuation of a done job");
+}
+
+//! A failed job cancels its successors, including the ones added after the failure.
+static void testCancellation()
+{
+    std::atomic<Int32> count(0);
+
+    JobGraph graph(g_pool);
+
+    Job *failing = graph.add([&] () { throw std::runtime_error("expected failure"); });
+    Job *before = failing->then([&] () { ++count; });
+    Job *chained = before->then([&] () { ++count; });
+    Job *independent = graph.add([&] () { ++count; });
+
+    graph.start();
+    graph.wait();
+
+    check(graph.isFailed(), "graph failed");
+    check(failing->isDone() && !failing->isCanceled(), "failed job done, not canceled");
+    check(before->isDone() && before->isCanceled(), "successor canceled");
+    check(chained->isDone() && chained->isCanceled(), "canceled job cancel its successors");
+    check(independent->isDone() && !independent->isCanceled(), "independent job run");
+    check(count.load() == 1, "canceled jobs never run");
+
+    // dependencies of the already failed or canceled jobs
+    Job *after = failing->then([&] () { ++count; });
+    Job *afterCanceled = graph.add([&] () { ++count; }, {before});
+    Job *afterDone = graph.add([&] () { ++count; }, {independent});
+
+    graph.wait();
+
+    check(after->isCanceled(), "continuation of a failed job canceled");
+    check(afterCanceled->isCanceled(), "dependency on a canceled job canceled");
+    check(!afterDone->isCanceled(), "dependency on a done job run");
+    check(count.load() == 2, "late canceled jobs never run");
+}
+
+//! Every index processed once, and a failed range reported.
+static void testParallelFor()
+{
+    const UInt32 count = 100000;
+    std::vector<UInt32> hits(count, 0);
+
+    JobGraph::parallelFor(0, count, 0, [&] (UInt32 first, UInt32 last) {
+        for (UInt32 i = first; i < last; ++i) {
+            ++hits[i];
+        }
+    }, g_pool);
+
+    Bool once = True;
+    for (UInt32 i = 0; i < count; ++i) {
+        if (hits[i] != 1) {
+            once = False;
+        }
+    }
+
+    check(once, "parallelFor processes each index once");
+
+    // small grain, more jobs than workers
+    std::atomic<UInt64> sum(0);
+    JobGraph::parallelFor(10, 1010, 7, [&] (UInt32 first, UInt32 last) {
+        UInt64 partial = 0;
+        for (UInt32 i = first; i < last; ++i) {
+            partial += i;
+        }
+        sum += partial;
+    }, g_pool);
+
+    check(sum.load() == (10 + 1009) * 1000 / 2, "parallelFor sum");
+
+    // range ending near the maximal index, the last sub-range must not wrap
+    std::atomic<UInt32> numIndices(0);
+    std::atomic<Bool> inRange(True);
+    JobGraph::parallelFor(0xffffffff - 1000, 0xffffffff, 300, [&] (UInt32 first, UInt32 last) {
+        if (first < 0xffffffff - 1000 || last > 0xffffffff || last <= first) {
+            inRange = False;
+        }
+        numIndices += last - first;
+    }, g_pool);
+
+    check(inRange.load() && numIndices.load() == 1000, "parallelFor near the maximal index");
+
+    // empty range
+    Bool called = False;
+    JobGraph::parallelFor(5, 5, 0, [&] (UInt32, UInt32) { called = True; }, g_pool);
+    check(!called, "parallelFor on an empty range");
+
+    Bool thrown = False;
+    try {
+        JobGraph::parallelFor(0, 1000, 10, [] (UInt32 first, UInt32) {
+            if (first == 500) {
+                throw std::runtime_error("expected failure");
+            }
+        }, g_pool);
+    } catch (E_InvalidResult &) {
+        thrown = True;
+    }
+
+    check(thrown, "parallelFor reports a failed range");
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 numIterations = argc > 1 ? (UInt32)atoi(argv[1]) : 100;
+    const UInt32 numWorkers = argc > 2 ? (UInt32)atoi(argv[2]) : 4;
+
+    ThreadManager::init();
+
+    g_pool = new WorkerPool(numWorkers);
+
+    for (UInt32 i = 0; i < numIterations; ++i) {
+        testDependencies();
+        testContinuations();
+        testCancellation();
+        testParallelFor();
+    }
+
+    std::cout << numIterations << " iterations on " << g_pool->getNumWorkers()
+              << " workers, " << g_numErrors << " errors" << std::endl;
+
+    delete g_pool;
+
+    return g_numErrors ? 1 : 0;
+}
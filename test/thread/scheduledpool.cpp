@@ -0,0 +1,128 @@
+/**
+ * @file scheduledpool.cpp
+ * @brief Micro-benchmark of the ScheduledThreadPool timing wheel.
+ * @author Frederic SCHERMA (frederic.scherma@dreamoverflow.org)
+ * @date 2026-10-17
+ * @copyright Copyright (c) 2001-2026 Dream Overflow. All rights reserved.
+ * @details Usage : scheduledpool [num-tasks] [period-ms] [num-threads]
+ * Schedule periodic tasks, and report the insert, fire and cancel rates, plus the
+ * maximal lateness of a one shot task.
+ */
+
+#include <o3d/core/scheduledthreadpool.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace o3d;
+
+static std::atomic<UInt64> g_fired(0);
+
+class Tick : public Runnable
+{
+public:
+
+    virtual Int32 run(void *)
+    {
+        ++g_fired;
+        return 0;
+    }
+};
+
+class OneShot : public Runnable
+{
+public:
+
+    OneShot(std::atomic<Int64> &runTime) : m_runTime(runTime) {}
+
+    virtual Int32 run(void *)
+    {
+        m_runTime = std::chrono::duration_cast<std::chrono::microseconds>(
+                        std::chrono::steady_clock::now().time_since_epoch()).count();
+
+        // no more run
+        return -1;
+    }
+
+private:
+
+    std::atomic<Int64> &m_runTime;
+};
+
+static Double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<Double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+    const UInt32 numTasks = argc > 1 ? (UInt32)atoi(argv[1]) : 100000;
+    const UInt32 period = argc > 2 ? (UInt32)atoi(argv[2]) : 100;
+    const UInt32 numThreads = argc > 3 ? (UInt32)atoi(argv[3]) : 4;
+
+    ThreadManager::init();
+
+    ScheduledThreadPool *pool = new ScheduledThreadPool(numThreads);
+    std::vector<UInt64> ids;
+    ids.reserve(numTasks);
+
+    // insert, with initial delays spread over a period
+    auto start = std::chrono::steady_clock::now();
+
+    for (UInt32 i = 0; i < numTasks; ++i) {
+        ids.push_back(pool->schedule(new Tick, (Int32)(i % period), (Int32)period));
+    }
+
+    const Double insertTime = seconds(start);
+
+    // fire during two seconds
+    const UInt64 firedBefore = g_fired.load();
+    start = std::chrono::steady_clock::now();
+
+    System::waitMs(2000);
+
+    const Double fireTime = seconds(start);
+    const UInt64 fired = g_fired.load() - firedBefore;
+
+    // one shot lateness
+    std::atomic<Int64> runTime(0);
+    const Int64 expected = std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now().time_since_epoch()).count() + 50000;
+
+    pool->schedule(new OneShot(runTime), 50, 0);
+
+    while (runTime.load() == 0) {
+        System::waitMs(1);
+    }
+
+    // cancel
+    start = std::chrono::steady_clock::now();
+
+    UInt32 canceled = 0;
+    for (UInt64 id : ids) {
+        if (pool->cancel(id)) {
+            ++canceled;
+        }
+    }
+
+    const Double cancelTime = seconds(start);
+
+    std::cout << numTasks << " tasks every " << period << " ms on " << numThreads << " threads" << std::endl;
+    std::cout << "  insert : " << UInt64(numTasks / insertTime) << " tasks/s" << std::endl;
+    std::cout << "  fire   : " << UInt64(fired / fireTime) << " runs/s (expected "
+              << UInt64(Double(numTasks) * 1000 / period) << ")" << std::endl;
+    std::cout << "  cancel : " << UInt64(canceled / cancelTime) << " tasks/s" << std::endl;
+    std::cout << "  one shot lateness : " << (runTime.load() - expected) << " us" << std::endl;
+
+    delete pool;
+
+    if (canceled != numTasks || runTime.load() < expected) {
+        std::cerr << "Unexpected cancel count or early run" << std::endl;
+        return 1;
+    }
+
+    return 0;
+}